@@ -13,12 +13,20 @@
         #define RB_ENABLE_ASSERTS
         #define RB_ENABLE_LOGS
         #define RB_DEBUG_BREAK __debugbreak()
+
+        #ifndef RB_ENABLE_PROFILING
+            #define RB_ENABLE_PROFILING
+        #endif
     #endif
     
     #ifdef RB_CONFIG_OPTIMIZED
         #define RB_ENABLE_ASSERTS
         #define RB_ENABLE_LOGS
         #define RB_DEBUG_BREAK
+
+        #ifndef RB_ENABLE_PROFILING
+            #define RB_ENABLE_PROFILING
+        #endif
     #endif
     
     #ifdef RB_CONFIG_DIST
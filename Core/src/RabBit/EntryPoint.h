@@ -5,7 +5,9 @@
 
 #include "utils/String.h"
 #include "utils/debug/Log.h"
+#include "utils/debug/MemoryTracker.h"
 #include "events/Event.h"
+#include "events/input/InputRing.h"
 #include "app/Application.h"
 
 extern RB::Application* RB::CreateApplication(const char* launch_args);
@@ -21,7 +23,13 @@ int WINAPI wWinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance,
     RB::Utils::Debug::Logger::OpenConsole();
 #endif
 
+    // Everything allocated from here on should be freed again before exiting
+#ifdef RB_ENABLE_MEMORY_TRACKING
+    uint64_t first_allocation = RB::Utils::Debug::MemoryTracker::GetNextAllocationId();
+#endif
+
     RB::Events::g_EventManager = new RB::Events::EventManager();
+    RB::Events::g_InputSampler = new RB::Events::InputSampler();
 
     char args[100];
     RB_ASSERT_FATAL(_countof(args) >= (wcslen(lpCmdLine) + 1), "Launch arguments copy should be made longer!");
@@ -42,7 +50,18 @@ int WINAPI wWinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance,
     }
 
     delete app;
+    delete RB::Events::g_InputSampler;
     delete RB::Events::g_EventManager;
 
+#ifdef RB_ENABLE_MEMORY_TRACKING
+    RB::Utils::Debug::MemoryTracker::LogReport();
+    RB::Utils::Debug::MemoryTracker::DumpLeaks(first_allocation);
+#endif
+
+    // Write out the last logs
+#ifdef RB_ENABLE_LOGS
+    RB::Utils::Debug::Logger::Shutdown();
+#endif
+
     return 0;
 }
\ No newline at end of file
@@ -20,7 +20,9 @@
 #include <tuple>
 #include <map>
 #include <queue>
+#include <deque>
 #include <array>
+#include <atomic>
 #include <unordered_map>
 #include <functional>
 
@@ -9,8 +9,14 @@
 
 #include "entity/Scene.h"
 
+#include "utils/Threading.h"
+#include "utils/debug/Profiler.h"
+#include "utils/debug/Stats.h"
+#include "utils/debug/MemoryTracker.h"
+
 #include "events/ApplicationEvent.h"
 #include "events/KeyEvent.h"
+#include "events/WindowEvent.h"
 #include "events/input/KeyCodes.h"
 #include "events/input/Input.h"
 
@@ -30,10 +36,17 @@ namespace RB
         , m_FrameIndex(0)
         , m_CheckWindows(false)
         , m_PrimaryWindowIndex(0)
+        , m_WorkerPool(nullptr)
     {
         RB_ASSERT_FATAL(LOGTAG_MAIN, s_Instance == nullptr, "Application already exists");
         s_Instance = this;
 
+        // All the other events go to the layers through OnEvent
+        Subscribe<KeyPressedEvent>(RB_BIND_EVENT_FN(Application::OnKeyPressed));
+        Subscribe<WindowOnFocusEvent>(RB_BIND_EVENT_FN(Application::OnWindowFocus));
+        Subscribe<WindowCloseRequestEvent>(RB_BIND_EVENT_FN(Application::OnWindowCloseRequest));
+        Subscribe<GraphicsSettingsChangedEvent>(RB_BIND_EVENT_FN(Application::OnGraphicsSettingsChanged));
+
         RB_LOG_RELEASE(LOGTAG_MAIN, "Welcome to the RabBit Engine");
         RB_LOG_RELEASE(LOGTAG_MAIN, "Version: %s.%s.%s", RB_VERSION_MAJOR, RB_VERSION_MINOR, RB_VERSION_PATCH);
     }
@@ -83,6 +96,8 @@ namespace RB
 
         m_GraphicsSettings.Print();
 
+        m_WorkerPool = new WorkerPool(L"Worker Pool");
+
         m_Renderer = Renderer::Create(std::strstr(launch_args, "-renderDebug"));
         m_Renderer->Init();
 
@@ -133,36 +148,65 @@ namespace RB
         LARGE_INTEGER prev_time, curr_time;
         QueryPerformanceCounter(&prev_time);
 
+        RB_PROFILE_THREAD("Main Thread");
+
         while (!m_ShouldStop)
         {
+            RB_PROFILE_CPU_SCOPED("Frame");
+
             QueryPerformanceCounter(&curr_time);
             float delta_time = static_cast<float>(curr_time.QuadPart - prev_time.QuadPart) / frequency.QuadPart;
             prev_time = curr_time;
 
+            RB_STAT_SET(FrameTime, delta_time * 1000000.0f);
+
             // Poll inputs and update windows
-            for (Graphics::Window* window : m_Windows)
             {
-                if (window->IsValid())
-                {
-                    window->Update();
-                }
-                else
+                RB_PROFILE_CPU_SCOPED("Update windows");
+                RB_STAT_TIME_SCOPED(WindowUpdateTime);
+
+                for (Graphics::Window* window : m_Windows)
                 {
-                    m_CheckWindows = true;
+                    if (window->IsValid())
+                    {
+                        window->Update();
+                    }
+                    else
+                    {
+                        m_CheckWindows = true;
+                    }
                 }
             }
 
+            // Take the input that was received while updating the windows, so the simulation uses the newest input
+            g_InputSampler->SampleFrame();
+
             // Process the new received events
-            ProcessEvents();
+            {
+                RB_PROFILE_CPU_SCOPED("Process events");
+                RB_STAT_TIME_SCOPED(EventProcessTime);
+                ProcessEvents();
+            }
 
             // Firstly update the engine itself
-            UpdateInternal(delta_time);
+            {
+                RB_PROFILE_CPU_SCOPED("Update engine");
+                RB_STAT_TIME_SCOPED(EngineUpdateTime);
+                UpdateInternal(delta_time);
+            }
 
             // Secondly update the application
-            UpdateApp(delta_time);
+            {
+                RB_PROFILE_CPU_SCOPED("Update application");
+                RB_STAT_TIME_SCOPED(AppUpdateTime);
+                UpdateApp(delta_time);
+            }
 
             // Submit the scene as context for rendering the next frame
-            m_Renderer->SubmitFrame(m_Scene);
+            {
+                RB_STAT_TIME_SCOPED(RenderSubmitTime);
+                m_Renderer->SubmitFrame(m_Scene);
+            }
 
             // Check if there are any windows that should be closed/removed
             if (m_CheckWindows)
@@ -188,8 +232,18 @@ namespace RB
                 m_CheckWindows = false;
             }
 
+#ifdef RB_ENABLE_MEMORY_TRACKING
+            Utils::Debug::MemoryTracker::EndFrame();
+#endif
+
+            Utils::Debug::Stats::EndFrame(m_FrameIndex);
+
             // Update the frame index
             ++m_FrameIndex;
+
+#ifdef RB_ENABLE_PROFILING
+            Utils::Debug::Profiler::Collect();
+#endif
         }
     }
 
@@ -244,6 +298,9 @@ namespace RB
         m_Renderer->Shutdown();
         delete m_Renderer;
 
+        // Finishes the jobs that are still scheduled
+        delete m_WorkerPool;
+
         RB_LOG(LOGTAG_MAIN, "");
         RB_LOG(LOGTAG_MAIN, "========= SHUTDOWN COMPLETE =========");
         RB_LOG(LOGTAG_MAIN, "");
@@ -332,76 +389,145 @@ namespace RB
         g_EventManager->InsertEvent(e);
     }
 
-    bool Application::OnEvent(Event& event)
+    bool Application::OnKeyPressed(KeyPressedEvent& key_event)
     {
+        // Like OnEvent, nothing is handled before the application is initialized
         if (!m_Initialized)
         {
             return true;
         }
 
-        // BindEvent<EventType>(RB_BIND_EVENT_FN(Class::Method), event);
+        if (key_event.GetKeyCode() == KeyCode::F11 ||
+            (IsKeyDown(KeyCode::LeftAlt) && key_event.GetKeyCode() == KeyCode::Enter))
+        {
+            WindowFullscreenToggleEvent e(GetPrimaryWindow()->GetNativeWindowHandle());
+            g_EventManager->InsertEvent(e);
 
-        bool passtrough_layers = true;
+            return true;
+        }
 
-        BindEvent<KeyPressedEvent>([&](KeyPressedEvent& e)
+        if (IsKeyDown(KeyCode::LeftAlt) && key_event.GetKeyCode() == KeyCode::F4)
         {
-            if (e.GetKeyCode() == KeyCode::F11 ||
-                (IsKeyDown(KeyCode::LeftAlt) && e.GetKeyCode() == KeyCode::Enter))
-            {
-                passtrough_layers = false;
+            RB_LOG(LOGTAG_EVENT, "Instant close requested, requesting to close all windows..");
 
-                WindowFullscreenToggleEvent e(GetPrimaryWindow()->GetNativeWindowHandle());
+            for (int i = 0; i < m_Windows.size(); i++)
+            {
+                WindowCloseRequestEvent e(m_Windows[i]->GetNativeWindowHandle());
                 g_EventManager->InsertEvent(e);
             }
 
-            if (IsKeyDown(KeyCode::LeftAlt) && e.GetKeyCode() == KeyCode::F4)
+            return true;
+        }
+
+        // Writes the stats of the last frames next to the executable
+        if (IsKeyDown(KeyCode::LeftControl) && key_event.GetKeyCode() == KeyCode::T)
+        {
+            char path[64];
+
+            snprintf(path, sizeof(path), "RabBit_stats_%llu.csv", m_FrameIndex);
+            bool saved = Utils::Debug::Stats::SaveCsv(path);
+
+            snprintf(path, sizeof(path), "RabBit_stats_%llu.json", m_FrameIndex);
+            saved &= Utils::Debug::Stats::SaveJson(path);
+
+            if (saved)
             {
-                RB_LOG(LOGTAG_EVENT, "Instant close requested, requesting to close all windows..");
-                passtrough_layers = false;
+                RB_LOG(LOGTAG_MAIN, "Saved the stats of the last frames to RabBit_stats_%llu", m_FrameIndex);
+            }
 
-                for (int i = 0; i < m_Windows.size(); i++)
+#ifdef RB_ENABLE_MEMORY_TRACKING
+            Utils::Debug::MemoryTracker::LogReport();
+#endif
+
+            return true;
+        }
+
+#ifdef RB_ENABLE_PROFILING
+        // Starts or stops a CPU capture, the capture is written next to the executable
+        if (IsKeyDown(KeyCode::LeftControl) && key_event.GetKeyCode() == KeyCode::P)
+        {
+            if (!Utils::Debug::Profiler::IsCapturing())
+            {
+                RB_LOG(LOGTAG_MAIN, "Started CPU capture at frame %llu", m_FrameIndex);
+                Utils::Debug::Profiler::BeginCapture();
+            }
+            else
+            {
+                Utils::Debug::ProfileCapture capture = Utils::Debug::Profiler::EndCapture();
+
+                char path[64];
+                snprintf(path, sizeof(path), "RabBit_capture_%llu.json", m_FrameIndex);
+
+                if (Utils::Debug::Profiler::SaveChromeTrace(capture, path))
                 {
-                    WindowCloseRequestEvent e(m_Windows[i]->GetNativeWindowHandle());
-                    g_EventManager->InsertEvent(e);
+                    RB_LOG(LOGTAG_MAIN, "Saved CPU capture to %s", path);
                 }
             }
-        }, event);
-        
-        BindEvent<WindowOnFocusEvent>([&](WindowOnFocusEvent& focus_event)
+
+            return true;
+        }
+#endif
+
+        return OnEvent(key_event);
+    }
+
+    bool Application::OnWindowFocus(WindowOnFocusEvent& focus_event)
+    {
+        if (!m_Initialized)
         {
-            passtrough_layers = false;
+            return true;
+        }
 
-            int32_t window_index = FindWindowIndex(focus_event.GetWindowHandle());
+        int32_t window_index = FindWindowIndex(focus_event.GetWindowHandle());
 
-            if (window_index >= 0)
-            {
-                m_PrimaryWindowIndex = window_index;
-            }
-        }, event);
+        if (window_index >= 0)
+        {
+            m_PrimaryWindowIndex = window_index;
+        }
+
+        return true;
+    }
+
+    bool Application::OnWindowCloseRequest(WindowCloseRequestEvent& close_event)
+    {
+        if (!m_Initialized)
+        {
+            return true;
+        }
+
+        m_CheckWindows = true;
 
-        BindEvent<WindowCloseRequestEvent>([&](WindowCloseRequestEvent& close_event)
+        return OnEvent(close_event);
+    }
+
+    bool Application::OnGraphicsSettingsChanged(GraphicsSettingsChangedEvent& settings_event)
+    {
+        if (!m_Initialized)
         {
-            m_CheckWindows = true;
-        }, event);
+            return true;
+        }
 
-        
-        BindEvent<GraphicsSettingsChangedEvent>([&](GraphicsSettingsChangedEvent& settings_event)
+        m_GraphicsSettings = settings_event.GetNewSettings();
+
+        return OnEvent(settings_event);
+    }
+
+    bool Application::OnEvent(Event& event)
+    {
+        if (!m_Initialized)
         {
-            m_GraphicsSettings = settings_event.GetNewSettings();
-        }, event);
+            return true;
+        }
 
-        if (passtrough_layers)
+        // Pass the event to the layers
+        for (ApplicationLayer* layer : m_LayerStack)
         {
-            // Pass the event to the layers
-            for (ApplicationLayer* layer : m_LayerStack)
+            if (layer->IsEnabled())
             {
-                if (layer->IsEnabled())
+                // If the event got handled by this layer, do not pass it to any layers after this one
+                if (layer->OnEvent(event))
                 {
-                    // If the event got handled by this layer, do not pass it to any layers after this one
-                    if (layer->OnEvent(event))
-                    {
-                        break;
-                    }
+                    break;
                 }
             }
         }
@@ -9,6 +9,16 @@
 
 namespace RB
 {
+    class WorkerPool;
+
+    namespace Events
+    {
+        class KeyPressedEvent;
+        class WindowOnFocusEvent;
+        class WindowCloseRequestEvent;
+        class GraphicsSettingsChangedEvent;
+    }
+
     namespace Graphics
     {
         class Window;
@@ -71,6 +81,9 @@ namespace RB
 
         Graphics::Renderer* GetRenderer() const { return m_Renderer; }
 
+        // Shared by all the systems that have work that can run in parallel
+        WorkerPool* GetWorkerPool() const { return m_WorkerPool; }
+
         Entity::Scene* GetScene() const { return m_Scene; }
 
         uint64_t GetFrameIndex() const { return m_FrameIndex; }
@@ -84,6 +97,12 @@ namespace RB
         void UpdateInternal(float delta_time);
         void UpdateApp(float delta_time);
         void OnNewLayerPushed(ApplicationLayer* layer);
+        bool OnKeyPressed(Events::KeyPressedEvent& key_event);
+        bool OnWindowFocus(Events::WindowOnFocusEvent& focus_event);
+        bool OnWindowCloseRequest(Events::WindowCloseRequestEvent& close_event);
+        bool OnGraphicsSettingsChanged(Events::GraphicsSettingsChangedEvent& settings_event);
+
+        // Passes the event to the layers
         bool OnEvent(Events::Event& event) override;
 
         const AppInfo				m_StartAppInfo;
@@ -100,6 +119,7 @@ namespace RB
         bool						m_CheckWindows;
 
         GraphicsSettings            m_GraphicsSettings;
+        WorkerPool*                 m_WorkerPool;
         Graphics::Renderer*			m_Renderer;
 
         Entity::Scene*				m_Scene;
@@ -1,6 +1,9 @@
 #include "RabBitCommon.h"
 #include "AssetManager.h"
 #include "utils/File.h"
+#include "graphics/TextureResidency.h"
+#include "utils/debug/MemoryTracker.h"
+#include "utils/debug/Profiler.h"
 
 #define STB_IMAGE_IMPLEMENTATION
 #include <stb_image.h>
@@ -13,12 +16,16 @@ namespace RB
 {
     LoadedImage::LoadedImage()
         : data(nullptr)
+        , mipChain(nullptr)
+        , mipLevels(1)
     {}
 
     LoadedImage::~LoadedImage()
     {
         stbi_image_free(data);
         data = nullptr;
+
+        SAFE_FREE(mipChain);
     }
 
     LoadedModel::LoadedModel()
@@ -29,8 +36,8 @@ namespace RB
 
     LoadedModel::~LoadedModel()
     {
-        SAFE_DELETE(vertices);
-        SAFE_DELETE(indices);
+        SAFE_FREE(vertices);
+        SAFE_FREE(indices);
         ufbx_free_scene((ufbx_scene*)internalScene);
     }
 
@@ -45,6 +52,9 @@ namespace RB
 
         bool LoadImage8Bit(const char* path, LoadedImage* out_image, uint32_t force_channels)
         {
+            RB_PROFILE_CPU_SCOPED("AssetManager::LoadImage8Bit");
+            RB_MEMORY_TAG(Assets);
+
             std::string final_path = (((std::string)g_AssetPath) + ((std::string)path));
 
             auto file_handle = FileLoader::OpenFile(final_path.c_str(), OpenFileMode::kFileMode_Read | OpenFileMode::kFileMode_Binary);
@@ -81,12 +91,75 @@ namespace RB
             }
 
             out_image->dataSize = GetElementSizeFromFormat(out_image->format) * out_image->width * out_image->height;
+            out_image->mipLevels = 1;
 
             return true;
         }
 
+        void GenerateMipChain8Bit(LoadedImage* image)
+        {
+            RB_MEMORY_TAG(Assets);
+
+            uint32_t width      = image->width;
+            uint32_t height     = image->height;
+            uint32_t channels   = GetElementSizeFromFormat(image->format);
+            uint32_t mip_levels = GetMipLevelCount(width, height);
+
+            uint64_t chain_size = GetMipChainSize(width, height, channels, 0, mip_levels);
+
+            uint8_t* chain = (uint8_t*)ALLOC_HEAP(chain_size);
+            memcpy(chain, image->data, GetMipSize(width, height, channels, 0));
+
+            uint8_t* src = chain;
+
+            for (uint32_t mip = 1; mip < mip_levels; ++mip)
+            {
+                uint32_t src_width  = Math::Max(width >> (mip - 1), 1u);
+                uint32_t src_height = Math::Max(height >> (mip - 1), 1u);
+                uint32_t dst_width  = Math::Max(width >> mip, 1u);
+                uint32_t dst_height = Math::Max(height >> mip, 1u);
+
+                uint8_t* dst = src + GetMipSize(width, height, channels, mip - 1);
+
+                for (uint32_t y = 0; y < dst_height; ++y)
+                {
+                    // Clamp for the sides that are already 1 pixel wide
+                    uint32_t y0 = Math::Min(y * 2, src_height - 1);
+                    uint32_t y1 = Math::Min(y * 2 + 1, src_height - 1);
+
+                    for (uint32_t x = 0; x < dst_width; ++x)
+                    {
+                        uint32_t x0 = Math::Min(x * 2, src_width - 1);
+                        uint32_t x1 = Math::Min(x * 2 + 1, src_width - 1);
+
+                        for (uint32_t c = 0; c < channels; ++c)
+                        {
+                            uint32_t sum = src[(y0 * src_width + x0) * channels + c] +
+                                           src[(y0 * src_width + x1) * channels + c] +
+                                           src[(y1 * src_width + x0) * channels + c] +
+                                           src[(y1 * src_width + x1) * channels + c];
+
+                            dst[(y * dst_width + x) * channels + c] = (uint8_t)((sum + 2) / 4);
+                        }
+                    }
+                }
+
+                src = dst;
+            }
+
+            stbi_image_free(image->data);
+
+            image->data      = nullptr;
+            image->mipChain  = chain;
+            image->dataSize  = chain_size;
+            image->mipLevels = mip_levels;
+        }
+
         bool LoadModel(const char* path, LoadedModel* out_model)
         {
+            RB_PROFILE_CPU_SCOPED("AssetManager::LoadModel");
+            RB_MEMORY_TAG(Assets);
+
             std::string final_path = (((std::string)g_AssetPath) + ((std::string)path));
 
             auto file_handle = FileLoader::OpenFile(final_path.c_str(), OpenFileMode::kFileMode_Read | OpenFileMode::kFileMode_Binary);
@@ -11,12 +11,14 @@ namespace RB
 {
     struct LoadedImage
     {
-        void*                           data;
+        void*                           data;       // Allocated by STB
+        void*                           mipChain;   // Allocated with ALLOC_HEAP by GenerateMipChain8Bit, replaces the data
         uint32_t				        dataSize;
         Graphics::RenderResourceFormat	format;
         int32_t					        width;
         int32_t					        height;
         int32_t					        channels;
+        uint32_t                        mipLevels;
 
         LoadedImage();
         ~LoadedImage();
@@ -47,6 +49,9 @@ namespace RB
 
         bool LoadImage8Bit(const char* path, LoadedImage* out_image, uint32_t force_channels = 0);
 
+        // Replaces the data of a loaded 8 bit image with its full mip chain (box filtered) in mipChain, tightly packed from fine to coarse
+        void GenerateMipChain8Bit(LoadedImage* image);
+
         bool LoadModel(const char* path, LoadedModel* out_model);
     }
 }
\ No newline at end of file
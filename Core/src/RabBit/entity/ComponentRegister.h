@@ -19,7 +19,7 @@ namespace RB::Entity
         ComponentID GetComponentID();
 
     private:
-        UnorderedMap<char*, ComponentID> m_IDs;
+        FlatMap<char*, ComponentID> m_IDs;
         ComponentID m_NextID;
     };
 
@@ -1,6 +1,7 @@
 #pragma once
 #include "RabBitCommon.h"
 #include "ComponentRegister.h"
+#include "utils/debug/MemoryTracker.h"
 
 namespace RB::Entity
 {
@@ -23,7 +24,7 @@ namespace RB::Entity
 		void AppendComponentsWithTypeOf(ComponentID comp_id, List<const ObjectComponent*>& list) const;
 
 	private:
-		UnorderedMap<ComponentID, List<ObjectComponent*>> m_Components;
+		FlatMap<ComponentID, List<ObjectComponent*>> m_Components;
 
 		ComponentRegister* m_Register;
 	};
@@ -31,6 +32,7 @@ namespace RB::Entity
 	template<class T, typename... Args>
 	inline T* GameObject::AddComponent(Args... args)
 	{
+		RB_MEMORY_TAG(Entity);
 		T* comp = new T(args...);
 
 		ComponentID tag = m_Register->RegisterComponent<T>();
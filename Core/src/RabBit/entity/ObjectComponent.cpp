@@ -3,6 +3,13 @@
 
 namespace RB::Entity
 {
+    SlabAllocator& GetComponentSlab()
+    {
+        // Never destroyed, components can still be deleted while the statics are destroyed
+        static NeverDestroyed<SlabAllocator> slab(256, 16 * 1024, Utils::Debug::MemoryTag::Entity);
+        return slab.Get();
+    }
+
     void ObjectComponent::OnAttachedToGameObject(GameObject* obj)
     {
         m_GameObject = obj;
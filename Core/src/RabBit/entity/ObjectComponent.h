@@ -7,11 +7,17 @@ namespace RB::Entity
 
     class GameObject;
 
+    // The slab that all the components are allocated from
+    SlabAllocator& GetComponentSlab();
+
     class ObjectComponent
     {
     public:
         virtual ~ObjectComponent() = default;
 
+        // Components of all game objects end up next to each other, instead of all over the heap
+        RB_SLAB_NEW_DELETE(GetComponentSlab())
+
         virtual void Update() {}
 
         GameObject* GetGameObject() const { return m_GameObject; }
@@ -1,6 +1,8 @@
 #include "RabBitCommon.h"
 #include "Mesh.h"
 #include "app/AssetManager.h"
+#include "app/Application.h"
+#include "graphics/Renderer.h"
 
 namespace RB::Entity
 {
@@ -18,14 +20,30 @@ namespace RB::Entity
 
             uint32_t vertex_size = sizeof(LoadedModel::Vertex);
 
-            m_VertexBuffer = Graphics::VertexBuffer::Create(vertex_name.c_str(), RB::Graphics::TopologyType::TriangleList, model.vertices, vertex_size, vertex_size * model.verticesCount);
+            Graphics::GeometryPool* pool = Application::GetInstance()->GetRenderer()->GetGeometryPool();
+
+            if (model.indicesCount > 0 && pool->Allocate(file_name, model.vertices, vertex_size, vertex_size * model.verticesCount,
+                model.indices, sizeof(uint32_t) * model.indicesCount, Graphics::StreamDataMode::TakeOwnership, m_Geometry))
+            {
+                m_VertexBuffer = m_Geometry.vertexBuffer;
+                m_IndexBuffer  = m_Geometry.indexBuffer;
+
+                model.vertices = nullptr;
+                model.indices  = nullptr;
+                return;
+            }
+
+            // Hand the loaded data over to the streamer instead of letting it make a copy
+            m_VertexBuffer = Graphics::VertexBuffer::Create(vertex_name.c_str(), RB::Graphics::TopologyType::TriangleList, model.vertices, vertex_size, vertex_size * model.verticesCount, Graphics::StreamDataMode::TakeOwnership);
+            model.vertices = nullptr;
 
             if (model.indicesCount > 0)
             {
                 std::string index_name = file_name;
                 index_name += " indices";
 
-                m_IndexBuffer = Graphics::IndexBuffer::Create(index_name.c_str(), model.indices, sizeof(uint32_t) * model.indicesCount);
+                m_IndexBuffer = Graphics::IndexBuffer::Create(index_name.c_str(), model.indices, sizeof(uint32_t) * model.indicesCount, Graphics::StreamDataMode::TakeOwnership);
+                model.indices = nullptr;
             }
         }
     }
@@ -34,6 +52,16 @@ namespace RB::Entity
         : m_VertexBuffer(nullptr)
         , m_IndexBuffer(nullptr)
     {
+        Graphics::GeometryPool* pool = Application::GetInstance()->GetRenderer()->GetGeometryPool();
+
+        if (index_data_count > 0 && pool->Allocate(name, vertex_data, elements_per_vertex * sizeof(float), vertex_data_count * sizeof(float),
+            index_data, index_data_count * sizeof(uint32_t), Graphics::StreamDataMode::Copy, m_Geometry))
+        {
+            m_VertexBuffer = m_Geometry.vertexBuffer;
+            m_IndexBuffer  = m_Geometry.indexBuffer;
+            return;
+        }
+
         m_VertexBuffer = Graphics::VertexBuffer::Create(name, RB::Graphics::TopologyType::TriangleList, vertex_data, elements_per_vertex * sizeof(float), vertex_data_count * sizeof(float));
 
         if (index_data_count > 0)
@@ -45,15 +73,46 @@ namespace RB::Entity
         }
     }
 
+    Mesh::~Mesh()
+    {
+        if (IsPooled())
+        {
+            // The pool deletes the buffers once the GPU is done with them
+            Application::GetInstance()->GetRenderer()->GetGeometryPool()->Free(m_Geometry);
+            return;
+        }
+
+        delete m_VertexBuffer;
+        delete m_IndexBuffer;
+    }
+
     Material::Material(const char* file_name, Graphics::TextureColorSpace color_space)
-        : m_Texture(nullptr)
+        : m_Texture(Graphics::kInvalidStreamedTexture)
     {
         LoadedImage img;
         bool success = AssetManager::LoadImage8Bit(file_name, &img);
 
         if (success)
         {
-            m_Texture = Graphics::Texture2D::Create(file_name, img.data, img.dataSize, img.format, img.width, img.height, false, false, color_space);
+            AssetManager::GenerateMipChain8Bit(&img);
+
+            // The residency manager keeps the mip chain on the CPU and streams the mips in when the texture is close enough to need them
+            Graphics::TextureResidencyManager* residency = Application::GetInstance()->GetRenderer()->GetTextureResidency();
+            m_Texture = residency->Register(file_name, img.mipChain, img.format, img.width, img.height, img.mipLevels, color_space);
+            img.mipChain = nullptr;
+        }
+    }
+
+    Material::~Material()
+    {
+        if (m_Texture != Graphics::kInvalidStreamedTexture)
+        {
+            Application::GetInstance()->GetRenderer()->GetTextureResidency()->Unregister(m_Texture);
         }
     }
+
+    Graphics::Texture2D* Material::GetTexture() const
+    {
+        return Application::GetInstance()->GetRenderer()->GetTextureResidency()->GetTexture(m_Texture);
+    }
 }
\ No newline at end of file
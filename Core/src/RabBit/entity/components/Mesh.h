@@ -2,6 +2,8 @@
 #include "RabBitCommon.h"
 #include "entity/ObjectComponent.h"
 #include "graphics/RenderResource.h"
+#include "graphics/TextureResidency.h"
+#include "graphics/GeometryPool.h"
 
 namespace RB::Entity
 {
@@ -12,11 +14,7 @@ namespace RB::Entity
         Mesh(const char* file_name);
         Mesh(const char* name, float* vertex_data, uint32_t elements_per_vertex, uint64_t vertex_data_count, uint32_t* index_data, uint64_t index_data_count);
 
-        ~Mesh()
-        {
-            delete m_VertexBuffer;
-            delete m_IndexBuffer;
-        }
+        ~Mesh();
 
         Graphics::VertexBuffer* GetVertexBuffer() const
         {
@@ -28,9 +26,21 @@ namespace RB::Entity
             return m_IndexBuffer;
         }
 
+        // Meshes with indices are placed in the GeometryPool when they fit, their buffers are then a part of the pool buffers
+        bool IsPooled() const
+        {
+            return m_Geometry.range.page != Graphics::kInvalidGeometryPage;
+        }
+
+        const Graphics::GeometryRange& GetGeometryRange() const
+        {
+            return m_Geometry.range;
+        }
+
     private:
         Graphics::VertexBuffer* m_VertexBuffer;
         Graphics::IndexBuffer* m_IndexBuffer;
+        Graphics::PooledGeometry m_Geometry;
     };
 
     class Material
@@ -38,19 +48,18 @@ namespace RB::Entity
     public:
 
         Material(const char* file_name, Graphics::TextureColorSpace color_space = Graphics::TextureColorSpace::sRGB);
+        ~Material();
 
-        ~Material()
-        {
-            delete m_Texture;
-        }
+        // The texture with the mips that are currently resident, nullptr while nothing is streamed in yet
+        Graphics::Texture2D* GetTexture() const;
 
-        Graphics::Texture2D* GetTexture() const
+        Graphics::StreamedTextureID GetStreamedTexture() const
         {
             return m_Texture;
         }
 
     private:
-        Graphics::Texture2D* m_Texture;
+        Graphics::StreamedTextureID m_Texture;
     };
 
     class MeshRenderer : public ObjectComponent
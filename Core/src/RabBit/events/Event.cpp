@@ -1,6 +1,8 @@
 #include "RabBitCommon.h"
 #include "Event.h"
 
+#include "utils/debug/Stats.h"
+
 namespace RB::Events
 {
     // ----------------------------------------------------------------------------
@@ -51,38 +53,16 @@ namespace RB::Events
         m_Listeners.erase(std::remove(m_Listeners.begin(), m_Listeners.end(), listener), m_Listeners.end());
     }
 
-    void EventManager::InsertEvent(const Event& event)
-    {
-        //m_LastEvents.insert(m_LastEvents.begin(), event);
-
-        for (int i = 0; i < m_Listeners.size(); ++i)
-        {
-            if (m_Listeners[i]->ListensToCategory((EventCategory)event.GetCategoryFlags()))
-            {
-                m_Listeners[i]->AddEvent(event);
-            }
-        }
-
-        //while (m_LastEvents.size() > EVENT_HISTORY_COUNT)
-        //{
-        //	delete m_LastEvents[m_LastEvents.size() - 1];
-        //	m_LastEvents.pop_back();
-        //}
-    }
-
     // ----------------------------------------------------------------------------
     //								EventListener
     // ----------------------------------------------------------------------------
 
-    EventListener::EventListener(int category, bool double_queue)
+    EventListener::EventListener(int category)
         : m_ListenerCategory(category)
-        , m_DoubleQueue(double_queue)
+        , m_SubscribedTypes(0)
     {
-        InitializeCriticalSection(&m_CS);
-
-        m_QueuedEvents0.reserve(10);
-        if (m_DoubleQueue)
-            m_QueuedEvents1.reserve(10);
+        m_PendingEvents.reserve(kEventQueueCapacity);
+        m_OverwriteSlots.fill(UINT32_MAX);
 
         g_EventManager->AddListener(this);
     }
@@ -90,81 +70,92 @@ namespace RB::Events
     EventListener::~EventListener()
     {
         g_EventManager->RemoveListener(this);
-        DeleteCriticalSection(&m_CS);
+
+        m_Queue.PopAll(m_PendingEvents);
+
+        for (EventSlot* slot : m_PendingEvents)
+        {
+            if (slot)
+            {
+                g_EventManager->GetPool().Release(slot);
+            }
+        }
+
+        m_PendingEvents.clear();
     }
 
     void EventListener::ProcessEvents()
     {
-        auto process_events = [this](List<Event*>& queue)
+        EventPool& pool = g_EventManager->GetPool();
+
+        // Only the events that are in the queue right now are processed, new events wait until the next time
+        uint32_t first_new = m_PendingEvents.size();
+        m_Queue.PopAll(m_PendingEvents);
+
+        // A newer event can overwrite an older one of the same type that is still waiting
+        for (uint32_t i = first_new; i < m_PendingEvents.size(); ++i)
         {
-            for (auto itr = queue.begin(); itr < queue.end();)
+            EventSlot* slot = m_PendingEvents[i];
+
+            if (!slot->overwritable)
             {
-                Event* e = *itr;
+                continue;
+            }
 
-                bool handled = OnEvent(*e);
+            uint32_t& overwrite_slot = m_OverwriteSlots[slot->type];
 
-                if (handled)
-                {
-                    itr = queue.erase(itr);
-                    delete e;
-                }
-                else
-                {
-                    // Do it next time
-                    itr++;
-                }
+            if (overwrite_slot != UINT32_MAX && m_PendingEvents[overwrite_slot]->event->IsOverwritable(slot->event))
+            {
+                pool.Release(m_PendingEvents[overwrite_slot]);
+                m_PendingEvents[overwrite_slot] = nullptr;
             }
-        };
 
-        if (m_DoubleQueue)
-        {
-            EnterCriticalSection(&m_CS);
-            m_QueueCycle = !m_QueueCycle;
-            List<Event*>& queue = m_QueueCycle ? m_QueuedEvents0 : m_QueuedEvents1;
-            LeaveCriticalSection(&m_CS);
-
-            process_events(queue);
-        }
-        else
-        {
-            EnterCriticalSection(&m_CS);
-            process_events(m_QueuedEvents0);
-            LeaveCriticalSection(&m_CS);
+            overwrite_slot = i;
         }
-    }
 
-    void EventListener::AddEvent(const Event& e)
-    {
-        auto add_event = [&e](List<Event*>& queue)
+        m_OverwriteSlots.fill(UINT32_MAX);
+
+        // Keep the events that should be processed a next time in order, without erasing from the middle
+        uint32_t kept_count = 0;
+        uint32_t handled_count = 0;
+
+        for (uint32_t i = 0; i < m_PendingEvents.size(); ++i)
         {
-            if (e.AllowOverwrite())
+            EventSlot* slot = m_PendingEvents[i];
+
+            if (!slot)
             {
-                auto itr = std::find_if(queue.begin(), queue.end(), [&e](Event* other) -> bool {
-                    return e.GetEventType() == other->GetEventType() && other->IsOverwritable(&e);
-                });
+                continue;
+            }
 
-                if (itr != queue.end())
+            // Handlers are looked up by the type, the events of a category without a handler go to OnEvent
+            const EventHandler& handler = m_Handlers[slot->type];
+            bool handled = handler ? handler(*slot->event) : OnEvent(*slot->event);
+
+            if (handled)
+            {
+                pool.Release(slot);
+                handled_count++;
+            }
+            else
+            {
+                // Do it next time
+                if (slot->overwritable)
                 {
-                    queue.erase(itr);
+                    m_OverwriteSlots[slot->type] = kept_count;
                 }
+
+                m_PendingEvents[kept_count++] = slot;
             }
+        }
 
-            queue.push_back(e.Clone());
-        };
+        m_PendingEvents.resize(kept_count);
 
-        if (m_DoubleQueue)
-        {
-            EnterCriticalSection(&m_CS);
-            List<Event*>& queue = m_QueueCycle ? m_QueuedEvents1 : m_QueuedEvents0;
-            LeaveCriticalSection(&m_CS);
+        RB_STAT_ADD(EventsProcessed, handled_count);
+    }
 
-            add_event(queue);
-        }
-        else
-        {
-            EnterCriticalSection(&m_CS);
-            add_event(m_QueuedEvents0);
-            LeaveCriticalSection(&m_CS);
-        }
+    void EventListener::AddEvent(EventSlot* slot)
+    {
+        m_Queue.Push(slot);
     }
 }
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "RabBitCommon.h"
+#include "EventQueue.h"
 
 namespace RB::Events
 {
@@ -13,6 +14,8 @@ namespace RB::Events
         GraphicsSettingsChanged
     };
 
+    constexpr uint32_t kEventTypeCount = (uint32_t)EventType::GraphicsSettingsChanged + 1;
+
     enum EventCategory
     {
         kEventCat_None          = 0,
@@ -26,17 +29,19 @@ namespace RB::Events
         kEventCat_All = (kEventCat_Window | kEventCat_Input | kEventCat_Keyboard | kEventCat_Mouse | kEventCat_MouseButton | kEventCat_Application)
     };
 
-    #define DEFINE_CLASS_TYPE_CUSTOM_OVERWRITE(classType, type) static EventType GetStaticType() { return EventType::type; }\
+    // Overwritable events replace the older event of the same type (for which IsOverwritable returns true) that is still queued at a listener
+    #define DEFINE_CLASS_TYPE_CUSTOM_OVERWRITE(classType, type) static constexpr EventType GetStaticType() { return EventType::type; }\
+                                                                static constexpr bool kOverwritable = true;\
 								                                virtual EventType GetEventType() const override { return GetStaticType(); }\
 								                                virtual const char* GetName() const override { return #type; }\
-								                                virtual Event* Clone() const override { return new classType(*this); }
+                                                                virtual bool AllowOverwrite() const override { return kOverwritable; }
 
-    #define DEFINE_CLASS_TYPE(classType, type, overwritable)    static EventType GetStaticType() { return EventType::type; }\
+    #define DEFINE_CLASS_TYPE(classType, type, overwritable)    static constexpr EventType GetStaticType() { return EventType::type; }\
+                                                                static constexpr bool kOverwritable = overwritable;\
 								                                virtual EventType GetEventType() const override { return GetStaticType(); }\
 								                                virtual const char* GetName() const override { return #type; }\
-								                                virtual Event* Clone() const override { return new classType(*this); }\
-                                                                virtual bool AllowOverwrite() const override { return overwritable; }\
-                                                                virtual bool IsOverwritable(const Event* e) const override { return overwritable; }
+                                                                virtual bool AllowOverwrite() const override { return kOverwritable; }\
+                                                                virtual bool IsOverwritable(const Event* e) const override { return kOverwritable; }
 
     #define RB_BIND_EVENT_FN(fn) [this](auto&&... args) -> decltype(auto) { return this->fn(std::forward<decltype(args)>(args)...); }
 
@@ -49,7 +54,6 @@ namespace RB::Events
         virtual EventType	GetEventType()		            const = 0;
         virtual const char* GetName()			            const = 0;
         virtual int			GetCategoryFlags()	            const = 0;
-        virtual Event*      Clone()				            const = 0;
         virtual bool        AllowOverwrite()                const = 0;
         virtual bool		IsOverwritable(const Event* e)	const = 0;
 
@@ -86,12 +90,18 @@ namespace RB::Events
         void AddListener(EventListener* listener);
         void RemoveListener(EventListener* listener);
 
-        void InsertEvent(const Event& event);
+        // The event is copied once and shared by all the listeners that subscribed to its type or category.
+        // The type, category and overwrite behaviour are resolved at compile time, so the concrete event type should be passed.
+        template<class T>
+        void InsertEvent(const T& event);
 
         //Event& GetPreviousEventPerCategory(const EventCategory& cat, uint8_t index);
 
+        EventPool& GetPool() { return m_Pool; }
+
     private:
         List<EventListener*> m_Listeners;
+        EventPool            m_Pool;
 
         //static const int EVENT_HISTORY_COUNT = 5;
 
@@ -103,32 +113,99 @@ namespace RB::Events
     class EventListener
     {
     public:
-        // Enabling double queue's is better when processing an event on the
-        // listener that can take a very long time (maybe even block). 
-        // This way we won't block the main thread.
-        EventListener(int category, bool double_queue = false);
+        // Events can be inserted from any thread without blocking, while the listener is processing its events as well.
+        // The events of the given categories that have no handler subscribed go to OnEvent.
+        EventListener(int category = kEventCat_None);
         virtual ~EventListener();
 
+        // The handler returns false when the event should be processed a next time.
+        // Should be done before events of this type are inserted, the handlers are not protected against concurrent changes.
+        template<class T>
+        void Subscribe(std::function<bool(T&)> handler)
+        {
+            static_assert(std::is_base_of<Event, T>::value, "Can only subscribe to events");
+
+            m_Handlers[(uint32_t)T::GetStaticType()] = [handler](Event& event) -> bool
+            {
+                return handler(static_cast<T&>(event));
+            };
+
+            m_SubscribedTypes |= 1ull << (uint32_t)T::GetStaticType();
+        }
+
+        bool ListensTo(EventType type, int category_flags) const
+        {
+            return (m_SubscribedTypes & (1ull << (uint32_t)type)) != 0 || (m_ListenerCategory & category_flags) > 0;
+        }
+
         bool ListensToCategory(const EventCategory cat) const
         {
             return (m_ListenerCategory & cat) > 0;
         }
 
+        // Should only be called from 1 thread at a time
         void ProcessEvents();
 
     private:
-        void AddEvent(const Event& e);
+        using EventHandler = std::function<bool(Event&)>;
+
+        void AddEvent(EventSlot* slot);
+
+        // Gets the events without a subscribed handler, returns false when the event should be processed a next time
+        virtual bool OnEvent(Event& event) { return true; }
 
-        // Returns false when the event should be processed a next time
-        virtual bool OnEvent(Event& event) = 0;
+        int		                                m_ListenerCategory;
+        uint64_t                                m_SubscribedTypes;
+        Array<EventHandler, kEventTypeCount>    m_Handlers;
 
-        int		            m_ListenerCategory;
-        bool                m_DoubleQueue;
-        bool                m_QueueCycle;
-        List<Event*>		m_QueuedEvents0;
-        List<Event*>		m_QueuedEvents1;
-        CRITICAL_SECTION	m_CS;
+        EventQueue                              m_Queue;
+        List<EventSlot*>                        m_PendingEvents;    // Taken from the queue, but not yet handled. Only used by the processing thread
+        // Index in m_PendingEvents of the newest overwritable event per type, so a new event only has to be compared with 1 other event
+        Array<uint32_t, kEventTypeCount>        m_OverwriteSlots;
 
         friend class EventManager;
     };
+
+    static_assert(kEventTypeCount <= 64, "EventListener::m_SubscribedTypes has a bit per event type");
+
+    template<class T>
+    void EventManager::InsertEvent(const T& event)
+    {
+        static_assert(std::is_base_of<Event, T>::value, "Can only insert events");
+
+        constexpr EventType type = T::GetStaticType();
+
+        // Not a virtual call, the category of the concrete type is used
+        int category_flags = event.T::GetCategoryFlags();
+
+        uint32_t listener_count = 0;
+
+        for (int i = 0; i < m_Listeners.size(); ++i)
+        {
+            if (m_Listeners[i]->ListensTo(type, category_flags))
+            {
+                listener_count++;
+            }
+        }
+
+        if (listener_count == 0)
+        {
+            return;
+        }
+
+        EventSlot* slot = m_Pool.Acquire(event, listener_count);
+
+        if (!slot)
+        {
+            return;
+        }
+
+        for (int i = 0; i < m_Listeners.size(); ++i)
+        {
+            if (m_Listeners[i]->ListensTo(type, category_flags))
+            {
+                m_Listeners[i]->AddEvent(slot);
+            }
+        }
+    }
 }
\ No newline at end of file
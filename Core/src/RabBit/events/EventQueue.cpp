@@ -0,0 +1,260 @@
+#include "RabBitCommon.h"
+#include "EventQueue.h"
+#include "Event.h"
+
+#include "utils/debug/MemoryTracker.h"
+
+namespace RB::Events
+{
+    // ----------------------------------------------------------------------------
+    //								EventPool
+    // ----------------------------------------------------------------------------
+
+    EventPool::EventPool()
+        : m_FreeHead(kInvalidEventSlot)
+        , m_ChunkCount(0)
+        , m_UsedCount(0)
+    {
+        for (std::atomic<EventSlot*>& chunk : m_Chunks)
+        {
+            chunk.store(nullptr, std::memory_order_relaxed);
+        }
+
+        InitializeCriticalSection(&m_GrowCS);
+    }
+
+    EventPool::~EventPool()
+    {
+        RB_ASSERT(LOGTAG_EVENT, m_UsedCount.load() == 0, "Not all events have been released");
+
+        for (std::atomic<EventSlot*>& chunk : m_Chunks)
+        {
+            delete[] chunk.load();
+        }
+
+        DeleteCriticalSection(&m_GrowCS);
+    }
+
+    void EventPool::Release(EventSlot* slot)
+    {
+        if (slot->references.fetch_sub(1, std::memory_order_acq_rel) != 1)
+        {
+            return;
+        }
+
+        // The last listener is done with it
+        slot->event->~Event();
+        slot->event = nullptr;
+
+        m_UsedCount.fetch_sub(1, std::memory_order_relaxed);
+
+        PushFreeSlots(slot->index, slot->index);
+    }
+
+    EventSlot* EventPool::GetSlot(uint32_t index) const
+    {
+        return &m_Chunks[index / kEventPoolSlotsPerChunk].load(std::memory_order_acquire)[index % kEventPoolSlotsPerChunk];
+    }
+
+    EventSlot* EventPool::PopFreeSlot()
+    {
+        while (true)
+        {
+            uint64_t head = m_FreeHead.load(std::memory_order_acquire);
+
+            while ((uint32_t)head != kInvalidEventSlot)
+            {
+                EventSlot* slot = GetSlot((uint32_t)head);
+
+                // Can be outdated when another thread takes the slot first, the tag makes the exchange fail in that case
+                uint64_t next = ((head >> 32) + 1) << 32 | slot->nextFree.load(std::memory_order_relaxed);
+
+                if (m_FreeHead.compare_exchange_weak(head, next, std::memory_order_acq_rel, std::memory_order_acquire))
+                {
+                    return slot;
+                }
+            }
+
+            // No free slots left, add a chunk
+            EnterCriticalSection(&m_GrowCS);
+
+            // Another thread could have added a chunk or given slots back in the meantime
+            if ((uint32_t)m_FreeHead.load(std::memory_order_acquire) != kInvalidEventSlot)
+            {
+                LeaveCriticalSection(&m_GrowCS);
+                continue;
+            }
+
+            uint32_t chunk_index = m_ChunkCount.load(std::memory_order_relaxed);
+
+            if (chunk_index == kEventPoolMaxChunks)
+            {
+                LeaveCriticalSection(&m_GrowCS);
+                RB_ASSERT_ALWAYS(LOGTAG_EVENT, "The event pool is full, are the event listeners still processing their events?");
+                return nullptr;
+            }
+
+            RB_MEMORY_TAG(Events);
+            EventSlot* chunk = new EventSlot[kEventPoolSlotsPerChunk];
+            uint32_t first = chunk_index * kEventPoolSlotsPerChunk;
+
+            for (uint32_t i = 0; i < kEventPoolSlotsPerChunk; ++i)
+            {
+                chunk[i].event = nullptr;
+                chunk[i].index = first + i;
+                chunk[i].nextFree.store(first + i + 1, std::memory_order_relaxed);
+            }
+
+            m_Chunks[chunk_index].store(chunk, std::memory_order_release);
+            m_ChunkCount.store(chunk_index + 1, std::memory_order_release);
+
+            // Keep the first slot, give the rest to the free list
+            PushFreeSlots(first + 1, first + kEventPoolSlotsPerChunk - 1);
+
+            LeaveCriticalSection(&m_GrowCS);
+
+            return &chunk[0];
+        }
+    }
+
+    void EventPool::PushFreeSlots(uint32_t first, uint32_t last)
+    {
+        EventSlot* last_slot = GetSlot(last);
+        uint64_t head = m_FreeHead.load(std::memory_order_relaxed);
+
+        do
+        {
+            last_slot->nextFree.store((uint32_t)head, std::memory_order_relaxed);
+        }
+        while (!m_FreeHead.compare_exchange_weak(head, ((head >> 32) + 1) << 32 | first, std::memory_order_release, std::memory_order_relaxed));
+    }
+
+    // ----------------------------------------------------------------------------
+    //								EventQueue
+    // ----------------------------------------------------------------------------
+
+    EventQueue::EventQueue(uint32_t capacity)
+        : m_Mask(capacity - 1)
+        , m_Head(0)
+        , m_Tail(0)
+        , m_Overflowing(false)
+    {
+        RB_ASSERT_FATAL(LOGTAG_EVENT, capacity > 0 && (capacity & (capacity - 1)) == 0, "The capacity of an event queue should be a power of 2");
+
+        RB_MEMORY_TAG(Events);
+        m_Cells = new Cell[capacity];
+
+        for (uint32_t i = 0; i < capacity; ++i)
+        {
+            m_Cells[i].sequence.store(i, std::memory_order_relaxed);
+            m_Cells[i].slot = nullptr;
+        }
+
+        InitializeCriticalSection(&m_OverflowCS);
+    }
+
+    EventQueue::~EventQueue()
+    {
+        delete[] m_Cells;
+        DeleteCriticalSection(&m_OverflowCS);
+    }
+
+    void EventQueue::Push(EventSlot* slot)
+    {
+        // Once the queue overflowed, keep using the overflow list until the consumer took it, otherwise the order would change
+        if (!m_Overflowing.load(std::memory_order_acquire) && TryPush(slot))
+        {
+            return;
+        }
+
+        EnterCriticalSection(&m_OverflowCS);
+        m_Overflow.push_back(slot);
+        m_Overflowing.store(true, std::memory_order_release);
+        LeaveCriticalSection(&m_OverflowCS);
+    }
+
+    bool EventQueue::TryPush(EventSlot* slot)
+    {
+        uint64_t position;
+
+        if (!TryClaim(position))
+        {
+            return false;
+        }
+
+        Publish(position, slot);
+        return true;
+    }
+
+    bool EventQueue::TryClaim(uint64_t& out_position)
+    {
+        uint64_t position = m_Head.load(std::memory_order_relaxed);
+
+        while (true)
+        {
+            Cell& cell = m_Cells[position & m_Mask];
+            int64_t diff = (int64_t)cell.sequence.load(std::memory_order_acquire) - (int64_t)position;
+
+            if (diff == 0)
+            {
+                if (m_Head.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                {
+                    out_position = position;
+                    return true;
+                }
+            }
+            else if (diff < 0)
+            {
+                // The consumer did not take the event in this cell yet
+                return false;
+            }
+            else
+            {
+                position = m_Head.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    void EventQueue::Publish(uint64_t position, EventSlot* slot)
+    {
+        Cell& cell = m_Cells[position & m_Mask];
+        cell.slot = slot;
+        cell.sequence.store(position + 1, std::memory_order_release);
+    }
+
+    void EventQueue::PopAll(List<EventSlot*>& out_slots)
+    {
+        while (true)
+        {
+            Cell& cell = m_Cells[m_Tail & m_Mask];
+
+            // Stops at a cell that is claimed by a producer but not written yet, it is taken the next time
+            if (cell.sequence.load(std::memory_order_acquire) != m_Tail + 1)
+            {
+                break;
+            }
+
+            out_slots.push_back(cell.slot);
+            cell.sequence.store(m_Tail + m_Mask + 1, std::memory_order_release);
+
+            m_Tail++;
+        }
+
+        if (m_Overflowing.load(std::memory_order_acquire))
+        {
+            EnterCriticalSection(&m_OverflowCS);
+
+            // The overflow can only come after the ring once the ring is drained all the way up to the head. Otherwise a producer can have
+            // an earlier event in a cell behind the one that is not written yet, it stays in the overflow until the next call in that case.
+            // The head is read while holding the lock, so it includes the cells that were claimed before anything went to the overflow.
+            if (m_Tail == m_Head.load(std::memory_order_relaxed))
+            {
+                out_slots.insert(out_slots.end(), m_Overflow.begin(), m_Overflow.end());
+                m_Overflow.clear();
+                m_Overflowing.store(false, std::memory_order_release);
+            }
+
+            LeaveCriticalSection(&m_OverflowCS);
+        }
+    }
+}
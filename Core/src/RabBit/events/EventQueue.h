@@ -0,0 +1,124 @@
+#pragma once
+
+#include "RabBitCommon.h"
+
+namespace RB::Events
+{
+    class Event;
+
+    // Every event type should fit in a pool slot, this is checked when the event type is defined
+    constexpr uint32_t kMaxEventSize            = 64;
+
+    constexpr uint32_t kEventPoolSlotsPerChunk  = 256;
+    constexpr uint32_t kEventPoolMaxChunks      = 64;
+    constexpr uint32_t kInvalidEventSlot        = UINT32_MAX;
+
+    // Amount of events a listener can have queued before the (locking) overflow list is used, should be a power of 2
+    constexpr uint32_t kEventQueueCapacity      = 1024;
+
+    // Copy of an event that is shared by all the listeners that receive it, the listeners should not change it
+    struct EventSlot
+    {
+        alignas(16) uint8_t     storage[kMaxEventSize];
+        Event*                  event;
+        uint32_t                type;           // The EventType of the event
+        bool                    overwritable;
+        std::atomic<uint32_t>   references;
+        std::atomic<uint32_t>   nextFree;
+        uint32_t                index;
+    };
+
+    // Fixed size slots for the events, allocated in chunks so that inserting an event does not allocate any memory.
+    // Acquire and Release are lock free and can be called from any thread, only adding a chunk takes a lock.
+    class EventPool
+    {
+    public:
+        EventPool();
+        ~EventPool();
+
+        // Copies the event into a free slot, the slot is freed once it has been released the given amount of times.
+        // Returns nullptr when the pool is full.
+        template<class T>
+        EventSlot* Acquire(const T& event, uint32_t references)
+        {
+            static_assert(sizeof(T) <= kMaxEventSize && alignof(T) <= 16, "Event does not fit in a pool slot");
+
+            EventSlot* slot = PopFreeSlot();
+
+            if (!slot)
+            {
+                return nullptr;
+            }
+
+            slot->event         = new (slot->storage) T(event);
+            slot->type          = (uint32_t)T::GetStaticType();
+            slot->overwritable  = T::kOverwritable;
+            slot->references.store(references, std::memory_order_release);
+
+            m_UsedCount.fetch_add(1, std::memory_order_relaxed);
+
+            return slot;
+        }
+
+        void       Release(EventSlot* slot);
+
+        uint32_t   GetSlotCount() const { return m_ChunkCount.load(std::memory_order_acquire) * kEventPoolSlotsPerChunk; }
+        uint32_t   GetUsedCount() const { return m_UsedCount.load(std::memory_order_relaxed); }
+
+    private:
+        EventSlot* GetSlot(uint32_t index) const;
+        EventSlot* PopFreeSlot();
+        void       PushFreeSlots(uint32_t first, uint32_t last);
+
+        // Index of the first free slot in the lower 32 bits and a tag in the upper 32 bits,
+        // the tag changes on every change so a slot that is taken and given back in between is noticed
+        std::atomic<uint64_t>   m_FreeHead;
+
+        std::atomic<EventSlot*> m_Chunks[kEventPoolMaxChunks];
+        std::atomic<uint32_t>   m_ChunkCount;
+        std::atomic<uint32_t>   m_UsedCount;
+        CRITICAL_SECTION        m_GrowCS;
+    };
+
+    // Bounded lock free queue of events, with multiple producers and a single consumer.
+    // When the queue is full the events go to an overflow list instead, so they are never dropped.
+    // The order of the events of a single producer is always kept.
+    class EventQueue
+    {
+    public:
+        EventQueue(uint32_t capacity = kEventQueueCapacity);
+        ~EventQueue();
+
+        // Can be called from any thread
+        void Push(EventSlot* slot);
+
+        // Should only be called from the consuming thread, appends all the queued events
+        void PopAll(List<EventSlot*>& out_slots);
+
+    private:
+        struct Cell
+        {
+            std::atomic<uint64_t>   sequence;
+            EventSlot*              slot;
+        };
+
+        bool TryPush(EventSlot* slot);
+
+        // The two halves of TryPush, a claimed cell is skipped by PopAll until it is published
+        bool TryClaim(uint64_t& out_position);
+        void Publish(uint64_t position, EventSlot* slot);
+
+        const uint64_t          m_Mask;
+        Cell*                   m_Cells;
+
+        std::atomic<uint64_t>   m_Head;     // Next position to push to
+        uint64_t                m_Tail;     // Next position to pop from, only used by the consumer
+
+        std::atomic<bool>       m_Overflowing;
+        List<EventSlot*>        m_Overflow;
+        CRITICAL_SECTION        m_OverflowCS;
+
+        // Lets the tests stall a producer in between claiming and publishing a cell
+        friend struct EventQueueTestAccess;
+    };
+}
@@ -21,7 +21,7 @@ namespace RB::Events
         float GetMouseX() const { return m_MouseX; }
         float GetMouseY() const { return m_MouseY; }
 
-        DEFINE_CLASS_TYPE(MouseMovedEvent, MouseMoved, false)
+        DEFINE_CLASS_TYPE(MouseMovedEvent, MouseMoved, true)
         int GetCategoryFlags() const override { return kEventCat_Mouse; }
 
     private:
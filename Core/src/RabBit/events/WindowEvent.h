@@ -45,7 +45,6 @@ namespace RB::Events
 
         DEFINE_CLASS_TYPE_CUSTOM_OVERWRITE(WindowResizeEvent, WindowResize)
 
-        virtual bool AllowOverwrite() const override { return true; }
         virtual bool IsOverwritable(const Event* e) const override { return ((WindowEvent*)e)->GetWindowHandle() == GetWindowHandle(); }
 
     private:
@@ -93,7 +92,6 @@ namespace RB::Events
 
         DEFINE_CLASS_TYPE_CUSTOM_OVERWRITE(WindowFullscreenToggleEvent, WindowFullscreenToggle)
 
-        virtual bool AllowOverwrite() const override { return true; }
         virtual bool IsOverwritable(const Event* e) const override { return ((WindowEvent*)e)->GetWindowHandle() == GetWindowHandle(); }
     };
 }
\ No newline at end of file
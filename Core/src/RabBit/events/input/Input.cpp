@@ -20,4 +20,17 @@ namespace RB::Events
         // Check high bit
         return (1 << 15) & state;
     }
+
+    const InputFrame& GetInputFrame()
+    {
+        return g_InputSampler->GetFrame();
+    }
+
+    uint64_t GetInputTimestamp()
+    {
+        LARGE_INTEGER time;
+        QueryPerformanceCounter(&time);
+
+        return time.QuadPart;
+    }
 }
\ No newline at end of file
@@ -2,10 +2,17 @@
 
 #include "KeyCodes.h"
 #include "MouseCodes.h"
+#include "InputRing.h"
 
 namespace RB::Events
 {
     bool IsKeyDown(const KeyCode& key);
 
     bool IsMouseKeyDown(const MouseCode& mouse_button);
+
+    // All the input that was received before the current frame started
+    const InputFrame& GetInputFrame();
+
+    // High resolution timestamp for the input samples
+    uint64_t GetInputTimestamp();
 }
\ No newline at end of file
@@ -0,0 +1,139 @@
+#include "RabBitCommon.h"
+#include "InputRing.h"
+
+namespace RB::Events
+{
+    // ----------------------------------------------------------------------------
+    //								InputSampler
+    // ----------------------------------------------------------------------------
+
+    InputSampler* g_InputSampler = nullptr;
+
+    InputSampler::InputSampler()
+        : m_Keyboard(kKeyboardInputRingSize)
+        , m_Mouse(kMouseInputRingSize)
+    {
+        m_Frame.samples.reserve(kKeyboardInputRingSize + kMouseInputRingSize);
+        m_KeyboardSamples.reserve(kKeyboardInputRingSize);
+        m_MouseSamples.reserve(kMouseInputRingSize);
+    }
+
+    void InputSampler::AddKey(uint64_t timestamp, KeyCode key, bool down)
+    {
+        AddSample(InputDevice::Keyboard, { timestamp, down ? InputSampleType::KeyDown : InputSampleType::KeyUp, (uint32_t)key, 0.0f, 0.0f });
+    }
+
+    void InputSampler::AddMouseMove(uint64_t timestamp, float x, float y)
+    {
+        AddSample(InputDevice::Mouse, { timestamp, InputSampleType::MouseMove, 0, x, y });
+    }
+
+    void InputSampler::AddMouseDelta(uint64_t timestamp, float delta_x, float delta_y)
+    {
+        AddSample(InputDevice::Mouse, { timestamp, InputSampleType::MouseDelta, 0, delta_x, delta_y });
+    }
+
+    void InputSampler::AddMouseButton(uint64_t timestamp, MouseCode button, bool down)
+    {
+        AddSample(InputDevice::Mouse, { timestamp, down ? InputSampleType::MouseButtonDown : InputSampleType::MouseButtonUp, (uint32_t)button, 0.0f, 0.0f });
+    }
+
+    void InputSampler::AddMouseScroll(uint64_t timestamp, float offset_x, float offset_y)
+    {
+        AddSample(InputDevice::Mouse, { timestamp, InputSampleType::MouseScroll, 0, offset_x, offset_y });
+    }
+
+    void InputSampler::AddSample(InputDevice device, const InputSample& sample)
+    {
+        RB_ASSERT(LOGTAG_EVENT, sample.type == InputSampleType::MouseMove || sample.type == InputSampleType::MouseDelta ||
+            sample.type == InputSampleType::MouseScroll || sample.code < 256, "Input code is out of range");
+
+        switch (device)
+        {
+        case InputDevice::Keyboard: m_Keyboard.Push(sample); break;
+        case InputDevice::Mouse:    m_Mouse.Push(sample);    break;
+        default:
+            RB_LOG_ERROR(LOGTAG_EVENT, "Input device not valid");
+            break;
+        }
+    }
+
+    const InputFrame& InputSampler::SampleFrame()
+    {
+        InputFrame& frame = m_Frame;
+
+        m_KeyboardSamples.clear();
+        m_MouseSamples.clear();
+
+        m_Keyboard.PopAll(m_KeyboardSamples);
+        m_Mouse.PopAll(m_MouseSamples);
+
+        // Every ring is already in order, so merging them keeps the samples ordered by time
+        frame.samples.resize(m_KeyboardSamples.size() + m_MouseSamples.size());
+        std::merge(m_KeyboardSamples.begin(), m_KeyboardSamples.end(), m_MouseSamples.begin(), m_MouseSamples.end(), frame.samples.begin(),
+            [](const InputSample& a, const InputSample& b) { return a.timestamp < b.timestamp; });
+
+        frame.mouseDeltaX = 0.0f;
+        frame.mouseDeltaY = 0.0f;
+        frame.scrollX = 0.0f;
+        frame.scrollY = 0.0f;
+
+        memset(frame.keysPressed, 0, sizeof(frame.keysPressed));
+        memset(frame.keysReleased, 0, sizeof(frame.keysReleased));
+        frame.buttonsPressed = 0;
+        frame.buttonsReleased = 0;
+
+        for (const InputSample& sample : frame.samples)
+        {
+            uint64_t bit = 1ull << (sample.code % 64);
+            uint32_t word = sample.code / 64;
+
+            switch (sample.type)
+            {
+            case InputSampleType::KeyDown:
+                // Repeats of a held key are not a new press
+                if ((frame.keysDown[word] & bit) == 0)
+                {
+                    frame.keysPressed[word] |= bit;
+                }
+                frame.keysDown[word] |= bit;
+                break;
+            case InputSampleType::KeyUp:
+                frame.keysReleased[word] |= bit;
+                frame.keysDown[word] &= ~bit;
+                break;
+            case InputSampleType::MouseButtonDown:
+                frame.buttonsPressed |= bit;
+                frame.buttonsDown |= bit;
+                break;
+            case InputSampleType::MouseButtonUp:
+                frame.buttonsReleased |= bit;
+                frame.buttonsDown &= ~bit;
+                break;
+            case InputSampleType::MouseMove:
+                frame.mouseX = sample.x;
+                frame.mouseY = sample.y;
+                break;
+            case InputSampleType::MouseDelta:
+                frame.mouseDeltaX += sample.x;
+                frame.mouseDeltaY += sample.y;
+                break;
+            case InputSampleType::MouseScroll:
+                frame.scrollX += sample.x;
+                frame.scrollY += sample.y;
+                break;
+            default:
+                break;
+            }
+
+            frame.lastTimestamp = sample.timestamp;
+        }
+
+        return frame;
+    }
+
+    uint64_t InputSampler::GetDroppedCount() const
+    {
+        return m_Keyboard.GetDroppedCount() + m_Mouse.GetDroppedCount();
+    }
+}
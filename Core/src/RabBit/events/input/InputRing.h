@@ -0,0 +1,111 @@
+#pragma once
+
+#include "RabBitCommon.h"
+#include "utils/SpscRing.h"
+#include "KeyCodes.h"
+#include "MouseCodes.h"
+
+namespace RB::Events
+{
+    enum class InputDevice : uint8_t
+    {
+        Keyboard,
+        Mouse,
+
+        Count
+    };
+
+    enum class InputSampleType : uint8_t
+    {
+        KeyDown,
+        KeyUp,
+        MouseMove,          // Cursor position in the client area of the window
+        MouseDelta,         // Raw motion of the mouse, not limited by the cursor and at the rate of the device
+        MouseButtonDown,
+        MouseButtonUp,
+        MouseScroll
+    };
+
+    struct InputSample
+    {
+        uint64_t        timestamp;
+        InputSampleType type;
+        uint32_t        code;       // KeyCode or MouseCode
+        float           x;
+        float           y;
+    };
+
+    constexpr uint32_t kKeyboardInputRingSize   = 256;
+    constexpr uint32_t kMouseInputRingSize      = 4096;
+
+    // The input samples of a single device, with 1 writer (the thread that pumps the window messages) and 1 reader (the main thread)
+    using InputRing = SpscRing<InputSample>;
+
+    // All the input of a frame, as the individual samples and as the state at the end of the frame
+    struct InputFrame
+    {
+        // Full resolution, the samples of all devices ordered by their timestamp
+        List<InputSample>   samples;
+
+        // Coalesced
+        float               mouseX          = 0.0f;     // Last cursor position
+        float               mouseY          = 0.0f;
+        float               mouseDeltaX     = 0.0f;     // Sum of the raw motion during the frame
+        float               mouseDeltaY     = 0.0f;
+        float               scrollX         = 0.0f;     // Sum of the scrolling during the frame
+        float               scrollY         = 0.0f;
+        uint64_t            lastTimestamp   = 0;        // Of the newest sample, the latency is the time between this and the simulation
+
+        bool IsKeyDown(KeyCode key) const               { return TestBit(keysDown, (uint32_t)key); }
+        bool WasKeyPressed(KeyCode key) const           { return TestBit(keysPressed, (uint32_t)key); }
+        bool WasKeyReleased(KeyCode key) const          { return TestBit(keysReleased, (uint32_t)key); }
+
+        bool IsMouseButtonDown(MouseCode button) const      { return TestBit(&buttonsDown, (uint32_t)button); }
+        bool WasMouseButtonPressed(MouseCode button) const  { return TestBit(&buttonsPressed, (uint32_t)button); }
+        bool WasMouseButtonReleased(MouseCode button) const { return TestBit(&buttonsReleased, (uint32_t)button); }
+
+        // A bit per key code, pressed and released can both be set when the key was tapped within the frame
+        uint64_t            keysDown[4]         = {};
+        uint64_t            keysPressed[4]      = {};
+        uint64_t            keysReleased[4]     = {};
+        uint64_t            buttonsDown         = 0;
+        uint64_t            buttonsPressed      = 0;
+        uint64_t            buttonsReleased     = 0;
+
+    private:
+        static bool TestBit(const uint64_t* bits, uint32_t index) { return (bits[index / 64] & (1ull << (index % 64))) != 0; }
+    };
+
+    // Collects the input of every device in its own ring, and gives it to the game code as a single batch per frame.
+    // The Add functions should be called from the thread that pumps the window messages, SampleFrame from the main thread.
+    class InputSampler
+    {
+    public:
+        InputSampler();
+
+        void AddKey(uint64_t timestamp, KeyCode key, bool down);
+        void AddMouseMove(uint64_t timestamp, float x, float y);
+        void AddMouseDelta(uint64_t timestamp, float delta_x, float delta_y);
+        void AddMouseButton(uint64_t timestamp, MouseCode button, bool down);
+        void AddMouseScroll(uint64_t timestamp, float offset_x, float offset_y);
+
+        void AddSample(InputDevice device, const InputSample& sample);
+
+        // Takes all the samples since the last call, the key/button states and cursor position carry over from the previous frame
+        const InputFrame& SampleFrame();
+
+        const InputFrame& GetFrame() const { return m_Frame; }
+
+        uint64_t GetDroppedCount() const;
+
+    private:
+        InputRing           m_Keyboard;
+        InputRing           m_Mouse;
+
+        InputFrame          m_Frame;
+        List<InputSample>   m_KeyboardSamples;
+        List<InputSample>   m_MouseSamples;
+    };
+
+    extern InputSampler* g_InputSampler;
+}
@@ -0,0 +1,146 @@
+#include "RabBitCommon.h"
+#include "DescriptorAllocator.h"
+
+namespace RB::Graphics
+{
+    // ---------------------------------------------------------------------------
+    //							DescriptorSlotAllocator
+    // ---------------------------------------------------------------------------
+
+    DescriptorSlotAllocator::DescriptorSlotAllocator(uint32_t capacity)
+        : m_Capacity(capacity)
+        , m_UsedCount(0)
+    {
+        RB_ASSERT_FATAL(LOGTAG_GRAPHICS, capacity > 0, "Cannot create a descriptor allocator without any slots");
+
+        uint32_t word_count = (capacity + 63) / 64;
+
+        m_FreeBits.resize(word_count, ~0ull);
+        m_SummaryBits.resize((word_count + 63) / 64, 0);
+
+        // The slots past the capacity in the last word are never free
+        if (capacity % 64 != 0)
+        {
+            m_FreeBits.back() = (1ull << (capacity % 64)) - 1;
+        }
+
+        for (uint32_t word = 0; word < word_count; ++word)
+        {
+            m_SummaryBits[word / 64] |= 1ull << (word % 64);
+        }
+    }
+
+    uint32_t DescriptorSlotAllocator::Allocate()
+    {
+        for (uint32_t summary = 0; summary < m_SummaryBits.size(); ++summary)
+        {
+            if (m_SummaryBits[summary] == 0)
+            {
+                continue;
+            }
+
+            uint32_t word = summary * 64 + FindLowestSetBit(m_SummaryBits[summary]);
+            uint32_t bit  = FindLowestSetBit(m_FreeBits[word]);
+
+            m_FreeBits[word] &= ~(1ull << bit);
+
+            if (m_FreeBits[word] == 0)
+            {
+                m_SummaryBits[summary] &= ~(1ull << (word % 64));
+            }
+
+            m_UsedCount++;
+
+            return word * 64 + bit;
+        }
+
+        return kInvalidDescriptorSlot;
+    }
+
+    void DescriptorSlotAllocator::Free(uint32_t slot)
+    {
+        RB_ASSERT_FATAL(LOGTAG_GRAPHICS, slot < m_Capacity && IsAllocated(slot), "Descriptor slot is not allocated");
+
+        uint32_t word = slot / 64;
+
+        m_FreeBits[word] |= 1ull << (slot % 64);
+        m_SummaryBits[word / 64] |= 1ull << (word % 64);
+
+        m_UsedCount--;
+    }
+
+    bool DescriptorSlotAllocator::IsAllocated(uint32_t slot) const
+    {
+        return (m_FreeBits[slot / 64] & (1ull << (slot % 64))) == 0;
+    }
+
+    // ---------------------------------------------------------------------------
+    //							TransientDescriptorRing
+    // ---------------------------------------------------------------------------
+
+    TransientDescriptorRing::TransientDescriptorRing(uint32_t size, uint32_t cycle_count)
+        : m_Size(size)
+        , m_CycleCount(cycle_count)
+        , m_Ring(size)
+        , m_Cycle(0)
+    {
+        RB_ASSERT_FATAL(LOGTAG_GRAPHICS, size > 0 && cycle_count > 0, "Cannot create a transient descriptor ring without any descriptors or cycles");
+    }
+
+    uint32_t TransientDescriptorRing::Allocate(uint32_t count)
+    {
+        uint64_t offset = m_Ring.Allocate(count);
+
+        return offset == kInvalidRingOffset ? kInvalidDescriptorSlot : (uint32_t)offset;
+    }
+
+    uint32_t TransientDescriptorRing::Allocate(TransientDescriptorBlock& block, uint32_t count)
+    {
+        // Read before taking a new block, so a block is never marked as newer than the part of the ring it is in
+        uint64_t cycle = GetCycle();
+
+        if (block.owner != this || block.cycle != cycle || block.next + count > block.end)
+        {
+            uint32_t block_size = Math::Max(count, Math::Min(kTransientDescriptorBlockSize, m_Size));
+            uint32_t start = Allocate(block_size);
+
+            if (start == kInvalidDescriptorSlot)
+            {
+                // Try to get just what is needed
+                block_size = count;
+                start = Allocate(block_size);
+
+                if (start == kInvalidDescriptorSlot)
+                {
+                    return kInvalidDescriptorSlot;
+                }
+            }
+
+            block.owner = this;
+            block.cycle = cycle;
+            block.next  = start;
+            block.end   = start + block_size;
+        }
+
+        uint32_t offset = block.next;
+        block.next += count;
+
+        return offset;
+    }
+
+    void TransientDescriptorRing::Cycle()
+    {
+        uint64_t cycle = m_Cycle.load(std::memory_order_relaxed);
+
+        // The descriptors that are allocated up to now belong to the cycle that ends, the oldest cycle is done
+        m_Ring.Submit(cycle);
+        cycle++;
+
+        if (cycle >= m_CycleCount)
+        {
+            m_Ring.Retire(cycle - m_CycleCount);
+        }
+
+        m_Cycle.store(cycle, std::memory_order_release);
+    }
+}
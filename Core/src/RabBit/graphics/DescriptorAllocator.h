@@ -0,0 +1,80 @@
+#pragma once
+
+#include "RabBitCommon.h"
+#include "RingAllocator.h"
+
+namespace RB::Graphics
+{
+    // Returned when there is no descriptor left
+    constexpr uint32_t kInvalidDescriptorSlot = UINT32_MAX;
+
+    // Amount of transient descriptors a thread takes from the shared ring at once
+    constexpr uint32_t kTransientDescriptorBlockSize = 32;
+
+    // Keeps track of the free persistent descriptors of a heap, without any API specific code.
+    // The free slots are bits in 64 bit words, and a summary bitset tells which words still have a free slot,
+    // so an allocation is a couple of find first set instructions no matter how fragmented the heap is.
+    // Not thread safe.
+    class DescriptorSlotAllocator
+    {
+    public:
+        DescriptorSlotAllocator(uint32_t capacity);
+
+        // Returns the lowest free slot, or kInvalidDescriptorSlot when all slots are used
+        uint32_t Allocate();
+        void     Free(uint32_t slot);
+
+        bool     IsAllocated(uint32_t slot) const;
+
+        uint32_t GetCapacity() const { return m_Capacity; }
+        uint32_t GetUsedCount() const { return m_UsedCount; }
+
+    private:
+        uint32_t        m_Capacity;
+        uint32_t        m_UsedCount;
+        List<uint64_t>  m_FreeBits;         // A set bit is a free slot
+        List<uint64_t>  m_SummaryBits;      // A set bit is a word in m_FreeBits with at least 1 free slot
+    };
+
+    // Part of the transient ring that is owned by a single thread, so its allocations do not touch the shared ring
+    struct TransientDescriptorBlock
+    {
+        const void* owner = nullptr;
+        uint64_t    cycle = UINT64_MAX;
+        uint32_t    next  = 0;
+        uint32_t    end   = 0;
+    };
+
+    // Descriptors that are only valid for a couple of cycles (frames), without any API specific code.
+    // All the cycles share 1 ring, so a cycle can use as much of the ring as the older cycles leave free instead of a fixed part of it.
+    // The descriptors of a cycle are reused once cycle_count newer cycles have been started, the cycles are the fence values of the RingAllocator.
+    //
+    // Allocate is lock free and can be called from multiple threads, Cycle should only be called by 1 thread.
+    class TransientDescriptorRing
+    {
+    public:
+        TransientDescriptorRing(uint32_t size, uint32_t cycle_count);
+
+        // Returns the offset of count contiguous descriptors in the ring, or kInvalidDescriptorSlot when the ring is full
+        uint32_t Allocate(uint32_t count = 1);
+
+        // Takes the descriptors from the block of the calling thread, the block is refilled from the ring when it is empty or from an older cycle
+        uint32_t Allocate(TransientDescriptorBlock& block, uint32_t count = 1);
+
+        // Starts a new cycle, the descriptors of the oldest cycle can be reused from now on
+        void     Cycle();
+
+        uint32_t GetSize() const { return m_Size; }
+        uint64_t GetCycle() const { return m_Cycle.load(std::memory_order_acquire); }
+
+        // Highest amount of descriptors that were in use at the same time
+        uint32_t GetHighWaterMark() const { return (uint32_t)m_Ring.GetHighWaterMark(); }
+
+    private:
+        const uint32_t          m_Size;
+        const uint32_t          m_CycleCount;
+
+        RingAllocator           m_Ring;
+        std::atomic<uint64_t>   m_Cycle;
+    };
+}
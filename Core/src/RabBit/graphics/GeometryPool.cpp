@@ -0,0 +1,194 @@
+#include "RabBitCommon.h"
+#include "GeometryPool.h"
+#include "Renderer.h"
+
+#include "app/Application.h"
+
+namespace RB::Graphics
+{
+    // ---------------------------------------------------------------------------
+    //								GeometryPoolAllocator
+    // ---------------------------------------------------------------------------
+
+    GeometryPoolAllocator::GeometryPoolAllocator(uint64_t vertex_page_size, uint64_t index_page_size)
+        : m_VertexPageSize(vertex_page_size)
+        , m_IndexPageSize(index_page_size)
+    {
+    }
+
+    GeometryPoolAllocator::~GeometryPoolAllocator()
+    {
+        for (Page* page : m_Pages)
+        {
+            delete page;
+        }
+
+        m_Pages.clear();
+    }
+
+    bool GeometryPoolAllocator::Allocate(uint32_t vertex_size, uint64_t vertex_count, uint64_t index_count, GeometryRange& out_range)
+    {
+        out_range = {};
+
+        uint64_t page_vertex_count = m_VertexPageSize / vertex_size;
+        uint64_t page_index_count  = m_IndexPageSize / sizeof(uint32_t);
+
+        if (vertex_count == 0 || index_count == 0 || vertex_count > page_vertex_count || index_count > page_index_count)
+        {
+            return false;
+        }
+
+        for (uint32_t page_index = 0; page_index <= m_Pages.size(); ++page_index)
+        {
+            // Nothing fits in the existing pages, start a new one
+            if (page_index == m_Pages.size())
+            {
+                m_Pages.push_back(new Page(vertex_size, page_vertex_count, page_index_count));
+            }
+
+            Page* page = m_Pages[page_index];
+
+            if (page->vertexSize != vertex_size)
+            {
+                continue;
+            }
+
+            if (!page->vertices.Allocate(vertex_count, 1, out_range.vertices))
+            {
+                continue;
+            }
+
+            if (!page->indices.Allocate(index_count, 1, out_range.indices))
+            {
+                page->vertices.Free(out_range.vertices);
+                continue;
+            }
+
+            out_range.page = page_index;
+            return true;
+        }
+
+        return false;
+    }
+
+    void GeometryPoolAllocator::Free(const GeometryRange& range)
+    {
+        RB_ASSERT_FATAL(LOGTAG_GRAPHICS, range.page < m_Pages.size(), "Geometry range is not part of this pool");
+
+        m_Pages[range.page]->vertices.Free(range.vertices);
+        m_Pages[range.page]->indices.Free(range.indices);
+    }
+
+    GeometryPoolStats GeometryPoolAllocator::GetStats() const
+    {
+        GeometryPoolStats stats = {};
+        stats.pageCount = m_Pages.size();
+
+        for (const Page* page : m_Pages)
+        {
+            HeapAllocatorStats vertex_stats = page->vertices.GetStats();
+            HeapAllocatorStats index_stats  = page->indices.GetStats();
+
+            stats.allocationCount   += vertex_stats.allocationCount;
+            stats.vertexBytes       += vertex_stats.size * page->vertexSize;
+            stats.usedVertexBytes   += vertex_stats.usedBytes * page->vertexSize;
+            stats.indexBytes        += index_stats.size * sizeof(uint32_t);
+            stats.usedIndexBytes    += index_stats.usedBytes * sizeof(uint32_t);
+        }
+
+        return stats;
+    }
+
+    // ---------------------------------------------------------------------------
+    //								GeometryPool
+    // ---------------------------------------------------------------------------
+
+    GeometryPool::GeometryPool()
+        : m_Allocator(kGeometryPoolVertexPageSize, kGeometryPoolIndexPageSize)
+    {
+    }
+
+    GeometryPool::~GeometryPool()
+    {
+        for (RetiredGeometry& retired : m_Retired)
+        {
+            delete retired.geometry.vertexBuffer;
+            delete retired.geometry.indexBuffer;
+        }
+
+        m_Retired.clear();
+
+        for (uint32_t i = 0; i < m_VertexBuffers.size(); ++i)
+        {
+            delete m_VertexBuffers[i];
+            delete m_IndexBuffers[i];
+        }
+
+        m_VertexBuffers.clear();
+        m_IndexBuffers.clear();
+    }
+
+    bool GeometryPool::Allocate(const char* name, void* vertex_data, uint32_t vertex_size, uint64_t vertex_data_size, uint32_t* index_data, uint64_t index_data_size,
+        StreamDataMode data_mode, PooledGeometry& out_geometry)
+    {
+        out_geometry = {};
+
+        if (!m_Allocator.Allocate(vertex_size, vertex_data_size / vertex_size, index_data_size / sizeof(uint32_t), out_geometry.range))
+        {
+            return false;
+        }
+
+        uint32_t page = out_geometry.range.page;
+
+        // Create the buffers of the new page, their contents are uploaded per range
+        while (m_VertexBuffers.size() < m_Allocator.GetPageCount())
+        {
+            uint32_t new_page = m_VertexBuffers.size();
+
+            m_VertexBuffers.push_back(VertexBuffer::Create("Geometry Pool vertices", TopologyType::TriangleList, nullptr,
+                m_Allocator.GetPageVertexSize(new_page), m_Allocator.GetPageVertexCount(new_page) * m_Allocator.GetPageVertexSize(new_page)));
+
+            m_IndexBuffers.push_back(IndexBuffer::Create("Geometry Pool indices", nullptr,
+                m_Allocator.GetPageIndexCount(new_page) * sizeof(uint32_t)));
+        }
+
+        // The buffers keep the pointer to the name
+        out_geometry.vertexBuffer = VertexBuffer::CreateRange(name, m_VertexBuffers[page], out_geometry.range.vertices.offset * vertex_size,
+            vertex_data, vertex_data_size, data_mode);
+
+        out_geometry.indexBuffer = IndexBuffer::CreateRange(name, m_IndexBuffers[page], out_geometry.range.indices.offset * sizeof(uint32_t),
+            index_data, index_data_size, data_mode);
+
+        return true;
+    }
+
+    void GeometryPool::Free(const PooledGeometry& geometry)
+    {
+        m_Retired.push_back({ geometry, Application::GetInstance()->GetRenderer()->GetRenderFrameIndex() });
+    }
+
+    void GeometryPool::Update()
+    {
+        uint64_t render_frame_index = Application::GetInstance()->GetRenderer()->GetRenderFrameIndex();
+
+        for (int32_t i = m_Retired.size() - 1; i >= 0; --i)
+        {
+            RetiredGeometry& retired = m_Retired[i];
+
+            // The range can not be reused while the streamer is still writing into it
+            if (retired.geometry.vertexBuffer->IsStreaming() || retired.geometry.indexBuffer->IsStreaming() ||
+                render_frame_index < retired.renderFrameIndex + kGeometryPoolRetireFrames)
+            {
+                continue;
+            }
+
+            delete retired.geometry.vertexBuffer;
+            delete retired.geometry.indexBuffer;
+
+            m_Allocator.Free(retired.geometry.range);
+
+            m_Retired[i] = m_Retired.back();
+            m_Retired.pop_back();
+        }
+    }
+}
@@ -0,0 +1,122 @@
+#pragma once
+
+#include "RabBitCommon.h"
+#include "RenderResource.h"
+#include "HeapAllocator.h"
+
+namespace RB::Graphics
+{
+    // Size of the vertex and index buffers of a pool page, geometry that does not fit in a page gets its own buffers
+    constexpr uint64_t kGeometryPoolVertexPageSize  = k16MB;
+    constexpr uint64_t kGeometryPoolIndexPageSize   = k8MB;
+    // Freed geometry is only overwritten once the GPU can not be drawing it anymore, the render thread can be a frame behind
+    // the main thread and the GPU can be BACK_BUFFER_COUNT frames behind the render thread
+    constexpr uint64_t kGeometryPoolRetireFrames    = 4;
+
+    constexpr uint32_t kInvalidGeometryPage = UINT32_MAX;
+
+    struct GeometryRange
+    {
+        uint32_t    page = kInvalidGeometryPage;
+        HeapBlock   vertices;   // Offset and size in vertices
+        HeapBlock   indices;    // Offset and size in indices
+
+        int32_t     GetBaseVertex() const { return (int32_t)vertices.offset; }
+        uint32_t    GetStartIndex() const { return (uint32_t)indices.offset; }
+        uint32_t    GetIndexCount() const { return (uint32_t)indices.size; }
+    };
+
+    struct GeometryPoolStats
+    {
+        uint32_t    pageCount;
+        uint32_t    allocationCount;
+        uint64_t    vertexBytes;
+        uint64_t    usedVertexBytes;
+        uint64_t    indexBytes;
+        uint64_t    usedIndexBytes;
+    };
+
+    // Keeps track of the free ranges in the vertex and index buffers of the pool pages, without any GPU resources.
+    // Every page holds vertices of a single size, so the geometry in a page can be drawn with just a base vertex and start index.
+    class GeometryPoolAllocator
+    {
+    public:
+        GeometryPoolAllocator(uint64_t vertex_page_size, uint64_t index_page_size);
+        ~GeometryPoolAllocator();
+
+        // Adds a page when the geometry does not fit in the existing pages of its vertex size.
+        // Returns false when the geometry is bigger than a page.
+        bool Allocate(uint32_t vertex_size, uint64_t vertex_count, uint64_t index_count, GeometryRange& out_range);
+        void Free(const GeometryRange& range);
+
+        uint32_t GetPageCount() const { return m_Pages.size(); }
+        uint32_t GetPageVertexSize(uint32_t page) const { return m_Pages[page]->vertexSize; }
+        uint64_t GetPageVertexCount(uint32_t page) const { return m_Pages[page]->vertices.GetSize(); }
+        uint64_t GetPageIndexCount(uint32_t page) const { return m_Pages[page]->indices.GetSize(); }
+
+        GeometryPoolStats GetStats() const;
+
+    private:
+        struct Page
+        {
+            uint32_t        vertexSize;
+            HeapAllocator   vertices;
+            HeapAllocator   indices;
+
+            Page(uint32_t vertex_size, uint64_t vertex_count, uint64_t index_count)
+                : vertexSize(vertex_size), vertices(vertex_count, 1), indices(index_count, 1) {}
+        };
+
+        uint64_t        m_VertexPageSize;
+        uint64_t        m_IndexPageSize;
+        List<Page*>     m_Pages;
+    };
+
+    // Part of a pool page. The buffers only cover the range of this geometry (and can be bound and streamed like normal buffers),
+    // but the geometry can also be drawn with the page buffers of the pool using the offsets of the range.
+    struct PooledGeometry
+    {
+        GeometryRange   range;
+        VertexBuffer*   vertexBuffer = nullptr;
+        IndexBuffer*    indexBuffer = nullptr;
+    };
+
+    // Suballocates the static (triangle list) geometry from a couple of big vertex and index buffers, so the draws of
+    // different meshes only differ in their offsets and no resources have to be created per mesh.
+    // Should only be used from the main thread.
+    class GeometryPool
+    {
+    public:
+        GeometryPool();
+        ~GeometryPool();
+
+        // Schedules the upload of the geometry into the pool. Returns false when it does not fit in a page, the data is not taken over in that case.
+        bool Allocate(const char* name, void* vertex_data, uint32_t vertex_size, uint64_t vertex_data_size, uint32_t* index_data, uint64_t index_data_size,
+            StreamDataMode data_mode, PooledGeometry& out_geometry);
+
+        // The range is reused once the GPU is done with it
+        void Free(const PooledGeometry& geometry);
+
+        // Gives the retired ranges back to the pool, should be called once per frame
+        void Update();
+
+        VertexBuffer*   GetVertexBuffer(uint32_t page) const { return m_VertexBuffers[page]; }
+        IndexBuffer*    GetIndexBuffer(uint32_t page) const { return m_IndexBuffers[page]; }
+
+        GeometryPoolStats GetStats() const { return m_Allocator.GetStats(); }
+
+    private:
+        struct RetiredGeometry
+        {
+            PooledGeometry  geometry;
+            uint64_t        renderFrameIndex;
+        };
+
+        GeometryPoolAllocator   m_Allocator;
+
+        List<VertexBuffer*>     m_VertexBuffers;
+        List<IndexBuffer*>      m_IndexBuffers;
+
+        List<RetiredGeometry>   m_Retired;
+    };
+}
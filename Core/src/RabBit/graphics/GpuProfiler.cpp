@@ -0,0 +1,235 @@
+#include "RabBitCommon.h"
+#include "GpuProfiler.h"
+
+#include "utils/debug/Profiler.h"
+
+namespace RB::Graphics
+{
+    // ---------------------------------------------------------------------------
+    //								GpuTimestampBackendNull
+    // ---------------------------------------------------------------------------
+
+    GpuTimestampBackendNull::GpuTimestampBackendNull(uint32_t query_count, uint64_t tick_step)
+        : m_Written(query_count, 0)
+        , m_Resolved(query_count, 0)
+        , m_Ticks(Utils::Debug::GetProfileTimestamp())
+        , m_TickStep(tick_step)
+    {
+    }
+
+    void GpuTimestampBackendNull::WriteTimestamp(uint32_t query)
+    {
+        m_Ticks += m_TickStep;
+        m_Written[query] = m_Ticks;
+    }
+
+    void GpuTimestampBackendNull::ResolveTimestamps(uint32_t first_query, uint32_t query_count)
+    {
+        std::copy_n(m_Written.begin() + first_query, query_count, m_Resolved.begin() + first_query);
+    }
+
+    void GpuTimestampBackendNull::ReadTimestamps(uint32_t first_query, uint32_t query_count, uint64_t* out_ticks)
+    {
+        std::copy_n(m_Resolved.begin() + first_query, query_count, out_ticks);
+    }
+
+    uint64_t GpuTimestampBackendNull::ToProfileTimestamp(uint64_t ticks)
+    {
+        // The ticks started counting at the current profile timestamp
+        return ticks;
+    }
+
+    // ---------------------------------------------------------------------------
+    //								GpuProfiler
+    // ---------------------------------------------------------------------------
+
+    GpuProfiler::GpuProfiler(GpuTimestampBackend* backend, uint32_t query_count, const char* track_name)
+        : m_Backend(backend)
+        , m_Mask(query_count - 1)
+        , m_Ticks(query_count, 0)
+        , m_NextQuery(0)
+        , m_ResolvedEnd(0)
+        , m_SubmittedEnd(0)
+        , m_ReadEnd(0)
+        , m_OldestUsedQuery(0)
+        , m_ReservedQueries(0)
+        , m_DroppedCount(0)
+        , m_Track(Utils::Debug::Profiler::CreateTrack(track_name))
+    {
+        RB_ASSERT_FATAL(LOGTAG_GRAPHICS, query_count >= 2 && (query_count & m_Mask) == 0, "Query count of a GPU profiler should be a power of 2");
+    }
+
+    GpuProfiler::~GpuProfiler()
+    {
+        delete m_Backend;
+    }
+
+    void GpuProfiler::BeginZone(const char* name)
+    {
+        // Every open zone still needs a query for its end
+        uint64_t used_queries = m_NextQuery - m_OldestUsedQuery;
+        if (used_queries + m_ReservedQueries + 2 > m_Mask + 1)
+        {
+            m_OpenZones.push_back({ name, 0, true });
+            m_DroppedCount++;
+            return;
+        }
+
+        m_OpenZones.push_back({ name, WriteTimestamp(), false });
+        m_ReservedQueries++;
+    }
+
+    void GpuProfiler::EndZone()
+    {
+        RB_ASSERT_FATAL(LOGTAG_GRAPHICS, !m_OpenZones.empty(), "Ended a GPU zone that was never begun");
+
+        OpenZone zone = m_OpenZones.back();
+        m_OpenZones.pop_back();
+
+        if (zone.dropped)
+        {
+            return;
+        }
+
+        m_ReservedQueries--;
+        m_PendingZones.push_back({ zone.name, zone.beginQuery, WriteTimestamp(), (uint32_t)m_OpenZones.size() });
+    }
+
+    void GpuProfiler::Resolve()
+    {
+        if (m_ResolvedEnd == m_NextQuery)
+        {
+            return;
+        }
+
+        ResolveRange(m_ResolvedEnd, m_NextQuery);
+        m_ResolvedEnd = m_NextQuery;
+    }
+
+    void GpuProfiler::Submit(uint64_t fence_value)
+    {
+        if (m_SubmittedEnd == m_ResolvedEnd)
+        {
+            return;
+        }
+
+        m_Submissions.push_back({ m_ResolvedEnd, fence_value });
+        m_SubmittedEnd = m_ResolvedEnd;
+    }
+
+    void GpuProfiler::ReadBack(uint64_t completed_fence_value)
+    {
+        while (!m_Submissions.empty() && m_Submissions.front().fenceValue <= completed_fence_value)
+        {
+            ReadRange(m_ReadEnd, m_Submissions.front().queryEnd);
+            m_ReadEnd = m_Submissions.front().queryEnd;
+            m_Submissions.pop_front();
+
+            PublishZones();
+        }
+
+        // Queries can be reused once they are read back, unless the begin of a zone that is not published yet still needs them.
+        // Zones that begin later only use newer queries, so this stays valid until the next read back.
+        m_OldestUsedQuery = m_ReadEnd;
+
+        for (const OpenZone& zone : m_OpenZones)
+        {
+            if (!zone.dropped)
+            {
+                m_OldestUsedQuery = std::min(m_OldestUsedQuery, zone.beginQuery);
+                break;
+            }
+        }
+
+        for (const PendingZone& zone : m_PendingZones)
+        {
+            m_OldestUsedQuery = std::min(m_OldestUsedQuery, zone.beginQuery);
+        }
+    }
+
+    const GpuZoneTiming* GpuProfiler::FindTiming(const char* name) const
+    {
+        for (const GpuZoneTiming& timing : m_Timings)
+        {
+            if (timing.name == name || strcmp(timing.name, name) == 0)
+            {
+                return &timing;
+            }
+        }
+
+        return nullptr;
+    }
+
+    uint64_t GpuProfiler::WriteTimestamp()
+    {
+        uint64_t query = m_NextQuery++;
+        m_Backend->WriteTimestamp(query & m_Mask);
+
+        return query;
+    }
+
+    void GpuProfiler::ResolveRange(uint64_t begin, uint64_t end)
+    {
+        uint32_t first = begin & m_Mask;
+        uint32_t count = end - begin;
+        uint32_t until_wrap = m_Mask + 1 - first;
+
+        if (count > until_wrap)
+        {
+            m_Backend->ResolveTimestamps(first, until_wrap);
+            m_Backend->ResolveTimestamps(0, count - until_wrap);
+        }
+        else
+        {
+            m_Backend->ResolveTimestamps(first, count);
+        }
+    }
+
+    void GpuProfiler::ReadRange(uint64_t begin, uint64_t end)
+    {
+        uint32_t first = begin & m_Mask;
+        uint32_t count = end - begin;
+        uint32_t until_wrap = m_Mask + 1 - first;
+
+        if (count > until_wrap)
+        {
+            m_Backend->ReadTimestamps(first, until_wrap, &m_Ticks[first]);
+            m_Backend->ReadTimestamps(0, count - until_wrap, &m_Ticks[0]);
+        }
+        else
+        {
+            m_Backend->ReadTimestamps(first, count, &m_Ticks[first]);
+        }
+    }
+
+    void GpuProfiler::PublishZones()
+    {
+        bool capturing = Utils::Debug::Profiler::IsCapturing();
+
+        // Zones are pending in the order they ended, so the first zone ends with the oldest query
+        while (!m_PendingZones.empty() && m_PendingZones.front().endQuery < m_ReadEnd)
+        {
+            const PendingZone& zone = m_PendingZones.front();
+
+            uint64_t start = m_Backend->ToProfileTimestamp(m_Ticks[zone.beginQuery & m_Mask]);
+            uint64_t end   = std::max(start, m_Backend->ToProfileTimestamp(m_Ticks[zone.endQuery & m_Mask]));
+
+            GpuZoneTiming* timing = (GpuZoneTiming*)FindTiming(zone.name);
+            if (!timing)
+            {
+                m_Timings.push_back({ zone.name, 0, 0 });
+                timing = &m_Timings.back();
+            }
+
+            timing->duration = end - start;
+            timing->count++;
+
+            if (capturing)
+            {
+                m_Track->ring.Push({ zone.name, start, end, zone.depth });
+            }
+
+            m_PendingZones.pop_front();
+        }
+    }
+}
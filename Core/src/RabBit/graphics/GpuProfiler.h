@@ -0,0 +1,139 @@
+#pragma once
+
+#include "RabBitCommon.h"
+
+namespace RB::Utils::Debug
+{
+    struct ProfileThread;
+}
+
+namespace RB::Graphics
+{
+    // Timestamps that can be in flight per queue, every zone takes 2
+    constexpr uint32_t kGpuProfilerQueryCount = 4096;
+
+    // Writes and reads back the timestamps of a single queue, implemented per graphics API
+    class GpuTimestampBackend
+    {
+    public:
+        virtual ~GpuTimestampBackend() = default;
+
+        // The timestamp is taken once the GPU reaches this point of the open command list
+        virtual void     WriteTimestamp(uint32_t query) = 0;
+        // Copies the written timestamps into memory the CPU can read, as part of the open command list
+        virtual void     ResolveTimestamps(uint32_t first_query, uint32_t query_count) = 0;
+        // Only called once the command list that resolved the queries has finished executing, so this never waits
+        virtual void     ReadTimestamps(uint32_t first_query, uint32_t query_count, uint64_t* out_ticks) = 0;
+        // Converts GPU ticks to the nanoseconds of the CPU profiler (see GetProfileTimestamp)
+        virtual uint64_t ToProfileTimestamp(uint64_t ticks) = 0;
+
+    protected:
+        GpuTimestampBackend() = default;
+    };
+
+    // Does not touch the GPU, every timestamp is a fixed amount of ticks (nanoseconds) after the previous one.
+    // Used to run the profiler headless.
+    class GpuTimestampBackendNull : public GpuTimestampBackend
+    {
+    public:
+        GpuTimestampBackendNull(uint32_t query_count, uint64_t tick_step = 1000);
+
+        void     WriteTimestamp(uint32_t query) override;
+        void     ResolveTimestamps(uint32_t first_query, uint32_t query_count) override;
+        void     ReadTimestamps(uint32_t first_query, uint32_t query_count, uint64_t* out_ticks) override;
+        uint64_t ToProfileTimestamp(uint64_t ticks) override;
+
+        void     SetTickStep(uint64_t tick_step) { m_TickStep = tick_step; }
+
+    private:
+        List<uint64_t>  m_Written;
+        List<uint64_t>  m_Resolved;
+        uint64_t        m_Ticks;
+        uint64_t        m_TickStep;
+        uint64_t        m_StartTimestamp;
+    };
+
+    struct GpuZoneTiming
+    {
+        const char* name;
+        uint64_t    duration;       // Nanoseconds, of the last time the zone was read back
+        uint64_t    count;          // Amount of times the zone was read back
+    };
+
+    // Measures zones on the timeline of a queue with timestamp queries, without ever waiting on the GPU. The timestamps are resolved at the
+    // end of every submission and read back once the fence of that submission has been reached, which is normally a few frames later.
+    // Finished zones are published into the CPU profiler on their own track, and the last duration per zone name is kept.
+    // Not thread safe, should only be used by the thread that records the command lists of the queue.
+    class GpuProfiler
+    {
+    public:
+        // Takes ownership of the backend, the query count should be a power of 2
+        GpuProfiler(GpuTimestampBackend* backend, uint32_t query_count, const char* track_name);
+        ~GpuProfiler();
+
+        // The name should be a literal (or at least outlive the profiler). Zones are dropped when all the queries are still in flight.
+        void BeginZone(const char* name);
+        void EndZone();
+
+        // Should be called right before the command list is submitted
+        void Resolve();
+        // Should be called right after, the resolved timestamps can be read once the fence reaches this value
+        void Submit(uint64_t fence_value);
+        // Reads back the timestamps of the finished submissions and publishes the zones that are complete
+        void ReadBack(uint64_t completed_fence_value);
+
+        const List<GpuZoneTiming>&  GetTimings() const { return m_Timings; }
+        const GpuZoneTiming*        FindTiming(const char* name) const;
+
+        uint64_t GetDroppedCount() const { return m_DroppedCount; }
+        uint32_t GetPendingZoneCount() const { return m_PendingZones.size(); }
+
+    private:
+        struct OpenZone
+        {
+            const char* name;
+            uint64_t    beginQuery;
+            bool        dropped;
+        };
+
+        struct PendingZone
+        {
+            const char* name;
+            uint64_t    beginQuery;
+            uint64_t    endQuery;
+            uint32_t    depth;
+        };
+
+        struct Submission
+        {
+            uint64_t    queryEnd;       // Every query before this one has been resolved by the submission
+            uint64_t    fenceValue;
+        };
+
+        uint64_t WriteTimestamp();
+        void     ResolveRange(uint64_t begin, uint64_t end);
+        void     ReadRange(uint64_t begin, uint64_t end);
+        void     PublishZones();
+
+        GpuTimestampBackend*            m_Backend;
+        const uint64_t                  m_Mask;
+        List<uint64_t>                  m_Ticks;        // Read back timestamps, per query
+
+        // Query indices keep counting up, the query itself is the index masked by the query count
+        uint64_t                        m_NextQuery;
+        uint64_t                        m_ResolvedEnd;
+        uint64_t                        m_SubmittedEnd;
+        uint64_t                        m_ReadEnd;
+        uint64_t                        m_OldestUsedQuery;  // Queries before this one can be reused
+        uint32_t                        m_ReservedQueries;  // End queries of the open zones
+
+        List<OpenZone>                  m_OpenZones;
+        Deque<PendingZone>              m_PendingZones;     // In the order they ended
+        Deque<Submission>               m_Submissions;
+
+        List<GpuZoneTiming>             m_Timings;
+        uint64_t                        m_DroppedCount;
+
+        Utils::Debug::ProfileThread*    m_Track;
+    };
+}
@@ -0,0 +1,392 @@
+#include "HeapAllocator.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// RabBitCommon.h is not included, the engine build gets its asserts through the precompiled header
+#if defined(RB_ASSERT_FATAL)
+    #define HEAP_ASSERT(check, message) RB_ASSERT_FATAL(LOGTAG_GRAPHICS, check, message)
+#else
+    #define HEAP_ASSERT(check, message) assert((check) && message)
+#endif
+
+namespace RB::Graphics
+{
+    namespace
+    {
+        uint64_t AlignUp(uint64_t value, uint64_t alignment)    { return (value + alignment - 1) & ~(alignment - 1); }
+        uint64_t AlignDown(uint64_t value, uint64_t alignment)  { return value & ~(alignment - 1); }
+
+        uint32_t LowestSetBit(uint32_t bitset)
+        {
+#if defined(_MSC_VER)
+            unsigned long index;
+            _BitScanForward(&index, bitset);
+            return index;
+#else
+            return __builtin_ctz(bitset);
+#endif
+        }
+
+        uint32_t HighestSetBit(uint64_t bitset)
+        {
+#if defined(_MSC_VER)
+            unsigned long index;
+            _BitScanReverse64(&index, bitset);
+            return index;
+#else
+            return 63 - __builtin_clzll(bitset);
+#endif
+        }
+    }
+
+    HeapAllocator::HeapAllocator(uint64_t size, uint64_t granularity)
+        : m_Size(AlignDown(size, granularity))
+        , m_Granularity(granularity)
+        , m_FirstLevelBitmap(0)
+        , m_UsedBytes(0)
+        , m_AllocationCount(0)
+        , m_FreeBlockCount(0)
+    {
+        HEAP_ASSERT(granularity > 0 && (granularity & (granularity - 1)) == 0, "The granularity of a heap should be a power of 2");
+        HEAP_ASSERT(m_Size >= granularity, "The heap is smaller than its granularity");
+        HEAP_ASSERT((m_Size / granularity) <= UINT32_MAX, "The heap has too many blocks, use a bigger granularity");
+
+        memset(m_SecondLevelBitmaps, 0, sizeof(m_SecondLevelBitmaps));
+        memset(m_FreeLists, 0xFF, sizeof(m_FreeLists));
+
+        // Start with 1 free block spanning the whole heap
+        InsertFreeNode(CreateNode(0, m_Size));
+    }
+
+    bool HeapAllocator::Allocate(uint64_t size, uint64_t alignment, HeapBlock& out_block)
+    {
+        out_block = {};
+
+        if (size == 0)
+        {
+            return false;
+        }
+
+        alignment = std::max(alignment, m_Granularity);
+        size = AlignUp(size, m_Granularity);
+
+        // Make sure the block can be aligned when the alignment is bigger than the granularity
+        uint64_t search_size = size + (alignment - m_Granularity);
+
+        if (search_size > m_Size)
+        {
+            return false;
+        }
+
+        uint32_t index = FindFreeNode(search_size);
+
+        if (index == kInvalidHeapBlock)
+        {
+            return false;
+        }
+
+        RemoveFreeNode(index);
+
+        // Give the front padding back as a separate free block
+        uint64_t aligned_offset = AlignUp(m_Nodes[index].offset, alignment);
+        uint64_t padding = aligned_offset - m_Nodes[index].offset;
+
+        if (padding > 0)
+        {
+            uint32_t front = CreateNode(m_Nodes[index].offset, padding);
+
+            m_Nodes[front].prevPhysical = m_Nodes[index].prevPhysical;
+            m_Nodes[front].nextPhysical = index;
+
+            if (m_Nodes[index].prevPhysical != kInvalidHeapBlock)
+            {
+                m_Nodes[m_Nodes[index].prevPhysical].nextPhysical = front;
+            }
+
+            m_Nodes[index].prevPhysical = front;
+            m_Nodes[index].offset = aligned_offset;
+            m_Nodes[index].size -= padding;
+
+            InsertFreeNode(front);
+        }
+
+        // Give the rest back as a separate free block
+        if (m_Nodes[index].size > size)
+        {
+            uint32_t back = CreateNode(m_Nodes[index].offset + size, m_Nodes[index].size - size);
+
+            m_Nodes[back].prevPhysical = index;
+            m_Nodes[back].nextPhysical = m_Nodes[index].nextPhysical;
+
+            if (m_Nodes[index].nextPhysical != kInvalidHeapBlock)
+            {
+                m_Nodes[m_Nodes[index].nextPhysical].prevPhysical = back;
+            }
+
+            m_Nodes[index].nextPhysical = back;
+            m_Nodes[index].size = size;
+
+            InsertFreeNode(back);
+        }
+
+        m_Nodes[index].free = false;
+        m_Nodes[index].references = 1;
+
+        m_UsedBytes += size;
+        m_AllocationCount++;
+
+        out_block.offset = m_Nodes[index].offset;
+        out_block.size   = size;
+        out_block.index  = index;
+
+        return true;
+    }
+
+    void HeapAllocator::AddReference(const HeapBlock& block)
+    {
+        HEAP_ASSERT(block.index < m_Nodes.size() && !m_Nodes[block.index].free, "Block is not allocated from this heap");
+
+        m_Nodes[block.index].references++;
+    }
+
+    bool HeapAllocator::Free(const HeapBlock& block)
+    {
+        HEAP_ASSERT(block.index < m_Nodes.size() && !m_Nodes[block.index].free, "Block is not allocated from this heap");
+
+        uint32_t index = block.index;
+
+        if (--m_Nodes[index].references > 0)
+        {
+            return false;
+        }
+
+        m_UsedBytes -= m_Nodes[index].size;
+        m_AllocationCount--;
+
+        m_Nodes[index].free = true;
+
+        // Merge with the previous block
+        uint32_t prev = m_Nodes[index].prevPhysical;
+
+        if (prev != kInvalidHeapBlock && m_Nodes[prev].free)
+        {
+            RemoveFreeNode(prev);
+
+            m_Nodes[prev].size += m_Nodes[index].size;
+            m_Nodes[prev].nextPhysical = m_Nodes[index].nextPhysical;
+
+            if (m_Nodes[index].nextPhysical != kInvalidHeapBlock)
+            {
+                m_Nodes[m_Nodes[index].nextPhysical].prevPhysical = prev;
+            }
+
+            DestroyNode(index);
+            index = prev;
+        }
+
+        // Merge with the next block
+        uint32_t next = m_Nodes[index].nextPhysical;
+
+        if (next != kInvalidHeapBlock && m_Nodes[next].free)
+        {
+            RemoveFreeNode(next);
+
+            m_Nodes[index].size += m_Nodes[next].size;
+            m_Nodes[index].nextPhysical = m_Nodes[next].nextPhysical;
+
+            if (m_Nodes[next].nextPhysical != kInvalidHeapBlock)
+            {
+                m_Nodes[m_Nodes[next].nextPhysical].prevPhysical = index;
+            }
+
+            DestroyNode(next);
+        }
+
+        InsertFreeNode(index);
+
+        return true;
+    }
+
+    HeapAllocatorStats HeapAllocator::GetStats() const
+    {
+        HeapAllocatorStats stats = {};
+        stats.size              = m_Size;
+        stats.usedBytes         = m_UsedBytes;
+        stats.allocationCount   = m_AllocationCount;
+        stats.freeBlockCount    = m_FreeBlockCount;
+
+        // The largest free block is in the highest non empty free list
+        if (m_FirstLevelBitmap != 0)
+        {
+            uint32_t first_level  = HighestSetBit(m_FirstLevelBitmap);
+            uint32_t second_level = HighestSetBit(m_SecondLevelBitmaps[first_level]);
+
+            for (uint32_t index = m_FreeLists[first_level][second_level]; index != kInvalidHeapBlock; index = m_Nodes[index].nextFree)
+            {
+                stats.largestFreeBlock = std::max(stats.largestFreeBlock, m_Nodes[index].size);
+            }
+        }
+
+        uint64_t free_bytes = m_Size - m_UsedBytes;
+        stats.fragmentation = free_bytes > 0 ? 1.0f - ((float)stats.largestFreeBlock / (float)free_bytes) : 0.0f;
+
+        return stats;
+    }
+
+    void HeapAllocator::GetFreeList(uint64_t size, uint32_t& out_first_level, uint32_t& out_second_level) const
+    {
+        uint64_t blocks = size / m_Granularity;
+
+        // Small sizes all get their own list in the first level
+        if (blocks < kHeapAllocatorSecondLevelCount)
+        {
+            out_first_level  = 0;
+            out_second_level = (uint32_t)blocks;
+            return;
+        }
+
+        uint32_t highest_bit = HighestSetBit(blocks);
+
+        out_first_level  = highest_bit - kHeapAllocatorSecondLevelLog2 + 1;
+        out_second_level = (uint32_t)(blocks >> (highest_bit - kHeapAllocatorSecondLevelLog2)) - kHeapAllocatorSecondLevelCount;
+    }
+
+    uint32_t HeapAllocator::FindFreeNode(uint64_t size) const
+    {
+        // Round up to the next list, so every block in the found list is big enough
+        uint64_t blocks = size / m_Granularity;
+
+        if (blocks >= kHeapAllocatorSecondLevelCount)
+        {
+            blocks += (1ull << (HighestSetBit(blocks) - kHeapAllocatorSecondLevelLog2)) - 1;
+        }
+
+        uint32_t first_level, second_level;
+        GetFreeList(blocks * m_Granularity, first_level, second_level);
+
+        if (first_level >= kHeapAllocatorFirstLevelCount)
+        {
+            return kInvalidHeapBlock;
+        }
+
+        uint32_t second_level_bitmap = m_SecondLevelBitmaps[first_level] & (~0u << second_level);
+
+        if (second_level_bitmap == 0)
+        {
+            // Nothing in this size range, take the smallest bigger range
+            uint32_t first_level_bitmap = first_level + 1 < kHeapAllocatorFirstLevelCount ? m_FirstLevelBitmap & (~0u << (first_level + 1)) : 0;
+
+            if (first_level_bitmap == 0)
+            {
+                return kInvalidHeapBlock;
+            }
+
+            first_level = LowestSetBit(first_level_bitmap);
+            second_level_bitmap = m_SecondLevelBitmaps[first_level];
+        }
+
+        second_level = LowestSetBit(second_level_bitmap);
+
+        return m_FreeLists[first_level][second_level];
+    }
+
+    void HeapAllocator::InsertFreeNode(uint32_t index)
+    {
+        uint32_t first_level, second_level;
+        GetFreeList(m_Nodes[index].size, first_level, second_level);
+
+        uint32_t head = m_FreeLists[first_level][second_level];
+
+        m_Nodes[index].free     = true;
+        m_Nodes[index].prevFree = kInvalidHeapBlock;
+        m_Nodes[index].nextFree = head;
+
+        if (head != kInvalidHeapBlock)
+        {
+            m_Nodes[head].prevFree = index;
+        }
+
+        m_FreeLists[first_level][second_level] = index;
+
+        m_FirstLevelBitmap |= 1u << first_level;
+        m_SecondLevelBitmaps[first_level] |= 1u << second_level;
+
+        m_FreeBlockCount++;
+    }
+
+    void HeapAllocator::RemoveFreeNode(uint32_t index)
+    {
+        uint32_t first_level, second_level;
+        GetFreeList(m_Nodes[index].size, first_level, second_level);
+
+        Node& node = m_Nodes[index];
+
+        if (node.prevFree != kInvalidHeapBlock)
+        {
+            m_Nodes[node.prevFree].nextFree = node.nextFree;
+        }
+        else
+        {
+            m_FreeLists[first_level][second_level] = node.nextFree;
+        }
+
+        if (node.nextFree != kInvalidHeapBlock)
+        {
+            m_Nodes[node.nextFree].prevFree = node.prevFree;
+        }
+
+        if (m_FreeLists[first_level][second_level] == kInvalidHeapBlock)
+        {
+            m_SecondLevelBitmaps[first_level] &= ~(1u << second_level);
+
+            if (m_SecondLevelBitmaps[first_level] == 0)
+            {
+                m_FirstLevelBitmap &= ~(1u << first_level);
+            }
+        }
+
+        node.prevFree = kInvalidHeapBlock;
+        node.nextFree = kInvalidHeapBlock;
+
+        m_FreeBlockCount--;
+    }
+
+    uint32_t HeapAllocator::CreateNode(uint64_t offset, uint64_t size)
+    {
+        uint32_t index;
+
+        if (!m_UnusedNodes.empty())
+        {
+            index = m_UnusedNodes.back();
+            m_UnusedNodes.pop_back();
+        }
+        else
+        {
+            index = m_Nodes.size();
+            m_Nodes.push_back({});
+        }
+
+        Node& node = m_Nodes[index];
+        node.offset         = offset;
+        node.size           = size;
+        node.prevPhysical   = kInvalidHeapBlock;
+        node.nextPhysical   = kInvalidHeapBlock;
+        node.prevFree       = kInvalidHeapBlock;
+        node.nextFree       = kInvalidHeapBlock;
+        node.references     = 0;
+        node.free           = true;
+
+        return index;
+    }
+
+    void HeapAllocator::DestroyNode(uint32_t index)
+    {
+        m_UnusedNodes.push_back(index);
+    }
+}
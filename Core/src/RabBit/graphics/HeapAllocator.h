@@ -0,0 +1,95 @@
+#pragma once
+
+// Only depends on the standard library, so the allocator can be unit tested on any platform
+#include <cstdint>
+#include <vector>
+
+namespace RB::Graphics
+{
+    // Every first level (power of 2) size range is split up in this many (1 << log2) linear second level ranges
+    constexpr uint32_t kHeapAllocatorSecondLevelLog2    = 4;
+    constexpr uint32_t kHeapAllocatorSecondLevelCount   = 1 << kHeapAllocatorSecondLevelLog2;
+    constexpr uint32_t kHeapAllocatorFirstLevelCount    = 32;
+
+    constexpr uint32_t kInvalidHeapBlock = UINT32_MAX;
+
+    struct HeapBlock
+    {
+        uint64_t    offset;
+        uint64_t    size;
+        uint32_t    index = kInvalidHeapBlock;   // Internal index of the block, kInvalidHeapBlock when the allocation failed
+    };
+
+    struct HeapAllocatorStats
+    {
+        uint64_t    size;
+        uint64_t    usedBytes;
+        uint64_t    largestFreeBlock;
+        uint32_t    allocationCount;
+        uint32_t    freeBlockCount;
+        float       fragmentation;          // 0 when all free memory is one block, close to 1 when it is split up in a lot of small blocks
+    };
+
+    // Two-Level Segregated Fit allocator over an address range, without any API specific code. Allocating and freeing is O(1),
+    // the free blocks are kept in size classes that are found with 2 bit scans, and neighbouring free blocks are merged.
+    // Reference: http://www.gii.upv.es/tlsf/files/papers/ecrts04_tlsf.pdf
+    //
+    // A block can be shared by multiple resources (aliasing), the memory is only given back when all references are freed.
+    // Not thread safe.
+    class HeapAllocator
+    {
+    public:
+        // All offsets and sizes are multiples of the granularity, which should be a power of 2
+        HeapAllocator(uint64_t size, uint64_t granularity);
+
+        // Returns false when there is no free block that fits, the alignment should be a power of 2
+        bool Allocate(uint64_t size, uint64_t alignment, HeapBlock& out_block);
+
+        // Another resource starts using the memory of this block
+        void AddReference(const HeapBlock& block);
+
+        // Returns true when this was the last reference and the memory is free again
+        bool Free(const HeapBlock& block);
+
+        bool IsEmpty() const { return m_AllocationCount == 0; }
+
+        uint64_t            GetSize() const { return m_Size; }
+        HeapAllocatorStats  GetStats() const;
+
+    private:
+        struct Node
+        {
+            uint64_t    offset;
+            uint64_t    size;
+            uint32_t    prevPhysical;
+            uint32_t    nextPhysical;
+            uint32_t    prevFree;
+            uint32_t    nextFree;
+            uint32_t    references;
+            bool        free;
+        };
+
+        void        GetFreeList(uint64_t size, uint32_t& out_first_level, uint32_t& out_second_level) const;
+        uint32_t    FindFreeNode(uint64_t size) const;
+
+        void        InsertFreeNode(uint32_t index);
+        void        RemoveFreeNode(uint32_t index);
+
+        uint32_t    CreateNode(uint64_t offset, uint64_t size);
+        void        DestroyNode(uint32_t index);
+
+        const uint64_t  m_Size;
+        const uint64_t  m_Granularity;
+
+        std::vector<Node>       m_Nodes;
+        std::vector<uint32_t>   m_UnusedNodes;
+
+        uint32_t        m_FirstLevelBitmap;
+        uint32_t        m_SecondLevelBitmaps[kHeapAllocatorFirstLevelCount];
+        uint32_t        m_FreeLists[kHeapAllocatorFirstLevelCount][kHeapAllocatorSecondLevelCount];
+
+        uint64_t        m_UsedBytes;
+        uint32_t        m_AllocationCount;
+        uint32_t        m_FreeBlockCount;
+    };
+}
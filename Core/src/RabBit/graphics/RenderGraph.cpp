@@ -4,6 +4,8 @@
 #include "RenderInterface.h"
 #include "View.h"
 
+#include "utils/debug/Profiler.h"
+
 namespace RB::Graphics
 {
     // ---------------------------------------------------------------------------
@@ -40,41 +42,60 @@ namespace RB::Graphics
             }
 
             submitted[id] = true;
+
+            RB_PROFILE_CPU_SCOPED(m_UnorderedPasses[id]->GetName());
             entries[idx] = m_UnorderedPasses[id]->SubmitEntry(view_context, scene);
         }
 
         return entries;
     }
 
-    void RenderGraph::RunGraph(ViewContext* view_context, RenderPassEntry** entries, RenderInterface* render_interface, RenderGraphContext* graph_context)
+    void RenderGraph::RunGraph(ViewContext* view_context, RenderPassEntry** entries, RenderInterface* render_interface, RenderInterface* compute_interface, RenderGraphContext* graph_context)
     {
+        uint64_t entry_mask = 0;
+        for (int i = 0; i < m_RenderFlow.size(); ++i)
+        {
+            if (entries[i] != nullptr)
+            {
+                entry_mask |= (1ull << i);
+            }
+        }
+
+        bool async_compute = compute_interface != nullptr;
+
+        // Only recompile the plan when something changed since the last run
+        if (!m_Plan.valid || m_Plan.entryMask != entry_mask || m_Plan.asyncCompute != async_compute || m_Plan.resourceVersion != graph_context->GetVersion())
+        {
+            CompilePlan(entry_mask, async_compute, graph_context);
+        }
+
+        m_CulledPassCount = m_RenderFlow.size() - m_Plan.flowIndices.size();
+
         // First clear the necessary resources
+        if (!m_Plan.clears.empty())
         {
             RB_PROFILE_GPU_SCOPED(render_interface, "Clear");
 
-            const List<ResourceID>& all_resources = graph_context->GetScheduledGraphResources(m_ID);
-            for (const ResourceID& id : all_resources)
+            for (const ResourceID& id : m_Plan.clears)
             {
-                if (graph_context->RequiresClear(id))
-                {
-                    render_interface->Clear(graph_context->GetResource(id));
-                }
+                render_interface->Clear(graph_context->GetResource(id));
             }
 
             render_interface->FlushAllPending();
         }
 
+        Shared<GpuGuard> compute_guard      = nullptr;
+        bool             compute_pending    = false;
+        int32_t          last_compute_pass  = -1;   // Plan index of the last pass recorded on the compute queue
+        int32_t          submitted_compute  = -1;   // Plan index of the last compute pass that is submitted, compute_guard belongs to it
+
         // Then actually execute the graph
-        for (int i = 0; i < m_RenderFlow.size(); ++i)
+        for (uint32_t plan_index = 0; plan_index < m_Plan.flowIndices.size(); ++plan_index)
         {
-            RenderPass*      pass  = m_UnorderedPasses[m_RenderFlow[i].passID];
-            RenderPassEntry* entry = entries[i];
-
-            // Do not render the pass if it did not submit an entry
-            if (entry == nullptr)
-            {
-                continue;
-            }
+            uint32_t             i         = m_Plan.flowIndices[plan_index];
+            RenderPass*          pass      = m_UnorderedPasses[m_RenderFlow[i].passID];
+            RenderPassEntry*     entry     = entries[i];
+            const ScheduledPass& scheduled = m_Plan.schedule[plan_index];
 
             RenderResource* parameters[MAX_INOUT_RESOURCES_PER_RENDERPASS] = {};
             RenderResource* intermediates[MAX_WORKING_RESOURCES_PER_RENDERPASS] = {};
@@ -110,21 +131,247 @@ namespace RB::Graphics
                 outputs[m_FinalOutputResourceID] = view_context->finalColorTarget;
             }
 
-            RB_PROFILE_GPU_SCOPED(render_interface, pass->GetName());
-
             // Clear the render state before every pass
             render_interface->InvalidateState(false);
 
-            RenderPassInput input;
-            input.viewContext           = view_context;
-            input.renderInterface       = render_interface;
-            input.entryContext          = entry;
-            input.dependencyTextures    = parameters;
-            input.workingTextures       = intermediates;
-            input.outputTextures        = outputs;
+            const BarrierBoundary& boundary = m_Plan.barriers[plan_index];
+
+            // Join the compute work first, so the transitions do not run while the compute queue is still using the resources
+            if (boundary.joinComputePass != -1)
+            {
+                if (boundary.joinComputePass > submitted_compute)
+                {
+                    compute_guard       = compute_interface->ExecuteOnGpu();
+                    compute_pending     = false;
+                    submitted_compute   = last_compute_pass;
+                }
+
+                // Submit the graphics work that does not depend on the compute work first, so it can overlap
+                render_interface->ExecuteOnGpu();
+                render_interface->GpuWaitOn(compute_guard.get());
+            }
+
+            // Submit the precomputed transitions of this pass boundary as one batch. These are always recorded 
+            // on the graphics queue, as the compute queue is not able to transition from or to graphics states.
+            for (const PlannedBarrier& barrier : boundary.barriers)
+            {
+                RenderResource* resource = graph_context->GetResource(barrier.resource);
+
+                switch (barrier.split)
+                {
+                case BarrierSplit::None:
+                    render_interface->TransitionResource(resource, barrier.state);
+                    break;
+                case BarrierSplit::Begin:
+                    render_interface->BeginTransitionResource(resource, barrier.state);
+                    break;
+                case BarrierSplit::End:
+                    render_interface->EndTransitionResource(resource);
+                    break;
+                }
+            }
+
+            render_interface->FlushResourceBarriers();
+
+            RenderInterface* pass_interface = render_interface;
+
+            if (scheduled.queue == RenderQueueType::Compute)
+            {
+                pass_interface = compute_interface;
+
+                // Wait on the graphics work this pass depends on, including the transitions that were just recorded
+                if (scheduled.waitForPass != -1 || !boundary.barriers.empty())
+                {
+                    Shared<GpuGuard> graphics_guard = render_interface->ExecuteOnGpu();
+                    compute_interface->GpuWaitOn(graphics_guard.get());
+                }
+
+                compute_interface->InvalidateState(false);
+            }
+
+            {
+                RB_PROFILE_GPU_SCOPED(pass_interface, pass->GetName());
+                RB_PROFILE_CPU_SCOPED(pass->GetName());
+
+                RenderPassInput input;
+                input.viewContext           = view_context;
+                input.renderInterface       = pass_interface;
+                input.entryContext          = entry;
+                input.dependencyTextures    = parameters;
+                input.workingTextures       = intermediates;
+                input.outputTextures        = outputs;
+
+                pass->Render(input);
+            }
+
+            if (scheduled.queue == RenderQueueType::Compute)
+            {
+                compute_pending   = true;
+                last_compute_pass = (int32_t)plan_index;
+
+                if (scheduled.signal)
+                {
+                    compute_guard       = compute_interface->ExecuteOnGpu();
+                    compute_pending     = false;
+                    submitted_compute   = (int32_t)plan_index;
+                }
+            }
+        }
+
+        // The graph resources are shared between ViewContexts, so make sure all compute work is finished before continuing on the graphics queue
+        if (compute_pending)
+        {
+            compute_guard = compute_interface->ExecuteOnGpu();
+            render_interface->ExecuteOnGpu();
+            render_interface->GpuWaitOn(compute_guard.get());
+        }
+    }
+
+    void RenderGraph::CompilePlan(uint64_t entry_mask, bool async_compute, RenderGraphContext* graph_context)
+    {
+        m_Plan.valid            = true;
+        m_Plan.entryMask        = entry_mask;
+        m_Plan.asyncCompute     = async_compute;
+        m_Plan.resourceVersion  = graph_context->GetVersion();
+        m_Plan.flowIndices.clear();
+        m_Plan.clears.clear();
+        m_Plan.barriers.clear();
+        m_Plan.schedule.clear();
+
+        if (m_RenderFlow.empty())
+        {
+            return;
+        }
+
+        const int32_t final_index = m_RenderFlow.size() - 1;
+
+        bool* live = (bool*)ALLOC_STACK(m_RenderFlow.size() * sizeof(bool));
+        memset(&live[0], false, m_RenderFlow.size() * sizeof(bool));
+
+        List<ResourceID> needed;
+
+        auto is_needed = [&needed](ResourceID id) -> bool
+        {
+            return id != -1 && std::find(needed.begin(), needed.end(), id) != needed.end();
+        };
+
+        // Walk back to front and only keep the passes that submitted an entry and contribute to the final output
+        for (int32_t i = final_index; i >= 0; --i)
+        {
+            const FlowNode& node = m_RenderFlow[i];
+
+            if ((entry_mask & (1ull << i)) == 0)
+            {
+                continue;
+            }
+
+            bool contributes = (i == final_index);
+
+            for (int j = 0; j < MAX_INOUT_RESOURCES_PER_RENDERPASS && !contributes; ++j)
+            {
+                contributes = is_needed(node.outputIDs[j]);
+            }
+
+            if (!contributes)
+            {
+                continue;
+            }
 
-            pass->Render(input);
+            live[i] = true;
+
+            for (int j = 0; j < MAX_INOUT_RESOURCES_PER_RENDERPASS; ++j)
+            {
+                if (node.parameterIDs[j] != -1)
+                    needed.push_back(node.parameterIDs[j]);
+
+                if (node.outputIDs[j] != -1 && (node.readOutputMask & (1u << j)) != 0)
+                    needed.push_back(node.outputIDs[j]);
+            }
         }
+
+        // Walk front to back to collect what every live pass touches, for the clears and the queue schedule
+        List<List<PassResourceTouch>> touches;
+        List<PassScheduleDesc> schedule_descs;
+
+        for (int32_t i = 0; i <= final_index; ++i)
+        {
+            if (!live[i])
+            {
+                continue;
+            }
+
+            m_Plan.flowIndices.push_back(i);
+
+            const FlowNode& node = m_RenderFlow[i];
+
+            List<PassResourceTouch>& pass_touches = touches.emplace_back();
+
+            PassScheduleDesc& schedule_desc = schedule_descs.emplace_back();
+            schedule_desc.asyncComputeCompatible = async_compute && node.asyncCompute;
+
+            for (int j = 0; j < MAX_INOUT_RESOURCES_PER_RENDERPASS; ++j)
+            {
+                if (node.parameterIDs[j] == -1)
+                    continue;
+
+                pass_touches.push_back({ node.parameterIDs[j], false });
+                schedule_desc.reads.push_back(node.parameterIDs[j]);
+            }
+
+            for (int j = 0; j < MAX_WORKING_RESOURCES_PER_RENDERPASS; ++j)
+            {
+                if (node.workingIDs[j] == -1)
+                    continue;
+
+                pass_touches.push_back({ node.workingIDs[j], false });
+                schedule_desc.writes.push_back(node.workingIDs[j]);
+            }
+
+            for (int j = 0; j < MAX_INOUT_RESOURCES_PER_RENDERPASS; ++j)
+            {
+                if (node.outputIDs[j] == -1)
+                    continue;
+
+                bool overwritten = (node.overwriteOutputMask & (1u << j)) != 0 && (node.readOutputMask & (1u << j)) == 0;
+                pass_touches.push_back({ node.outputIDs[j], overwritten });
+
+                schedule_desc.writes.push_back(node.outputIDs[j]);
+
+                if ((node.readOutputMask & (1u << j)) != 0)
+                    schedule_desc.reads.push_back(node.outputIDs[j]);
+            }
+        }
+
+        BuildClearList(touches, [graph_context](ResourceID id) { return graph_context->RequiresClear(id); }, m_Plan.clears);
+        BuildQueueSchedule(schedule_descs, m_Plan.schedule);
+
+        List<List<PassResourceUsage>> usages;
+
+        for (uint32_t plan_index = 0; plan_index < m_Plan.flowIndices.size(); ++plan_index)
+        {
+            const FlowNode& node = m_RenderFlow[m_Plan.flowIndices[plan_index]];
+
+            // Dependencies are always bound as shader resources, the compute queue only supports the non pixel shader variant
+            ResourceState read_state = m_Plan.schedule[plan_index].queue == RenderQueueType::Compute ? ResourceState::NON_PIXEL_SHADER_RESOURCE : ResourceState::PIXEL_SHADER_RESOURCE;
+
+            List<PassResourceUsage>& pass_usages = usages.emplace_back();
+
+            for (int j = 0; j < MAX_INOUT_RESOURCES_PER_RENDERPASS; ++j)
+            {
+                if (node.parameterIDs[j] != -1)
+                    pass_usages.push_back({ node.parameterIDs[j], read_state });
+                if (node.outputIDs[j] != -1)
+                    pass_usages.push_back({ node.outputIDs[j], node.outputStates[j] });
+            }
+
+            for (int j = 0; j < MAX_WORKING_RESOURCES_PER_RENDERPASS; ++j)
+            {
+                if (node.workingIDs[j] != -1)
+                    pass_usages.push_back({ node.workingIDs[j], node.workingStates[j] });
+            }
+        }
+
+        BuildBarrierPlan(usages, m_Plan.schedule, m_Plan.barriers);
     }
 
     void RenderGraph::DestroyEntries(RenderPassEntry** entries)
@@ -141,6 +388,19 @@ namespace RB::Graphics
     //                            RenderGraphBuilder
     // ---------------------------------------------------------------------------
 
+    // The state a pass is expected to write a resource in, passes that write a random read/write 
+    // capable texture as a render target still work, they just get an extra transition while binding
+    static ResourceState GetWriteState(const RenderTextureDesc& desc)
+    {
+        if (IsDepthFormat(desc.format))
+            return ResourceState::DEPTH_WRITE;
+
+        if (desc.HasFlag(kRTFlag_AllowRandomReadWrites))
+            return ResourceState::UNORDERED_ACCESS;
+
+        return ResourceState::RENDER_TARGET;
+    }
+
     RenderGraphBuilder::RenderGraphBuilder()
         : m_FinalPassType(RenderPassType::None)
         , m_FinalResourceId(0)
@@ -167,7 +427,7 @@ namespace RB::Graphics
         uint64_t processed_mask = 0;
         RenderPassType pass_type = RenderPassType::None;
 
-        UnorderedMap<uint32_t, RenderPass*> passes;
+        FlatMap<uint32_t, RenderPass*> passes;
         List<RenderGraph::FlowNode> render_flow;
 
         // Process from back to front
@@ -203,6 +463,8 @@ namespace RB::Graphics
 
             RenderPassConfig config = pass_ptr->second->GetConfiguration(settings_ptr->second);
 
+            node.asyncCompute = config.asyncComputeCompatible;
+
             auto GetAlias = [&](const RenderTextureDesc& desc, bool check_lifetime) -> ResourceID
             {
                 ResourceID id = -1;
@@ -316,6 +578,7 @@ namespace RB::Graphics
 
                             // The pass will use the output parameter to access this input
                             parameter_ids[to_res_idx] = -1;
+                            node.readOutputMask |= (1u << linked_out_idx);
 
                             const RenderTextureDesc& desc = config.outputTextures[linked_out_idx];
 
@@ -374,6 +637,8 @@ namespace RB::Graphics
             {
                 const RenderTextureDesc& desc = config.workingTextures[i];
 
+                node.workingStates[i] = GetWriteState(desc);
+
                 // No need to check the full lifetime of working textures, they are only used by this pass
                 ResourceID id = GetAlias(desc, false);
 
@@ -401,6 +666,13 @@ namespace RB::Graphics
 
             for (uint32_t i = 0; i < config.totalOutputTextures; ++i)
             {
+                if (config.outputTextures[i].HasFlag(kRTFlag_FullyOverwritten))
+                {
+                    node.overwriteOutputMask |= (1u << i);
+                }
+
+                node.outputStates[i] = GetWriteState(config.outputTextures[i]);
+
                 if (pass_type == m_FinalPassType && i == m_FinalResourceId)
                 {
                     if (config.outputTextures[i].width != kRTSize_Full || config.outputTextures[i].height != kRTSize_Full)
@@ -445,6 +717,12 @@ namespace RB::Graphics
 
         } while (pass_type != m_FinalPassType);
 
+        if (render_flow.size() > 64)
+        {
+            RB_ASSERT_ALWAYS(LOGTAG_GRAPHICS, "A RenderGraph can not contain more than 64 passes, the compiled plan relies on a 64 bit entry mask");
+            return nullptr;
+        }
+
         // Copy over all the necessary data into an actual RenderGraph
         RenderGraph* graph = new RenderGraph();
         graph->m_ID                      = graph_id;
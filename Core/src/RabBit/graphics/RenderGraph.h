@@ -2,6 +2,8 @@
 
 #include "RenderPass.h"
 #include "RenderGraphContext.h"
+#include "RenderGraphBarriers.h"
+#include "RenderGraphScheduler.h"
 
 namespace RB::Graphics
 {
@@ -21,10 +23,14 @@ namespace RB::Graphics
         RenderGraph() = default;
 
         RenderPassEntry** SubmitEntry(const ViewContext* view_context, const Entity::Scene* const scene);
-        void RunGraph(ViewContext* view_context, RenderPassEntry** entries, RenderInterface* render_interface, RenderGraphContext* graph_context);
+        // Passes that are async compute compatible run on the compute_interface, pass nullptr to run everything on the render_interface
+        void RunGraph(ViewContext* view_context, RenderPassEntry** entries, RenderInterface* render_interface, RenderInterface* compute_interface, RenderGraphContext* graph_context);
 
         void DestroyEntries(RenderPassEntry** entries);
 
+        // The amount of passes that were skipped during the last RunGraph call
+        uint32_t GetCulledPassCount() const { return m_CulledPassCount; }
+
     private:
         friend class RenderGraphBuilder;
 
@@ -34,12 +40,37 @@ namespace RB::Graphics
             ResourceID  parameterIDs[MAX_INOUT_RESOURCES_PER_RENDERPASS]; // -1 means not valid
             ResourceID  workingIDs[MAX_WORKING_RESOURCES_PER_RENDERPASS];
             ResourceID  outputIDs[MAX_INOUT_RESOURCES_PER_RENDERPASS];
+            uint32_t    readOutputMask;      // Outputs that are also read by this pass (linked inouts)
+            uint32_t    overwriteOutputMask; // Outputs that are fully overwritten by this pass
+            bool        asyncCompute;        // Can run on the compute queue
+            // The states the pass writes its resources in
+            ResourceState workingStates[MAX_WORKING_RESOURCES_PER_RENDERPASS];
+            ResourceState outputStates[MAX_INOUT_RESOURCES_PER_RENDERPASS];
+        };
+
+        // The part of the render flow that actually contributes to the final output.
+        // Only recompiled when the submitted entries or the graph resources change.
+        struct CompiledPlan
+        {
+            bool             valid = false;
+            uint64_t         entryMask = 0;       // Bit per FlowNode, set when the pass submitted an entry
+            bool             asyncCompute = false;
+            uint32_t         resourceVersion = 0; // RenderGraphContext version this plan is compiled against
+            List<uint32_t>   flowIndices;         // Indices into m_RenderFlow, in execution order
+            List<ResourceID> clears;              // Resources to clear before the first pass
+            List<BarrierBoundary>      barriers;  // Batched transitions before every pass in flowIndices
+            List<ScheduledPass>        schedule;  // The queue of every pass in flowIndices
         };
 
+        void CompilePlan(uint64_t entry_mask, bool async_compute, RenderGraphContext* graph_context);
+
         uint32_t                             m_ID;
         uint32_t                             m_FinalOutputResourceID;
-        UnorderedMap<uint32_t, RenderPass*>  m_UnorderedPasses;
+        FlatMap<uint32_t, RenderPass*>       m_UnorderedPasses;
         List<FlowNode>                       m_RenderFlow;
+
+        CompiledPlan                         m_Plan;
+        uint32_t                             m_CulledPassCount = 0;
     };
 
     // ---------------------------------------------------------------------------
@@ -77,12 +108,12 @@ namespace RB::Graphics
         using ResourceConnections = List<uint32_t>;
 
         // Yes, I know, these types are getting very long and confusing :(
-        RenderPassType                                                                  m_FinalPassType;
-        uint32_t                                                                        m_FinalResourceId;
-        UnorderedMap<RenderPassType, RenderPass*>                                       m_Passes;
-        UnorderedMap<RenderPassType, RenderPassSettings>                                m_PassSettings;
-        //           To                           From            Resources
-        UnorderedMap<RenderPassType, UnorderedMap<RenderPassType, ResourceConnections>> m_Connections;
+        RenderPassType                                                        m_FinalPassType;
+        uint32_t                                                              m_FinalResourceId;
+        FlatMap<RenderPassType, RenderPass*>                                  m_Passes;
+        FlatMap<RenderPassType, RenderPassSettings>                           m_PassSettings;
+        //      To                      From            Resources
+        FlatMap<RenderPassType, FlatMap<RenderPassType, ResourceConnections>> m_Connections;
     };
 
     template<class Pass>
@@ -116,7 +147,7 @@ namespace RB::Graphics
 
         if (to_itr == m_Connections.end())
         {
-            UnorderedMap<RenderPassType, ResourceConnections> list;
+            FlatMap<RenderPassType, ResourceConnections> list;
             list.emplace(from, connection_ids);
 
             m_Connections.emplace(to, list);
@@ -0,0 +1,121 @@
+#include "RabBitCommon.h"
+#include "RenderGraphBarriers.h"
+
+namespace RB::Graphics
+{
+    void BuildClearList(const List<List<PassResourceTouch>>& pass_touches, const std::function<bool(ResourceID)>& requires_clear, List<ResourceID>& out_clears)
+    {
+        out_clears.clear();
+
+        List<ResourceID> touched;
+
+        for (const List<PassResourceTouch>& touches : pass_touches)
+        {
+            for (const PassResourceTouch& touch : touches)
+            {
+                if (touch.resource == -1 || std::find(touched.begin(), touched.end(), touch.resource) != touched.end())
+                {
+                    continue;
+                }
+
+                touched.push_back(touch.resource);
+
+                if (!touch.fullyOverwritten && requires_clear(touch.resource))
+                {
+                    out_clears.push_back(touch.resource);
+                }
+            }
+        }
+    }
+
+    void BuildBarrierPlan(const List<List<PassResourceUsage>>& pass_usages, const List<ScheduledPass>& schedule, List<BarrierBoundary>& out_boundaries)
+    {
+        RB_ASSERT(LOGTAG_GRAPHICS, pass_usages.size() == schedule.size(), "Every pass should have a usage and a schedule entry");
+
+        out_boundaries.clear();
+        out_boundaries.resize(pass_usages.size());
+
+        struct LastUsage
+        {
+            ResourceID      resource;
+            ResourceState   state;
+            int32_t         passIndex;
+        };
+
+        List<LastUsage> last_usages;
+
+        // The last compute pass the graphics queue waited on at every boundary (so far)
+        List<int32_t> joined_compute;
+        joined_compute.reserve(pass_usages.size());
+
+        auto add_transition = [&](ResourceID resource, ResourceState state, int32_t begin_boundary, int32_t end_boundary)
+        {
+            if (begin_boundary < end_boundary)
+            {
+                // There is a gap in which the resource is not used, give the GPU the chance to already start the transition
+                out_boundaries[begin_boundary].barriers.push_back({ resource, state, BarrierSplit::Begin });
+                out_boundaries[end_boundary].barriers.push_back({ resource, state, BarrierSplit::End });
+            }
+            else
+            {
+                out_boundaries[end_boundary].barriers.push_back({ resource, state, BarrierSplit::None });
+            }
+        };
+
+        for (int32_t pass_index = 0; pass_index < pass_usages.size(); ++pass_index)
+        {
+            // The graphics passes that depend on compute work wait on it before their barriers are recorded
+            int32_t joined = pass_index > 0 ? joined_compute[pass_index - 1] : -1;
+
+            if (schedule[pass_index].queue == RenderQueueType::Graphics && schedule[pass_index].waitForPass != -1)
+            {
+                out_boundaries[pass_index].joinComputePass = schedule[pass_index].waitForPass;
+                joined = std::max(joined, schedule[pass_index].waitForPass);
+            }
+
+            joined_compute.push_back(joined);
+
+            for (const PassResourceUsage& usage : pass_usages[pass_index])
+            {
+                auto itr = std::find_if(last_usages.begin(), last_usages.end(), [&usage](const LastUsage& last) -> bool
+                {
+                    return last.resource == usage.resource;
+                });
+
+                if (itr == last_usages.end())
+                {
+                    // First usage in the graph, the state before the graph is only known at runtime
+                    // so the transition can already start at the very first boundary
+                    add_transition(usage.resource, usage.state, 0, pass_index);
+                    last_usages.push_back({ usage.resource, usage.state, pass_index });
+                    continue;
+                }
+
+                if (itr->state != usage.state)
+                {
+                    int32_t begin_boundary = itr->passIndex + 1;
+
+                    if (schedule[itr->passIndex].queue == RenderQueueType::Compute)
+                    {
+                        // The compute queue can still be using the resource, so the transition can only start after the join
+                        while (begin_boundary < pass_index && joined_compute[begin_boundary] < itr->passIndex)
+                        {
+                            begin_boundary++;
+                        }
+
+                        if (joined_compute[pass_index] < itr->passIndex)
+                        {
+                            out_boundaries[pass_index].joinComputePass = std::max(out_boundaries[pass_index].joinComputePass, itr->passIndex);
+                            joined_compute[pass_index] = out_boundaries[pass_index].joinComputePass;
+                        }
+                    }
+
+                    add_transition(usage.resource, usage.state, begin_boundary, pass_index);
+                }
+
+                itr->state     = usage.state;
+                itr->passIndex = pass_index;
+            }
+        }
+    }
+}
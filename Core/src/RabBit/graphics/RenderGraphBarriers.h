@@ -0,0 +1,54 @@
+#pragma once
+
+#include "RenderGraphContext.h"
+#include "RenderGraphScheduler.h"
+
+namespace RB::Graphics
+{
+    enum class BarrierSplit
+    {
+        None,   // Regular transition, issued right before the pass that needs it
+        Begin,  // Starts the transition right after the last pass that used the resource in its previous state
+        End     // Finishes a transition that was started at an earlier pass boundary
+    };
+
+    // The state a pass needs one of its resources in
+    struct PassResourceUsage
+    {
+        ResourceID      resource;
+        ResourceState   state;
+    };
+
+    struct PlannedBarrier
+    {
+        ResourceID      resource;
+        ResourceState   state;
+        BarrierSplit    split;
+    };
+
+    // The barriers that should be submitted as one batch right before a pass. They are always recorded on the graphics queue.
+    struct BarrierBoundary
+    {
+        List<PlannedBarrier>    barriers;
+        // The compute pass (and the compute passes before it) the graphics queue should wait on before the barriers are recorded, -1 when not needed
+        int32_t                 joinComputePass = -1;
+    };
+
+    // How a pass touches one of its resources, for the clears at the start of the graph
+    struct PassResourceTouch
+    {
+        ResourceID      resource;
+        bool            fullyOverwritten;   // Every texel is written by the pass, without being read first
+    };
+
+    // The resources that should be cleared before the first pass (in execution order): the ones that require a clear, unless the first
+    // pass touching them fully overwrites them. Resources that are not touched by any pass (only used by culled passes) are skipped.
+    void BuildClearList(const List<List<PassResourceTouch>>& pass_touches, const std::function<bool(ResourceID)>& requires_clear, List<ResourceID>& out_clears);
+
+    // Computes the state transitions of a RenderGraph ahead of time, based on the resource usages and the queue schedule of every pass
+    // (in execution order). out_boundaries[i] holds the barriers that should be submitted right before pass i. When there are passes in 
+    // between two usages of a resource that do not touch it, the transition is split over that gap using a begin and end barrier.
+    // A resource that was last used on the compute queue is only transitioned once the graphics queue waited on that compute pass,
+    // an extra join is added when the schedule does not already have one before the resource is needed again.
+    void BuildBarrierPlan(const List<List<PassResourceUsage>>& pass_usages, const List<ScheduledPass>& schedule, List<BarrierBoundary>& out_boundaries);
+}
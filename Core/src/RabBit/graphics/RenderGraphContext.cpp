@@ -7,7 +7,7 @@ namespace RB::Graphics
 {
     RenderGraphContext::~RenderGraphContext()
     {
-        DeleteGraphResources();
+        ReleaseGraphResources();
     }
 
     RenderResource* RenderGraphContext::GetResource(ResourceID id)
@@ -36,7 +36,7 @@ namespace RB::Graphics
     {
         if (graph_id >= m_GraphSizes.size())
         {
-            m_GraphSizes.push_back({});
+            m_GraphSizes.resize(graph_id + 1);
         }
 
         m_GraphSizes[graph_id].push_back(size);
@@ -47,17 +47,54 @@ namespace RB::Graphics
         m_GraphSizes.clear();
     }
 
-    void RenderGraphContext::CreateGraphResources()
+    void RenderGraphContext::CalculateBiggestSizes(List<RenderGraphSize>& out_sizes) const
     {
-        if (m_Resources.size() != 0)
+        out_sizes.resize(m_GraphDescriptions.size());
+
+        for (uint32_t graph_id = 0; graph_id < m_GraphDescriptions.size(); ++graph_id)
         {
-            RB_LOG_WARN(LOGTAG_GRAPHICS, "Cannot create graph resources when there are already resources");
-            return;
+            // A graph without any sizes is not used by any view, its resources do not need to exist
+            RenderGraphSize biggest_size = {};
+
+            if (graph_id < m_GraphSizes.size())
+            {
+                // Create a one fits all sizes
+                for (const RenderGraphSize& current_size : m_GraphSizes[graph_id])
+                {
+                    biggest_size.size.x = Math::Max(biggest_size.size.x, current_size.size.x);
+                    biggest_size.size.y = Math::Max(biggest_size.size.y, current_size.size.y);
+
+                    biggest_size.uiSize.x = Math::Max(biggest_size.uiSize.x, current_size.uiSize.x);
+                    biggest_size.uiSize.y = Math::Max(biggest_size.uiSize.y, current_size.uiSize.y);
+
+                    biggest_size.upscaledSize.x = Math::Max(biggest_size.upscaledSize.x, current_size.upscaledSize.x);
+                    biggest_size.upscaledSize.y = Math::Max(biggest_size.upscaledSize.y, current_size.upscaledSize.y);
+                }
+            }
+
+            out_sizes[graph_id] = biggest_size;
+        }
+    }
+
+    void RenderGraphContext::UpdateGraphResources(uint64_t frame_index)
+    {
+        m_TexturePool.Update(frame_index);
+
+        List<RenderGraphSize> biggest_sizes;
+        CalculateBiggestSizes(biggest_sizes);
+
+        bool sizes_changed = biggest_sizes.size() != m_ResourceSizes.size();
+
+        for (uint32_t i = 0; !sizes_changed && i < biggest_sizes.size(); ++i)
+        {
+            sizes_changed = biggest_sizes[i].size.x         != m_ResourceSizes[i].size.x         || biggest_sizes[i].size.y         != m_ResourceSizes[i].size.y ||
+                            biggest_sizes[i].uiSize.x       != m_ResourceSizes[i].uiSize.x       || biggest_sizes[i].uiSize.y       != m_ResourceSizes[i].uiSize.y ||
+                            biggest_sizes[i].upscaledSize.x != m_ResourceSizes[i].upscaledSize.x || biggest_sizes[i].upscaledSize.y != m_ResourceSizes[i].upscaledSize.y;
         }
 
-        if (m_GraphSizes.size() == 0)
+        if (!sizes_changed && !m_DescriptionsDirty)
         {
-            RB_LOG_WARN(LOGTAG_GRAPHICS, "Cannot create graph resources when there are not sizes registered yet");
+            // Resources are up-to-date
             return;
         }
 
@@ -68,26 +105,17 @@ namespace RB::Graphics
             List<ResourceID> ids;
         };
 
-        // Will contain all the resources that will be created for this context
+        // Will contain all the resources that will be used by this context
         List<LinkedDesc> aliased_descs;
 
         for (uint32_t current_graph_id = 0; current_graph_id < m_GraphDescriptions.size(); ++current_graph_id)
         {
-            RenderGraphSize biggest_size = m_GraphSizes[current_graph_id][0];
+            const RenderGraphSize& biggest_size = biggest_sizes[current_graph_id];
 
-            // Create a one fits all sizes
-            for (uint32_t i = 1; i < m_GraphSizes[current_graph_id].size(); ++i)
+            if (biggest_size.size.x <= 0.0f || biggest_size.size.y <= 0.0f)
             {
-                const RenderGraphSize& current_size = m_GraphSizes[current_graph_id][i];
-
-                biggest_size.size.x = Math::Max(biggest_size.size.x, current_size.size.x);
-                biggest_size.size.y = Math::Max(biggest_size.size.y, current_size.size.y);
-
-                biggest_size.uiSize.x = Math::Max(biggest_size.uiSize.x, current_size.uiSize.x);
-                biggest_size.uiSize.y = Math::Max(biggest_size.uiSize.y, current_size.uiSize.y);
-
-                biggest_size.upscaledSize.x = Math::Max(biggest_size.upscaledSize.x, current_size.upscaledSize.x);
-                biggest_size.upscaledSize.y = Math::Max(biggest_size.upscaledSize.y, current_size.upscaledSize.y);
+                // Graph is not used this frame
+                continue;
             }
 
             for (const ResourceID& current_id : m_GraphDescriptions[current_graph_id])
@@ -156,6 +184,13 @@ namespace RB::Graphics
             }
         }
 
+        // Give the current resources back to the pool first, so they can be picked up again when they still fit
+        List<Texture2D*> previous_resources = m_Resources;
+        uint32_t previous_version           = m_Version;
+        bool descriptions_changed           = m_DescriptionsDirty;
+
+        ReleaseGraphResources();
+
         // Initialize the resource pointers
         size_t size = sizeof(uint32_t) * m_Descriptions.size();
         m_ResourcePointers = (uint32_t*) ALLOC_HEAP(size);
@@ -164,20 +199,18 @@ namespace RB::Graphics
         m_Resources.reserve(aliased_descs.size());
         m_Clears.reserve(aliased_descs.size());
 
-        // Actually create the resources
         for (uint32_t i = 0; i < aliased_descs.size(); ++i)
         {
             const LinkedDesc& aliased_desc = aliased_descs[i];
 
-            std::string name = "GraphResouce " + std::to_string(i);
-
-            m_Resources.push_back(Texture2D::Create(name.c_str(),
-                                                    aliased_desc.desc.format, 
-                                                    aliased_desc.desc.width, 
-                                                    aliased_desc.desc.height, 
-                                                    aliased_desc.desc.HasFlag(kRTFlag_AllowRenderTarget),
-                                                    aliased_desc.desc.HasFlag(kRTFlag_AllowRandomReadWrites)));
+            PooledTextureDesc pooled_desc = {};
+            pooled_desc.format          = aliased_desc.desc.format;
+            pooled_desc.width           = aliased_desc.desc.width;
+            pooled_desc.height          = aliased_desc.desc.height;
+            pooled_desc.renderTarget    = aliased_desc.desc.HasFlag(kRTFlag_AllowRenderTarget);
+            pooled_desc.randomReadWrite = aliased_desc.desc.HasFlag(kRTFlag_AllowRandomReadWrites);
 
+            m_Resources.push_back(m_TexturePool.Acquire(pooled_desc));
             m_Clears.push_back(aliased_desc.desc.HasFlag(kRTFlag_ClearBeforeGraph));
 
             // Make sure that the ResourceID's point to the correct resource in the m_Resources list
@@ -189,24 +222,38 @@ namespace RB::Graphics
                 m_ResourcePointers[current_id] = pointer_id;
             }
         }
+
+        m_ResourceSizes     = biggest_sizes;
+        m_DescriptionsDirty = false;
+
+        // Only invalidate the compiled graph plans when the resources actually changed
+        if (!descriptions_changed && previous_resources == m_Resources)
+        {
+            m_Version = previous_version;
+        }
     }
 
-    void RenderGraphContext::DeleteGraphResources()
+    void RenderGraphContext::ReleaseGraphResources()
     {
-        for (RenderResource* res : m_Resources)
+        for (Texture2D* res : m_Resources)
         {
-            delete res;
+            m_TexturePool.Release(res);
         }
 
         m_Resources.clear();
         m_Clears.clear();
         SAFE_FREE(m_ResourcePointers);
+
+        m_Version++;
     }
 
     void RenderGraphContext::DeleteGraphResourceDescriptions()
     {
+        ReleaseGraphResources();
+
         m_Descriptions.clear();
         m_GraphDescriptions.clear();
+        m_DescriptionsDirty = true;
     }
 
     ResourceID RenderGraphContext::ScheduleNewResource(const RenderTextureDesc& desc, uint32_t current_graph_id)
@@ -217,6 +264,7 @@ namespace RB::Graphics
         }
 
         m_Descriptions.push_back(desc);
+        m_DescriptionsDirty = true;
 
         ResourceID new_id = m_Descriptions.size() - 1;
 
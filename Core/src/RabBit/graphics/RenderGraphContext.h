@@ -1,6 +1,7 @@
 #pragma once
 
 #include "RenderPass.h"
+#include "RenderTexturePool.h"
 
 namespace RB::Graphics
 {
@@ -28,10 +29,18 @@ namespace RB::Graphics
         void AddGraphSize(uint32_t graph_id, const RenderGraphSize& size);
         void DeleteSizes();
 
-        void CreateGraphResources();
-        void DeleteGraphResources();
+        // Makes sure the graph resources fit the registered sizes. Resources are taken from (and given back to) a pool,
+        // so a resize or a change in the amount of views does not have to wait on the GPU. Should be called every frame.
+        void UpdateGraphResources(uint64_t frame_index);
+        // Gives all the graph resources back to the pool
+        void ReleaseGraphResources();
         void DeleteGraphResourceDescriptions();
 
+        // Changes every time the graph resources are (re)assigned
+        uint32_t GetVersion() const { return m_Version; }
+
+        const RenderTexturePool& GetTexturePool() const { return m_TexturePool; }
+
         // Returns a new ResourceID or returns one that was already
         // created for a different RenderGraph and can be aliased.
         ResourceID ScheduleNewResource(const RenderTextureDesc& desc, uint32_t graph_id);
@@ -40,17 +49,27 @@ namespace RB::Graphics
         List<ResourceID> GetScheduledGraphResources(uint32_t graph_id);
 
     private:
+        void CalculateBiggestSizes(List<RenderGraphSize>& out_sizes) const;
+
         // All the resources used by all graphs
-        List<RenderResource*>       m_Resources;
+        List<Texture2D*>            m_Resources;
         List<bool>                  m_Clears;
         // Points to the actual resources in the list above
-        uint32_t*                   m_ResourcePointers;
+        uint32_t*                   m_ResourcePointers = nullptr;
         
         // The rendertexture sizes for each graph
         List<List<RenderGraphSize>> m_GraphSizes;
+        // The sizes (per graph) the current resources were assigned with
+        List<RenderGraphSize>       m_ResourceSizes;
+        // Set when the descriptions changed, the resources have to be reassigned
+        bool                        m_DescriptionsDirty = true;
         // The scheduled resources for all graphs
         List<RenderTextureDesc>     m_Descriptions;
         // All the resources stored with the graph they are used in
         List<List<ResourceID>>      m_GraphDescriptions;
+
+        uint32_t                    m_Version = 0;
+
+        RenderTexturePool           m_TexturePool;
     };
 }
\ No newline at end of file
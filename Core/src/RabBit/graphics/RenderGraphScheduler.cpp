@@ -0,0 +1,69 @@
+#include "RabBitCommon.h"
+#include "RenderGraphScheduler.h"
+
+namespace RB::Graphics
+{
+    static bool Contains(const List<ResourceID>& ids, ResourceID id)
+    {
+        return std::find(ids.begin(), ids.end(), id) != ids.end();
+    }
+
+    static bool HasHazard(const PassScheduleDesc& earlier, const PassScheduleDesc& later)
+    {
+        for (const ResourceID& id : later.reads)
+        {
+            // Read after write
+            if (Contains(earlier.writes, id))
+                return true;
+        }
+
+        for (const ResourceID& id : later.writes)
+        {
+            // Write after read & write after write
+            if (Contains(earlier.reads, id) || Contains(earlier.writes, id))
+                return true;
+        }
+
+        return false;
+    }
+
+    void BuildQueueSchedule(const List<PassScheduleDesc>& passes, List<ScheduledPass>& out_schedule)
+    {
+        out_schedule.clear();
+        out_schedule.resize(passes.size());
+
+        // The last pass of the other queue that each queue already waited on
+        int32_t waited_on[2] = { -1, -1 };
+
+        for (int32_t i = 0; i < passes.size(); ++i)
+        {
+            bool last_pass = (i == passes.size() - 1);
+
+            ScheduledPass& scheduled = out_schedule[i];
+            scheduled.queue       = (passes[i].asyncComputeCompatible && !last_pass) ? RenderQueueType::Compute : RenderQueueType::Graphics;
+            scheduled.waitForPass = -1;
+            scheduled.signal      = false;
+
+            // Find the latest pass on the other queue this pass depends on
+            int32_t dependency = -1;
+            for (int32_t j = i - 1; j > waited_on[(uint32_t)scheduled.queue]; --j)
+            {
+                if (out_schedule[j].queue != scheduled.queue && HasHazard(passes[j], passes[i]))
+                {
+                    dependency = j;
+                    break;
+                }
+            }
+
+            if (dependency == -1)
+            {
+                continue;
+            }
+
+            // The queues execute in order, so waiting on this pass also covers all earlier passes of that queue
+            scheduled.waitForPass = dependency;
+            out_schedule[dependency].signal = true;
+            waited_on[(uint32_t)scheduled.queue] = dependency;
+        }
+    }
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "RenderGraphContext.h"
+
+namespace RB::Graphics
+{
+    enum class RenderQueueType
+    {
+        Graphics,
+        Compute
+    };
+
+    // The resources a pass touches, used to find the dependencies between passes
+    struct PassScheduleDesc
+    {
+        bool                asyncComputeCompatible;
+        List<ResourceID>    reads;
+        List<ResourceID>    writes;
+    };
+
+    struct ScheduledPass
+    {
+        RenderQueueType     queue;
+        int32_t             waitForPass;    // Pass on the other queue that has to be finished before this pass can start, -1 when not needed
+        bool                signal;         // A pass on the other queue waits on this pass
+    };
+
+    // Assigns the passes (in execution order) to either the graphics or the compute queue. The order on each queue stays the same as the
+    // given order. A cross-queue wait is only inserted at a real dependency edge (read after write, write after read or write after write) 
+    // that is not already covered by an earlier wait of the same queue. The last pass always stays on the graphics queue, as its output
+    // is consumed outside of the graph.
+    void BuildQueueSchedule(const List<PassScheduleDesc>& passes, List<ScheduledPass>& out_schedule);
+}
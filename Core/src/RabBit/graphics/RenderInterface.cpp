@@ -4,6 +4,8 @@
 
 #include "d3d12/RenderInterfaceD3D12.h"
 
+#include "utils/debug/Stats.h"
+
 namespace RB::Graphics
 {
     Shared<GpuGuard> RenderInterface::ExecuteOnGpu()
@@ -19,6 +21,8 @@ namespace RB::Graphics
 
     void RenderInterface::Draw()
     {
+        RB_STAT_ADD(DrawCalls, 1);
+
         m_TotalDraws++;
         DrawInternal();
 
@@ -28,8 +32,23 @@ namespace RB::Graphics
         }
     }
 
+    void RenderInterface::DrawRange(uint32_t element_count, uint32_t start_element, int32_t base_vertex)
+    {
+        RB_STAT_ADD(DrawCalls, 1);
+
+        m_TotalDraws++;
+        DrawRangeInternal(element_count, start_element, base_vertex);
+
+        if (NeedsIntermediateExecute())
+        {
+            ExecuteOnGpu();
+        }
+    }
+
     void RenderInterface::Dispatch(uint32_t thread_groups_x, uint32_t thread_groups_y, uint32_t thread_groups_z)
     {
+        RB_STAT_ADD(Dispatches, 1);
+
         m_TotalDraws++;
         DispatchInternal(thread_groups_x, thread_groups_y, thread_groups_z);
 
@@ -49,12 +68,12 @@ namespace RB::Graphics
         Clear(resource, Math::Float4(reversed_depth ? 0 : 1, 0, 0, 0));
     }
 
-    RenderInterface* RenderInterface::Create(bool allow_only_copy_operations)
+    RenderInterface* RenderInterface::Create(RenderInterfaceType type)
     {
         switch (Renderer::GetAPI())
         {
         case RenderAPI::D3D12:
-            return new D3D12::RenderInterfaceD3D12(allow_only_copy_operations);
+            return new D3D12::RenderInterfaceD3D12(type);
         default:
             RB_LOG_CRITICAL(LOGTAG_GRAPHICS, "Did not yet implement the render interface for the set graphics API");
             break;
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "View.h"
+#include "UploadRing.h"
+#include "GpuProfiler.h"
 
 namespace RB::Math
 {
@@ -9,8 +11,8 @@ namespace RB::Math
 
 namespace RB::Graphics
 {
-    // GPU markers
-#ifdef RB_ENABLE_LOGS
+    // GPU markers, also measured with timestamp queries when profiling is enabled
+#if defined(RB_ENABLE_LOGS) || defined(RB_ENABLE_PROFILING)
     #define RB_PROFILE_GPU_SCOPED(render_interface, name)				ProfileGpuScoped rb_profile_gpu_scoped(render_interface, 0, name);
     #define RB_PROFILE_GPU_SCOPED_COLOR(render_interface, name, color)	ProfileGpuScoped rb_profile_gpu_scoped(render_interface, color, name);
 #else
@@ -44,6 +46,13 @@ namespace RB::Graphics
         PassCloser,
     };
 
+    enum class RenderInterfaceType
+    {
+        Graphics,
+        Compute,    // Only allows compute & copy operations, executes on the async compute queue
+        Copy        // Only allows copy operations
+    };
+
     class GpuGuard
     {
     public:
@@ -69,6 +78,9 @@ namespace RB::Graphics
 
         // You should normally not have to manually transition resources, this will be done automatically
         virtual void TransitionResource(RenderResource* resource, ResourceState state) = 0;
+        // Split transitions, begin the transition as early as possible and end it right before the resource gets used
+        virtual void BeginTransitionResource(RenderResource* resource, ResourceState state) = 0;
+        virtual void EndTransitionResource(RenderResource* resource) = 0;
         virtual void FlushResourceBarriers() = 0;
         // Flushes all possible pending things, also resource barriers
         virtual void FlushAllPending() = 0;
@@ -105,13 +117,22 @@ namespace RB::Graphics
         virtual void UploadDataToResource(RenderResource* resource, void* data, uint64_t data_size) = 0;
         virtual void CopyResource(RenderResource* src, RenderResource* dest) = 0;
 
+        // Usage of the upload memory (constant data and resource uploads) of this interface
+        virtual UploadRingStats GetUploadStats() const = 0;
+
         void Draw();
+        // Draws a part of the bound index buffer (or vertex buffer when no index buffer is bound), for geometry that shares its buffers
+        // with other geometry (e.g. the GeometryPool). The base vertex is added to every index.
+        void DrawRange(uint32_t element_count, uint32_t start_element, int32_t base_vertex = 0);
         void Dispatch(uint32_t thread_groups_x, uint32_t thread_groups_y, uint32_t thread_groups_z);
 
         virtual void ProfileMarkerBegin(uint64_t color, const char* name) = 0;
         virtual void ProfileMarkerEnd() = 0;
 
-        static RenderInterface* Create(bool allow_only_copy_operations);
+        // nullptr when the interface does not measure its GPU zones (e.g. copy interfaces, or profiling is disabled)
+        GpuProfiler* GetGpuProfiler() const { return m_GpuProfiler; }
+
+        static RenderInterface* Create(RenderInterfaceType type);
 
     protected:
         RenderInterface() = default;
@@ -120,24 +141,45 @@ namespace RB::Graphics
 
         virtual Shared<GpuGuard> ExecuteInternal() = 0;
         virtual void DrawInternal() = 0;
+        virtual void DrawRangeInternal(uint32_t element_count, uint32_t start_element, int32_t base_vertex) = 0;
         virtual void DispatchInternal(uint32_t thread_groups_x, uint32_t thread_groups_y, uint32_t thread_groups_z) = 0;
 
         uint32_t m_TotalDraws = 0;
+        GpuProfiler* m_GpuProfiler = nullptr;
     };
 
-#ifdef RB_ENABLE_LOGS
+#if defined(RB_ENABLE_LOGS) || defined(RB_ENABLE_PROFILING)
     class ProfileGpuScoped
     {
     public:
         ProfileGpuScoped(RenderInterface* i, uint64_t color, const char* name)
         {
             m_Interface = i;
+
+#ifdef RB_ENABLE_LOGS
             m_Interface->ProfileMarkerBegin(color, name);
+#endif
+
+#ifdef RB_ENABLE_PROFILING
+            if (GpuProfiler* profiler = m_Interface->GetGpuProfiler())
+            {
+                profiler->BeginZone(name);
+            }
+#endif
         }
 
         ~ProfileGpuScoped()
         {
+#ifdef RB_ENABLE_PROFILING
+            if (GpuProfiler* profiler = m_Interface->GetGpuProfiler())
+            {
+                profiler->EndZone();
+            }
+#endif
+
+#ifdef RB_ENABLE_LOGS
             m_Interface->ProfileMarkerEnd();
+#endif
         }
 
     private:
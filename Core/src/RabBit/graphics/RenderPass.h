@@ -39,7 +39,8 @@ namespace RB::Graphics
         kRTFlag_AllowRenderTarget           = (1 << 3), // Will not be used as a RenderTarget?
         kRTFlag_AllowRandomReadWrites       = (1 << 4), // Is UAV allowed?
         kRTFlag_DenyAliasing                = (1 << 5), // Makes sure this resource is not shared between passes (likely contains history data)
-        kRTFlag_ClearBeforeGraph            = (1 << 6)  // Clears the resource to 0 before it enters the first RenderPass
+        kRTFlag_ClearBeforeGraph            = (1 << 6), // Clears the resource to 0 before it enters the first RenderPass
+        kRTFlag_FullyOverwritten            = (1 << 7)  // The pass writes every texel of this output, a ClearBeforeGraph is skipped when this pass is the first to touch it
     };
 
     struct RenderTextureDesc
@@ -96,7 +97,7 @@ namespace RB::Graphics
         uint32_t                totalWorkingTextures;
         RenderTextureDesc	    outputTextures[MAX_INOUT_RESOURCES_PER_RENDERPASS]; // Maybe it should be possible to not only output rendertextures, but also buffers?
         uint32_t                totalOutputTextures;
-        bool                    asyncComputeCompatible  = false; // TODO Still unused
+        bool                    asyncComputeCompatible  = false; // Allows the RenderGraph to schedule the pass on the async compute queue
     };
 
     // Make sure to do all your deletes and free's in the destructor!
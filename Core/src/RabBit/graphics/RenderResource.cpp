@@ -3,6 +3,8 @@
 #include "Renderer.h"
 #include "d3d12/resource/RenderResourceD3D12.h"
 
+#include "utils/debug/MemoryTracker.h"
+
 namespace RB::Graphics
 {
     uint32_t GetElementSizeFromFormat(const RenderResourceFormat& format)
@@ -79,6 +81,31 @@ namespace RB::Graphics
         return (float)GetWidth() / (float)GetHeight();
     }
 
+    bool IsValidResidencyTransition(ResidencyState from, ResidencyState to)
+    {
+        switch (from)
+        {
+        case ResidencyState::Resident:  return to == ResidencyState::Pending || to == ResidencyState::Evicting;
+        case ResidencyState::Pending:   return to == ResidencyState::Uploading;
+        case ResidencyState::Uploading: return to == ResidencyState::Resident;
+        case ResidencyState::Evicting:  return false;
+        default:                        return false;
+        }
+    }
+
+    bool RenderResource::IsStreaming() const
+    {
+        ResidencyState state = GetResidencyState();
+        return state == ResidencyState::Pending || state == ResidencyState::Uploading;
+    }
+
+    bool RenderResource::TransitionResidency(ResidencyState from, ResidencyState to)
+    {
+        RB_ASSERT(LOGTAG_GRAPHICS, IsValidResidencyTransition(from, to), "Invalid residency transition of resource \"%s\"", GetName());
+
+        return m_ResidencyState.compare_exchange_strong(from, to, std::memory_order_acq_rel, std::memory_order_acquire);
+    }
+
     RenderResourceType RenderResource::GetPrimitiveType() const
     {
         uint32_t last_primitive = (uint32_t)RenderResourceType::kLastPrimitiveType;
@@ -89,12 +116,40 @@ namespace RB::Graphics
         return (RenderResourceType)primitive_type;
     }
 
-    VertexBuffer* VertexBuffer::Create(const char* name, const TopologyType& type, void* data, uint32_t vertex_size, uint64_t data_size)
+    VertexBuffer* VertexBuffer::Create(const char* name, const TopologyType& type, void* data, uint32_t vertex_size, uint64_t data_size, StreamDataMode data_mode)
+    {
+        switch (Renderer::GetAPI())
+        {
+        case RenderAPI::D3D12:
+            return new D3D12::VertexBufferD3D12(name, type, data, vertex_size, data_size, data_mode);
+        default:
+            RB_LOG_CRITICAL(LOGTAG_GRAPHICS, "Not yet implemented");
+            break;
+        }
+
+        return nullptr;
+    }
+
+    VertexBuffer* VertexBuffer::CreateRange(const char* name, VertexBuffer* buffer, uint64_t offset, void* data, uint64_t data_size, StreamDataMode data_mode)
+    {
+        switch (Renderer::GetAPI())
+        {
+        case RenderAPI::D3D12:
+            return new D3D12::VertexBufferD3D12(name, (D3D12::VertexBufferD3D12*)buffer, offset, data, data_size, data_mode);
+        default:
+            RB_LOG_CRITICAL(LOGTAG_GRAPHICS, "Not yet implemented");
+            break;
+        }
+
+        return nullptr;
+    }
+
+    IndexBuffer* IndexBuffer::Create(const char* name, uint32_t* data, uint64_t data_size, StreamDataMode data_mode)
     {
         switch (Renderer::GetAPI())
         {
         case RenderAPI::D3D12:
-            return new D3D12::VertexBufferD3D12(name, type, data, vertex_size, data_size);
+            return new D3D12::IndexBufferD3D12(name, data, data_size, data_mode);
         default:
             RB_LOG_CRITICAL(LOGTAG_GRAPHICS, "Not yet implemented");
             break;
@@ -103,12 +158,12 @@ namespace RB::Graphics
         return nullptr;
     }
 
-    IndexBuffer* IndexBuffer::Create(const char* name, uint32_t* data, uint64_t data_size)
+    IndexBuffer* IndexBuffer::CreateRange(const char* name, IndexBuffer* buffer, uint64_t offset, uint32_t* data, uint64_t data_size, StreamDataMode data_mode)
     {
         switch (Renderer::GetAPI())
         {
         case RenderAPI::D3D12:
-            return new D3D12::IndexBufferD3D12(name, data, data_size);
+            return new D3D12::IndexBufferD3D12(name, (D3D12::IndexBufferD3D12*)buffer, offset, data, data_size, data_mode);
         default:
             RB_LOG_CRITICAL(LOGTAG_GRAPHICS, "Not yet implemented");
             break;
@@ -119,10 +174,12 @@ namespace RB::Graphics
 
     Texture2D* Texture2D::Create(const char* name, RenderResourceFormat format, uint32_t width, uint32_t height, bool is_render_target, bool random_read_write_access, TextureColorSpace color_space)
     {
+        RB_MEMORY_TAG(Graphics);
+
         switch (Renderer::GetAPI())
         {
         case RenderAPI::D3D12:
-            return new D3D12::Texture2DD3D12(name, format, width, height, is_render_target, random_read_write_access, color_space);
+            return new D3D12::Texture2DD3D12(name, format, width, height, is_render_target, random_read_write_access, color_space, 1);
         default:
             RB_LOG_CRITICAL(LOGTAG_GRAPHICS, "Not yet implemented");
             break;
@@ -131,12 +188,14 @@ namespace RB::Graphics
         return nullptr;
     }
 
-    Texture2D* Texture2D::Create(const char* name, void* data, uint64_t data_size, RenderResourceFormat format, uint32_t width, uint32_t height, bool is_render_target, bool random_read_write_access, TextureColorSpace color_space)
+    Texture2D* Texture2D::Create(const char* name, void* data, uint64_t data_size, RenderResourceFormat format, uint32_t width, uint32_t height, bool is_render_target, bool random_read_write_access, TextureColorSpace color_space, StreamDataMode data_mode, uint32_t mip_levels)
     {
+        RB_MEMORY_TAG(Graphics);
+
         switch (Renderer::GetAPI())
         {
         case RenderAPI::D3D12:
-            return new D3D12::Texture2DD3D12(name, data, data_size, format, width, height, is_render_target, random_read_write_access, color_space);
+            return new D3D12::Texture2DD3D12(name, data, data_size, format, width, height, is_render_target, random_read_write_access, color_space, data_mode, mip_levels);
         default:
             RB_LOG_CRITICAL(LOGTAG_GRAPHICS, "Not yet implemented");
             break;
@@ -147,6 +206,8 @@ namespace RB::Graphics
 
     Texture2D* Texture2D::Create(const char* name, void* internal_resource, RenderResourceFormat format, uint32_t width, uint32_t height, bool is_render_target, bool random_read_write_access, TextureColorSpace color_space)
     {
+        RB_MEMORY_TAG(Graphics);
+
         switch (Renderer::GetAPI())
         {
         case RenderAPI::D3D12:
@@ -70,6 +70,28 @@ namespace RB::Graphics
         Texture2D           = (1 << 5) | Texture
     };
 
+    // The native resources are created asynchronously, a resource can only be used by the GPU once it is created
+    enum class CreationState : uint32_t
+    {
+        Scheduled,
+        Created,
+        Failed
+    };
+
+    // Where the data of a resource is in its lifetime. Resources without initial data are resident from the start.
+    //
+    //   Resident -> Pending -> Uploading -> Resident -> Evicting
+    //
+    enum class ResidencyState : uint32_t
+    {
+        Resident,   // Can be used by the GPU
+        Pending,    // Scheduled for streaming, waiting in the queue of the ResourceStreamer
+        Uploading,  // The upload is recorded on the copy queue, but the GPU is not done with it yet
+        Evicting    // Replaced or about to be deleted, new work should not start using it anymore
+    };
+
+    bool IsValidResidencyTransition(ResidencyState from, ResidencyState to);
+
     class RenderResource
     {
     public:
@@ -81,24 +103,44 @@ namespace RB::Graphics
 
         virtual RenderResourceFormat GetFormat() const = 0;
 
-        bool ReadyToRender() const { return m_IsStreaming; } // TODO Make this thread safe
-        void SetStreaming(bool is_streaming) { m_IsStreaming = is_streaming; } // TODO Make this thread safe
+        // Can be polled from any thread, never waits on the creation
+        virtual CreationState GetCreationState() const { return CreationState::Created; }
+        bool IsCreated() const { return GetCreationState() == CreationState::Created; }
+
+        // The state is written by the streaming and main threads and read by all threads, a resource that is read as resident
+        // also has all of its uploaded data visible (acquire/release).
+        ResidencyState GetResidencyState() const { return m_ResidencyState.load(std::memory_order_acquire); }
+        bool ReadyToRender() const { return GetResidencyState() == ResidencyState::Resident && IsCreated(); }
+        bool IsStreaming() const;
+
+        // Only changes the state when it is still in the expected state, returns false when another thread changed it first
+        bool TransitionResidency(ResidencyState from, ResidencyState to);
 
         RenderResourceType GetType() const { return m_Type; }
         RenderResourceType GetPrimitiveType() const;
 
     protected:
-        RenderResource(RenderResourceType type) : m_Type(type), m_IsStreaming(false) {}
+        RenderResource(RenderResourceType type) : m_Type(type), m_ResidencyState(ResidencyState::Resident) {}
 
-        RenderResourceType	m_Type;
-        bool				m_IsStreaming;
+        RenderResourceType	        m_Type;
+        std::atomic<ResidencyState>	m_ResidencyState;
     };
 
+    // Returns the resource when it can be used by the GPU, otherwise the fallback (use nullptr to skip the resource)
+    template<typename T>
+    inline T* ResidentOr(T* resource, T* fallback)
+    {
+        return (resource != nullptr && resource->ReadyToRender()) ? resource : fallback;
+    }
+
     class Buffer : public RenderResource
     {
     public:
         virtual ~Buffer() = default;
 
+        // Offset (in bytes) of the buffer in its native resource, buffers can be a part of a bigger buffer (e.g. the GeometryPool)
+        virtual uint64_t GetOffset() const { return 0; }
+
     protected:
         Buffer(RenderResourceType type) : RenderResource(type) {}
     };
@@ -108,6 +150,13 @@ namespace RB::Graphics
 
     };
 
+    // How the initial data of a resource is handed over to the ResourceStreamer
+    enum class StreamDataMode
+    {
+        Copy,           // The data is copied, the caller keeps ownership of its memory
+        TakeOwnership   // The streamer frees the data (with FREE) after the upload, the memory should be allocated with ALLOC_HEAP
+    };
+
     enum class TopologyType
     {
         TriangleList,
@@ -124,7 +173,10 @@ namespace RB::Graphics
         virtual uint32_t GetVertexElementCount() const = 0;
         virtual TopologyType GetTopologyType() const = 0;
 
-        static VertexBuffer* Create(const char* name, const TopologyType& type, void* data, uint32_t vertex_size, uint64_t data_size);
+        // Without data the buffer is only created, its contents can then be uploaded per range
+        static VertexBuffer* Create(const char* name, const TopologyType& type, void* data, uint32_t vertex_size, uint64_t data_size, StreamDataMode data_mode = StreamDataMode::Copy);
+        // A vertex buffer that lives in a part of another vertex buffer, with the same vertex size and topology type. The data is streamed into that part.
+        static VertexBuffer* CreateRange(const char* name, VertexBuffer* buffer, uint64_t offset, void* data, uint64_t data_size, StreamDataMode data_mode = StreamDataMode::Copy);
 
     protected:
         VertexBuffer() : Buffer(RenderResourceType::VertexBuffer) {}
@@ -139,7 +191,10 @@ namespace RB::Graphics
 
         virtual uint64_t GetIndexCount() const = 0;
 
-        static IndexBuffer* Create(const char* name, uint32_t* data, uint64_t data_size);
+        // Without data the buffer is only created, its contents can then be uploaded per range
+        static IndexBuffer* Create(const char* name, uint32_t* data, uint64_t data_size, StreamDataMode data_mode = StreamDataMode::Copy);
+        // An index buffer that lives in a part of another index buffer. The data is streamed into that part.
+        static IndexBuffer* CreateRange(const char* name, IndexBuffer* buffer, uint64_t offset, uint32_t* data, uint64_t data_size, StreamDataMode data_mode = StreamDataMode::Copy);
 
     protected:
         IndexBuffer() : Buffer(RenderResourceType::IndexBuffer) {}
@@ -151,7 +206,7 @@ namespace RB::Graphics
         sRGB
     };
 
-    #define MAX_TEXTURE_SUBRESOURCE_COUNT 8
+    #define MAX_TEXTURE_SUBRESOURCE_COUNT 16
 
     class Texture : public RenderResource
     {
@@ -180,10 +235,12 @@ namespace RB::Graphics
 
         virtual uint32_t GetWidth() const = 0;
         virtual uint32_t GetHeight() const = 0;
+        virtual uint32_t GetMipLevels() const = 0;
         float	         GetAspectRatio() const;
 
         static Texture2D* Create(const char* name, RenderResourceFormat format, uint32_t width, uint32_t height, bool is_render_target, bool random_read_write_access, TextureColorSpace color_space = TextureColorSpace::Linear);
-        static Texture2D* Create(const char* name, void* data, uint64_t data_size, RenderResourceFormat format, uint32_t width, uint32_t height, bool is_render_target, bool random_read_write_access, TextureColorSpace color_space = TextureColorSpace::Linear);
+        // The data contains all the mips tightly packed, from fine to coarse
+        static Texture2D* Create(const char* name, void* data, uint64_t data_size, RenderResourceFormat format, uint32_t width, uint32_t height, bool is_render_target, bool random_read_write_access, TextureColorSpace color_space = TextureColorSpace::Linear, StreamDataMode data_mode = StreamDataMode::Copy, uint32_t mip_levels = 1);
         static Texture2D* Create(const char* name, void* internal_resource, RenderResourceFormat format, uint32_t width, uint32_t height, bool is_render_target, bool random_read_write_access, TextureColorSpace color_space = TextureColorSpace::Linear);
 
     protected:
@@ -0,0 +1,157 @@
+#include "RabBitCommon.h"
+#include "RenderTexturePool.h"
+
+namespace RB::Graphics
+{
+    uint32_t GetBucketedTextureSize(uint32_t size)
+    {
+        if (size == 0)
+        {
+            return kRenderTexturePoolBucketSize;
+        }
+
+        return ((size + kRenderTexturePoolBucketSize - 1) / kRenderTexturePoolBucketSize) * kRenderTexturePoolBucketSize;
+    }
+
+    bool IsPooledTextureReusable(const PooledTextureDesc& pooled, const PooledTextureDesc& requested)
+    {
+        if (pooled.format != requested.format ||
+            pooled.renderTarget != requested.renderTarget ||
+            pooled.randomReadWrite != requested.randomReadWrite)
+        {
+            return false;
+        }
+
+        if (pooled.width < requested.width || pooled.height < requested.height)
+        {
+            return false;
+        }
+
+        // Do not keep using a texture that is way too big (e.g. after making the window a lot smaller)
+        uint64_t pooled_area = (uint64_t)pooled.width * pooled.height;
+        uint64_t bucket_area = (uint64_t)GetBucketedTextureSize(requested.width) * GetBucketedTextureSize(requested.height);
+
+        return pooled_area <= bucket_area * kRenderTexturePoolMaxWaste;
+    }
+
+    RenderTexturePool::~RenderTexturePool()
+    {
+        Clear();
+    }
+
+    Texture2D* RenderTexturePool::Acquire(const PooledTextureDesc& desc)
+    {
+        int32_t best_index = -1;
+        uint64_t best_area = UINT64_MAX;
+
+        for (uint32_t i = 0; i < m_Entries.size(); ++i)
+        {
+            const Entry& entry = m_Entries[i];
+
+            if (entry.inUse || !IsPooledTextureReusable(entry.desc, desc))
+            {
+                continue;
+            }
+
+            uint64_t area = (uint64_t)entry.desc.width * entry.desc.height;
+
+            if (area < best_area)
+            {
+                best_index = i;
+                best_area = area;
+            }
+        }
+
+        if (best_index != -1)
+        {
+            m_Entries[best_index].inUse = true;
+            m_Entries[best_index].lastUsedFrame = m_FrameIndex;
+            return m_Entries[best_index].texture;
+        }
+
+        // Nothing to reuse, create a new texture with bucketed sizes
+        Entry entry = {};
+        entry.desc          = desc;
+        entry.desc.width    = GetBucketedTextureSize(desc.width);
+        entry.desc.height   = GetBucketedTextureSize(desc.height);
+        entry.inUse         = true;
+        entry.lastUsedFrame = m_FrameIndex;
+
+        std::string name = "GraphResource " + std::to_string(m_CreatedCount++);
+
+        entry.texture = Texture2D::Create(name.c_str(),
+                                          entry.desc.format,
+                                          entry.desc.width,
+                                          entry.desc.height,
+                                          entry.desc.renderTarget,
+                                          entry.desc.randomReadWrite);
+
+        m_Entries.push_back(entry);
+
+        return entry.texture;
+    }
+
+    void RenderTexturePool::Release(Texture2D* texture)
+    {
+        for (Entry& entry : m_Entries)
+        {
+            if (entry.texture == texture)
+            {
+                RB_ASSERT(LOGTAG_GRAPHICS, entry.inUse, "Releasing a texture to the pool that was not in use");
+
+                entry.inUse = false;
+                entry.lastUsedFrame = m_FrameIndex;
+                return;
+            }
+        }
+
+        RB_ASSERT_ALWAYS(LOGTAG_GRAPHICS, "Trying to release a texture that is not owned by the RenderTexturePool");
+    }
+
+    void RenderTexturePool::Update(uint64_t frame_index)
+    {
+        m_FrameIndex = frame_index;
+
+        for (int32_t i = m_Entries.size() - 1; i >= 0; --i)
+        {
+            Entry& entry = m_Entries[i];
+
+            if (entry.inUse || (m_FrameIndex - entry.lastUsedFrame) < kRenderTexturePoolEvictFrames)
+            {
+                continue;
+            }
+
+            // Deleting is safe while the GPU might still use it, the actual resource is kept alive until the GPU is done with it
+            delete entry.texture;
+
+            m_Entries[i] = m_Entries.back();
+            m_Entries.pop_back();
+        }
+    }
+
+    void RenderTexturePool::Clear()
+    {
+        for (Entry& entry : m_Entries)
+        {
+            RB_ASSERT(LOGTAG_GRAPHICS, !entry.inUse, "Clearing the RenderTexturePool while textures are still in use");
+            delete entry.texture;
+        }
+
+        m_Entries.clear();
+    }
+
+    uint32_t RenderTexturePool::GetFreeTextureCount() const
+    {
+        uint32_t count = 0;
+
+        for (const Entry& entry : m_Entries)
+        {
+            if (!entry.inUse)
+            {
+                count++;
+            }
+        }
+
+        return count;
+    }
+}
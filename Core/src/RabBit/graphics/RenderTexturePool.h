@@ -0,0 +1,62 @@
+#pragma once
+
+#include "RenderResource.h"
+
+namespace RB::Graphics
+{
+    // Graph textures are allocated in steps of this size, so small resizes keep landing in the same bucket
+    constexpr uint32_t kRenderTexturePoolBucketSize     = 64;
+    // A pooled texture is only reused when it is at most this many times bigger (in area) than the requested bucket
+    constexpr uint32_t kRenderTexturePoolMaxWaste       = 2;
+    // Textures that have not been used for this many frames are released back to the GPU
+    constexpr uint32_t kRenderTexturePoolEvictFrames    = 120;
+
+    struct PooledTextureDesc
+    {
+        RenderResourceFormat    format;
+        uint32_t                width;
+        uint32_t                height;
+        bool                    renderTarget;
+        bool                    randomReadWrite;
+    };
+
+    // Rounds the size up to the next bucket
+    uint32_t GetBucketedTextureSize(uint32_t size);
+
+    // Returns true when a pooled texture can be used for the requested description. The texture may be bigger than requested,
+    // passes should therefore always use the viewport of the ViewContext instead of the size of the texture.
+    bool IsPooledTextureReusable(const PooledTextureDesc& pooled, const PooledTextureDesc& requested);
+
+    // Keeps the textures of the RenderGraphContext alive when they are not used anymore, so they can be reused when
+    // the sizes or amount of views change instead of waiting on the GPU and recreating all the resources.
+    class RenderTexturePool
+    {
+    public:
+        RenderTexturePool() = default;
+        ~RenderTexturePool();
+
+        // Returns the smallest free texture that fits the description, or creates a new one with bucketed sizes
+        Texture2D* Acquire(const PooledTextureDesc& desc);
+        void       Release(Texture2D* texture);
+
+        // Deletes the textures that have not been used for a while, should be called once per frame
+        void Update(uint64_t frame_index);
+        void Clear();
+
+        uint32_t GetTotalTextureCount() const { return m_Entries.size(); }
+        uint32_t GetFreeTextureCount() const;
+
+    private:
+        struct Entry
+        {
+            Texture2D*          texture;
+            PooledTextureDesc   desc;
+            bool                inUse;
+            uint64_t            lastUsedFrame;
+        };
+
+        List<Entry>     m_Entries;
+        uint64_t        m_FrameIndex = 0;
+        uint32_t        m_CreatedCount = 0;
+    };
+}
@@ -6,8 +6,14 @@
 #include "View.h"
 #include "ResourceDefaults.h"
 #include "ResourceStreamer.h"
+#include "TextureResidency.h"
+#include "GeometryPool.h"
 #include "RenderGraph.h"
 
+#include "utils/debug/MemoryTracker.h"
+#include "utils/debug/Profiler.h"
+#include "utils/debug/Stats.h"
+
 #include "codeGen/ShaderDefines.h"
 #include "shaders/shared/Common.h"
 #include "shaders/shared/ConstantBuffers.h"
@@ -44,8 +50,10 @@ namespace RB::Graphics
         RenderPassEntry***                  renderPassEntries;
 
         RenderInterface*                    graphicsInterface;
+        RenderInterface*                    computeInterface;
 
         ThreadedVariable<uint64_t>*         renderFrameIndex;
+        ThreadedVariable<uint32_t>*         culledPassCount;
 
         VertexBuffer*                       backBufferCopyVB;
 
@@ -53,6 +61,7 @@ namespace RB::Graphics
         std::function<void()>				OnRenderFrameEnd;
         std::function<void()>				SyncWithGpu;
         std::function<void()>				ProcessEvents;
+        std::function<void(ViewContext*, uint32_t, uint64_t)> UpdateRenderGraphSizes;
 
         ~RenderContext()
         {
@@ -74,27 +83,36 @@ namespace RB::Graphics
     };
 
     Renderer::Renderer(bool multi_threading_support)
-        : EventListener(kEventCat_Window | kEventCat_Application, true)
+        : EventListener(kEventCat_Window)
         , m_IsShutdown(true)
         , m_MultiThreadingSupport(multi_threading_support)
         , m_RenderFrameIndex(0)
         , m_ForceSync(kForceSyncState_None)
+        , m_CulledPassCount(0)
     {
-
+        Subscribe<WindowResizeEvent>(RB_BIND_EVENT_FN(Renderer::OnWindowResize));
+        Subscribe<WindowCloseRequestEvent>(RB_BIND_EVENT_FN(Renderer::OnWindowCloseRequest));
+        Subscribe<GraphicsSettingsChangedEvent>(RB_BIND_EVENT_FN(Renderer::OnGraphicsSettingsChanged));
     }
 
     void Renderer::Init()
     {
         m_IsShutdown = false;
 
-        m_ResourceStreamer = new ResourceStreamer();
+        // TODO Maybe change this to a compute queue so that it can generate mip maps
+        m_CopyInterface = RenderInterface::Create(RenderInterfaceType::Copy);
+
+        // The copy interface is only used by the streamer (on the streaming thread)
+        m_ResourceStreamer = new ResourceStreamer(m_CopyInterface, m_MultiThreadingSupport);
+
+        m_TextureResidency = new TextureResidencyManager();
+        m_GeometryPool = new GeometryPool();
 
         // Initialize default resources
         InitResourceDefaults();
 
-        // TODO Maybe change this to a compute queue so that it can generate mip maps
-        m_CopyInterface = RenderInterface::Create(true);
-        m_GraphicsInterface = RenderInterface::Create(false);
+        m_GraphicsInterface = RenderInterface::Create(RenderInterfaceType::Graphics);
+        m_ComputeInterface = RenderInterface::Create(RenderInterfaceType::Compute);
 
         if (m_MultiThreadingSupport)
         {
@@ -107,7 +125,6 @@ namespace RB::Graphics
         m_ForceSync.SetValue(kForceSyncState_None);
 
         m_RenderGraphContext = new RenderGraphContext();
-        m_CurrentValidRenderGraphSizes = 0;
 
         CreateRenderGraphs(Application::GetInstance()->GetGraphicsSettings());
 
@@ -152,22 +169,27 @@ namespace RB::Graphics
 
         delete m_ResourceStreamer;
 
+        // After the streamer, as it might still be uploading some of the streamed textures
+        delete m_TextureResidency;
+        delete m_GeometryPool;
+
         // Delete default resources
         DeleteResourceDefaults();
 
         delete m_GraphicsInterface;
+        delete m_ComputeInterface;
         delete m_CopyInterface;
     }
 
     void Renderer::SubmitFrame(const Entity::Scene* const scene)
     {
+        RB_PROFILE_CPU_SCOPED("Renderer::SubmitFrame");
+
         // Schedule a render job (overwrites the previous render job if not yet picked up)
         {
             uint32_t total_view_contexts;
             ViewContext* view_contexts = CreateViewContexts(scene, total_view_contexts);
 
-            UpdateRenderGraphSizes(view_contexts, total_view_contexts);
-
             // Gather the entries from all render passes for every view context
             RenderPassEntry*** entries = (RenderPassEntry***) ALLOC_HEAP(sizeof(RenderPassEntry***) * total_view_contexts);
             for (int i = 0; i < total_view_contexts; ++i)
@@ -183,12 +205,15 @@ namespace RB::Graphics
             context->renderGraphs                   = m_RenderGraphs;
             context->renderPassEntries              = entries;
             context->graphicsInterface              = m_GraphicsInterface;
+            context->computeInterface               = m_ComputeInterface;
             context->renderFrameIndex               = &m_RenderFrameIndex;
+            context->culledPassCount                = &m_CulledPassCount;
             context->backBufferCopyVB               = m_BackBufferCopyVB;
             context->OnRenderFrameStart             = std::bind(&Renderer::OnFrameStart, this);
             context->OnRenderFrameEnd               = std::bind(&Renderer::OnFrameEnd, this);
             context->SyncWithGpu                    = std::bind(&Renderer::SyncWithGpu, this);
             context->ProcessEvents                  = std::bind(&Renderer::ProcessEvents, this);
+            context->UpdateRenderGraphSizes         = std::bind(&Renderer::UpdateRenderGraphSizes, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3);
 
             if (m_MultiThreadingSupport)
             {
@@ -201,19 +226,14 @@ namespace RB::Graphics
             }
         }
 
-        // Stream resources to the GPU on the main thread 
-        // (maybe in the future do this on a different thread?)
-        {
-            Shared<GpuGuard> guard = m_ResourceStreamer->Stream(m_CopyInterface);
-
-            // No need to place a GPU barrier as we do not use resources 
-            // on the graphics interface that are being streamed.
-            //if (guard != nullptr)
-            //{
-            //	// Place a GPU barrier on the graphics queue to wait on the streaming
-            //	m_GraphicsInterface->GpuWaitOn(guard.get());
-            //}
-        }
+        // Start the residency changes for the mips that were requested by the entries of this frame
+        m_TextureResidency->Update();
+
+        // Give the geometry of deleted meshes back to the pool once the GPU is done with it
+        m_GeometryPool->Update();
+
+        // Kick the streaming of the scheduled resources on the streaming thread
+        m_ResourceStreamer->KickStream();
 
         if (m_MultiThreadingSupport)
         {
@@ -346,22 +366,19 @@ namespace RB::Graphics
             .Build(kRenderGraphType_Normal, m_RenderGraphContext);
     }
 
-    void Renderer::UpdateRenderGraphSizes(ViewContext* view_contexts, uint32_t context_count)
+    void Renderer::UpdateRenderGraphSizes(ViewContext* view_contexts, uint32_t context_count, uint64_t frame_index)
     {
-        if (m_CurrentValidRenderGraphSizes == context_count)
-        {
-            // Render graph context is up-to-date
-            return;
-        }
-
-        // Make sure that the RenderThread is idle before altering the sizes
-        SyncRenderer(false);
-
-        m_RenderGraphContext->DeleteGraphResources();
+        // Called from the render thread, the graph resources are reused from a pool when the sizes or amount of views 
+        // change, so there is no need to sync with the main thread or the GPU here.
         m_RenderGraphContext->DeleteSizes();
 
         for (uint32_t i = 0; i < context_count; ++i)
         {
+            if (!view_contexts[i].enabled)
+            {
+                continue;
+            }
+
             RenderGraphSize graph_size = {};
             graph_size.size         = Math::Float2(view_contexts[i].viewport.width, view_contexts[i].viewport.height);
             graph_size.uiSize       = graph_size.size; // TODO Add support for separate resolutions for UI (rendering the UI always at window resolution)
@@ -370,12 +387,7 @@ namespace RB::Graphics
             m_RenderGraphContext->AddGraphSize(view_contexts[i].renderGraphType, graph_size);
         }
 
-        // Make sure that the previous resources are done rendering and have been released before creating new ones
-        SyncWithGpu();
-
-        m_RenderGraphContext->CreateGraphResources();
-
-        m_CurrentValidRenderGraphSizes = context_count;
+        m_RenderGraphContext->UpdateGraphResources(frame_index);
     }
 
     void Renderer::SyncRenderer(bool gpu_sync)
@@ -414,116 +426,105 @@ namespace RB::Graphics
         return m_RenderFrameIndex.GetValue();
     }
 
-    bool Renderer::OnEvent(Event& event)
+    uint32_t Renderer::GetCulledPassCount()
     {
-        auto sync = [this]() -> bool
+        return m_CulledPassCount.GetValue();
+    }
+
+    bool Renderer::SyncForEvent()
+    {
+        if (!m_MultiThreadingSupport)
         {
-            if (!m_MultiThreadingSupport)
-            {
-                return true;
-            }
+            return true;
+        }
 
-            if (m_ForceSync.GetValue() == kForceSyncState_MainSyncing)
-            {
-                // Main is waiting from an unknown location which could cause a deadlock if we would sync now.
-                // We should do the sync & event the next time.
-                return false;
-            }
+        if (m_ForceSync.GetValue() == kForceSyncState_MainSyncing)
+        {
+            // Main is waiting from an unknown location which could cause a deadlock if we would sync now.
+            // We should do the sync & event the next time.
+            return false;
+        }
 
-            if (m_ForceSync.GetValue() != kForceSyncState_MainSyncingSafe)
-            {
-                // Force the main thread to sync with the render thread (wait until the main thread has set the value to kForceSyncState_MainSyncingSafe)
-                m_ForceSync.SetValue(kForceSyncState_RenderSyncing);
-                m_ForceSync.WaitUntilConditionMet([](const uint32_t& new_value) -> bool
-                    {
-                        return new_value == kForceSyncState_MainSyncingSafe;
-                    });
-            }
+        if (m_ForceSync.GetValue() != kForceSyncState_MainSyncingSafe)
+        {
+            // Force the main thread to sync with the render thread (wait until the main thread has set the value to kForceSyncState_MainSyncingSafe)
+            m_ForceSync.SetValue(kForceSyncState_RenderSyncing);
+            m_ForceSync.WaitUntilConditionMet([](const uint32_t& new_value) -> bool
+                {
+                    return new_value == kForceSyncState_MainSyncingSafe;
+                });
+        }
 
-            // Need to cancel all next jobs for the render thread as these will not be valid
-            m_RenderThread->CancelAll();
+        // Need to cancel all next jobs for the render thread as these will not be valid
+        m_RenderThread->CancelAll();
 
-            return true;
-        };
+        return true;
+    }
 
-        if (event.IsInCategory(kEventCat_Window))
+    bool Renderer::OnWindowResize(WindowResizeEvent& resize_event)
+    {
+        // Only needed for resizing the back buffers, the graph resources pick up the new sizes by themselves
+        if (Application::GetInstance()->FindWindow(resize_event.GetWindowHandle()) && !SyncForEvent())
         {
-            WindowEvent* window_event = static_cast<WindowEvent*>(&event);
+            return false;
+        }
 
-            Window* window = Application::GetInstance()->FindWindow(window_event->GetWindowHandle());
+        return OnEvent(resize_event);
+    }
 
-            if (window)
-            {
-                switch (window_event->GetEventType())
-                {
-                case EventType::WindowResize:
-                {
-                    bool success = sync();
-                    if (!success)
-                    {
-                        return false;
-                    }
-
-                    // Recreate the render resources with the new sizes before rendering the next frame
-                    m_CurrentValidRenderGraphSizes = 0;
-                }
-                break;
+    bool Renderer::OnWindowCloseRequest(WindowCloseRequestEvent& close_event)
+    {
+        // Make sure that the next render jobs are canceled
+        if (Application::GetInstance()->FindWindow(close_event.GetWindowHandle()) && !SyncForEvent())
+        {
+            return false;
+        }
 
-                case EventType::WindowCloseRequest:
-                {
-                    // Make sure that the next render jobs are canceled
-                    bool success = sync();
-                    if (!success)
-                    {
-                        return false;
-                    }
-                }
-                break;
-
-                case EventType::WindowCreated:
-                case EventType::WindowClose:
-                case EventType::WindowFocus:
-                case EventType::WindowLostFocus:
-                case EventType::WindowMoved:
-                case EventType::WindowFullscreenToggle: // Also toggles a window resize event after this
-                default:
-                    break;
-                }
+        return OnEvent(close_event);
+    }
 
-                // Actually process the event
-                window->ProcessEvent(*window_event);
-            }
+    bool Renderer::OnGraphicsSettingsChanged(GraphicsSettingsChangedEvent& settings_event)
+    {
+        const GraphicsSettings& settings = settings_event.GetNewSettings();
+
+        if (!settings.RequiresNewResources(settings_event.GetOldSettings()))
+        {
+            // We don't have to recreate the render resources on this setting change
+            return true;
         }
-        else if (event.IsInCategory(kEventCat_Application))
+
+        if (!SyncForEvent())
         {
-            BindEvent<GraphicsSettingsChangedEvent>([&](GraphicsSettingsChangedEvent& app_event)
-            {
-                const GraphicsSettings& settings = app_event.GetNewSettings();
+            return false;
+        }
 
-                if (!settings.RequiresNewResources(app_event.GetOldSettings()))
-                {
-                    // We don't have to recreate the render resources on this setting change
-                    return true;
-                }
+        for (int i = 0; i < kRenderGraphType_Count; ++i)
+        {
+            SAFE_DELETE(m_RenderGraphs[i]);
+        }
 
-                bool success = sync();
-                if (!success)
-                {
-                    return false;
-                }
+        m_RenderGraphContext->DeleteGraphResourceDescriptions();
 
-                for (int i = 0; i < kRenderGraphType_Count; ++i)
-                {
-                    SAFE_DELETE(m_RenderGraphs[i]);
-                }
+        // The render resources are reassigned for the new graphs before rendering the next frame
+        CreateRenderGraphs(settings);
 
-                m_RenderGraphContext->DeleteGraphResourceDescriptions();
+        return true;
+    }
 
-                CreateRenderGraphs(settings);
+    bool Renderer::OnEvent(Event& event)
+    {
+        // All the window events end up here, the ones that need a sync first have their own handler
+        if (event.IsInCategory(kEventCat_Window))
+        {
+            WindowEvent* window_event = static_cast<WindowEvent*>(&event);
 
-                // Makes sure to recreate the render resources with the new graphs before rendering the next frame
-                m_CurrentValidRenderGraphSizes = 0;
-            }, event);
+            Window* window = Application::GetInstance()->FindWindow(window_event->GetWindowHandle());
+
+            if (window)
+            {
+                // Actually process the event
+                window->ProcessEvent(*window_event);
+            }
         }
 
         return true;
@@ -547,10 +548,18 @@ namespace RB::Graphics
     {
         RenderContext* context = (RenderContext*)data;
 
+        RB_PROFILE_CPU_SCOPED("RenderJob");
+        RB_MEMORY_TAG(Graphics);
+
         uint64_t frame_index = context->renderFrameIndex->GetValue();
 
         context->OnRenderFrameStart();
 
+        uint32_t culled_passes = 0;
+
+        // Make sure the graph resources fit the ViewContexts of this frame
+        context->UpdateRenderGraphSizes(context->viewContexts, context->totalViewContexts, frame_index);
+
         {
             RB_PROFILE_GPU_SCOPED(context->graphicsInterface, "Frame");
 
@@ -577,10 +586,15 @@ namespace RB::Graphics
                 context->graphicsInterface->Clear(final_color_target, view_context.clearColor);
 
                 // Render the different passes
-                context->renderGraphs[view_context.renderGraphType]->RunGraph(&view_context, context->renderPassEntries[view_context_index], context->graphicsInterface, context->graphContext);
+                RenderGraph* graph = context->renderGraphs[view_context.renderGraphType];
+                graph->RunGraph(&view_context, context->renderPassEntries[view_context_index], context->graphicsInterface, context->computeInterface, context->graphContext);
+
+                culled_passes += graph->GetCulledPassCount();
             }
         }
 
+        context->culledPassCount->SetValue(culled_passes);
+
         // Prepare draw(s) to backbuffer(s)
         context->graphicsInterface->InvalidateState(false);
         context->graphicsInterface->SetVertexShader(VS_Present);
@@ -598,8 +612,6 @@ namespace RB::Graphics
         uint32_t total_pairs = 0;
         WindowPair* window_pairs = (WindowPair*)ALLOC_STACK(sizeof(WindowPair) * context->totalViewContexts);
 
-        // TODO Future optimize to batch the resource barriers that are done below
-
         // Copy to real backbuffers and present
         for (int view_context_index = 0; view_context_index < context->totalViewContexts; ++view_context_index)
         {
@@ -664,18 +676,33 @@ namespace RB::Graphics
             // Backbuffer copy
             context->graphicsInterface->Draw();
 
-            // Prepare for present
-            context->graphicsInterface->TransitionResource(back_buffer, ResourceState::PRESENT);
-            context->graphicsInterface->FlushResourceBarriers();
-
             window_pairs[total_pairs].window = window;
             window_pairs[total_pairs].windowIndex = window_index;
             total_pairs++;
         }
 
+        // Prepare all the backbuffers for present in one batch
+        for (int pair_index = 0; pair_index < total_pairs; ++pair_index)
+        {
+            context->graphicsInterface->TransitionResource(window_pairs[pair_index].window->GetCurrentBackBuffer(), ResourceState::PRESENT);
+        }
+
+        context->graphicsInterface->FlushResourceBarriers();
+
         // Execute al the work to the GPU
         Shared<GpuGuard> guard = context->graphicsInterface->ExecuteOnGpu();
 
+#ifdef RB_ENABLE_PROFILING
+        // The GPU time of a frame that finished a few frames ago, measured without waiting on it
+        if (GpuProfiler* gpu_profiler = context->graphicsInterface->GetGpuProfiler())
+        {
+            if (const GpuZoneTiming* frame_timing = gpu_profiler->FindTiming("Frame"))
+            {
+                RB_STAT_SET(GpuFrameTime, frame_timing->duration / 1000);
+            }
+        }
+#endif
+
         // Present to each window
         for (int pair_index = 0; pair_index < total_pairs; ++pair_index)
         {
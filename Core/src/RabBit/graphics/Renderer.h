@@ -10,6 +10,13 @@ namespace RB::Entity
     class Scene;
 }
 
+namespace RB::Events
+{
+    class WindowResizeEvent;
+    class WindowCloseRequestEvent;
+    class GraphicsSettingsChangedEvent;
+}
+
 namespace RB::Graphics
 {
     enum class RenderAPI
@@ -22,6 +29,8 @@ namespace RB::Graphics
     class GpuGuard;
     class ViewContext;
     class ResourceStreamer;
+    class TextureResidencyManager;
+    class GeometryPool;
     class VertexBuffer;
     class RenderGraph;
     class RenderGraphContext;
@@ -50,8 +59,17 @@ namespace RB::Graphics
 
         ResourceStreamer* GetStreamer() const { return m_ResourceStreamer; }
 
+        // Should only be used from the main thread
+        TextureResidencyManager* GetTextureResidency() const { return m_TextureResidency; }
+
+        // Should only be used from the main thread
+        GeometryPool* GetGeometryPool() const { return m_GeometryPool; }
+
         uint64_t GetRenderFrameIndex();
 
+        // The amount of RenderPasses that were culled from the RenderGraphs in the last rendered frame
+        uint32_t GetCulledPassCount();
+
         void Init();
 
         // Also syncs with the render thread and GPU
@@ -70,9 +88,15 @@ namespace RB::Graphics
     private:
         ViewContext* CreateViewContexts(const Entity::Scene* const scene, uint32_t& out_context_count);
         void CreateRenderGraphs(const GraphicsSettings& settings);
-        void UpdateRenderGraphSizes(ViewContext* view_contexts, uint32_t context_count);
 
         // Should only be called from the render thread!
+        void UpdateRenderGraphSizes(ViewContext* view_contexts, uint32_t context_count, uint64_t frame_index);
+
+        // Returns false when the event should be handled a next time
+        bool SyncForEvent();
+        bool OnWindowResize(Events::WindowResizeEvent& resize_event);
+        bool OnWindowCloseRequest(Events::WindowCloseRequestEvent& close_event);
+        bool OnGraphicsSettingsChanged(Events::GraphicsSettingsChangedEvent& settings_event);
         bool OnEvent(Events::Event& event) override;
 
         inline static RenderAPI s_Api = RenderAPI::None;
@@ -82,19 +106,22 @@ namespace RB::Graphics
         JobTypeID					m_RenderJobType;
 
         RenderInterface*            m_GraphicsInterface; // Used by the render graphs
-        RenderInterface*            m_CopyInterface;	 // Used for resource streaming 
+        RenderInterface*            m_ComputeInterface;  // Used by the async compute passes of the render graphs
+        RenderInterface*            m_CopyInterface;	 // Used by the ResourceStreamer on the streaming thread
         RenderGraph*                m_RenderGraphs[kRenderGraphType_Count];
         RenderGraphContext*         m_RenderGraphContext;
-        uint32_t                    m_CurrentValidRenderGraphSizes;
 
         ThreadedVariable<uint64_t>	m_RenderFrameIndex;
         ThreadedVariable<uint32_t>	m_ForceSync;
+        ThreadedVariable<uint32_t>	m_CulledPassCount;
 
         VertexBuffer*               m_BackBufferCopyVB;
 
         bool						m_MultiThreadingSupport;
 
         ResourceStreamer*           m_ResourceStreamer;
+        TextureResidencyManager*    m_TextureResidency;
+        GeometryPool*               m_GeometryPool;
 
     public:
         struct BackBufferGuard
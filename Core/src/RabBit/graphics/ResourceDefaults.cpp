@@ -1,5 +1,9 @@
 #include "RabBitCommon.h"
 #include "ResourceDefaults.h"
+#include "ResourceStreamer.h"
+#include "Renderer.h"
+
+#include "app/Application.h"
 
 namespace RB::Graphics
 {
@@ -7,7 +11,8 @@ namespace RB::Graphics
     //							Texture Defines
     // ---------------------------------------------------------------------------
 
-    Texture2D* g_TexDefaultError = nullptr;
+    Texture2D* g_TexDefaultError        = nullptr;
+    Texture2D* g_TexDefaultStreaming    = nullptr;
 
     // ---------------------------------------------------------------------------
     //							 Texture Data
@@ -23,17 +28,32 @@ namespace RB::Graphics
         RGBA8(0xFF, 0x00, 0x00, 0xFF), RGBA8(0xFF, 0x00, 0x00, 0xFF), RGBA8(0xFF, 0x00, 0x00, 0xFF), RGBA8(0xFF, 0x00, 0x00, 0xFF),
     };
 
+    uint32_t g_TexDefaultStreamingData[] =
+    {
+        RGBA8(0x80, 0x80, 0x80, 0xFF), RGBA8(0x80, 0x80, 0x80, 0xFF), RGBA8(0x80, 0x80, 0x80, 0xFF), RGBA8(0x80, 0x80, 0x80, 0xFF),
+        RGBA8(0x80, 0x80, 0x80, 0xFF), RGBA8(0x80, 0x80, 0x80, 0xFF), RGBA8(0x80, 0x80, 0x80, 0xFF), RGBA8(0x80, 0x80, 0x80, 0xFF),
+        RGBA8(0x80, 0x80, 0x80, 0xFF), RGBA8(0x80, 0x80, 0x80, 0xFF), RGBA8(0x80, 0x80, 0x80, 0xFF), RGBA8(0x80, 0x80, 0x80, 0xFF),
+        RGBA8(0x80, 0x80, 0x80, 0xFF), RGBA8(0x80, 0x80, 0x80, 0xFF), RGBA8(0x80, 0x80, 0x80, 0xFF), RGBA8(0x80, 0x80, 0x80, 0xFF),
+    };
+
     // ---------------------------------------------------------------------------
     //							Initialization
     // ---------------------------------------------------------------------------
 
     void InitResourceDefaults()
     {
-        g_TexDefaultError = Texture2D::Create("Default error texture 2D", g_TexDefaultErrorData, sizeof(g_TexDefaultErrorData), RenderResourceFormat::R8G8B8A8_UNORM, 4, 4, false, false);
+        g_TexDefaultError       = Texture2D::Create("Default error texture 2D", g_TexDefaultErrorData, sizeof(g_TexDefaultErrorData), RenderResourceFormat::R8G8B8A8_UNORM, 4, 4, false, false);
+        g_TexDefaultStreaming   = Texture2D::Create("Default streaming texture 2D", g_TexDefaultStreamingData, sizeof(g_TexDefaultStreamingData), RenderResourceFormat::R8G8B8A8_UNORM, 4, 4, false, false);
+
+        // The defaults are used as fallbacks for other resources, so they should never wait on the streaming budget
+        ResourceStreamer* streamer = Application::GetInstance()->GetRenderer()->GetStreamer();
+        streamer->Prioritize(g_TexDefaultError, StreamPriority::Critical);
+        streamer->Prioritize(g_TexDefaultStreaming, StreamPriority::Critical);
     }
 
     void DeleteResourceDefaults()
     {
         delete g_TexDefaultError;
+        delete g_TexDefaultStreaming;
     }
 }
\ No newline at end of file
@@ -5,6 +5,7 @@
 namespace RB::Graphics
 {
     extern Texture2D* g_TexDefaultError;
+    extern Texture2D* g_TexDefaultStreaming; // Used while the actual texture is still streaming
 
     void InitResourceDefaults();
     void DeleteResourceDefaults();
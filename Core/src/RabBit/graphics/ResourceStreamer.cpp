@@ -3,20 +3,173 @@
 #include "RenderResource.h"
 #include "RenderInterface.h"
 
+#include "utils/debug/MemoryTracker.h"
+#include "utils/debug/Stats.h"
+
 namespace RB::Graphics
 {
-    ResourceStreamer::ResourceStreamer()
+    // ---------------------------------------------------------------------------
+    //								StreamQueue
+    // ---------------------------------------------------------------------------
+
+    void StreamQueue::Push(const Streamable& streamable)
     {
+        RB_ASSERT(LOGTAG_GRAPHICS, m_Queued.find(streamable.resource) == m_Queued.end(), "Resource is already queued for streaming");
+
+        uint64_t ticket = m_NextTicket++;
+
+        m_Queued[streamable.resource] = { streamable, ticket };
+        m_Queues[(uint32_t)streamable.priority].push_back({ streamable.resource, ticket });
+    }
+
+    bool StreamQueue::Promote(const RenderResource* resource, StreamPriority priority)
+    {
+        auto itr = m_Queued.find(resource);
+
+        // Nothing to do when it is already queued with a higher priority
+        if (itr == m_Queued.end() || itr->second.streamable.priority <= priority)
+        {
+            return false;
+        }
+
+        itr->second.streamable.priority = priority;
+        m_Queues[(uint32_t)priority].push_back({ resource, itr->second.ticket });
+        return true;
+    }
+
+    bool StreamQueue::PopNext(const StreamBudget& budget, uint64_t streamed_bytes, double elapsed_ms, uint32_t streamed_count, Streamable& out_streamable)
+    {
+        for (uint32_t queue_index = 0; queue_index < (uint32_t)StreamPriority::Count; ++queue_index)
+        {
+            Deque<QueueEntry>& queue = m_Queues[queue_index];
+
+            // Entries of promoted streamables are left behind in the lower priority classes
+            while (!queue.empty() && FindQueued(queue.front(), queue_index) == nullptr)
+            {
+                queue.pop_front();
+            }
+
+            if (queue.empty())
+            {
+                continue;
+            }
+
+            const Streamable& next = FindQueued(queue.front(), queue_index)->streamable;
+
+            bool within_budget = streamed_count == 0 ||
+                                 (elapsed_ms < budget.maxMsPerFrame && streamed_bytes + next.uploadSize <= budget.maxBytesPerFrame);
+
+            if (next.priority != StreamPriority::Critical && !within_budget)
+            {
+                // Everything after this one has a lower (or the same) priority, so stop here
+                return false;
+            }
+
+            out_streamable = next;
+            m_Queued.erase(queue.front().resource);
+            queue.pop_front();
+            return true;
+        }
+
+        return false;
+    }
+
+    List<Streamable> StreamQueue::Drain()
+    {
+        List<Streamable> streamables;
+        streamables.reserve(GetDepth());
+
+        for (uint32_t queue_index = 0; queue_index < (uint32_t)StreamPriority::Count; ++queue_index)
+        {
+            for (const QueueEntry& entry : m_Queues[queue_index])
+            {
+                if (const QueuedStreamable* queued = FindQueued(entry, queue_index))
+                {
+                    streamables.push_back(queued->streamable);
+                }
+            }
+
+            m_Queues[queue_index].clear();
+        }
+
+        m_Queued.clear();
+
+        return streamables;
+    }
+
+    const StreamQueue::QueuedStreamable* StreamQueue::FindQueued(const QueueEntry& entry, uint32_t queue_index) const
+    {
+        auto itr = m_Queued.find(entry.resource);
+
+        if (itr == m_Queued.end() || itr->second.ticket != entry.ticket || (uint32_t)itr->second.streamable.priority != queue_index)
+        {
+            return nullptr;
+        }
+
+        return &itr->second;
+    }
+
+    // ---------------------------------------------------------------------------
+    //							  ResourceStreamer
+    // ---------------------------------------------------------------------------
+
+    ResourceStreamer::ResourceStreamer(RenderInterface* copy_interface, bool multi_threading_support)
+        : m_CopyInterface(copy_interface)
+        , m_StreamThread(nullptr)
+        , m_StreamJobType(0)
+        , m_Budget(kDefaultStreamBudget)
+        , m_QueueDepth(0)
+        , m_InFlightCount(0)
+        , m_BytesStreamedLastFrame(0)
+        , m_TotalBytesStreamed(0)
+        , m_TotalResidentCount(0)
+        , m_TotalTimeToResidentMs(0.0)
+        , m_StagingBytesInUse(0)
+        , m_PeakStagingBytes(0)
+        , m_TotalBytesCopied(0)
+    {
+        LARGE_INTEGER li;
+        if (!QueryPerformanceFrequency(&li))
+        {
+            RB_LOG_ERROR(LOGTAG_GRAPHICS, "Could not retrieve value from QueryPerformanceFrequency");
+        }
+
+        m_PerformanceFreqMs = double(li.QuadPart) / 1000.0;
+
+        InitializeCriticalSection(&m_CS);
+
+        if (multi_threading_support)
+        {
+            m_StreamThread  = new WorkerThread(L"Stream Thread", ThreadPriority::Medium);
+
+            // Only one stream job has to be pending at a time, it picks up everything that is scheduled
+            m_StreamJobType = m_StreamThread->AddJobType(std::bind(&ResourceStreamer::Stream, this), true);
+        }
     }
 
     ResourceStreamer::~ResourceStreamer()
     {
-        // Clear the streamable queue
+        if (m_StreamThread)
+        {
+            // Blocks until the stream thread is completely idle
+            delete m_StreamThread;
+        }
+
+        EnterCriticalSection(&m_CS);
+
+        // Clear the streamable queues
+        for (Streamable& streamable : m_Incoming)
+        {
+            FreeStagingMemory(streamable);
+        }
+
+        for (Streamable& streamable : m_Streamables.Drain())
         {
-            Queue<Streamable> empty;
-            std::swap(m_Streamables, empty);
+            FreeStagingMemory(streamable);
         }
 
+        m_Incoming.clear();
+
         // Wait until all the resources have been streamed completely
         for (auto itr = m_StreamedEntries.begin(); itr != m_StreamedEntries.end(); ++itr)
         {
@@ -25,85 +178,336 @@ namespace RB::Graphics
             for (int i = 0; i < itr->streamables.size(); ++i)
             {
                 // Free the upload data and set the resource as being finished with streaming
-                SAFE_FREE(itr->streamables[i].uploadData);
-                itr->streamables[i].resource->SetStreaming(false);
+                FreeStagingMemory(itr->streamables[i]);
+                itr->streamables[i].resource->TransitionResidency(ResidencyState::Uploading, ResidencyState::Resident);
             }
         }
 
         m_StreamedEntries.clear();
+
+        for (auto& reservation : m_Reservations)
+        {
+            RB_LOG_WARN(LOGTAG_GRAPHICS, "Staging memory of %llu bytes was reserved, but never scheduled for streaming", reservation.second);
+            void* memory = reservation.first;
+            SAFE_FREE(memory);
+        }
+
+        LeaveCriticalSection(&m_CS);
+
+        DeleteCriticalSection(&m_CS);
+    }
+
+    void* ResourceStreamer::ReserveStagingMemory(uint64_t size)
+    {
+        RB_MEMORY_TAG(Streaming);
+
+        void* memory = ALLOC_HEAP(size);
+
+        EnterCriticalSection(&m_CS);
+
+        m_Reservations[memory] = size;
+
+        m_StagingBytesInUse += size;
+        m_PeakStagingBytes   = Math::Max(m_PeakStagingBytes, m_StagingBytesInUse);
+
+        LeaveCriticalSection(&m_CS);
+
+        return memory;
+    }
+
+    void ResourceStreamer::ReleaseStagingMemory(void* memory)
+    {
+        EnterCriticalSection(&m_CS);
+
+        auto itr = m_Reservations.find(memory);
+
+        if (itr == m_Reservations.end())
+        {
+            LeaveCriticalSection(&m_CS);
+            RB_ASSERT_ALWAYS(LOGTAG_GRAPHICS, "Trying to release staging memory that was not reserved by the ResourceStreamer");
+            return;
+        }
+
+        m_StagingBytesInUse -= itr->second;
+        m_Reservations.erase(itr);
+
+        LeaveCriticalSection(&m_CS);
+
+        SAFE_FREE(memory);
+    }
+
+    void ResourceStreamer::ScheduleForStream(const Streamable& streamable, StreamDataMode data_mode)
+    {
+        RB_MEMORY_TAG(Streaming);
+
+        // Set the resource as streaming, only resources that are resident (e.g. just created) can be scheduled
+        bool scheduled = streamable.resource->TransitionResidency(ResidencyState::Resident, ResidencyState::Pending);
+        RB_ASSERT(LOGTAG_GRAPHICS, scheduled, "Resource \"%s\" is scheduled for streaming while it is still streaming or evicting", streamable.resource->GetName());
+
+        Streamable owned;
+        owned.resource       = streamable.resource;
+        owned.uploadSize     = streamable.uploadSize;
+        owned.priority       = streamable.priority;
+        owned.onResident     = streamable.onResident;
+        owned.scheduleTimeMs = GetTimeMs();
+
+        if (data_mode == StreamDataMode::Copy)
+        {
+            // Memcpy over the data so the RenderResource does not need to keep it around
+            owned.uploadData = ALLOC_HEAP(owned.uploadSize);
+            memcpy(owned.uploadData, streamable.uploadData, owned.uploadSize);
+        }
+        else
+        {
+            owned.uploadData = streamable.uploadData;
+        }
+
+        EnterCriticalSection(&m_CS);
+
+        auto itr = m_Reservations.find(owned.uploadData);
+
+        if (data_mode == StreamDataMode::TakeOwnership && itr != m_Reservations.end())
+        {
+            // Reserved staging memory is already accounted for
+            owned.stagingSize = itr->second;
+            m_Reservations.erase(itr);
+        }
+        else
+        {
+            owned.stagingSize    = owned.uploadSize;
+            m_StagingBytesInUse += owned.stagingSize;
+        }
+
+        if (data_mode == StreamDataMode::Copy)
+        {
+            m_TotalBytesCopied += owned.uploadSize;
+        }
+
+        m_PeakStagingBytes = Math::Max(m_PeakStagingBytes, m_StagingBytesInUse);
+
+        m_Incoming.push_back(owned);
+        m_QueueDepth++;
+
+        LeaveCriticalSection(&m_CS);
     }
 
-    void ResourceStreamer::ScheduleForStream(const Streamable& streamable)
+    void ResourceStreamer::Prioritize(const RenderResource* resource, StreamPriority priority)
     {
-        // Set the resource as streaming
-        streamable.resource->SetStreaming(true);
+        EnterCriticalSection(&m_CS);
+        m_PriorityRequests.push_back({ resource, priority });
+        LeaveCriticalSection(&m_CS);
+    }
 
-        Streamable copy;
-        copy.resource   = streamable.resource;
-        copy.uploadSize = streamable.uploadSize;
-        copy.uploadData = ALLOC_HEAP(copy.uploadSize);
+    void ResourceStreamer::KickStream()
+    {
+        if (m_StreamThread)
+        {
+            // Overwrites the previous stream job if not yet picked up
+            m_StreamThread->ScheduleJob(m_StreamJobType, new JobData());
+        }
+        else
+        {
+            Stream();
+        }
+    }
+
+    void ResourceStreamer::Sync()
+    {
+        if (m_StreamThread)
+        {
+            m_StreamThread->SyncAll();
+        }
+    }
+
+    void ResourceStreamer::SetBudget(const StreamBudget& budget)
+    {
+        EnterCriticalSection(&m_CS);
+        m_Budget = budget;
+        LeaveCriticalSection(&m_CS);
+    }
 
-        // Memcpy over the data so the RenderResource does not need to keep it around
-        memcpy(copy.uploadData, streamable.uploadData, copy.uploadSize);
+    StreamBudget ResourceStreamer::GetBudget()
+    {
+        EnterCriticalSection(&m_CS);
+        StreamBudget budget = m_Budget;
+        LeaveCriticalSection(&m_CS);
 
-        m_Streamables.push(copy);
+        return budget;
     }
 
-    Shared<GpuGuard> ResourceStreamer::Stream(RenderInterface* render_interface)
+    void ResourceStreamer::Stream()
     {
+        RB_MEMORY_TAG(Streaming);
+
+        // Pick up everything that has been scheduled since the last stream
+        EnterCriticalSection(&m_CS);
+
+        for (const Streamable& streamable : m_Incoming)
+        {
+            m_Streamables.Push(streamable);
+        }
+
+        for (const PriorityRequest& request : m_PriorityRequests)
+        {
+            m_Streamables.Promote(request.resource, request.priority);
+        }
+
+        m_Incoming.clear();
+        m_PriorityRequests.clear();
+
+        StreamBudget budget = m_Budget;
+
+        LeaveCriticalSection(&m_CS);
+
         UpdateStreamedEntries();
 
-        // TODO Maybe stream only a max number of streamables per frame, or maybe give it a time budget
-        // (unstreamed resources can just use a fallback if they are not very important, or use a lower 
-        // mip if its a texture as textures will be streamed per mip).
+        // Only stream what fits in the budget of this frame, resources that are not streamed yet
+        // use a fallback (see ResourceDefaults) or are skipped by the render passes.
 
         StreamedEntry streamed_entry = {};
 
-        streamed_entry.streamables.reserve(m_Streamables.size());
+        double   start_time     = GetTimeMs();
+        uint64_t streamed_bytes = 0;
+
+        // Resources that are still being created are retried next stream, so the streamer never waits on a creation
+        List<Streamable> not_created;
 
-        while (!m_Streamables.empty())
+        Streamable streamable;
+        while (m_Streamables.PopNext(budget, streamed_bytes, GetTimeMs() - start_time, streamed_entry.streamables.size(), streamable))
         {
-            Streamable& streamable = m_Streamables.front();
+            CreationState creation_state = streamable.resource->GetCreationState();
 
-            render_interface->UploadDataToResource(streamable.resource, streamable.uploadData, streamable.uploadSize);
+            if (creation_state == CreationState::Scheduled)
+            {
+                not_created.push_back(streamable);
+                continue;
+            }
+
+            streamable.resource->TransitionResidency(ResidencyState::Pending, ResidencyState::Uploading);
+
+            if (creation_state == CreationState::Failed)
+            {
+                RB_LOG_WARN(LOGTAG_GRAPHICS, "Dropping the upload of resource \"%s\", its creation failed", streamable.resource->GetName());
+
+                EnterCriticalSection(&m_CS);
+                FreeStagingMemory(streamable);
+                LeaveCriticalSection(&m_CS);
+
+                // Nothing is uploaded, finish its residency so nothing keeps waiting on it
+                streamable.resource->TransitionResidency(ResidencyState::Uploading, ResidencyState::Resident);
+                continue;
+            }
+
+            m_CopyInterface->UploadDataToResource(streamable.resource, streamable.uploadData, streamable.uploadSize);
 
+            streamed_bytes += streamable.uploadSize;
             streamed_entry.streamables.push_back(streamable);
-            m_Streamables.pop();
         }
 
-        if (streamed_entry.streamables.empty())
+        for (const Streamable& waiting : not_created)
         {
-            // Did no streaming
-            return nullptr;
+            m_Streamables.Push(waiting);
+        }
+
+        if (!streamed_entry.streamables.empty())
+        {
+            // Execute the streaming on the GPU
+            streamed_entry.guard = m_CopyInterface->ExecuteOnGpu();
+
+            m_StreamedEntries.push_back(streamed_entry);
+        }
+
+        EnterCriticalSection(&m_CS);
+
+        m_QueueDepth                = m_Streamables.GetDepth() + m_Incoming.size();
+        m_BytesStreamedLastFrame    = streamed_bytes;
+        m_TotalBytesStreamed       += streamed_bytes;
+        m_InFlightCount             = 0;
+
+        for (const StreamedEntry& entry : m_StreamedEntries)
+        {
+            m_InFlightCount += entry.streamables.size();
         }
 
-        // Execute the streaming on the GPU
-        streamed_entry.guard = render_interface->ExecuteOnGpu();
+        RB_STAT_ADD(StreamedBytes, streamed_bytes);
+        RB_STAT_SET(StreamQueueDepth, m_QueueDepth);
 
-        m_StreamedEntries.push_back(streamed_entry);
+        LeaveCriticalSection(&m_CS);
+    }
+
+    StreamingStats ResourceStreamer::GetStats()
+    {
+        EnterCriticalSection(&m_CS);
 
-        return streamed_entry.guard;
+        StreamingStats stats = {};
+        stats.queueDepth                = m_QueueDepth;
+        stats.inFlightCount             = m_InFlightCount;
+        stats.bytesStreamedLastFrame    = m_BytesStreamedLastFrame;
+        stats.totalBytesStreamed        = m_TotalBytesStreamed;
+        stats.averageTimeToResidentMs   = m_TotalResidentCount == 0 ? 0.0 : m_TotalTimeToResidentMs / m_TotalResidentCount;
+        stats.stagingBytesInUse         = m_StagingBytesInUse;
+        stats.peakStagingBytes          = m_PeakStagingBytes;
+        stats.totalBytesCopied          = m_TotalBytesCopied;
+
+        LeaveCriticalSection(&m_CS);
+
+        return stats;
     }
 
     void ResourceStreamer::UpdateStreamedEntries()
     {
+        double current_time = GetTimeMs();
+
         for (auto itr = m_StreamedEntries.begin(); itr != m_StreamedEntries.end();)
         {
-            if (itr->guard->IsFinishedRendering())
+            if (!itr->guard->IsFinishedRendering())
             {
-                for (int i = 0; i < itr->streamables.size(); ++i)
-                {
-                    // Free the upload data and set the resource as being finished with streaming
-                    SAFE_FREE(itr->streamables[i].uploadData);
-                    itr->streamables[i].resource->SetStreaming(false);
-                }
+                ++itr;
+                continue;
+            }
+
+            EnterCriticalSection(&m_CS);
+
+            for (int i = 0; i < itr->streamables.size(); ++i)
+            {
+                // Free the upload data
+                FreeStagingMemory(itr->streamables[i]);
 
-                itr = m_StreamedEntries.erase(itr);
+                m_TotalTimeToResidentMs += current_time - itr->streamables[i].scheduleTimeMs;
+                m_TotalResidentCount++;
             }
-            else
+
+            LeaveCriticalSection(&m_CS);
+
+            for (int i = 0; i < itr->streamables.size(); ++i)
             {
-                ++itr;
+                // The copy queue is done, so the resource can safely be used by the graphics queue now
+                itr->streamables[i].resource->TransitionResidency(ResidencyState::Uploading, ResidencyState::Resident);
+
+                if (itr->streamables[i].onResident)
+                {
+                    itr->streamables[i].onResident(itr->streamables[i].resource);
+                }
             }
+
+            itr = m_StreamedEntries.erase(itr);
         }
     }
-}
\ No newline at end of file
+
+    // Should be called while holding m_CS
+    void ResourceStreamer::FreeStagingMemory(Streamable& streamable)
+    {
+        SAFE_FREE(streamable.uploadData);
+
+        m_StagingBytesInUse -= streamable.stagingSize;
+        streamable.stagingSize = 0;
+    }
+
+    double ResourceStreamer::GetTimeMs() const
+    {
+        LARGE_INTEGER li;
+        QueryPerformanceCounter(&li);
+
+        return double(li.QuadPart) / m_PerformanceFreqMs;
+    }
+}
@@ -1,32 +1,135 @@
 #pragma once
 
 #include "RabBitCommon.h"
+#include "RenderResource.h"
+#include "utils/Threading.h"
 
 namespace RB::Graphics
 {
     class RenderInterface;
-    class RenderResource;
     class GpuGuard;
 
+    // Streamables are uploaded in this order
+    enum class StreamPriority
+    {
+        Critical,   // Ignores the budget (e.g. the default resources that are used as fallbacks)
+        Visible,    // Used by a view this frame
+        Normal,
+        Background,
+
+        Count
+    };
+
     struct Streamable
     {
         RenderResource* resource;
         void*           uploadData;
         uint64_t		uploadSize;
+        StreamPriority  priority = StreamPriority::Normal;
+        // Called on the streaming thread once the GPU finished the upload
+        std::function<void(RenderResource*)> onResident;
+        double          scheduleTimeMs = 0.0; // Set by the ResourceStreamer
+        uint64_t        stagingSize = 0;      // Set by the ResourceStreamer, the amount of memory owned by the streamer for this streamable
+    };
+
+    struct StreamBudget
+    {
+        uint64_t        maxBytesPerFrame;
+        double          maxMsPerFrame;
+    };
+
+    constexpr StreamBudget kDefaultStreamBudget = { k32MB, 2.0 };
+
+    struct StreamingStats
+    {
+        uint32_t        queueDepth;                 // Streamables that are still waiting to be uploaded
+        uint32_t        inFlightCount;              // Streamables that are uploaded, but not yet finished on the GPU
+        uint64_t        bytesStreamedLastFrame;
+        uint64_t        totalBytesStreamed;
+        double          averageTimeToResidentMs;    // From scheduling until the GPU finished the upload
+        uint64_t        stagingBytesInUse;          // CPU memory owned by the streamer (reserved, queued and in flight)
+        uint64_t        peakStagingBytes;
+        uint64_t        totalBytesCopied;           // Bytes copied when scheduling with StreamDataMode::Copy
+    };
+
+    // Holds the streamables that still need to be uploaded, per priority class. A resource can only be queued once.
+    class StreamQueue
+    {
+    public:
+        void Push(const Streamable& streamable);
+
+        // Moves a queued resource to a higher priority class. Returns false if the resource is not queued (anymore).
+        // The entry in the lower priority class is not searched for, it is skipped once it reaches the front of its queue.
+        bool Promote(const RenderResource* resource, StreamPriority priority);
+
+        // Pops the streamable with the highest priority if it still fits in the budget of this frame. Critical streamables ignore
+        // the budget and at least one streamable is always popped per frame, so an upload bigger than the budget can not get stuck.
+        bool PopNext(const StreamBudget& budget, uint64_t streamed_bytes, double elapsed_ms, uint32_t streamed_count, Streamable& out_streamable);
+
+        uint32_t GetDepth() const   { return (uint32_t)m_Queued.size(); }
+        bool     IsEmpty() const    { return m_Queued.empty(); }
+
+        // Removes all the streamables from the queue and returns them
+        List<Streamable> Drain();
+
+    private:
+        struct QueuedStreamable
+        {
+            Streamable  streamable;
+            uint64_t    ticket;
+        };
+
+        // An entry in a priority class, only valid while the queued streamable still has the same ticket and priority
+        struct QueueEntry
+        {
+            const RenderResource*   resource;
+            uint64_t                ticket;
+        };
+
+        const QueuedStreamable* FindQueued(const QueueEntry& entry, uint32_t queue_index) const;
+
+        FlatMap<const RenderResource*, QueuedStreamable> m_Queued;
+        Deque<QueueEntry>   m_Queues[(uint32_t)StreamPriority::Count];
+        uint64_t            m_NextTicket = 0;
     };
 
+    // Uploads the scheduled resources on a dedicated streaming thread using a copy queue. All the public methods are thread safe.
+    // A resource is only marked as ready to render once the copy queue finished its upload, so the graphics queue never has
+    // to wait on the copy queue for a resource it is allowed to use.
     class ResourceStreamer
     {
     public:
-        ResourceStreamer();
+        ResourceStreamer(RenderInterface* copy_interface, bool multi_threading_support);
         ~ResourceStreamer();
 
-        void ScheduleForStream(const Streamable& streamable);
+        // Returns memory that a loader can directly write (or decode) the data of a resource into. The memory should be handed back
+        // with ScheduleForStream using StreamDataMode::TakeOwnership, or with ReleaseStagingMemory when it is not used after all.
+        void* ReserveStagingMemory(uint64_t size);
+        void  ReleaseStagingMemory(void* memory);
+
+        // Only pushes the streamable to the streaming thread, the upload happens on the next kick
+        void ScheduleForStream(const Streamable& streamable, StreamDataMode data_mode = StreamDataMode::Copy);
+
+        // Makes sure the resource is streamed earlier when it is still queued
+        void Prioritize(const RenderResource* resource, StreamPriority priority);
+
+        // Starts the streaming of this frame on the streaming thread (or streams directly without multi threading support).
+        // Should be called from the thread that owns the streamer, once per frame.
+        void KickStream();
+
+        // Blocks until the streaming thread is idle
+        void Sync();
 
-        Shared<GpuGuard> Stream(RenderInterface* render_interface);
+        void         SetBudget(const StreamBudget& budget);
+        StreamBudget GetBudget();
+
+        StreamingStats GetStats();
 
     private:
+        void Stream();
         void UpdateStreamedEntries();
+        void FreeStagingMemory(Streamable& streamable);
+        double GetTimeMs() const;
 
         struct StreamedEntry
         {
@@ -34,7 +137,41 @@ namespace RB::Graphics
             List<Streamable> streamables;
         };
 
-        Queue<Streamable>	 m_Streamables;
+        struct PriorityRequest
+        {
+            const RenderResource*   resource;
+            StreamPriority          priority;
+        };
+
+        RenderInterface*     m_CopyInterface;
+        WorkerThread*        m_StreamThread;
+        JobTypeID            m_StreamJobType;
+
+        // Guards all the members below
+        CRITICAL_SECTION     m_CS;
+
+        // Filled by the scheduling threads, emptied by the streaming thread
+        List<Streamable>     m_Incoming;
+        List<PriorityRequest> m_PriorityRequests;
+
+        // Only used by the streaming thread
+        StreamQueue	         m_Streamables;
         List<StreamedEntry>	 m_StreamedEntries;
+
+        StreamBudget         m_Budget;
+        double               m_PerformanceFreqMs;
+
+        uint32_t             m_QueueDepth;
+        uint32_t             m_InFlightCount;
+        uint64_t             m_BytesStreamedLastFrame;
+        uint64_t             m_TotalBytesStreamed;
+        uint64_t             m_TotalResidentCount;
+        double               m_TotalTimeToResidentMs;
+
+        // Staging memory that is handed out, but not yet scheduled
+        FlatMap<void*, uint64_t> m_Reservations;
+        uint64_t             m_StagingBytesInUse;
+        uint64_t             m_PeakStagingBytes;
+        uint64_t             m_TotalBytesCopied;
     };
-}
\ No newline at end of file
+}
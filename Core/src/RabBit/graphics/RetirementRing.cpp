@@ -0,0 +1,79 @@
+#include "RabBitCommon.h"
+#include "RetirementRing.h"
+
+namespace RB::Graphics
+{
+    RetirementRing::RetirementRing(uint32_t initial_capacity)
+        : m_Buckets(Math::Max(initial_capacity, 2u))
+        , m_Head(0)
+        , m_SubmittedCount(0)
+        , m_FirstSubmission(0)
+        , m_LastFenceValue(0)
+        , m_ItemCount(0)
+    {
+    }
+
+    void RetirementRing::Add(uint64_t submission, uint32_t item)
+    {
+        GetBucket(submission).items.push_back(item);
+        m_ItemCount++;
+    }
+
+    void RetirementRing::Submit(uint64_t fence_value)
+    {
+        RB_ASSERT(LOGTAG_GRAPHICS, fence_value >= m_LastFenceValue, "Fence values of a queue should only grow");
+
+        // Make sure there is a bucket left for the next open submission
+        if (m_SubmittedCount + 2 > m_Buckets.size())
+        {
+            Grow();
+        }
+
+        GetBucket(GetOpenSubmission()).fenceValue = fence_value;
+        m_SubmittedCount++;
+        m_LastFenceValue = fence_value;
+    }
+
+    void RetirementRing::Retire(uint64_t completed_fence_value, List<uint32_t>& out_items)
+    {
+        while (m_SubmittedCount > 0 && m_Buckets[m_Head].fenceValue <= completed_fence_value)
+        {
+            List<uint32_t>& items = m_Buckets[m_Head].items;
+
+            out_items.insert(out_items.end(), items.begin(), items.end());
+            m_ItemCount -= items.size();
+            items.clear();
+
+            m_Head = (m_Head + 1) % m_Buckets.size();
+            m_SubmittedCount--;
+            m_FirstSubmission++;
+        }
+    }
+
+    void RetirementRing::RetireAll(List<uint32_t>& out_items)
+    {
+        Submit(m_LastFenceValue);
+        Retire(UINT64_MAX, out_items);
+    }
+
+    RetirementRing::Bucket& RetirementRing::GetBucket(uint64_t submission)
+    {
+        RB_ASSERT_FATAL(LOGTAG_GRAPHICS, !IsRetired(submission) && submission <= GetOpenSubmission(), "Submission is already retired or does not exist yet");
+
+        return m_Buckets[(m_Head + (submission - m_FirstSubmission)) % m_Buckets.size()];
+    }
+
+    void RetirementRing::Grow()
+    {
+        List<Bucket> buckets(m_Buckets.size() * 2);
+
+        // Unwrap the ring, so the first submission is at the start again
+        for (uint32_t i = 0; i <= m_SubmittedCount; ++i)
+        {
+            buckets[i] = std::move(m_Buckets[(m_Head + i) % m_Buckets.size()]);
+        }
+
+        m_Buckets = std::move(buckets);
+        m_Head = 0;
+    }
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "RabBitCommon.h"
+
+namespace RB::Graphics
+{
+    constexpr uint64_t kInvalidSubmission = UINT64_MAX;
+
+    // Buckets of items (e.g. indices of resources that are waiting for their release) per submission of a queue, without any API specific code.
+    // Items can be added to the open submission or to a submission that is still executing, and are handed back once the fence value of
+    // their submission has been reached. Adding is an append and retiring pops the finished buckets, the buckets keep their memory.
+    // Not thread safe.
+    class RetirementRing
+    {
+    public:
+        RetirementRing(uint32_t initial_capacity = 8);
+
+        // The submission that the work recorded right now ends up in
+        uint64_t GetOpenSubmission() const { return m_FirstSubmission + m_SubmittedCount; }
+
+        // Whether the submission is done and its items have been handed back
+        bool IsRetired(uint64_t submission) const { return submission < m_FirstSubmission; }
+
+        // The submission should not be retired yet
+        void Add(uint64_t submission, uint32_t item);
+
+        // Closes the open submission, its items are retired once the fence reaches this value
+        void Submit(uint64_t fence_value);
+
+        // Appends the items of all the finished submissions to out_items
+        void Retire(uint64_t completed_fence_value, List<uint32_t>& out_items);
+
+        // Hands back everything, including the items of the open submission. Should only be used when the queue is idle.
+        void RetireAll(List<uint32_t>& out_items);
+
+        uint64_t GetLastFenceValue() const { return m_LastFenceValue; }
+        uint32_t GetInFlightCount() const { return m_SubmittedCount; }
+        uint64_t GetItemCount() const { return m_ItemCount; }
+
+    private:
+        struct Bucket
+        {
+            uint64_t        fenceValue;
+            List<uint32_t>  items;
+        };
+
+        Bucket& GetBucket(uint64_t submission);
+        void    Grow();
+
+        // Ring of the submitted buckets followed by the open bucket, starting at m_Head
+        List<Bucket>    m_Buckets;
+        uint32_t        m_Head;
+        uint32_t        m_SubmittedCount;
+        uint64_t        m_FirstSubmission;
+        uint64_t        m_LastFenceValue;
+        uint64_t        m_ItemCount;
+    };
+}
@@ -0,0 +1,95 @@
+#include "RabBitCommon.h"
+#include "RingAllocator.h"
+
+namespace RB::Graphics
+{
+    RingAllocator::RingAllocator(uint64_t size)
+        : m_Size(size)
+        , m_Head(0)
+        , m_Tail(0)
+        , m_HighWaterMark(0)
+    {
+        RB_ASSERT_FATAL(LOGTAG_GRAPHICS, size > 0, "Cannot create a ring allocator without any space");
+    }
+
+    uint64_t RingAllocator::Allocate(uint64_t size, uint64_t alignment)
+    {
+        RB_ASSERT(LOGTAG_GRAPHICS, (m_Size % alignment) == 0, "The size of the ring should be a multiple of the alignment");
+
+        uint64_t head = m_Head.load(std::memory_order_relaxed);
+
+        while (true)
+        {
+            uint64_t start = Math::AlignUp(head, alignment);
+
+            // An allocation can not be split over the end of the ring, skip the rest of the ring instead
+            if ((start % m_Size) + size > m_Size)
+            {
+                start = ((start / m_Size) + 1) * m_Size;
+            }
+
+            uint64_t end = start + size;
+
+            // The tail only moves forward, so an old value can only make the ring look fuller than it is
+            uint64_t tail = m_Tail.load(std::memory_order_acquire);
+
+            if (size > m_Size || end - tail > m_Size)
+            {
+                return kInvalidRingOffset;
+            }
+
+            if (!m_Head.compare_exchange_weak(head, end, std::memory_order_acq_rel, std::memory_order_relaxed))
+            {
+                // Another thread allocated in the meantime, try again with its head
+                continue;
+            }
+
+            uint64_t used = end - tail;
+            uint64_t high_water_mark = m_HighWaterMark.load(std::memory_order_relaxed);
+
+            while (used > high_water_mark && !m_HighWaterMark.compare_exchange_weak(high_water_mark, used, std::memory_order_relaxed))
+            {
+            }
+
+            return start % m_Size;
+        }
+    }
+
+    void RingAllocator::Submit(uint64_t fence_value)
+    {
+        uint64_t head = m_Head.load(std::memory_order_acquire);
+
+        uint64_t last_head = m_Submissions.empty() ? m_Tail.load(std::memory_order_relaxed) : m_Submissions.back().head;
+
+        // Nothing has been allocated since the last submission
+        if (head == last_head)
+        {
+            return;
+        }
+
+        m_Submissions.push_back({ fence_value, head });
+    }
+
+    void RingAllocator::Retire(uint64_t completed_fence_value)
+    {
+        while (!m_Submissions.empty() && m_Submissions.front().fenceValue <= completed_fence_value)
+        {
+            m_Tail.store(m_Submissions.front().head, std::memory_order_release);
+            m_Submissions.pop_front();
+        }
+    }
+
+    uint64_t RingAllocator::GetUsed() const
+    {
+        // Load the tail first, so it can never be ahead of the head
+        uint64_t tail = m_Tail.load(std::memory_order_acquire);
+        uint64_t head = m_Head.load(std::memory_order_acquire);
+
+        return head - tail;
+    }
+
+    void RingAllocator::ResetHighWaterMark()
+    {
+        m_HighWaterMark.store(GetUsed(), std::memory_order_relaxed);
+    }
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "RabBitCommon.h"
+
+namespace RB::Graphics
+{
+    // Returned by RingAllocator::Allocate when the allocation does not fit
+    constexpr uint64_t kInvalidRingOffset = UINT64_MAX;
+
+    // Offset bookkeeping of a ring that is written by the CPU and read by the GPU, without any API specific code or unit (bytes, descriptors).
+    // The offsets only grow (the offset in the ring is the offset modulo the size), so the used space is always [tail, head).
+    // Space is given back once the fence value of the submission that used it has been reached.
+    //
+    // Allocate is lock free and can be called from multiple threads at the same time,
+    // Submit and Retire should only be called from the thread that executes the work.
+    class RingAllocator
+    {
+    public:
+        RingAllocator(uint64_t size);
+
+        // Returns the offset in the ring, or kInvalidRingOffset when there is not enough free space.
+        // An allocation is never split over the end of the ring. The alignment should be a power of 2 and the size of the ring a multiple of it.
+        uint64_t Allocate(uint64_t size, uint64_t alignment = 1);
+
+        // All the allocations that are done before this call are used by the work that signals this fence value
+        void     Submit(uint64_t fence_value);
+
+        // Frees the space of all the submissions that have been finished
+        void     Retire(uint64_t completed_fence_value);
+
+        uint64_t GetSize() const { return m_Size; }
+        // Allocated, but not yet retired (including the padding at the end of the ring)
+        uint64_t GetUsed() const;
+
+        // Highest used amount since the creation (or the last ResetHighWaterMark)
+        uint64_t GetHighWaterMark() const { return m_HighWaterMark.load(std::memory_order_relaxed); }
+        void     ResetHighWaterMark();
+
+    private:
+        struct Submission
+        {
+            uint64_t    fenceValue;
+            uint64_t    head;
+        };
+
+        const uint64_t          m_Size;
+
+        std::atomic<uint64_t>   m_Head;
+        std::atomic<uint64_t>   m_Tail;
+        std::atomic<uint64_t>   m_HighWaterMark;
+
+        // Only used by the executing thread
+        Deque<Submission>       m_Submissions;
+    };
+}
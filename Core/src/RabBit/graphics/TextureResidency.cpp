@@ -0,0 +1,525 @@
+#include "RabBitCommon.h"
+#include "TextureResidency.h"
+#include "Renderer.h"
+#include "ResourceStreamer.h"
+
+#include "app/Application.h"
+
+namespace RB::Graphics
+{
+    uint32_t GetMipLevelCount(uint32_t width, uint32_t height)
+    {
+        uint32_t size  = Math::Max(width, height);
+        uint32_t count = 1;
+
+        while (size > 1)
+        {
+            size >>= 1;
+            count++;
+        }
+
+        return Math::Min(count, (uint32_t)MAX_TEXTURE_SUBRESOURCE_COUNT);
+    }
+
+    uint64_t GetMipSize(uint32_t width, uint32_t height, uint32_t bytes_per_pixel, uint32_t mip)
+    {
+        uint64_t mip_width  = Math::Max(width >> mip, 1u);
+        uint64_t mip_height = Math::Max(height >> mip, 1u);
+
+        return mip_width * mip_height * bytes_per_pixel;
+    }
+
+    uint64_t GetMipChainSize(uint32_t width, uint32_t height, uint32_t bytes_per_pixel, uint32_t first_mip, uint32_t mip_count)
+    {
+        uint64_t size = 0;
+
+        for (uint32_t mip = first_mip; mip < mip_count; ++mip)
+        {
+            size += GetMipSize(width, height, bytes_per_pixel, mip);
+        }
+
+        return size;
+    }
+
+    uint32_t GetDesiredMip(uint32_t width, uint32_t height, uint32_t mip_count, float screen_size)
+    {
+        if (screen_size <= 0.0f)
+        {
+            return mip_count - 1;
+        }
+
+        float texels_per_pixel = float(Math::Max(width, height)) / screen_size;
+
+        if (texels_per_pixel <= 1.0f)
+        {
+            return 0;
+        }
+
+        uint32_t mip = (uint32_t)Math::Floor(std::log2(texels_per_pixel));
+
+        return Math::Min(mip, mip_count - 1);
+    }
+
+    // ---------------------------------------------------------------------------
+    //						    TextureResidencyPolicy
+    // ---------------------------------------------------------------------------
+
+    StreamedTextureID TextureResidencyPolicy::Register(uint32_t width, uint32_t height, uint32_t mip_count, uint32_t bytes_per_pixel)
+    {
+        RB_ASSERT(LOGTAG_GRAPHICS, mip_count > 0, "A streamed texture needs at least one mip");
+
+        Entry entry = {};
+        entry.width         = width;
+        entry.height        = height;
+        entry.mipCount      = mip_count;
+        entry.bytesPerPixel = bytes_per_pixel;
+        entry.residentMip   = mip_count;
+        entry.registered    = true;
+
+        // The coarse mips are so small that they are always kept resident
+        entry.tailMip = 0;
+        while (entry.tailMip < mip_count - 1 && Math::Max(width >> entry.tailMip, height >> entry.tailMip) > kTextureResidencyTailSize)
+        {
+            entry.tailMip++;
+        }
+
+        entry.requestedMip = entry.tailMip;
+
+        if (!m_FreeIDs.empty())
+        {
+            StreamedTextureID id = m_FreeIDs.back();
+            m_FreeIDs.pop_back();
+
+            m_Entries[id] = entry;
+            return id;
+        }
+
+        m_Entries.push_back(entry);
+        return m_Entries.size() - 1;
+    }
+
+    void TextureResidencyPolicy::Unregister(StreamedTextureID id)
+    {
+        RB_ASSERT(LOGTAG_GRAPHICS, id < m_Entries.size() && m_Entries[id].registered, "Unregistering a texture that is not registered");
+
+        m_Entries[id].registered = false;
+        m_FreeIDs.push_back(id);
+    }
+
+    void TextureResidencyPolicy::RequestMip(StreamedTextureID id, uint32_t mip, uint64_t frame_index)
+    {
+        Entry& entry = m_Entries[id];
+
+        mip = Math::Min(mip, entry.tailMip);
+
+        if (!entry.requested || entry.requestFrame != frame_index)
+        {
+            entry.requestedMip = mip;
+        }
+        else
+        {
+            entry.requestedMip = Math::Min(entry.requestedMip, mip);
+        }
+
+        entry.requested    = true;
+        entry.requestFrame = frame_index;
+    }
+
+    void TextureResidencyPolicy::SetResidentMip(StreamedTextureID id, uint32_t mip)
+    {
+        Entry& entry = m_Entries[id];
+        entry.residentMip   = mip;
+        entry.actionPending = false;
+    }
+
+    void TextureResidencyPolicy::Update(uint64_t frame_index, uint64_t budget, List<TextureResidencyAction>& out_actions)
+    {
+        List<uint32_t> wanted_mips(m_Entries.size(), 0);
+        List<StreamedTextureID> candidates;
+        uint64_t wanted_bytes = 0;
+
+        for (StreamedTextureID id = 0; id < m_Entries.size(); ++id)
+        {
+            const Entry& entry = m_Entries[id];
+
+            if (!entry.registered)
+            {
+                continue;
+            }
+
+            bool used = entry.requested && (frame_index - entry.requestFrame) <= kTextureResidencyUnusedFrames;
+
+            wanted_mips[id] = used ? entry.requestedMip : entry.tailMip;
+            wanted_bytes   += GetEntryBytes(entry, wanted_mips[id]);
+
+            if (wanted_mips[id] < entry.tailMip)
+            {
+                candidates.push_back(id);
+            }
+        }
+
+        if (wanted_bytes > budget)
+        {
+            // Drop the fine mips of the least recently used textures first, and of the biggest ones when used in the same frame
+            std::sort(candidates.begin(), candidates.end(), [&](StreamedTextureID a, StreamedTextureID b)
+            {
+                if (m_Entries[a].requestFrame != m_Entries[b].requestFrame)
+                {
+                    return m_Entries[a].requestFrame < m_Entries[b].requestFrame;
+                }
+
+                return GetEntryBytes(m_Entries[a], wanted_mips[a]) > GetEntryBytes(m_Entries[b], wanted_mips[b]);
+            });
+
+            for (StreamedTextureID id : candidates)
+            {
+                const Entry& entry = m_Entries[id];
+
+                while (wanted_bytes > budget && wanted_mips[id] < entry.tailMip)
+                {
+                    wanted_bytes -= GetMipSize(entry.width, entry.height, entry.bytesPerPixel, wanted_mips[id]);
+                    wanted_mips[id]++;
+                }
+
+                if (wanted_bytes <= budget)
+                {
+                    break;
+                }
+            }
+        }
+
+        uint32_t changes = 0;
+
+        // Evictions are started first, as they make room for the loads
+        for (StreamedTextureID id = 0; id < m_Entries.size() && changes < kTextureResidencyMaxChanges; ++id)
+        {
+            Entry& entry = m_Entries[id];
+
+            if (!entry.registered || entry.actionPending || entry.residentMip >= wanted_mips[id])
+            {
+                continue;
+            }
+
+            entry.actionPending = true;
+            entry.pendingMip    = wanted_mips[id];
+
+            out_actions.push_back({ id, TextureResidencyActionType::Evict, entry.pendingMip, entry.requestFrame == frame_index });
+            changes++;
+        }
+
+        // The memory that is used once all the started actions are finished
+        uint64_t committed_bytes = 0;
+        List<StreamedTextureID> loads;
+
+        for (StreamedTextureID id = 0; id < m_Entries.size(); ++id)
+        {
+            const Entry& entry = m_Entries[id];
+
+            if (!entry.registered)
+            {
+                continue;
+            }
+
+            committed_bytes += GetEntryBytes(entry, entry.actionPending ? entry.pendingMip : entry.residentMip);
+
+            if (!entry.actionPending && entry.residentMip > wanted_mips[id])
+            {
+                loads.push_back(id);
+            }
+        }
+
+        // Textures without anything resident first, then the most recently used ones, then the ones that are furthest from their wanted mip
+        std::sort(loads.begin(), loads.end(), [&](StreamedTextureID a, StreamedTextureID b)
+        {
+            const Entry& entry_a = m_Entries[a];
+            const Entry& entry_b = m_Entries[b];
+
+            bool resident_a = entry_a.residentMip < entry_a.mipCount;
+            bool resident_b = entry_b.residentMip < entry_b.mipCount;
+
+            if (resident_a != resident_b)
+            {
+                return !resident_a;
+            }
+
+            if (entry_a.requestFrame != entry_b.requestFrame)
+            {
+                return entry_a.requestFrame > entry_b.requestFrame;
+            }
+
+            return (entry_a.residentMip - wanted_mips[a]) > (entry_b.residentMip - wanted_mips[b]);
+        });
+
+        for (StreamedTextureID id : loads)
+        {
+            if (changes >= kTextureResidencyMaxChanges)
+            {
+                break;
+            }
+
+            Entry& entry = m_Entries[id];
+
+            // Only go one mip finer at a time, so the texture quickly gets better instead of waiting on the full chain
+            bool     first_load = entry.residentMip == entry.mipCount;
+            uint32_t mip        = first_load ? entry.tailMip : entry.residentMip - 1;
+            uint64_t extra      = GetEntryBytes(entry, mip) - GetEntryBytes(entry, entry.residentMip);
+
+            // The tail is always loaded, otherwise the texture could never be shown
+            if (!first_load && committed_bytes + extra > budget)
+            {
+                continue;
+            }
+
+            committed_bytes    += extra;
+            entry.actionPending = true;
+            entry.pendingMip    = mip;
+
+            out_actions.push_back({ id, TextureResidencyActionType::Load, mip, entry.requestFrame == frame_index });
+            changes++;
+        }
+    }
+
+    uint32_t TextureResidencyPolicy::GetResidentMip(StreamedTextureID id) const
+    {
+        return m_Entries[id].residentMip;
+    }
+
+    uint32_t TextureResidencyPolicy::GetTailMip(StreamedTextureID id) const
+    {
+        return m_Entries[id].tailMip;
+    }
+
+    bool TextureResidencyPolicy::IsActionPending(StreamedTextureID id) const
+    {
+        return m_Entries[id].actionPending;
+    }
+
+    uint64_t TextureResidencyPolicy::GetResidentBytes() const
+    {
+        uint64_t bytes = 0;
+
+        for (const Entry& entry : m_Entries)
+        {
+            if (entry.registered)
+            {
+                bytes += GetEntryBytes(entry, entry.residentMip);
+            }
+        }
+
+        return bytes;
+    }
+
+    uint32_t TextureResidencyPolicy::GetTextureCount() const
+    {
+        return m_Entries.size() - m_FreeIDs.size();
+    }
+
+    uint64_t TextureResidencyPolicy::GetEntryBytes(const Entry& entry, uint32_t first_mip) const
+    {
+        return GetMipChainSize(entry.width, entry.height, entry.bytesPerPixel, first_mip, entry.mipCount);
+    }
+
+    // ---------------------------------------------------------------------------
+    //						    TextureResidencyManager
+    // ---------------------------------------------------------------------------
+
+    TextureResidencyManager::TextureResidencyManager()
+        : m_Budget(kDefaultTextureResidencyBudget)
+        , m_FrameIndex(0)
+        , m_TotalLoads(0)
+        , m_TotalEvictions(0)
+    {
+    }
+
+    // Should only be deleted once the ResourceStreamer is done with all the textures
+    TextureResidencyManager::~TextureResidencyManager()
+    {
+        for (StreamedTexture& texture : m_Textures)
+        {
+            SAFE_DELETE(texture.resident);
+            SAFE_DELETE(texture.pending);
+            SAFE_FREE(texture.mipChain);
+        }
+
+        for (RetiredTexture& retired : m_Retired)
+        {
+            delete retired.texture;
+        }
+
+        m_Textures.clear();
+        m_Retired.clear();
+    }
+
+    StreamedTextureID TextureResidencyManager::Register(const char* name, void* mip_chain, RenderResourceFormat format, uint32_t width, uint32_t height, uint32_t mip_count, TextureColorSpace color_space)
+    {
+        StreamedTextureID id = m_Policy.Register(width, height, mip_count, GetElementSizeFromFormat(format));
+
+        if (id >= m_Textures.size())
+        {
+            m_Textures.resize(id + 1);
+        }
+
+        StreamedTexture& texture = m_Textures[id];
+        texture = {};
+        texture.name        = name;
+        texture.mipChain    = (uint8_t*)mip_chain;
+        texture.format      = format;
+        texture.width       = width;
+        texture.height      = height;
+        texture.mipCount    = mip_count;
+        texture.colorSpace  = color_space;
+
+        return id;
+    }
+
+    void TextureResidencyManager::Unregister(StreamedTextureID id)
+    {
+        StreamedTexture& texture = m_Textures[id];
+
+        Retire(texture.resident);
+        Retire(texture.pending);
+
+        // The streamer has its own copy of the data that is still being uploaded
+        SAFE_FREE(texture.mipChain);
+
+        texture = {};
+
+        m_Policy.Unregister(id);
+    }
+
+    Texture2D* TextureResidencyManager::GetTexture(StreamedTextureID id) const
+    {
+        if (id == kInvalidStreamedTexture)
+        {
+            return nullptr;
+        }
+
+        return m_Textures[id].resident;
+    }
+
+    void TextureResidencyManager::RequestScreenSize(StreamedTextureID id, float screen_size)
+    {
+        const StreamedTexture& texture = m_Textures[id];
+
+        m_Policy.RequestMip(id, GetDesiredMip(texture.width, texture.height, texture.mipCount, screen_size), m_FrameIndex);
+    }
+
+    void TextureResidencyManager::Update()
+    {
+        // Swap in the textures that finished streaming
+        for (StreamedTextureID id = 0; id < m_Textures.size(); ++id)
+        {
+            StreamedTexture& texture = m_Textures[id];
+
+            if (texture.pending == nullptr || !texture.pending->ReadyToRender())
+            {
+                continue;
+            }
+
+            Retire(texture.resident);
+
+            texture.resident = texture.pending;
+            texture.pending  = nullptr;
+
+            m_Policy.SetResidentMip(id, texture.pendingMip);
+        }
+
+        // Delete the replaced textures once the render thread can not be using them anymore (the GPU side is kept alive by the ResourceManager)
+        uint64_t render_frame_index = Application::GetInstance()->GetRenderer()->GetRenderFrameIndex();
+
+        for (int32_t i = m_Retired.size() - 1; i >= 0; --i)
+        {
+            RetiredTexture& retired = m_Retired[i];
+
+            // The streamer might still be using the texture when it was retired while streaming
+            if (retired.texture->IsStreaming() || render_frame_index < retired.renderFrameIndex + kTextureResidencyRetireFrames)
+            {
+                continue;
+            }
+
+            retired.texture->TransitionResidency(ResidencyState::Resident, ResidencyState::Evicting);
+
+            delete retired.texture;
+
+            m_Retired[i] = m_Retired.back();
+            m_Retired.pop_back();
+        }
+
+        m_Actions.clear();
+        m_Policy.Update(m_FrameIndex, m_Budget, m_Actions);
+
+        ResourceStreamer* streamer = Application::GetInstance()->GetRenderer()->GetStreamer();
+
+        for (const TextureResidencyAction& action : m_Actions)
+        {
+            StreamedTexture& texture = m_Textures[action.id];
+
+            uint32_t bytes_per_pixel = GetElementSizeFromFormat(texture.format);
+            uint64_t offset          = GetMipChainSize(texture.width, texture.height, bytes_per_pixel, 0, action.mip);
+            uint64_t size            = GetMipChainSize(texture.width, texture.height, bytes_per_pixel, action.mip, texture.mipCount);
+
+            // A new texture that only contains the wanted mips, the current texture keeps being used until this one is streamed
+            texture.pending = Texture2D::Create(texture.name,
+                                                texture.mipChain + offset,
+                                                size,
+                                                texture.format,
+                                                Math::Max(texture.width >> action.mip, 1u),
+                                                Math::Max(texture.height >> action.mip, 1u),
+                                                false,
+                                                false,
+                                                texture.colorSpace,
+                                                StreamDataMode::Copy,
+                                                texture.mipCount - action.mip);
+            texture.pendingMip = action.mip;
+
+            if (action.type == TextureResidencyActionType::Load)
+            {
+                m_TotalLoads++;
+
+                if (action.visible)
+                {
+                    streamer->Prioritize(texture.pending, StreamPriority::Visible);
+                }
+            }
+            else
+            {
+                m_TotalEvictions++;
+            }
+        }
+
+        m_FrameIndex++;
+    }
+
+    TextureResidencyStats TextureResidencyManager::GetStats() const
+    {
+        TextureResidencyStats stats = {};
+        stats.textureCount      = m_Policy.GetTextureCount();
+        stats.residentBytes     = m_Policy.GetResidentBytes();
+        stats.budgetBytes       = m_Budget;
+        stats.totalLoads        = m_TotalLoads;
+        stats.totalEvictions    = m_TotalEvictions;
+
+        for (const StreamedTexture& texture : m_Textures)
+        {
+            if (texture.pending != nullptr)
+            {
+                stats.pendingCount++;
+            }
+        }
+
+        return stats;
+    }
+
+    void TextureResidencyManager::Retire(Texture2D* texture)
+    {
+        if (texture == nullptr)
+        {
+            return;
+        }
+
+        // Textures that are still streaming are marked once they are resident
+        texture->TransitionResidency(ResidencyState::Resident, ResidencyState::Evicting);
+
+        m_Retired.push_back({ texture, Application::GetInstance()->GetRenderer()->GetRenderFrameIndex() });
+    }
+}
@@ -0,0 +1,166 @@
+#pragma once
+
+#include "RabBitCommon.h"
+#include "RenderResource.h"
+
+namespace RB::Graphics
+{
+    // All the streamed textures together may use this much GPU memory
+    constexpr uint64_t kDefaultTextureResidencyBudget   = k256MB;
+    // Mips with a width and height of this size or smaller are always resident, it is the first thing that gets streamed in
+    constexpr uint32_t kTextureResidencyTailSize        = 64;
+    // Textures that have not been requested for this many frames drop back to their tail mip
+    constexpr uint32_t kTextureResidencyUnusedFrames    = 60;
+    // Upper limit of residency changes that are started per frame
+    constexpr uint32_t kTextureResidencyMaxChanges      = 16;
+    // Replaced textures are kept alive for this many rendered frames, as the render thread might still be using them
+    constexpr uint32_t kTextureResidencyRetireFrames    = 2;
+
+    using StreamedTextureID = uint32_t;
+    constexpr StreamedTextureID kInvalidStreamedTexture = UINT32_MAX;
+
+    // Amount of mips of a full mip chain (down to 1x1)
+    uint32_t GetMipLevelCount(uint32_t width, uint32_t height);
+    uint64_t GetMipSize(uint32_t width, uint32_t height, uint32_t bytes_per_pixel, uint32_t mip);
+    // Size of the mips [first_mip, mip_count), tightly packed from fine to coarse
+    uint64_t GetMipChainSize(uint32_t width, uint32_t height, uint32_t bytes_per_pixel, uint32_t first_mip, uint32_t mip_count);
+    // The finest mip that is still useful when the texture covers screen_size pixels (along its biggest axis)
+    uint32_t GetDesiredMip(uint32_t width, uint32_t height, uint32_t mip_count, float screen_size);
+
+    enum class TextureResidencyActionType
+    {
+        Load,   // Make a finer mip resident
+        Evict   // Drop the finest mips
+    };
+
+    struct TextureResidencyAction
+    {
+        StreamedTextureID           id;
+        TextureResidencyActionType  type;
+        uint32_t                    mip;        // The finest mip that should be resident after the action
+        bool                        visible;    // Requested during the current frame
+    };
+
+    // Decides which mips of the streamed textures should be resident. Only does the bookkeeping, so it can be used without a GPU.
+    // Textures are loaded one mip at a time (coarsest first) and the fine mips of the least recently used textures are
+    // evicted first when the wanted mips do not fit in the budget.
+    class TextureResidencyPolicy
+    {
+    public:
+        StreamedTextureID Register(uint32_t width, uint32_t height, uint32_t mip_count, uint32_t bytes_per_pixel);
+        void Unregister(StreamedTextureID id);
+
+        // Requests can be done multiple times per frame (e.g. for multiple views), the finest requested mip is used
+        void RequestMip(StreamedTextureID id, uint32_t mip, uint64_t frame_index);
+
+        // Should be called when an action has been finished (or was cancelled with the mip that is actually resident)
+        void SetResidentMip(StreamedTextureID id, uint32_t mip);
+
+        // Outputs the actions that should be started this frame. No new actions are given for a texture until its
+        // previous action has been finished with SetResidentMip.
+        void Update(uint64_t frame_index, uint64_t budget, List<TextureResidencyAction>& out_actions);
+
+        // Returns the mip count of the texture when nothing is resident yet
+        uint32_t GetResidentMip(StreamedTextureID id) const;
+        uint32_t GetTailMip(StreamedTextureID id) const;
+        bool     IsActionPending(StreamedTextureID id) const;
+
+        uint64_t GetResidentBytes() const;
+        uint32_t GetTextureCount() const;
+
+    private:
+        struct Entry
+        {
+            uint32_t    width;
+            uint32_t    height;
+            uint32_t    mipCount;
+            uint32_t    tailMip;
+            uint32_t    bytesPerPixel;
+            uint32_t    residentMip;
+            uint32_t    requestedMip;
+            uint32_t    pendingMip;
+            uint64_t    requestFrame;
+            bool        requested;
+            bool        actionPending;
+            bool        registered;
+        };
+
+        uint64_t GetEntryBytes(const Entry& entry, uint32_t first_mip) const;
+
+        List<Entry>             m_Entries;
+        List<StreamedTextureID> m_FreeIDs;
+    };
+
+    struct TextureResidencyStats
+    {
+        uint32_t    textureCount;
+        uint32_t    pendingCount;       // Textures that are waiting on the streamer for a residency change
+        uint64_t    residentBytes;
+        uint64_t    budgetBytes;
+        uint64_t    totalLoads;
+        uint64_t    totalEvictions;
+    };
+
+    // Streams textures mip by mip using the TextureResidencyPolicy. A residency change creates a new texture with only the wanted
+    // mips (uploaded from the CPU mip chain by the ResourceStreamer), which replaces the current texture once it is ready to render.
+    // Should only be used from the main thread.
+    class TextureResidencyManager
+    {
+    public:
+        TextureResidencyManager();
+        ~TextureResidencyManager();
+
+        // Takes ownership of the mip chain (allocated with ALLOC_HEAP), the mips are tightly packed from fine to coarse.
+        // The name has to stay alive as long as the texture is registered.
+        StreamedTextureID Register(const char* name, void* mip_chain, RenderResourceFormat format, uint32_t width, uint32_t height, uint32_t mip_count, TextureColorSpace color_space);
+        void Unregister(StreamedTextureID id);
+
+        // Returns nullptr when no mip is resident yet
+        Texture2D* GetTexture(StreamedTextureID id) const;
+
+        // Screen space size (in pixels) of the object using the texture
+        void RequestScreenSize(StreamedTextureID id, float screen_size);
+
+        // Swaps in the finished textures and starts the residency changes of this frame, should be called once per frame
+        // after all the requests have been made
+        void Update();
+
+        void     SetBudget(uint64_t budget) { m_Budget = budget; }
+        uint64_t GetBudget() const { return m_Budget; }
+
+        TextureResidencyStats GetStats() const;
+
+    private:
+        struct StreamedTexture
+        {
+            const char*             name;
+            uint8_t*                mipChain;
+            RenderResourceFormat    format;
+            uint32_t                width;
+            uint32_t                height;
+            uint32_t                mipCount;
+            TextureColorSpace       colorSpace;
+            Texture2D*              resident;
+            Texture2D*              pending;
+            uint32_t                pendingMip;
+        };
+
+        struct RetiredTexture
+        {
+            Texture2D*  texture;
+            uint64_t    renderFrameIndex;
+        };
+
+        void Retire(Texture2D* texture);
+
+        TextureResidencyPolicy          m_Policy;
+        List<StreamedTexture>           m_Textures;
+        List<RetiredTexture>            m_Retired;
+        List<TextureResidencyAction>    m_Actions;
+
+        uint64_t                        m_Budget;
+        uint64_t                        m_FrameIndex;
+        uint64_t                        m_TotalLoads;
+        uint64_t                        m_TotalEvictions;
+    };
+}
@@ -0,0 +1,47 @@
+#include "RabBitCommon.h"
+#include "UploadRing.h"
+
+namespace RB::Graphics
+{
+    UploadRing::UploadRing(uint64_t size)
+        : m_Ring(size)
+        , m_OverflowCount(0)
+        , m_OverflowBytes(0)
+    {
+    }
+
+    uint64_t UploadRing::Allocate(uint64_t size, uint64_t alignment)
+    {
+        uint64_t offset = m_Ring.Allocate(size, alignment);
+
+        if (offset == kInvalidRingOffset)
+        {
+            m_OverflowCount.fetch_add(1, std::memory_order_relaxed);
+            m_OverflowBytes.fetch_add(size, std::memory_order_relaxed);
+        }
+
+        return offset;
+    }
+
+    UploadRingStats UploadRing::GetStats() const
+    {
+        UploadRingStats stats = {};
+        stats.size          = m_Ring.GetSize();
+        stats.usedBytes     = m_Ring.GetUsed();
+        stats.highWaterMark = m_Ring.GetHighWaterMark();
+        stats.overflowCount = m_OverflowCount.load(std::memory_order_relaxed);
+        stats.overflowBytes = m_OverflowBytes.load(std::memory_order_relaxed);
+
+        return stats;
+    }
+
+    bool IsUploadDestinationState(RenderResourceType primitive_type, ResourceState state)
+    {
+        if (state == ResourceState::COMMON)
+        {
+            return true;
+        }
+
+        return primitive_type == RenderResourceType::Texture && state == ResourceState::COPY_DEST;
+    }
+}
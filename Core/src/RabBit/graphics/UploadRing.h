@@ -0,0 +1,53 @@
+#pragma once
+
+#include "RabBitCommon.h"
+#include "RenderResource.h"
+#include "RingAllocator.h"
+
+namespace RB::Graphics
+{
+    // Whether a resource in this state can be the destination of an upload on a copy queue. Copy queues only use resources in
+    // the common state, but textures are created as copy destination (see ResourceManager) so that state is valid for them as well.
+    bool IsUploadDestinationState(RenderResourceType primitive_type, ResourceState state);
+
+    struct UploadRingStats
+    {
+        uint64_t    size;
+        uint64_t    usedBytes;          // Allocated, but not yet retired (including the padding at the end of the ring)
+        uint64_t    highWaterMark;      // Highest usedBytes since the creation (or the last ResetHighWaterMark)
+        uint64_t    overflowCount;      // Allocations that did not fit in the ring
+        uint64_t    overflowBytes;
+    };
+
+    // The bytes of an upload buffer, see RingAllocator. Keeps track of the allocations that did not fit, the caller should
+    // fall back to a dedicated resource for those (kInvalidRingOffset).
+    //
+    // Allocate is lock free and can be called from multiple threads at the same time,
+    // Submit and Retire should only be called from the thread that executes the work.
+    class UploadRing
+    {
+    public:
+        UploadRing(uint64_t size);
+
+        // Returns the offset in the buffer, or kInvalidRingOffset when there is not enough free space.
+        // The alignment should be a power of 2 and the size of the ring should be a multiple of it.
+        uint64_t Allocate(uint64_t size, uint64_t alignment);
+
+        // All the allocations that are done before this call are used by the work that signals this fence value
+        void Submit(uint64_t fence_value) { m_Ring.Submit(fence_value); }
+
+        // Frees the space of all the submissions that have been finished
+        void Retire(uint64_t completed_fence_value) { m_Ring.Retire(completed_fence_value); }
+
+        uint64_t        GetSize() const { return m_Ring.GetSize(); }
+        UploadRingStats GetStats() const;
+
+        void ResetHighWaterMark() { m_Ring.ResetHighWaterMark(); }
+
+    private:
+        RingAllocator           m_Ring;
+
+        std::atomic<uint64_t>   m_OverflowCount;
+        std::atomic<uint64_t>   m_OverflowBytes;
+    };
+}
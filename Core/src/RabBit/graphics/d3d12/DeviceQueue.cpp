@@ -161,6 +161,11 @@ namespace RB::Graphics::D3D12
         return m_Fence->GetCompletedValue() >= fence_value;
     }
 
+    uint64_t DeviceQueue::GetCompletedFenceValue()
+    {
+        return m_Fence->GetCompletedValue();
+    }
+
     void DeviceQueue::CpuWaitForFenceValue(uint64_t fence_value, uint64_t max_duration_ms)
     {
         if (IsFenceReached(fence_value))
@@ -0,0 +1,92 @@
+#include "RabBitCommon.h"
+#include "GpuProfilerD3D12.h"
+#include "RenderInterfaceD3D12.h"
+#include "DeviceQueue.h"
+#include "GraphicsDevice.h"
+
+namespace RB::Graphics::D3D12
+{
+    GpuTimestampBackendD3D12::GpuTimestampBackendD3D12(RenderInterfaceD3D12* render_interface, DeviceQueue* queue, uint32_t query_count)
+        : m_Interface(render_interface)
+        , m_Queue(queue)
+        , m_ReadbackData(nullptr)
+        , m_GpuFrequency(1)
+        , m_GpuCalibration(0)
+        , m_CpuCalibration(0)
+    {
+        RB_ASSERT_FATAL(LOGTAG_GRAPHICS, queue->GetType() != D3D12_COMMAND_LIST_TYPE_COPY, "Timestamps of the copy queue are not supported");
+
+        D3D12_QUERY_HEAP_DESC heap_desc = {};
+        heap_desc.Type  = D3D12_QUERY_HEAP_TYPE_TIMESTAMP;
+        heap_desc.Count = query_count;
+
+        RB_ASSERT_FATAL_RELEASE_D3D(g_GraphicsDevice->Get()->CreateQueryHeap(&heap_desc, IID_PPV_ARGS(&m_QueryHeap)), "Could not create timestamp query heap");
+        m_QueryHeap->SetName(L"Timestamp Query Heap");
+
+        RB_ASSERT_FATAL_RELEASE_D3D(g_GraphicsDevice->Get()->CreateCommittedResource(
+            &CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_READBACK),
+            D3D12_HEAP_FLAG_NONE,
+            &CD3DX12_RESOURCE_DESC::Buffer(query_count * sizeof(uint64_t)),
+            D3D12_RESOURCE_STATE_COPY_DEST,
+            nullptr,
+            IID_PPV_ARGS(&m_ReadbackBuffer)
+        ), "Could not create timestamp readback buffer");
+        m_ReadbackBuffer->SetName(L"Timestamp Readback");
+
+        // Readback resources can stay mapped, the data is only read once the GPU is done writing it
+        m_ReadbackBuffer->Map(0, nullptr, (void**)&m_ReadbackData);
+
+        RB_ASSERT_FATAL_RELEASE_D3D(m_Queue->GetCommandQueue()->GetTimestampFrequency(&m_GpuFrequency), "Could not retrieve the timestamp frequency");
+
+        Calibrate();
+    }
+
+    GpuTimestampBackendD3D12::~GpuTimestampBackendD3D12()
+    {
+        D3D12_RANGE written_range = { 0, 0 };
+        m_ReadbackBuffer->Unmap(0, &written_range);
+    }
+
+    void GpuTimestampBackendD3D12::WriteTimestamp(uint32_t query)
+    {
+        m_Interface->GetCommandList()->EndQuery(m_QueryHeap.Get(), D3D12_QUERY_TYPE_TIMESTAMP, query);
+    }
+
+    void GpuTimestampBackendD3D12::ResolveTimestamps(uint32_t first_query, uint32_t query_count)
+    {
+        m_Interface->GetCommandList()->ResolveQueryData(m_QueryHeap.Get(), D3D12_QUERY_TYPE_TIMESTAMP, first_query, query_count,
+            m_ReadbackBuffer.Get(), first_query * sizeof(uint64_t));
+    }
+
+    void GpuTimestampBackendD3D12::ReadTimestamps(uint32_t first_query, uint32_t query_count, uint64_t* out_ticks)
+    {
+        memcpy(out_ticks, m_ReadbackData + first_query, query_count * sizeof(uint64_t));
+
+        // Keeps the clocks from drifting apart, this only happens once per finished submission
+        Calibrate();
+    }
+
+    uint64_t GpuTimestampBackendD3D12::ToProfileTimestamp(uint64_t ticks)
+    {
+        int64_t delta_ticks = (int64_t)(ticks - m_GpuCalibration);
+        return m_CpuCalibration + (int64_t)((double)delta_ticks * 1e9 / (double)m_GpuFrequency);
+    }
+
+    void GpuTimestampBackendD3D12::Calibrate()
+    {
+        uint64_t gpu_timestamp, cpu_timestamp;
+        if (FAILED(m_Queue->GetCommandQueue()->GetClockCalibration(&gpu_timestamp, &cpu_timestamp)))
+        {
+            // Keep using the previous calibration
+            return;
+        }
+
+        LARGE_INTEGER frequency;
+        QueryPerformanceFrequency(&frequency);
+
+        // The same conversion as the steady clock, which is used by the CPU profiler
+        uint64_t cpu_frequency = frequency.QuadPart;
+        m_CpuCalibration = (cpu_timestamp / cpu_frequency) * 1000000000ull + (cpu_timestamp % cpu_frequency) * 1000000000ull / cpu_frequency;
+        m_GpuCalibration = gpu_timestamp;
+    }
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "graphics/GpuProfiler.h"
+
+#include <d3d12.h>
+
+namespace RB::Graphics::D3D12
+{
+    class DeviceQueue;
+    class RenderInterfaceD3D12;
+
+    // Timestamp queries of a direct or compute queue, resolved into a readback buffer that stays mapped
+    class GpuTimestampBackendD3D12 : public GpuTimestampBackend
+    {
+    public:
+        GpuTimestampBackendD3D12(RenderInterfaceD3D12* render_interface, DeviceQueue* queue, uint32_t query_count);
+        // Should only be deleted when the GPU is done with all the submissions
+        ~GpuTimestampBackendD3D12();
+
+        void     WriteTimestamp(uint32_t query) override;
+        void     ResolveTimestamps(uint32_t first_query, uint32_t query_count) override;
+        void     ReadTimestamps(uint32_t first_query, uint32_t query_count, uint64_t* out_ticks) override;
+        uint64_t ToProfileTimestamp(uint64_t ticks) override;
+
+    private:
+        void Calibrate();
+
+        RenderInterfaceD3D12*   m_Interface;
+        DeviceQueue*            m_Queue;
+        GPtr<ID3D12QueryHeap>   m_QueryHeap;
+        GPtr<ID3D12Resource>    m_ReadbackBuffer;
+        const uint64_t*         m_ReadbackData;
+
+        // The GPU and CPU clock at the same moment, the CPU clock in profile nanoseconds
+        uint64_t                m_GpuFrequency;
+        uint64_t                m_GpuCalibration;
+        uint64_t                m_CpuCalibration;
+    };
+}
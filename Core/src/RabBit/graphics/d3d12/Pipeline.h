@@ -27,11 +27,11 @@ namespace RB::Graphics::D3D12
 
         List<D3D12_STATIC_SAMPLER_DESC> GetSamplerDescriptions();
 
-        UnorderedMap<uint64_t, GPtr<ID3D12PipelineState>>		m_ComputePipelines;
-        UnorderedMap<uint64_t, GPtr<ID3D12PipelineState>>		m_GraphicsPipelines;
+        FlatMap<uint64_t, GPtr<ID3D12PipelineState>>			m_ComputePipelines;
+        FlatMap<uint64_t, GPtr<ID3D12PipelineState>>			m_GraphicsPipelines;
 
-        UnorderedMap<uint64_t, GPtr<ID3D12RootSignature>>		m_RootSignatures;
-        UnorderedMap<uint32_t, List<D3D12_INPUT_ELEMENT_DESC>>	m_InputElementDescriptions;
+        FlatMap<uint64_t, GPtr<ID3D12RootSignature>>			m_RootSignatures;
+        FlatMap<uint32_t, List<D3D12_INPUT_ELEMENT_DESC>>		m_InputElementDescriptions;
     };
 
     extern PipelineManager* g_PipelineManager;
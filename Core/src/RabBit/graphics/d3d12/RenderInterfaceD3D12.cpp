@@ -10,6 +10,7 @@
 #include "ShaderSystem.h"
 #include "UtilsD3D12.h"
 #include "GraphicsDevice.h"
+#include "GpuProfilerD3D12.h"
 #include "graphics/ResourceDefaults.h"
 
 #define USE_PIX
@@ -37,15 +38,35 @@ namespace RB::Graphics::D3D12
     //								GpuGuard
     // ---------------------------------------------------------------------------
 
-    RenderInterfaceD3D12::RenderInterfaceD3D12(bool allow_only_copy_operations)
-        : m_CopyOperationsOnly(allow_only_copy_operations)
+    RenderInterfaceD3D12::RenderInterfaceD3D12(RenderInterfaceType type)
+        : m_CopyOperationsOnly(type == RenderInterfaceType::Copy)
+        , m_ShaderResourceState(type == RenderInterfaceType::Compute ? ResourceState::NON_PIXEL_SHADER_RESOURCE : ResourceState::PIXEL_SHADER_RESOURCE)
         , m_RenderState()
-        , m_CurrentCBVAllocator(nullptr)
+        , m_UploadAllocator(nullptr)
     {
-        if (allow_only_copy_operations)
+        switch (type)
+        {
+        case RenderInterfaceType::Copy:
             m_Queue = g_GraphicsDevice->GetCopyQueue();
-        else
+            break;
+        case RenderInterfaceType::Compute:
+            m_Queue = g_GraphicsDevice->GetComputeQueue();
+            break;
+        case RenderInterfaceType::Graphics:
+        default:
             m_Queue = g_GraphicsDevice->GetGraphicsQueue();
+            break;
+        }
+
+        m_UploadAllocator = new UploadAllocator("Upload Ring", m_CopyOperationsOnly ? kCopyUploadRingSize : kUploadRingSize);
+
+#ifdef RB_ENABLE_PROFILING
+        if (!m_CopyOperationsOnly)
+        {
+            m_GpuProfiler = new GpuProfiler(new GpuTimestampBackendD3D12(this, m_Queue, kGpuProfilerQueryCount), kGpuProfilerQueryCount,
+                type == RenderInterfaceType::Compute ? "GPU Compute" : "GPU Graphics");
+        }
+#endif
 
         SetNewCommandList();
         InvalidateState(true);
@@ -53,18 +74,8 @@ namespace RB::Graphics::D3D12
 
     RenderInterfaceD3D12::~RenderInterfaceD3D12()
     {
-        SAFE_DELETE(m_CurrentCBVAllocator);
-
-        while (!m_AvailableCBVAllocators.empty())
-        {
-            SAFE_DELETE(m_AvailableCBVAllocators.front());
-            m_AvailableCBVAllocators.pop();
-        }
-
-        for (int i = 0; i < m_InFlightCBVAllocators.size(); ++i)
-        {
-            SAFE_DELETE(m_InFlightCBVAllocators[i].allocator);
-        }
+        SAFE_DELETE(m_GpuProfiler);
+        SAFE_DELETE(m_UploadAllocator);
     }
 
     void RenderInterfaceD3D12::InvalidateState(bool rebind_descriptor_heap)
@@ -88,18 +99,34 @@ namespace RB::Graphics::D3D12
 
     Shared<GpuGuard> RenderInterfaceD3D12::ExecuteInternal()
     {
+        // Split transitions can not stay open across command lists
+        if (!m_OpenSplitTransitions.empty())
+        {
+            EndAllSplitTransitions();
+            FlushResourceBarriers();
+        }
+
+        // The timestamps of this command list are read back once it is done, without waiting for it
+        if (m_GpuProfiler)
+        {
+            m_GpuProfiler->Resolve();
+        }
+
         // TODO Maybe do the ExecuteCommandLists on a separate thread in the future?
         uint64_t fence_value = m_Queue->ExecuteCommandList(m_CommandList);
 
-        g_ResourceManager->OnCommandListExecute(m_Queue, fence_value);
-
-        if (m_CurrentCBVAllocator)
+        if (m_GpuProfiler)
         {
-            m_InFlightCBVAllocators.push_back({ m_CurrentCBVAllocator, fence_value });
-
-            m_CurrentCBVAllocator = nullptr;
+            m_GpuProfiler->Submit(fence_value);
+            m_GpuProfiler->ReadBack(m_Queue->GetCompletedFenceValue());
         }
 
+        g_ResourceManager->OnCommandListExecute(m_Queue, fence_value);
+
+        // Everything that is allocated so far is used by this command list
+        m_UploadAllocator->Submit(fence_value);
+        m_UploadAllocator->Retire(m_Queue->GetCompletedFenceValue());
+
         SetNewCommandList();
         InvalidateState(true);
 
@@ -116,7 +143,57 @@ namespace RB::Graphics::D3D12
     {
         MarkResourceUsed(resource);
 
-        g_ResourceStateManager->TransitionResource((GpuResource*)resource->GetNativeResource(), ConvertToD3D12ResourceState(state));
+        GpuResource* native_resource = (GpuResource*)resource->GetNativeResource();
+
+        // A resource that is still halfway a split transition first needs to finish that one
+        EndSplitTransition(native_resource);
+
+        g_ResourceStateManager->TransitionResource(native_resource, ConvertToD3D12ResourceState(state));
+    }
+
+    void RenderInterfaceD3D12::BeginTransitionResource(RenderResource* resource, ResourceState state)
+    {
+        MarkResourceUsed(resource);
+
+        GpuResource* native_resource = (GpuResource*)resource->GetNativeResource();
+
+        EndSplitTransition(native_resource);
+
+        D3D12_RESOURCE_STATES after_state = ConvertToD3D12ResourceState(state);
+        D3D12_RESOURCE_STATES before_state;
+
+        if (g_ResourceStateManager->BeginSplitTransition(native_resource, after_state, before_state))
+        {
+            m_OpenSplitTransitions.push_back({ native_resource, before_state, after_state });
+        }
+    }
+
+    void RenderInterfaceD3D12::EndTransitionResource(RenderResource* resource)
+    {
+        EndSplitTransition((GpuResource*)resource->GetNativeResource());
+    }
+
+    void RenderInterfaceD3D12::EndSplitTransition(GpuResource* resource)
+    {
+        for (auto itr = m_OpenSplitTransitions.begin(); itr != m_OpenSplitTransitions.end(); ++itr)
+        {
+            if (itr->resource == resource)
+            {
+                g_ResourceStateManager->EndSplitTransition(itr->resource, itr->before, itr->after);
+                m_OpenSplitTransitions.erase(itr);
+                return;
+            }
+        }
+    }
+
+    void RenderInterfaceD3D12::EndAllSplitTransitions()
+    {
+        for (const SplitTransition& split : m_OpenSplitTransitions)
+        {
+            g_ResourceStateManager->EndSplitTransition(split.resource, split.before, split.after);
+        }
+
+        m_OpenSplitTransitions.clear();
     }
 
     void RenderInterfaceD3D12::FlushResourceBarriers()
@@ -221,7 +298,7 @@ namespace RB::Graphics::D3D12
 
     void RenderInterfaceD3D12::SetShaderResourceInput(RenderResource* resource, uint32_t slot)
     {
-        TransitionResource(resource, ResourceState::PIXEL_SHADER_RESOURCE);
+        TransitionResource(resource, m_ShaderResourceState);
 
         switch (resource->GetType())
         {
@@ -286,38 +363,7 @@ namespace RB::Graphics::D3D12
     {
         RB_ASSERT_FATAL(LOGTAG_GRAPHICS, slot < _countof(m_RenderState.cbvAddresses), "Up the amount of possible CBV addresses");
 
-        if (m_CurrentCBVAllocator == nullptr)
-        {
-            // Update the available allocators
-            {
-                auto itr = m_InFlightCBVAllocators.begin();
-                while (itr != m_InFlightCBVAllocators.end())
-                {
-                    if (m_Queue->IsFenceReached(itr->fenceValue))
-                    {
-                        itr->allocator->Reset();
-                        m_AvailableCBVAllocators.push(itr->allocator);
-                        itr = m_InFlightCBVAllocators.erase(itr);
-                    }
-                    else
-                    {
-                        ++itr;
-                    }
-                }
-            }
-
-            if (m_AvailableCBVAllocators.empty())
-            {
-                m_CurrentCBVAllocator = new UploadAllocator("CBV Upload Allocator", k64KB);
-            }
-            else
-            {
-                m_CurrentCBVAllocator = m_AvailableCBVAllocators.front();
-                m_AvailableCBVAllocators.pop();
-            }
-        }
-
-        UploadAllocation allocation = m_CurrentCBVAllocator->Allocate(data_size, D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT);
+        UploadAllocation allocation = m_UploadAllocator->Allocate(data_size, D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT);
 
         memcpy(allocation.cpuWriteAddress, data, data_size);
 
@@ -654,31 +700,30 @@ namespace RB::Graphics::D3D12
 
     void RenderInterfaceD3D12::UploadDataToResource(RenderResource* resource, void* data, uint64_t data_size)
     {
-        // TODO Create a big upload resource and keep it alive for a couple of frames so we don't have to create an upload resource for every upload 
-        // if we do 10 uploads after eachother (so suballocate an upload resource in the full resource). If we create such a big upload resource, 
-        // make sure that when doing texture uploads, the starting point of a allocation should be aligned by D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT!
-        // !!! REMOVE THE HACK IN ResourceManager.cpp WHEN THIS HAS BEEN IMPLEMENTED !!!
-
         RB_ASSERT(LOGTAG_GRAPHICS, m_CopyOperationsOnly, "This operation should only be done on a Copy Queue!");
 
-        switch (resource->GetPrimitiveType())
+        GpuResource* dest_res = (GpuResource*)resource->GetNativeResource();
+
+        MarkResourceUsed(dest_res);
+
+        // Resources used by a dedicated copy command list MUST be in the common state, textures can also still be in the state they were created in
+        RenderResourceType primitive_type = resource->GetPrimitiveType();
+        RB_ASSERT_FATAL(LOGTAG_GRAPHICS, (dest_res->IsInState(D3D12_RESOURCE_STATE_COMMON) && IsUploadDestinationState(primitive_type, ResourceState::COMMON)) ||
+            (dest_res->IsInState(D3D12_RESOURCE_STATE_COPY_DEST) && IsUploadDestinationState(primitive_type, ResourceState::COPY_DEST)),
+            "Destination resource was not in a state that can be uploaded to");
+
+        switch (primitive_type)
         {
         case RenderResourceType::Buffer:
         {
-            GpuResource* upload_res = new GpuResource();
-            g_ResourceManager->ScheduleCreateUploadResource(upload_res, "Upload resource", { data_size });
-
-            char* mapped_mem;
-            RB_ASSERT_FATAL_D3D(upload_res->GetResource()->Map(0, nullptr, reinterpret_cast<void**>(&mapped_mem)), "Could not map the upload resource");
-
-            memcpy(mapped_mem, data, data_size);
+            UploadAllocation allocation = m_UploadAllocator->Allocate(data_size, 1);
 
-            // Unmapping is unnecessary
-            //upload_res->Unmap(0, nullptr);
+            memcpy(allocation.cpuWriteAddress, data, data_size);
 
-            InternalCopy(upload_res, (GpuResource*)resource->GetNativeResource(), resource->GetPrimitiveType());
+            // The buffer can be a part of a bigger resource
+            uint64_t dest_offset = ((Buffer*)resource)->GetOffset();
 
-            delete upload_res;
+            m_CommandList->CopyBufferRegion(dest_res->GetResource().Get(), dest_offset, allocation.resource->GetResource().Get(), allocation.offset, data_size);
         }
         break;
 
@@ -686,9 +731,9 @@ namespace RB::Graphics::D3D12
         {
             // Reference: https://alextardif.com/D3D11To12P3.html
 
-            D3D12_RESOURCE_DESC desc = ((GpuResource*)resource->GetNativeResource())->GetResource()->GetDesc();
+            D3D12_RESOURCE_DESC desc = dest_res->GetResource()->GetDesc();
 
-            uint64_t row_size = GetElementSizeFromFormat(resource->GetFormat()) * desc.Width;
+            uint64_t element_size = GetElementSizeFromFormat(resource->GetFormat());
 
             uint64_t tex_mem_size = 0;
             uint32_t num_rows[MAX_TEXTURE_SUBRESOURCE_COUNT];
@@ -696,13 +741,15 @@ namespace RB::Graphics::D3D12
             D3D12_PLACED_SUBRESOURCE_FOOTPRINT layouts[MAX_TEXTURE_SUBRESOURCE_COUNT];
             const uint64_t num_sub_resources = desc.MipLevels * desc.DepthOrArraySize;
 
+            RB_ASSERT_FATAL(LOGTAG_GRAPHICS, num_sub_resources <= MAX_TEXTURE_SUBRESOURCE_COUNT, "Too many subresources to upload");
+
             g_GraphicsDevice->Get()->GetCopyableFootprints(&desc, 0, (uint32_t)num_sub_resources, 0, layouts, num_rows, row_sizes_in_bytes, &tex_mem_size);
 
-            GpuResource* upload_res = new GpuResource();
-            g_ResourceManager->ScheduleCreateUploadResource(upload_res, "Upload resource", { tex_mem_size });
+            // The footprints are relative to the start of the allocation
+            UploadAllocation allocation = m_UploadAllocator->Allocate(tex_mem_size, D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT);
 
-            uint8_t* mapped_mem;
-            RB_ASSERT_FATAL_D3D(upload_res->GetResource()->Map(0, nullptr, reinterpret_cast<void**>(&mapped_mem)), "Could not map the upload resource");
+            // The source data contains the subresources tightly packed after each other (mips from fine to coarse)
+            const uint8_t* source_sub_resource_memory = ((uint8_t*)data);
 
             for (uint64_t array_index = 0; array_index < desc.DepthOrArraySize; array_index++)
             {
@@ -715,17 +762,12 @@ namespace RB::Graphics::D3D12
                     const uint64_t sub_resource_height = num_rows[sub_resource_index];
                     const uint64_t sub_resource_pitch = Math::AlignUp(sub_resourceLayout.Footprint.RowPitch, D3D12_TEXTURE_DATA_PITCH_ALIGNMENT);
                     const uint64_t sub_resource_depth = sub_resourceLayout.Footprint.Depth;
+                    const uint64_t sub_resource_row_pitch = element_size * sub_resourceLayout.Footprint.Width;
 
-                    uint8_t* destination_sub_resource_memory = mapped_mem + sub_resourceLayout.Offset;
+                    uint8_t* destination_sub_resource_memory = allocation.cpuWriteAddress + sub_resourceLayout.Offset;
 
                     for (uint64_t slice_index = 0; slice_index < sub_resource_depth; slice_index++)
                     {
-                        //const DirectX::Image* sub_image = image_data->GetImage(mip_index, array_index, slice_index);
-
-                        // TODO This will break with more than 1 subresource, fix when implementing mips!
-                        const uint8_t* source_sub_resource_memory = ((uint8_t*)data);
-                        uint64_t sub_resource_row_pitch = row_size;
-
                         for (uint64_t height = 0; height < sub_resource_height; height++)
                         {
                             memcpy(destination_sub_resource_memory, source_sub_resource_memory, Math::Min(sub_resource_pitch, sub_resource_row_pitch));
@@ -736,26 +778,23 @@ namespace RB::Graphics::D3D12
                 }
             }
 
+            RB_ASSERT(LOGTAG_GRAPHICS, (uint64_t)(source_sub_resource_memory - (uint8_t*)data) <= data_size, "The upload data is smaller than the subresources of the texture");
+
             for (int sub_resource_index = 0; sub_resource_index < num_sub_resources; ++sub_resource_index)
             {
                 D3D12_TEXTURE_COPY_LOCATION src_loc = {};
-                src_loc.pResource               = upload_res->GetResource().Get();
-                src_loc.Type                    = D3D12_TEXTURE_COPY_TYPE_PLACED_FOOTPRINT;
-                src_loc.PlacedFootprint         = layouts[sub_resource_index];
-                src_loc.PlacedFootprint.Offset  = 0;
+                src_loc.pResource                   = allocation.resource->GetResource().Get();
+                src_loc.Type                        = D3D12_TEXTURE_COPY_TYPE_PLACED_FOOTPRINT;
+                src_loc.PlacedFootprint             = layouts[sub_resource_index];
+                src_loc.PlacedFootprint.Offset     += allocation.offset;
 
                 D3D12_TEXTURE_COPY_LOCATION dest_loc = {};
-                dest_loc.pResource          = ((GpuResource*)resource->GetNativeResource())->GetResource().Get();
+                dest_loc.pResource          = dest_res->GetResource().Get();
                 dest_loc.Type               = D3D12_TEXTURE_COPY_TYPE_SUBRESOURCE_INDEX;
                 dest_loc.SubresourceIndex   = sub_resource_index;
 
                 m_CommandList->CopyTextureRegion(&dest_loc, 0, 0, 0, &src_loc, nullptr);
             }
-
-            MarkResourceUsed(resource);
-            MarkResourceUsed(upload_res);
-
-            delete upload_res;
         }
         break;
 
@@ -765,7 +804,24 @@ namespace RB::Graphics::D3D12
         }
     }
 
+    UploadRingStats RenderInterfaceD3D12::GetUploadStats() const
+    {
+        return m_UploadAllocator->GetStats();
+    }
+
     void RenderInterfaceD3D12::DrawInternal()
+    {
+        if (m_RenderState.indexCountPerInstance > 0)
+        {
+            DrawRangeInternal(m_RenderState.indexCountPerInstance, 0, 0);
+        }
+        else
+        {
+            DrawRangeInternal(m_RenderState.vertexCountPerInstance, 0, 0);
+        }
+    }
+
+    void RenderInterfaceD3D12::DrawRangeInternal(uint32_t element_count, uint32_t start_element, int32_t base_vertex)
     {
         HandlePendingClears();
         FlushResourceBarriers();
@@ -779,11 +835,11 @@ namespace RB::Graphics::D3D12
 
         if (m_RenderState.indexCountPerInstance > 0)
         {
-            m_CommandList->DrawIndexedInstanced(m_RenderState.indexCountPerInstance, 1, 0, 0, 0);
+            m_CommandList->DrawIndexedInstanced(element_count, 1, start_element, base_vertex, 0);
         }
         else
         {
-            m_CommandList->DrawInstanced(m_RenderState.vertexCountPerInstance, 1, 0, 0);
+            m_CommandList->DrawInstanced(element_count, 1, start_element + base_vertex, 0);
         }
     }
 
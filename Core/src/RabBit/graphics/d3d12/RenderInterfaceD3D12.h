@@ -31,7 +31,7 @@ namespace RB::Graphics::D3D12
     class RenderInterfaceD3D12 : public RenderInterface
     {
     public:
-        RenderInterfaceD3D12(bool allow_only_copy_operations);
+        RenderInterfaceD3D12(RenderInterfaceType type);
         ~RenderInterfaceD3D12();
 
         void InvalidateState(bool rebind_descriptor_heap) override;
@@ -42,6 +42,8 @@ namespace RB::Graphics::D3D12
         void GpuWaitOn(GpuGuard* guard) override;
 
         void TransitionResource(RenderResource* resource, ResourceState state) override;
+        void BeginTransitionResource(RenderResource* resource, ResourceState state) override;
+        void EndTransitionResource(RenderResource* resource) override;
         void FlushResourceBarriers() override;
         void FlushAllPending() override;
 
@@ -76,7 +78,10 @@ namespace RB::Graphics::D3D12
 
         void UploadDataToResource(RenderResource* resource, void* data, uint64_t data_size) override;
 
+        UploadRingStats GetUploadStats() const override;
+
         void DrawInternal() override;
+        void DrawRangeInternal(uint32_t element_count, uint32_t start_element, int32_t base_vertex) override;
         void DispatchInternal(uint32_t thread_groups_x, uint32_t thread_groups_y, uint32_t thread_groups_z) override;
 
         void ProfileMarkerBegin(uint64_t color, const char* name) override;
@@ -86,6 +91,8 @@ namespace RB::Graphics::D3D12
 
     private:
         void HandlePendingClears();
+        void EndSplitTransition(GpuResource* resource);
+        void EndAllSplitTransitions();
         void InternalCopy(GpuResource* src, GpuResource* dst, const RenderResourceType& primitive_type);
         void MarkResourceUsed(RenderResource* resource);
         void MarkResourceUsed(GpuResource* resource);
@@ -100,6 +107,7 @@ namespace RB::Graphics::D3D12
         void SetNewCommandList();
 
         bool								m_CopyOperationsOnly;
+        ResourceState                       m_ShaderResourceState; // The compute queue does not support the pixel shader resource state
         DeviceQueue*                        m_Queue;
         GPtr<ID3D12GraphicsCommandList2>	m_CommandList;
 
@@ -144,14 +152,17 @@ namespace RB::Graphics::D3D12
 
         RenderState                         m_RenderState;
 
-        struct UploadAllocatorPair
+        struct SplitTransition
         {
-            UploadAllocator* allocator;
-            uint64_t fenceValue;
+            GpuResource*            resource;
+            D3D12_RESOURCE_STATES   before;
+            D3D12_RESOURCE_STATES   after;
         };
 
-        Queue<UploadAllocator*>		        m_AvailableCBVAllocators;
-        List<UploadAllocatorPair>	        m_InFlightCBVAllocators;
-        UploadAllocator*                    m_CurrentCBVAllocator;
+        // Split transitions that are started on the current command list, but not yet ended
+        List<SplitTransition>               m_OpenSplitTransitions;
+
+        // Used for the constant data and the uploads of this interface
+        UploadAllocator*                    m_UploadAllocator;
     };
 }
\ No newline at end of file
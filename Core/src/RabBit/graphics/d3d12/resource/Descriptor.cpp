@@ -2,6 +2,8 @@
 #include "Descriptor.h"
 #include "graphics/d3d12/GraphicsDevice.h"
 
+#include "utils/debug/Stats.h"
+
 namespace RB::Graphics::D3D12
 {
     // ---------------------------------------------------------------------------
@@ -12,9 +14,9 @@ namespace RB::Graphics::D3D12
 
     DescriptorManager::DescriptorManager()
     {
-        m_BindlessSrvUavHeap = new DescriptorHeap(L"Bindless SRV/UAV heap", true, D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV, BINDLESS_REGULAR_DESCRIPTORS, BINDLESS_TRANSIENT_DESCRIPTORS_PER_CYCLE);
-        m_RenderTargetHeap   = new DescriptorHeap(L"RenderTarget heap", false, D3D12_DESCRIPTOR_HEAP_TYPE_RTV, RENDERTARGET_REGULAR_DESCRIPTORS, RTV_DSV_TRANSIENT_DESCRIPTORS_PER_CYCLE);
-        m_DepthStencilHeap   = new DescriptorHeap(L"Depth Stencil heap", false, D3D12_DESCRIPTOR_HEAP_TYPE_DSV, DEPTHSTENCIL_REGULAR_DESCRIPTORS, RTV_DSV_TRANSIENT_DESCRIPTORS_PER_CYCLE);
+        m_BindlessSrvUavHeap = new DescriptorHeap(L"Bindless SRV/UAV heap", true, D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV, BINDLESS_REGULAR_DESCRIPTORS, BINDLESS_TRANSIENT_DESCRIPTORS);
+        m_RenderTargetHeap   = new DescriptorHeap(L"RenderTarget heap", false, D3D12_DESCRIPTOR_HEAP_TYPE_RTV, RENDERTARGET_REGULAR_DESCRIPTORS, RTV_DSV_TRANSIENT_DESCRIPTORS);
+        m_DepthStencilHeap   = new DescriptorHeap(L"Depth Stencil heap", false, D3D12_DESCRIPTOR_HEAP_TYPE_DSV, DEPTHSTENCIL_REGULAR_DESCRIPTORS, RTV_DSV_TRANSIENT_DESCRIPTORS);
 
         D3D12_UNORDERED_ACCESS_VIEW_DESC dummy_desc = {};
         dummy_desc.Format               = DXGI_FORMAT_R8G8B8A8_UNORM;
@@ -166,24 +168,17 @@ namespace RB::Graphics::D3D12
     //								DescriptorHeap
     // ---------------------------------------------------------------------------
 
-    DescriptorHeap::DescriptorHeap(const wchar_t* name, bool shader_visible, D3D12_DESCRIPTOR_HEAP_TYPE type, uint32_t max_persistent_descriptors, uint32_t max_transient_descriptors_per_cycle)
+    DescriptorHeap::DescriptorHeap(const wchar_t* name, bool shader_visible, D3D12_DESCRIPTOR_HEAP_TYPE type, uint32_t max_persistent_descriptors, uint32_t max_transient_descriptors)
         : m_Type(type)
         , m_ShaderVisible(shader_visible)
         , m_MaxPersistent(max_persistent_descriptors)
-        , m_MaxTransientPerCycle(max_transient_descriptors_per_cycle)
-        , m_CurrPersistentIdx(0)
-        , m_CycleIndex(0)
+        , m_PersistentSlots(max_persistent_descriptors)
+        , m_TransientRing(max_transient_descriptors, DESCRIPTOR_HEAP_TRANSIENT_CYCLES)
     {
-        uint32_t max_descriptors = m_MaxPersistent + (m_MaxTransientPerCycle * DESCRIPTOR_HEAP_TRANSIENT_CYCLES);
+        uint32_t max_descriptors = m_MaxPersistent + max_transient_descriptors;
 
         RB_ASSERT_FATAL(LOGTAG_GRAPHICS, max_descriptors < 1e6, "The max total of descriptors cannot exceed 1 million");
 
-        m_PersistentSlots.reserve(m_MaxPersistent);
-        for (uint32_t i = 0; i < m_MaxPersistent; ++i)
-        {
-            m_PersistentSlots.push_back(true);
-        }
-
         m_IncrementSize = g_GraphicsDevice->Get()->GetDescriptorHandleIncrementSize(m_Type);
 
         // Create descriptor heap
@@ -205,55 +200,52 @@ namespace RB::Graphics::D3D12
             m_GpuStart = m_Heap->GetGPUDescriptorHandleForHeapStart();
         }
 
-        CycleTransientDescriptors();
+        InitializeCriticalSection(&m_PersistentCS);
+    }
+
+    DescriptorHeap::~DescriptorHeap()
+    {
+        DeleteCriticalSection(&m_PersistentCS);
     }
 
     int32_t DescriptorHeap::AllocPersistent()
     {
-        uint32_t start = m_CurrPersistentIdx;
-        uint32_t slot = start;
+        EnterCriticalSection(&m_PersistentCS);
+        uint32_t slot = m_PersistentSlots.Allocate();
+        LeaveCriticalSection(&m_PersistentCS);
 
-        // TODO This is slow, improve this!
-        // Find the first available slot in the heap
-        while (!m_PersistentSlots[slot])
+        if (slot == kInvalidDescriptorSlot)
         {
-            slot = (slot + 1) % m_MaxPersistent;
-
-            if (slot == start)
-            {
-                RB_ASSERT_ALWAYS(LOGTAG_GRAPHICS, "Increase the max amount of persistent descriptors for heap type: %d", (int)m_Type);
-                return -1;
-            }
+            RB_ASSERT_ALWAYS(LOGTAG_GRAPHICS, "Increase the max amount of persistent descriptors for heap type: %d", (int)m_Type);
+            return -1;
         }
 
-        m_PersistentSlots[slot] = false;
-
-        uint32_t before = m_CurrPersistentIdx;
-        m_CurrPersistentIdx = slot;
+        RB_STAT_ADD(DescriptorsAllocated, 1);
 
-        return (int32_t)before;
+        return (int32_t)slot;
     }
 
     int32_t DescriptorHeap::AllocTransient()
     {
-        if ((m_CurrTransientIdx - m_TransientBase + 1) >= m_MaxTransientPerCycle)
+        // Every heap type has its own block per thread
+        static thread_local TransientDescriptorBlock blocks[D3D12_DESCRIPTOR_HEAP_TYPE_NUM_TYPES];
+
+        uint32_t offset = m_TransientRing.Allocate(blocks[m_Type]);
+
+        if (offset == kInvalidDescriptorSlot)
         {
             RB_ASSERT_ALWAYS(LOGTAG_GRAPHICS, "Increase the max amount of transient descriptors for heap type: %d", (int)m_Type);
-            m_CurrTransientIdx = m_TransientBase;
-            return m_CurrTransientIdx;
+            return -1;
         }
 
-        uint32_t before = m_CurrTransientIdx;
-        m_CurrTransientIdx++;
+        RB_STAT_ADD(DescriptorsAllocated, 1);
 
-        return (int32_t)before;
+        return (int32_t)(m_MaxPersistent + offset);
     }
 
     void DescriptorHeap::CycleTransientDescriptors()
     {
-        m_CycleIndex        = (m_CycleIndex + 1) % DESCRIPTOR_HEAP_TRANSIENT_CYCLES;
-        m_TransientBase     = m_CycleIndex * m_MaxTransientPerCycle + m_MaxPersistent;
-        m_CurrTransientIdx  = m_TransientBase;
+        m_TransientRing.Cycle();
     }
 
     void DescriptorHeap::InvalidateDescriptor(int32_t& heap_index)
@@ -264,7 +256,10 @@ namespace RB::Graphics::D3D12
             return;
         }
 
-        m_PersistentSlots[heap_index] = true;
+        EnterCriticalSection(&m_PersistentCS);
+        m_PersistentSlots.Free(heap_index);
+        LeaveCriticalSection(&m_PersistentCS);
+
         heap_index = -1;
     }
 
@@ -2,17 +2,20 @@
 
 #include <d3d12.h>
 
+#include "graphics/DescriptorAllocator.h"
+
 namespace RB::Graphics::D3D12
 {
     // SRV & UAV descriptors
     #define BINDLESS_REGULAR_DESCRIPTORS		        10000
-    #define BINDLESS_TRANSIENT_DESCRIPTORS_PER_CYCLE    50
+    #define BINDLESS_TRANSIENT_DESCRIPTORS              4096
     
     // RTV & DSV descriptors
     #define RENDERTARGET_REGULAR_DESCRIPTORS	        1000
     #define DEPTHSTENCIL_REGULAR_DESCRIPTORS	        1000
-    #define RTV_DSV_TRANSIENT_DESCRIPTORS_PER_CYCLE     50
+    #define RTV_DSV_TRANSIENT_DESCRIPTORS               256
 
+    // Transient descriptors are shared by all the cycles, a descriptor is reused after this many cycles
     #define DESCRIPTOR_HEAP_TRANSIENT_CYCLES            3
 
     enum class DescriptorHandleType
@@ -74,9 +77,11 @@ namespace RB::Graphics::D3D12
     class DescriptorHeap
     {
     public:
-        DescriptorHeap(const wchar_t* name, bool shader_visible, D3D12_DESCRIPTOR_HEAP_TYPE type, uint32_t max_persistent_descriptors, uint32_t max_transient_descriptors_per_cycle);
+        DescriptorHeap(const wchar_t* name, bool shader_visible, D3D12_DESCRIPTOR_HEAP_TYPE type, uint32_t max_persistent_descriptors, uint32_t max_transient_descriptors);
+        ~DescriptorHeap();
 
         int32_t AllocPersistent();
+        // Can be called from any thread, every thread takes its transient descriptors from its own block of the ring
         int32_t AllocTransient();
 
         void CycleTransientDescriptors();
@@ -97,13 +102,12 @@ namespace RB::Graphics::D3D12
         bool						m_ShaderVisible;
         uint32_t					m_IncrementSize;
 
-        List<bool>					m_PersistentSlots;
         uint32_t					m_MaxPersistent;
-        uint32_t					m_MaxTransientPerCycle;
-        uint32_t                    m_CurrPersistentIdx;
-        uint32_t                    m_CurrTransientIdx;
-        uint32_t                    m_TransientBase;
-        uint32_t                    m_CycleIndex;
+        DescriptorSlotAllocator     m_PersistentSlots;
+        TransientDescriptorRing     m_TransientRing;    // Placed after the persistent descriptors in the heap
+
+        // Persistent descriptors are created by the resource creation jobs, which run in parallel
+        CRITICAL_SECTION            m_PersistentCS;
     };
 
 
@@ -8,22 +8,34 @@ namespace RB::Graphics::D3D12
         : m_Resource(nullptr)
         , m_State(D3D12_RESOURCE_STATE_COMMON)
         , m_OwnsResource(true)
-        , m_IsValid(false)
+        , m_CreationState(CreationState::Scheduled)
+        , m_CreationJob(UINT64_MAX)
+        , m_Allocation({})
         , m_OnCreationCallback(on_resource_created_callback)
     {
+        std::fill_n(m_LastUsedSubmissions, kMaxTrackedQueues, kInvalidSubmission);
     }
 
     GpuResource::GpuResource(GPtr<ID3D12Resource> resource, D3D12_RESOURCE_STATES state, bool transfer_ownership)
         : m_Resource(resource)
         , m_State(state)
         , m_OwnsResource(transfer_ownership)
-        , m_IsValid(true)
+        , m_CreationState(CreationState::Created)
+        , m_CreationJob(UINT64_MAX)
+        , m_Allocation({})
         , m_OnCreationCallback(nullptr)
     {
+        std::fill_n(m_LastUsedSubmissions, kMaxTrackedQueues, kInvalidSubmission);
     }
 
     GpuResource::~GpuResource()
     {
+        // The creation job still writes into this object
+        if (GetCreationState() == CreationState::Scheduled)
+        {
+            g_ResourceManager->WaitUntilResourceValid(this);
+        }
+
         if (IsValid() && m_OwnsResource)
         {
             g_ResourceManager->MarkForDelete(this);
@@ -47,7 +59,32 @@ namespace RB::Graphics::D3D12
 
     bool GpuResource::IsValid() const
     {
-        return m_IsValid;
+        return GetCreationState() == CreationState::Created;
+    }
+
+    CreationState GpuResource::GetCreationState() const
+    {
+        return m_CreationState.load(std::memory_order_acquire);
+    }
+
+    void GpuResource::SetCreationJob(JobID job_id)
+    {
+        m_CreationJob = job_id;
+    }
+
+    JobID GpuResource::GetCreationJob() const
+    {
+        return m_CreationJob;
+    }
+
+    void GpuResource::SetAllocation(const ResourceAllocation& allocation)
+    {
+        m_Allocation = allocation;
+    }
+
+    const ResourceAllocation& GpuResource::GetAllocation() const
+    {
+        return m_Allocation;
     }
 
     void GpuResource::MarkAsUsed(DeviceQueue* queue)
@@ -75,11 +112,18 @@ namespace RB::Graphics::D3D12
         m_Resource = resource;
         m_State = state;
 
+        if (!m_Resource)
+        {
+            m_CreationState.store(CreationState::Failed, std::memory_order_release);
+            return;
+        }
+
         if (m_OnCreationCallback)
         {
             m_OnCreationCallback(this);
         }
 
-        m_IsValid = true;
+        // Everything written above is visible to the threads that see the resource as created
+        m_CreationState.store(CreationState::Created, std::memory_order_release);
     }
 }
\ No newline at end of file
@@ -1,6 +1,10 @@
 #pragma once
 
 #include "RabBitCommon.h"
+#include "graphics/HeapAllocator.h"
+#include "graphics/RenderResource.h"
+#include "graphics/RetirementRing.h"
+#include "utils/Threading.h"
 
 // DirectX 12 specific headers.
 #include <d3d12.h>
@@ -8,23 +12,51 @@
 namespace RB::Graphics::D3D12
 {
     class DeviceQueue;
+    struct ResourceHeap;
 
+    // Amount of queues that the usage of a resource is tracked on (direct, compute and copy)
+    constexpr uint32_t kMaxTrackedQueues = 4;
+
+    // Where the memory of a resource lives, heap is nullptr for committed resources
+    struct ResourceAllocation
+    {
+        ResourceHeap*   heap;
+        HeapBlock       block;
+        uint64_t        size;
+    };
+
+    // Also acts as the handle of its scheduled creation, the creation state can be polled from any thread without waiting on it
     class GpuResource
     {
     public:
+        // The callback is called by the thread that created the resource, before the resource is marked as created
         GpuResource(std::function<void(GpuResource*)> on_resource_created_callback = nullptr);
         GpuResource(GPtr<ID3D12Resource> resource, D3D12_RESOURCE_STATES state, bool transfer_ownership);
         ~GpuResource();
 
-        // Should only be called on the render thread!
+        // Waits for the creation when it is not done yet, check IsValid first on threads that should never wait
         GPtr<ID3D12Resource> GetResource();
 
+        // A nullptr resource marks the creation as failed
         void SetResource(GPtr<ID3D12Resource> resource, D3D12_RESOURCE_STATES state);
 
         bool IsValid() const;
+        CreationState GetCreationState() const;
+
+        // Set by the ResourceManager when scheduling the creation
+        void SetCreationJob(JobID job_id);
+        JobID GetCreationJob() const;
+
+        // Should be set before the resource itself
+        void SetAllocation(const ResourceAllocation& allocation);
+        const ResourceAllocation& GetAllocation() const;
 
         void MarkAsUsed(DeviceQueue* queue);
 
+        // Set by the ResourceManager, per queue slot the last submission that uses the resource
+        void SetLastUsedSubmission(uint32_t queue_slot, uint64_t submission) { m_LastUsedSubmissions[queue_slot] = submission; }
+        uint64_t GetLastUsedSubmission(uint32_t queue_slot) const { return m_LastUsedSubmissions[queue_slot]; }
+
         void UpdateState(D3D12_RESOURCE_STATES state);
         D3D12_RESOURCE_STATES GetState() const;
         bool IsInState(D3D12_RESOURCE_STATES state) const;
@@ -33,7 +65,10 @@ namespace RB::Graphics::D3D12
         GPtr<ID3D12Resource>				m_Resource;
         D3D12_RESOURCE_STATES				m_State;
         bool								m_OwnsResource;
-        bool                                m_IsValid;
+        std::atomic<CreationState>          m_CreationState;
+        JobID                               m_CreationJob;
+        uint64_t                            m_LastUsedSubmissions[kMaxTrackedQueues];
+        ResourceAllocation                  m_Allocation;
         std::function<void(GpuResource*)>	m_OnCreationCallback;
     };
 }
\ No newline at end of file
@@ -13,34 +13,73 @@ namespace RB::Graphics::D3D12
     //								VertexBuffer
     // ---------------------------------------------------------------------------
 
-    VertexBufferD3D12::VertexBufferD3D12(const char* name, const TopologyType& type, void* data, uint32_t vertex_size, uint64_t data_size)
+    VertexBufferD3D12::VertexBufferD3D12(const char* name, const TopologyType& type, void* data, uint32_t vertex_size, uint64_t data_size, StreamDataMode data_mode)
         : m_Name(name)
         , m_Type(type)
         , m_VertexSize(vertex_size)
         , m_Size(data_size)
-        , m_Data(data)
+        , m_Offset(0)
+        , m_OwnsResource(true)
         , m_View{}
     {
         m_Resource = new GpuResource();
         g_ResourceManager->ScheduleCreateVertexResource(m_Resource, name, { data_size });
 
+        if (data == nullptr)
+        {
+            return;
+        }
+
         Streamable streamable = {};
         streamable.resource     = this;
         streamable.uploadData   = data;
         streamable.uploadSize   = data_size;
-        Application::GetInstance()->GetRenderer()->GetStreamer()->ScheduleForStream(streamable);
+        Application::GetInstance()->GetRenderer()->GetStreamer()->ScheduleForStream(streamable, data_mode);
+    }
+
+    VertexBufferD3D12::VertexBufferD3D12(const char* name, VertexBufferD3D12* buffer, uint64_t offset, void* data, uint64_t data_size, StreamDataMode data_mode)
+        : m_Name(name)
+        , m_Resource(buffer->m_Resource)
+        , m_Type(buffer->m_Type)
+        , m_VertexSize(buffer->m_VertexSize)
+        , m_Size(data_size)
+        , m_Offset(buffer->m_Offset + offset)
+        , m_OwnsResource(false)
+        , m_View{}
+    {
+        RB_ASSERT_FATAL(LOGTAG_GRAPHICS, offset + data_size <= buffer->m_Size, "The range does not fit in the vertex buffer");
+        RB_ASSERT(LOGTAG_GRAPHICS, (offset % m_VertexSize) == 0, "The range should start at a vertex");
+
+        if (data == nullptr)
+        {
+            return;
+        }
+
+        Streamable streamable = {};
+        streamable.resource     = this;
+        streamable.uploadData   = data;
+        streamable.uploadSize   = data_size;
+        Application::GetInstance()->GetRenderer()->GetStreamer()->ScheduleForStream(streamable, data_mode);
     }
 
     VertexBufferD3D12::~VertexBufferD3D12()
     {
-        SAFE_DELETE(m_Resource);
+        if (m_OwnsResource)
+        {
+            SAFE_DELETE(m_Resource);
+        }
+    }
+
+    CreationState VertexBufferD3D12::GetCreationState() const
+    {
+        return m_Resource->GetCreationState();
     }
 
     D3D12_VERTEX_BUFFER_VIEW VertexBufferD3D12::GetView()
     {
         if (m_View.SizeInBytes == 0)
         {
-            m_View.BufferLocation = m_Resource->GetResource()->GetGPUVirtualAddress();
+            m_View.BufferLocation = m_Resource->GetResource()->GetGPUVirtualAddress() + m_Offset;
             m_View.SizeInBytes    = m_Size;
             m_View.StrideInBytes  = m_VertexSize;
         }
@@ -52,32 +91,68 @@ namespace RB::Graphics::D3D12
     //								IndexBuffer
     // ---------------------------------------------------------------------------
 
-    IndexBufferD3D12::IndexBufferD3D12(const char* name, uint32_t* data, uint64_t data_size)
+    IndexBufferD3D12::IndexBufferD3D12(const char* name, uint32_t* data, uint64_t data_size, StreamDataMode data_mode)
         : m_Name(name)
         , m_Size(data_size)
-        , m_Data(data)
+        , m_Offset(0)
+        , m_OwnsResource(true)
         , m_View{}
     {
         m_Resource = new GpuResource();
         g_ResourceManager->ScheduleCreateIndexResource(m_Resource, name, { data_size });
 
+        if (data == nullptr)
+        {
+            return;
+        }
+
+        Streamable streamable = {};
+        streamable.resource     = this;
+        streamable.uploadData   = data;
+        streamable.uploadSize   = data_size;
+        Application::GetInstance()->GetRenderer()->GetStreamer()->ScheduleForStream(streamable, data_mode);
+    }
+
+    IndexBufferD3D12::IndexBufferD3D12(const char* name, IndexBufferD3D12* buffer, uint64_t offset, uint32_t* data, uint64_t data_size, StreamDataMode data_mode)
+        : m_Name(name)
+        , m_Resource(buffer->m_Resource)
+        , m_Size(data_size)
+        , m_Offset(buffer->m_Offset + offset)
+        , m_OwnsResource(false)
+        , m_View{}
+    {
+        RB_ASSERT_FATAL(LOGTAG_GRAPHICS, offset + data_size <= buffer->m_Size, "The range does not fit in the index buffer");
+
+        if (data == nullptr)
+        {
+            return;
+        }
+
         Streamable streamable = {};
         streamable.resource     = this;
         streamable.uploadData   = data;
         streamable.uploadSize   = data_size;
-        Application::GetInstance()->GetRenderer()->GetStreamer()->ScheduleForStream(streamable);
+        Application::GetInstance()->GetRenderer()->GetStreamer()->ScheduleForStream(streamable, data_mode);
     }
 
     IndexBufferD3D12::~IndexBufferD3D12()
     {
-        SAFE_DELETE(m_Resource);
+        if (m_OwnsResource)
+        {
+            SAFE_DELETE(m_Resource);
+        }
+    }
+
+    CreationState IndexBufferD3D12::GetCreationState() const
+    {
+        return m_Resource->GetCreationState();
     }
 
     D3D12_INDEX_BUFFER_VIEW IndexBufferD3D12::GetView()
     {
         if (m_View.SizeInBytes == 0)
         {
-            m_View.BufferLocation = m_Resource->GetResource()->GetGPUVirtualAddress();
+            m_View.BufferLocation = m_Resource->GetResource()->GetGPUVirtualAddress() + m_Offset;
             m_View.SizeInBytes    = m_Size;
             m_View.Format         = ConvertToDXGIFormat(GetFormat());
         }
@@ -89,12 +164,13 @@ namespace RB::Graphics::D3D12
     //								Texture2D
     // ---------------------------------------------------------------------------
 
-    Texture2DD3D12::Texture2DD3D12(const char* name, RenderResourceFormat format, uint32_t width, uint32_t height, bool is_render_target, bool random_read_write_access, TextureColorSpace color_space)
+    Texture2DD3D12::Texture2DD3D12(const char* name, RenderResourceFormat format, uint32_t width, uint32_t height, bool is_render_target, bool random_read_write_access, TextureColorSpace color_space, uint32_t mip_levels)
         : Texture2D(color_space)
         , m_Name(name)
         , m_Format(format)
         , m_Width(width)
         , m_Height(height)
+        , m_MipLevels(mip_levels)
         , m_IsRenderTarget(is_render_target)
         , m_AllowUAV(random_read_write_access)
         , m_ReadHandle({})
@@ -105,6 +181,8 @@ namespace RB::Graphics::D3D12
         , m_DepthStencilDescriptor({})
     {
         RB_ASSERT_FATAL(LOGTAG_GRAPHICS, width > 0 && height > 0, "Cannot create a texture with a width or height smaller than 1");
+        RB_ASSERT_FATAL(LOGTAG_GRAPHICS, mip_levels > 0 && mip_levels <= MAX_TEXTURE_SUBRESOURCE_COUNT, "Unsupported amount of mip levels");
+        RB_ASSERT(LOGTAG_GRAPHICS, mip_levels == 1 || (!is_render_target && !random_read_write_access), "Only the first mip of a render target or UAV texture can be written to");
 
         m_Resource = new GpuResource(std::bind(&Texture2DD3D12::CreateViews, this, std::placeholders::_1));
 
@@ -121,27 +199,25 @@ namespace RB::Graphics::D3D12
             flags |= D3D12_RESOURCE_FLAG_DENY_SHADER_RESOURCE;
         }
 
-        // TODO Add mip support
-
         ResourceManager::Texture2DDesc desc = {};
         desc.format     = ConvertToDXGIFormat(m_Format);
         desc.width      = m_Width;
         desc.height     = m_Height;
         desc.arraySize  = 1;
-        desc.mipLevels  = 1;
+        desc.mipLevels  = m_MipLevels;
         desc.flags      = flags;
 
         g_ResourceManager->ScheduleCreateTexture2DResource(m_Resource, name, desc);
     }
 
-    Texture2DD3D12::Texture2DD3D12(const char* name, void* data, uint64_t data_size, RenderResourceFormat format, uint32_t width, uint32_t height, bool is_render_target, bool random_read_write_access, TextureColorSpace color_space)
-        : Texture2DD3D12(name, format, width, height, is_render_target, random_read_write_access, color_space)
+    Texture2DD3D12::Texture2DD3D12(const char* name, void* data, uint64_t data_size, RenderResourceFormat format, uint32_t width, uint32_t height, bool is_render_target, bool random_read_write_access, TextureColorSpace color_space, StreamDataMode data_mode, uint32_t mip_levels)
+        : Texture2DD3D12(name, format, width, height, is_render_target, random_read_write_access, color_space, mip_levels)
     {
         Streamable streamable = {};
         streamable.resource     = this;
         streamable.uploadData   = data;
         streamable.uploadSize   = data_size;
-        Application::GetInstance()->GetRenderer()->GetStreamer()->ScheduleForStream(streamable);
+        Application::GetInstance()->GetRenderer()->GetStreamer()->ScheduleForStream(streamable, data_mode);
     }
 
     Texture2DD3D12::Texture2DD3D12(const char* name, void* internal_resource, RenderResourceFormat format, uint32_t width, uint32_t height, bool is_render_target, bool random_read_write_access, TextureColorSpace color_space)
@@ -151,6 +227,7 @@ namespace RB::Graphics::D3D12
         , m_Format(format)
         , m_Width(width)
         , m_Height(height)
+        , m_MipLevels(1)
         , m_IsRenderTarget(is_render_target)
         , m_AllowUAV(random_read_write_access)
         , m_ReadHandle({})
@@ -165,12 +242,18 @@ namespace RB::Graphics::D3D12
 
     Texture2DD3D12::~Texture2DD3D12()
     {
+        // Deleted first, as it waits on a creation job that might still be creating the views
+        SAFE_DELETE(m_Resource);
+
         g_DescriptorManager->InvalidateDescriptor(m_ReadHandle);
         g_DescriptorManager->InvalidateDescriptor(m_WriteHandle);
         g_DescriptorManager->InvalidateDescriptor(m_RenderTargetHandle);
         g_DescriptorManager->InvalidateDescriptor(m_DepthStencilHandle);
+    }
 
-        SAFE_DELETE(m_Resource);
+    CreationState Texture2DD3D12::GetCreationState() const
+    {
+        return m_Resource->GetCreationState();
     }
 
     void Texture2DD3D12::SetRenderTargetHandle(D3D12_CPU_DESCRIPTOR_HANDLE handle)
@@ -188,13 +271,11 @@ namespace RB::Graphics::D3D12
         // SRV
         if (!m_IsDepthStencil)
         {
-            // TODO Add mip support
-
             D3D12_SHADER_RESOURCE_VIEW_DESC desc = {};
             desc.Format                         = ConvertToDXGIFormat(m_Format);
             desc.ViewDimension                  = D3D12_SRV_DIMENSION_TEXTURE2D;
             desc.Shader4ComponentMapping        = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
-            desc.Texture2D.MipLevels            = 1;
+            desc.Texture2D.MipLevels            = m_MipLevels;
             desc.Texture2D.MostDetailedMip      = 0;
             desc.Texture2D.PlaneSlice           = 0;
             desc.Texture2D.ResourceMinLODClamp  = 0.0f;
@@ -14,12 +14,16 @@ namespace RB::Graphics::D3D12
     class VertexBufferD3D12 : public VertexBuffer
     {
     public:
-        VertexBufferD3D12(const char* name, const TopologyType& type, void* data, uint32_t vertex_size, uint64_t data_size);
+        VertexBufferD3D12(const char* name, const TopologyType& type, void* data, uint32_t vertex_size, uint64_t data_size, StreamDataMode data_mode);
+        VertexBufferD3D12(const char* name, VertexBufferD3D12* buffer, uint64_t offset, void* data, uint64_t data_size, StreamDataMode data_mode);
         ~VertexBufferD3D12();
 
         const char* GetName() const override { return m_Name; }
 
         void* GetNativeResource() const override { return m_Resource; }
+        CreationState GetCreationState() const override;
+
+        uint64_t GetOffset() const override { return m_Offset; }
 
         uint32_t GetVertexElementCount() const override { return m_Size / m_VertexSize; }
 
@@ -34,18 +38,23 @@ namespace RB::Graphics::D3D12
         TopologyType				m_Type;
         uint32_t					m_VertexSize;
         uint64_t					m_Size;
-        void*                       m_Data;
+        uint64_t                    m_Offset;
+        bool                        m_OwnsResource;
     };
 
     class IndexBufferD3D12 : public IndexBuffer
     {
     public:
-        IndexBufferD3D12(const char* name, uint32_t* data, uint64_t data_size);
+        IndexBufferD3D12(const char* name, uint32_t* data, uint64_t data_size, StreamDataMode data_mode);
+        IndexBufferD3D12(const char* name, IndexBufferD3D12* buffer, uint64_t offset, uint32_t* data, uint64_t data_size, StreamDataMode data_mode);
         ~IndexBufferD3D12();
 
         const char* GetName() const override { return m_Name; }
 
         void* GetNativeResource() const override { return m_Resource; }
+        CreationState GetCreationState() const override;
+
+        uint64_t GetOffset() const override { return m_Offset; }
 
         uint64_t GetIndexCount() const override { return m_Size / sizeof(uint32_t); }
 
@@ -56,20 +65,22 @@ namespace RB::Graphics::D3D12
         GpuResource*                m_Resource;
         D3D12_INDEX_BUFFER_VIEW		m_View;
         uint64_t					m_Size;
-        void*                       m_Data;
+        uint64_t                    m_Offset;
+        bool                        m_OwnsResource;
     };
 
     class Texture2DD3D12 : public Texture2D
     {
     public:
-        Texture2DD3D12(const char* name, RenderResourceFormat format, uint32_t width, uint32_t height, bool is_render_target, bool random_read_write_access, TextureColorSpace color_space);
-        Texture2DD3D12(const char* name, void* data, uint64_t data_size, RenderResourceFormat format, uint32_t width, uint32_t height, bool is_render_target, bool random_read_write_access, TextureColorSpace color_space);
+        Texture2DD3D12(const char* name, RenderResourceFormat format, uint32_t width, uint32_t height, bool is_render_target, bool random_read_write_access, TextureColorSpace color_space, uint32_t mip_levels);
+        Texture2DD3D12(const char* name, void* data, uint64_t data_size, RenderResourceFormat format, uint32_t width, uint32_t height, bool is_render_target, bool random_read_write_access, TextureColorSpace color_space, StreamDataMode data_mode, uint32_t mip_levels);
         Texture2DD3D12(const char* name, void* internal_resource, RenderResourceFormat format, uint32_t width, uint32_t height, bool is_render_target, bool random_read_write_access, TextureColorSpace color_space);
         ~Texture2DD3D12();
 
         const char* GetName() const override { return m_Name; }
 
         void* GetNativeResource() const override { return m_Resource; }
+        CreationState GetCreationState() const override;
 
         RenderResourceFormat GetFormat() const override { return m_Format; }
 
@@ -79,6 +90,7 @@ namespace RB::Graphics::D3D12
 
         uint32_t GetWidth() const override { return m_Width; }
         uint32_t GetHeight() const override { return m_Height; }
+        uint32_t GetMipLevels() const override { return m_MipLevels; }
 
         DescriptorIndex GetSrvHandle() const { return m_ReadHandle; }
         DescriptorIndex GetUavHandle() const { return m_WriteHandle; }
@@ -94,6 +106,7 @@ namespace RB::Graphics::D3D12
         GpuResource*                    m_Resource;
         uint32_t						m_Width;
         uint32_t						m_Height;
+        uint32_t						m_MipLevels;
         RenderResourceFormat			m_Format;
 
         bool							m_IsRenderTarget;
@@ -4,33 +4,78 @@
 #include "ResourceManager.h"
 #include "ResourceStateManager.h"
 
+#include "app/Application.h"
+
 namespace RB::Graphics::D3D12
 {
     void CreationJob(JobData* data);
 
     ResourceManager* g_ResourceManager = nullptr;
 
+    static ResourceHeapType GetResourceHeapType(const D3D12_RESOURCE_DESC& desc)
+    {
+        if (desc.Dimension == D3D12_RESOURCE_DIMENSION_BUFFER)
+        {
+            return ResourceHeapType::Buffer;
+        }
+
+        if (desc.Flags & (D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET | D3D12_RESOURCE_FLAG_ALLOW_DEPTH_STENCIL))
+        {
+            return ResourceHeapType::RenderTarget;
+        }
+
+        return ResourceHeapType::Texture;
+    }
+
     ResourceManager::ResourceManager()
+        : m_CommittedBytes(0)
+        , m_CommittedCount(0)
+        , m_PendingReleaseCount(0)
+        , m_PendingReleaseBytes(0)
     {
         InitializeCriticalSection(&m_CS);
+        InitializeCriticalSection(&m_HeapCS);
 
-        m_CreationThread = new WorkerThread(L"Resource Creation Thread", ThreadPriority::Medium);
+        m_CreationPool = Application::GetInstance()->GetWorkerPool();
 
-        m_CreationJob = m_CreationThread->AddJobType(&CreationJob, false);
+        m_CreationJob = m_CreationPool->AddJobType(&CreationJob);
     }
 
     ResourceManager::~ResourceManager()
     {
-        // Waits until the thread is done with all tasks
-        delete m_CreationThread;
+        // Wait until all the scheduled creations are done
+        m_CreationPool->SyncAll();
 
-        // Wait until all objects can be release
-        for (auto itr = m_InFlight.begin(); itr != m_InFlight.end();)
+        // Wait until all objects can be released
+        for (QueueRetirement& retirement : m_QueueRetirements)
         {
-            itr->first->queue->CpuWaitForFenceValue(itr->first->fenceValue);
-            itr = m_InFlight.erase(itr);
+            retirement.queue->CpuWaitForFenceValue(retirement.ring.GetLastFenceValue());
+            retirement.ring.RetireAll(m_RetiredReleases);
         }
 
+        for (uint32_t index : m_RetiredReleases)
+        {
+            if (--m_PendingReleases[index].waitCount == 0)
+            {
+                Release(index);
+            }
+        }
+
+        m_RetiredReleases.clear();
+        m_PendingReleases.clear();
+
+        for (List<ResourceHeap*>& heaps : m_Heaps)
+        {
+            for (ResourceHeap* heap : heaps)
+            {
+                RB_ASSERT(LOGTAG_GRAPHICS, heap->allocator.IsEmpty(), "Not all placed resources were deleted before the resource manager");
+                delete heap;
+            }
+
+            heaps.clear();
+        }
+
+        DeleteCriticalSection(&m_HeapCS);
         DeleteCriticalSection(&m_CS);
     }
 
@@ -38,35 +83,25 @@ namespace RB::Graphics::D3D12
     {
         EnterCriticalSection(&m_CS);
 
-        // TODO Future improvement would be to free the resources on the ResourceCreation thread as this can also be pretty expensive
+        // TODO Future improvement would be to free the resources on the worker pool as this can also be pretty expensive
 
-        // Check which resources have finished executing on the GPU
-        for (auto itr = m_InFlight.begin(); itr != m_InFlight.end();)
+        // Pop the submissions that have finished executing on the GPU
+        for (QueueRetirement& retirement : m_QueueRetirements)
         {
-            if (itr->first->queue->IsFenceReached(itr->first->fenceValue))
-            {
-                delete itr->first;
-                itr = m_InFlight.erase(itr);
-            }
-            else
-            {
-                ++itr;
-            }
+            retirement.ring.Retire(retirement.queue->GetCompletedFenceValue(), m_RetiredReleases);
         }
 
-        // Check which scheduled creations are completed
-        for (auto itr = m_ScheduledCreations.begin(); itr < m_ScheduledCreations.end();)
+        // Release the deleted resources that are not used by any queue anymore, their memory can be reused from now on
+        for (uint32_t index : m_RetiredReleases)
         {
-            if (m_CreationThread->IsFinished(itr->jobID))
-            {
-                itr = m_ScheduledCreations.erase(itr);
-            }
-            else
+            if (--m_PendingReleases[index].waitCount == 0)
             {
-                ++itr;
+                Release(index);
             }
         }
 
+        m_RetiredReleases.clear();
+
         LeaveCriticalSection(&m_CS);
     }
 
@@ -80,91 +115,122 @@ namespace RB::Graphics::D3D12
 
         EnterCriticalSection(&m_CS);
 
-        auto itr = m_ScheduledUsages.find(queue);
+        uint32_t slot = GetQueueSlot(queue);
+        resource->SetLastUsedSubmission(slot, m_QueueRetirements[slot].ring.GetOpenSubmission());
 
-        if (itr == m_ScheduledUsages.end())
-        {
-            List<GPtr<ID3D12Object>> list;
-            list.push_back(resource->GetResource());
+        LeaveCriticalSection(&m_CS);
+    }
+
+    void ResourceManager::MarkForDelete(GpuResource* resource)
+    {
+        EnterCriticalSection(&m_CS);
+
+        uint32_t index;
 
-            m_ScheduledUsages.emplace(queue, list);
+        if (!m_FreeReleases.empty())
+        {
+            index = m_FreeReleases.back();
+            m_FreeReleases.pop_back();
         }
         else
         {
-            // Only add it if its not already in the list
-            if (std::find(itr->second.begin(), itr->second.end(), resource->GetResource()) == itr->second.end())
+            index = m_PendingReleases.size();
+            m_PendingReleases.push_back({});
+        }
+
+        PendingRelease& release = m_PendingReleases[index];
+        release.resource    = resource->GetResource();
+        release.allocation  = resource->GetAllocation();
+        release.waitCount   = 0;
+
+        m_PendingReleaseCount++;
+        m_PendingReleaseBytes += release.allocation.size;
+
+        // Wait on the last submission of every queue that used the resource and is not done with it yet
+        for (uint32_t slot = 0; slot < m_QueueRetirements.size(); ++slot)
+        {
+            uint64_t submission = resource->GetLastUsedSubmission(slot);
+
+            if (submission != kInvalidSubmission && !m_QueueRetirements[slot].ring.IsRetired(submission))
             {
-                itr->second.push_back(resource->GetResource());
+                m_QueueRetirements[slot].ring.Add(submission, index);
+                release.waitCount++;
             }
         }
 
+        if (release.waitCount == 0)
+        {
+            Release(index);
+        }
+
         LeaveCriticalSection(&m_CS);
     }
 
-    void ResourceManager::MarkForDelete(GpuResource* resource)
+    void ResourceManager::OnCommandListExecute(DeviceQueue* queue, uint64_t fence_value)
     {
-        // Don't need to do anything to delete at the right time. This because when the resource is currently in flight or still 
-        // has to be used by a command list, there is a reference being kept to it by the m_ScheduledUsages or the m_InFlight member.
+        EnterCriticalSection(&m_CS);
+
+        // Everything that was marked as used on this queue so far is part of this submission
+        m_QueueRetirements[GetQueueSlot(queue)].ring.Submit(fence_value);
+
+        LeaveCriticalSection(&m_CS);
     }
 
-    void ResourceManager::OnCommandListExecute(DeviceQueue* queue, uint64_t fence_value)
+    uint32_t ResourceManager::GetQueueSlot(DeviceQueue* queue)
     {
-        EnterCriticalSection(&m_CS);
+        for (uint32_t slot = 0; slot < m_QueueRetirements.size(); ++slot)
+        {
+            if (m_QueueRetirements[slot].queue == queue)
+            {
+                return slot;
+            }
+        }
 
-        auto scheduled_use_itr = m_ScheduledUsages.find(queue);
-        RB_ASSERT_FATAL(LOGTAG_GRAPHICS, scheduled_use_itr != m_ScheduledUsages.end(), "DeviceQueue was not yet registered for the scheduled usages queue");
+        RB_ASSERT_FATAL(LOGTAG_GRAPHICS, m_QueueRetirements.size() < kMaxTrackedQueues, "Too many queues, increase kMaxTrackedQueues");
 
-        FencePair* fence_pair = new FencePair();
-        fence_pair->queue       = queue;
-        fence_pair->fenceValue  = fence_value;
+        m_QueueRetirements.push_back({ queue });
 
-        // Set all resources that were marked for use to this queue in flight
-        m_InFlight.emplace(fence_pair, scheduled_use_itr->second);
+        return m_QueueRetirements.size() - 1;
+    }
 
-        // Clear the scheduled usages for this queue
-        scheduled_use_itr->second.clear();
+    void ResourceManager::Release(uint32_t release_index)
+    {
+        PendingRelease& release = m_PendingReleases[release_index];
 
-        LeaveCriticalSection(&m_CS);
+        m_PendingReleaseCount--;
+        m_PendingReleaseBytes -= release.allocation.size;
+
+        release.resource = nullptr;
+        FreeAllocation(release.allocation);
+
+        m_FreeReleases.push_back(release_index);
     }
 
     bool ResourceManager::WaitUntilResourceValid(GpuResource* resource)
     {
-        if (m_CreationThread->IsCurrentThread())
+        if (resource->IsValid())
         {
-            // Its possible the creation thread might get in here because of the creation callback of the GpuResource
             return true;
         }
 
         EnterCriticalSection(&m_CS);
+        JobID id = resource->GetCreationJob();
+        LeaveCriticalSection(&m_CS);
 
-        // Find the scheduled creation
-        auto itr = std::find_if(m_ScheduledCreations.begin(), m_ScheduledCreations.end(), [resource](const Scheduled& scheduled) -> bool {
-            return resource == scheduled.resource;
-            });
-
-        if (itr == m_ScheduledCreations.end())
+        if (id == UINT64_MAX)
         {
-            LeaveCriticalSection(&m_CS);
             return false;
         }
 
-        JobID id = itr->jobID;
-
-        // HACK
-        // TODO Somehow the references to the upload resources from RenderInterfaceD3D12::UploadDataToResource are somehow getting mixed up in this list 
-        // and they start waiting on eachothers job (no clue why). To fix this for now just remove the job from the list when starting to wait on it.
-        // This can break when having multiple threads calling WaitUntilResourceValid and thus should be removed when the big upload resource has been implemented!
-        m_ScheduledCreations.erase(itr);
-
-        // Tell the thread to prioritize this resource creation as we are waiting for it
-        m_CreationThread->PrioritizeJob(id);
-
-        LeaveCriticalSection(&m_CS);
+        // Its possible the creating thread gets in here because of the creation callback of the GpuResource
+        if (m_CreationPool->IsExecutingJob(id))
+        {
+            return true;
+        }
 
-        // Sync until the job is completed
-        m_CreationThread->Sync(id);
+        m_CreationPool->Sync(id);
 
-        return true;
+        return resource->IsValid();
     }
 
     void ResourceManager::ScheduleCreateUploadResource(GpuResource* resource, const char* name, const BufferDesc& buffer_desc)
@@ -179,12 +245,7 @@ namespace RB::Graphics::D3D12
         desc->name      = wname;
         desc->buffer    = buffer_desc;
 
-        EnterCriticalSection(&m_CS);
-
-        JobID id = m_CreationThread->ScheduleJob(m_CreationJob, desc);
-        m_ScheduledCreations.push_back({ resource, id });
-
-        LeaveCriticalSection(&m_CS);
+        ScheduleCreation(desc);
     }
 
     void ResourceManager::ScheduleCreateVertexResource(GpuResource* resource, const char* name, const BufferDesc& buffer_desc)
@@ -199,12 +260,7 @@ namespace RB::Graphics::D3D12
         desc->name      = wname;
         desc->buffer    = buffer_desc;
 
-        EnterCriticalSection(&m_CS);
-
-        JobID id = m_CreationThread->ScheduleJob(m_CreationJob, desc);
-        m_ScheduledCreations.push_back({ resource, id });
-
-        LeaveCriticalSection(&m_CS);
+        ScheduleCreation(desc);
     }
 
     void ResourceManager::ScheduleCreateIndexResource(GpuResource* resource, const char* name, const BufferDesc& buffer_desc)
@@ -219,12 +275,7 @@ namespace RB::Graphics::D3D12
         desc->name      = wname;
         desc->buffer    = buffer_desc;
 
-        EnterCriticalSection(&m_CS);
-
-        JobID id = m_CreationThread->ScheduleJob(m_CreationJob, desc);
-        m_ScheduledCreations.push_back({ resource, id });
-
-        LeaveCriticalSection(&m_CS);
+        ScheduleCreation(desc);
     }
 
     void ResourceManager::ScheduleCreateTexture2DResource(GpuResource* resource, const char* name, const Texture2DDesc& tex_desc)
@@ -239,14 +290,221 @@ namespace RB::Graphics::D3D12
         desc->name      = wname;
         desc->tex2D     = tex_desc;
 
+        ScheduleCreation(desc);
+    }
+
+    void ResourceManager::ScheduleCreation(ResourceCreationDesc* desc)
+    {
+        // The job can already be done (and the desc deleted) before the job id is set
+        GpuResource* resource = desc->resource;
+
         EnterCriticalSection(&m_CS);
 
-        JobID id = m_CreationThread->ScheduleJob(m_CreationJob, desc);
-        m_ScheduledCreations.push_back({ resource, id });
+        JobID id = m_CreationPool->ScheduleJob(m_CreationJob, desc);
+        resource->SetCreationJob(id);
 
         LeaveCriticalSection(&m_CS);
     }
 
+    ResourceMemoryStats ResourceManager::GetMemoryStats()
+    {
+        ResourceMemoryStats stats = {};
+
+        EnterCriticalSection(&m_HeapCS);
+
+        stats.committedBytes = m_CommittedBytes;
+        stats.committedCount = m_CommittedCount;
+
+        float weighted_fragmentation = 0.0f;
+        uint64_t free_bytes = 0;
+
+        for (List<ResourceHeap*>& heaps : m_Heaps)
+        {
+            for (ResourceHeap* heap : heaps)
+            {
+                HeapAllocatorStats heap_stats = heap->allocator.GetStats();
+
+                stats.heapBytes         += heap_stats.size;
+                stats.heapCount         += 1;
+                stats.placedBytes       += heap_stats.usedBytes;
+                stats.placedCount       += heap_stats.allocationCount;
+                stats.largestFreeBlock  = Math::Max(stats.largestFreeBlock, heap_stats.largestFreeBlock);
+
+                uint64_t heap_free_bytes = heap_stats.size - heap_stats.usedBytes;
+                weighted_fragmentation  += heap_stats.fragmentation * heap_free_bytes;
+                free_bytes              += heap_free_bytes;
+            }
+        }
+
+        LeaveCriticalSection(&m_HeapCS);
+
+        stats.fragmentation = free_bytes > 0 ? weighted_fragmentation / free_bytes : 0.0f;
+
+        EnterCriticalSection(&m_CS);
+        stats.pendingReleaseCount = m_PendingReleaseCount;
+        stats.pendingReleaseBytes = m_PendingReleaseBytes;
+        LeaveCriticalSection(&m_CS);
+
+        return stats;
+    }
+
+    bool ResourceManager::AllocateFromHeap(ResourceHeapType type, const D3D12_RESOURCE_ALLOCATION_INFO& info, ResourceAllocation& out_allocation)
+    {
+        List<ResourceHeap*>& heaps = m_Heaps[(int)type];
+
+        out_allocation = {};
+        out_allocation.size = info.SizeInBytes;
+
+        for (ResourceHeap* heap : heaps)
+        {
+            if (heap->allocator.Allocate(info.SizeInBytes, info.Alignment, out_allocation.block))
+            {
+                out_allocation.heap = heap;
+                return true;
+            }
+        }
+
+        // Small textures can be placed at a smaller alignment, so their heaps are split up in smaller blocks
+        uint64_t granularity = type == ResourceHeapType::Texture ? D3D12_SMALL_RESOURCE_PLACEMENT_ALIGNMENT : D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT;
+
+        ResourceHeap* heap = new ResourceHeap(type, kResourceHeapSize, granularity);
+
+        D3D12_HEAP_DESC heap_desc = {};
+        heap_desc.SizeInBytes   = kResourceHeapSize;
+        heap_desc.Properties    = CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_DEFAULT);
+        heap_desc.Alignment     = D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT;
+
+        switch (type)
+        {
+        case ResourceHeapType::Buffer:          heap_desc.Flags = D3D12_HEAP_FLAG_ALLOW_ONLY_BUFFERS;               break;
+        case ResourceHeapType::Texture:         heap_desc.Flags = D3D12_HEAP_FLAG_ALLOW_ONLY_NON_RT_DS_TEXTURES;    break;
+        case ResourceHeapType::RenderTarget:    heap_desc.Flags = D3D12_HEAP_FLAG_ALLOW_ONLY_RT_DS_TEXTURES;        break;
+        default:
+            RB_ASSERT_ALWAYS(LOGTAG_GRAPHICS, "Unknown resource heap type");
+            break;
+        }
+
+        if (FAILED(g_GraphicsDevice->Get()->CreateHeap(&heap_desc, IID_PPV_ARGS(&heap->heap))))
+        {
+            RB_LOG_WARN(LOGTAG_GRAPHICS, "Could not create a new resource heap, falling back to committed resources");
+            delete heap;
+            return false;
+        }
+
+        heap->heap->SetName(L"Resource Heap");
+        heaps.push_back(heap);
+
+        if (!heap->allocator.Allocate(info.SizeInBytes, info.Alignment, out_allocation.block))
+        {
+            return false;
+        }
+
+        out_allocation.heap = heap;
+        return true;
+    }
+
+    void ResourceManager::FreeAllocation(const ResourceAllocation& allocation)
+    {
+        EnterCriticalSection(&m_HeapCS);
+
+        if (!allocation.heap)
+        {
+            m_CommittedBytes -= allocation.size;
+            m_CommittedCount--;
+
+            LeaveCriticalSection(&m_HeapCS);
+            return;
+        }
+
+        ResourceHeap* heap = allocation.heap;
+
+        // Keep 1 heap per type around, so creating and deleting a single resource does not keep recreating the heap
+        if (heap->allocator.Free(allocation.block) && heap->allocator.IsEmpty())
+        {
+            List<ResourceHeap*>& heaps = m_Heaps[(int)heap->type];
+
+            if (heaps.size() > 1)
+            {
+                heaps.erase(std::find(heaps.begin(), heaps.end(), heap));
+                delete heap;
+            }
+        }
+
+        LeaveCriticalSection(&m_HeapCS);
+    }
+
+    GPtr<ID3D12Resource> ResourceManager::CreateResource(const wchar_t* name, D3D12_RESOURCE_DESC resource_desc, D3D12_HEAP_TYPE heap_type, D3D12_RESOURCE_STATES start_state,
+        ResourceAllocation& out_allocation)
+    {
+        out_allocation = {};
+
+        GPtr<ID3D12Device2> device = g_GraphicsDevice->Get();
+        ResourceHeapType type = GetResourceHeapType(resource_desc);
+
+        // Try to use the small alignment for textures, this is only possible when the most detailed mip is small enough
+        if (type == ResourceHeapType::Texture)
+        {
+            resource_desc.Alignment = D3D12_SMALL_RESOURCE_PLACEMENT_ALIGNMENT;
+        }
+
+        D3D12_RESOURCE_ALLOCATION_INFO info = device->GetResourceAllocationInfo(0, 1, &resource_desc);
+
+        if (info.Alignment != resource_desc.Alignment)
+        {
+            resource_desc.Alignment = 0;
+            info = device->GetResourceAllocationInfo(0, 1, &resource_desc);
+        }
+
+        if (heap_type == D3D12_HEAP_TYPE_DEFAULT && info.SizeInBytes <= kMaxPlacedResourceSize)
+        {
+            EnterCriticalSection(&m_HeapCS);
+
+            bool placed = AllocateFromHeap(type, info, out_allocation);
+
+            LeaveCriticalSection(&m_HeapCS);
+
+            if (placed)
+            {
+                return CreatePlacedResource(name, resource_desc, out_allocation, start_state);
+            }
+        }
+
+        // Too big, not in a default heap or no heap could be created
+        resource_desc.Alignment = 0;
+
+        out_allocation = {};
+        out_allocation.size = device->GetResourceAllocationInfo(0, 1, &resource_desc).SizeInBytes;
+
+        EnterCriticalSection(&m_HeapCS);
+        m_CommittedBytes += out_allocation.size;
+        m_CommittedCount++;
+        LeaveCriticalSection(&m_HeapCS);
+
+        return CreateCommittedResource(name, resource_desc, heap_type, D3D12_HEAP_FLAG_NONE, start_state);
+    }
+
+    GPtr<ID3D12Resource> ResourceManager::CreatePlacedResource(const wchar_t* name, const D3D12_RESOURCE_DESC& resource_desc, const ResourceAllocation& allocation,
+        D3D12_RESOURCE_STATES start_state, const D3D12_CLEAR_VALUE* optimized_clear_value)
+    {
+        GPtr<ID3D12Resource> resource = nullptr;
+
+        RB_ASSERT_FATAL_D3D(g_GraphicsDevice->Get()->CreatePlacedResource(
+            allocation.heap->heap.Get(),
+            allocation.block.offset,
+            &resource_desc,
+            start_state,
+            optimized_clear_value,
+            IID_PPV_ARGS(&resource)
+        ), "Could not create placed resource: %s", name);
+
+        if (resource)
+        {
+            resource->SetName(name);
+        }
+
+        return resource;
+    }
+
     GPtr<ID3D12Resource> ResourceManager::CreateCommittedResource(const wchar_t* name, const D3D12_RESOURCE_DESC& resource_desc, D3D12_HEAP_TYPE heap_type,
         D3D12_HEAP_FLAGS heap_flags, D3D12_RESOURCE_STATES start_state, const D3D12_CLEAR_VALUE* optimized_clear_value)
     {
@@ -275,20 +533,23 @@ namespace RB::Graphics::D3D12
     {
         ResourceManager::ResourceCreationDesc* creation_desc = (ResourceManager::ResourceCreationDesc*)data;
 
+        ResourceAllocation allocation = {};
+
         switch (creation_desc->type)
         {
         case ResourceManager::ResourceType::Upload:
         {
             D3D12_RESOURCE_STATES state = D3D12_RESOURCE_STATE_COMMON;
 
-            creation_desc->resource->SetResource(
-                g_ResourceManager->CreateCommittedResource(
-                    creation_desc->name,
-                    CD3DX12_RESOURCE_DESC::Buffer(creation_desc->buffer.size),
-                    D3D12_HEAP_TYPE_UPLOAD,
-                    D3D12_HEAP_FLAG_NONE,
-                    state),
-                state);
+            GPtr<ID3D12Resource> resource = g_ResourceManager->CreateResource(
+                creation_desc->name,
+                CD3DX12_RESOURCE_DESC::Buffer(creation_desc->buffer.size),
+                D3D12_HEAP_TYPE_UPLOAD,
+                state,
+                allocation);
+
+            creation_desc->resource->SetAllocation(allocation);
+            creation_desc->resource->SetResource(resource, state);
         }
         break;
 
@@ -297,14 +558,15 @@ namespace RB::Graphics::D3D12
         {
             D3D12_RESOURCE_STATES state = D3D12_RESOURCE_STATE_COMMON; //D3D12_RESOURCE_STATE_COPY_DEST // Buffers are always created in the common state
 
-            creation_desc->resource->SetResource(
-                g_ResourceManager->CreateCommittedResource(
-                    creation_desc->name,
-                    CD3DX12_RESOURCE_DESC::Buffer(creation_desc->buffer.size),
-                    D3D12_HEAP_TYPE_DEFAULT,
-                    D3D12_HEAP_FLAG_NONE, //D3D12_HEAP_FLAG_ALLOW_ONLY_BUFFERS, // This flag is not allowed for commited resources as they are set automatically
-                    state),
-                state);
+            GPtr<ID3D12Resource> resource = g_ResourceManager->CreateResource(
+                creation_desc->name,
+                CD3DX12_RESOURCE_DESC::Buffer(creation_desc->buffer.size),
+                D3D12_HEAP_TYPE_DEFAULT,
+                state,
+                allocation);
+
+            creation_desc->resource->SetAllocation(allocation);
+            creation_desc->resource->SetResource(resource, state);
         }
         break;
 
@@ -314,15 +576,16 @@ namespace RB::Graphics::D3D12
 
             // TODO Fill in the optimized clear value for RenderTargets and DepthStencil textures
 
-            creation_desc->resource->SetResource(
-                g_ResourceManager->CreateCommittedResource(
-                    creation_desc->name,
-                    CD3DX12_RESOURCE_DESC::Tex2D(creation_desc->tex2D.format, creation_desc->tex2D.width, creation_desc->tex2D.height,
-                        creation_desc->tex2D.arraySize, creation_desc->tex2D.mipLevels, 1, 0, creation_desc->tex2D.flags, D3D12_TEXTURE_LAYOUT_UNKNOWN, 0),
-                    D3D12_HEAP_TYPE_DEFAULT,
-                    D3D12_HEAP_FLAG_NONE,
-                    state),
-                state);
+            GPtr<ID3D12Resource> resource = g_ResourceManager->CreateResource(
+                creation_desc->name,
+                CD3DX12_RESOURCE_DESC::Tex2D(creation_desc->tex2D.format, creation_desc->tex2D.width, creation_desc->tex2D.height,
+                    creation_desc->tex2D.arraySize, creation_desc->tex2D.mipLevels, 1, 0, creation_desc->tex2D.flags, D3D12_TEXTURE_LAYOUT_UNKNOWN, 0),
+                D3D12_HEAP_TYPE_DEFAULT,
+                state,
+                allocation);
+
+            creation_desc->resource->SetAllocation(allocation);
+            creation_desc->resource->SetResource(resource, state);
         }
         break;
 
@@ -4,17 +4,50 @@
 #include "GpuResource.h"
 #include "graphics/d3d12/DeviceQueue.h"
 #include "graphics/RenderInterface.h"
+#include "graphics/RetirementRing.h"
 #include "utils/Threading.h"
 
 #include <d3d12.h>
 
 namespace RB::Graphics::D3D12
 {
-    /*
-    * TODO:
-    * - Track the resource sizes
-    * - Make is possible to easily create and alias (multiple) resources from 1 heap (all rendertargets in 1 big heap?)
-    */
+    // Size of the heaps that the placed resources are suballocated from
+    constexpr uint64_t kResourceHeapSize        = k64MB;
+    // Bigger resources get their own committed resource, so a couple of big textures do not take up a whole heap
+    constexpr uint64_t kMaxPlacedResourceSize   = k16MB;
+
+    // Separate heaps per resource category, as heap tier 1 hardware does not allow mixing them
+    enum class ResourceHeapType
+    {
+        Buffer,
+        Texture,
+        RenderTarget,   // Render target and depth stencil textures
+        Count
+    };
+
+    struct ResourceHeap
+    {
+        GPtr<ID3D12Heap>    heap;
+        ResourceHeapType    type;
+        HeapAllocator       allocator;
+
+        ResourceHeap(ResourceHeapType type, uint64_t size, uint64_t granularity)
+            : type(type), allocator(size, granularity) {}
+    };
+
+    struct ResourceMemoryStats
+    {
+        uint64_t    committedBytes;
+        uint32_t    committedCount;
+        uint64_t    heapBytes;          // Total size of all heaps
+        uint32_t    heapCount;
+        uint64_t    placedBytes;        // Used memory in the heaps
+        uint32_t    placedCount;        // Allocations in the heaps
+        uint64_t    largestFreeBlock;
+        float       fragmentation;      // Of the free memory in the heaps, weighted by the free memory per heap
+        uint32_t    pendingReleaseCount;  // Deleted resources that the GPU might still be using
+        uint64_t    pendingReleaseBytes;
+    };
 
     // Global resource manager
     class ResourceManager
@@ -45,11 +78,16 @@ namespace RB::Graphics::D3D12
             D3D12_RESOURCE_FLAGS	flags;
         };
 
+        // The creations run on the shared worker pool, the GpuResource is the handle to poll the creation with (see GpuResource::GetCreationState)
         void ScheduleCreateUploadResource(GpuResource* resource, const char* name, const BufferDesc& desc);
         void ScheduleCreateVertexResource(GpuResource* resource, const char* name, const BufferDesc& desc);
         void ScheduleCreateIndexResource(GpuResource* resource, const char* name, const BufferDesc& desc);
         void ScheduleCreateTexture2DResource(GpuResource* resource, const char* name, const Texture2DDesc& desc);
 
+        ResourceMemoryStats GetMemoryStats();
+
+        // Only for when the resource is needed right away, the creation is done on the calling thread when no worker started on it yet.
+        // Returns false when the creation failed or was never scheduled.
         bool WaitUntilResourceValid(GpuResource* resource);
 
     private:
@@ -57,17 +95,59 @@ namespace RB::Graphics::D3D12
         // -----------------------------------------------------------------------------
         //								RAW RESOUCE CREATION
 
+        // Places the resource in one of the heaps when it is small enough, or creates a committed resource otherwise
+        GPtr<ID3D12Resource> CreateResource(const wchar_t* name, D3D12_RESOURCE_DESC resource_desc, D3D12_HEAP_TYPE heap_type, D3D12_RESOURCE_STATES start_state,
+            ResourceAllocation& out_allocation);
+
+        GPtr<ID3D12Resource> CreatePlacedResource(const wchar_t* name, const D3D12_RESOURCE_DESC& resource_desc, const ResourceAllocation& allocation,
+            D3D12_RESOURCE_STATES start_state = D3D12_RESOURCE_STATE_COMMON, const D3D12_CLEAR_VALUE* optimized_clear_value = nullptr);
+
         GPtr<ID3D12Resource> CreateCommittedResource(const wchar_t* name, const D3D12_RESOURCE_DESC& resource_desc, D3D12_HEAP_TYPE heap_type = D3D12_HEAP_TYPE_DEFAULT,
             D3D12_HEAP_FLAGS heap_flags = D3D12_HEAP_FLAG_NONE, D3D12_RESOURCE_STATES start_state = D3D12_RESOURCE_STATE_COMMON, const D3D12_CLEAR_VALUE* optimized_clear_value = nullptr);
 
-        struct FencePair
+
+        // -----------------------------------------------------------------------------
+        //								HEAPS
+
+        bool AllocateFromHeap(ResourceHeapType type, const D3D12_RESOURCE_ALLOCATION_INFO& info, ResourceAllocation& out_allocation);
+        void FreeAllocation(const ResourceAllocation& allocation);
+
+        // -----------------------------------------------------------------------------
+        //								DEFERRED RELEASES
+
+        // Resources are stamped with the submission of every queue they are used in. A deleted resource waits in the buckets of those
+        // submissions, and its memory is reused once the submissions of all the queues that used it are retired.
+        struct QueueRetirement
+        {
+            DeviceQueue*    queue;
+            RetirementRing  ring;
+        };
+
+        struct PendingRelease
         {
-            DeviceQueue* queue;
-            uint64_t	 fenceValue;
+            GPtr<ID3D12Resource>    resource;
+            ResourceAllocation      allocation;
+            uint32_t                waitCount;      // Queues that can still be using the resource
         };
 
-        UnorderedMap<DeviceQueue*, List<GPtr<ID3D12Object>>> m_ScheduledUsages;
-        UnorderedMap<FencePair*,   List<GPtr<ID3D12Object>>> m_InFlight;
+        // Should be called while holding m_CS
+        uint32_t GetQueueSlot(DeviceQueue* queue);
+        void     Release(uint32_t release_index);
+
+        List<QueueRetirement>   m_QueueRetirements;
+
+        List<PendingRelease>    m_PendingReleases;
+        List<uint32_t>          m_FreeReleases;
+        List<uint32_t>          m_RetiredReleases;
+        uint32_t                m_PendingReleaseCount;
+        uint64_t                m_PendingReleaseBytes;
+
+        List<ResourceHeap*>     m_Heaps[(int)ResourceHeapType::Count];
+        uint64_t                m_CommittedBytes;
+        uint32_t                m_CommittedCount;
+
+        // Guards the heaps and the memory stats, which are used by both the creation thread and the bookkeeping
+        CRITICAL_SECTION        m_HeapCS;
 
         enum class ResourceType
         {
@@ -95,15 +175,10 @@ namespace RB::Graphics::D3D12
             }
         };
 
-        struct Scheduled
-        {
-            GpuResource* resource;
-            JobID		 jobID;
-        };
+        void ScheduleCreation(ResourceCreationDesc* desc);
 
-        WorkerThread*       m_CreationThread;
+        WorkerPool*         m_CreationPool;
         JobTypeID			m_CreationJob;
-        List<Scheduled>		m_ScheduledCreations;
 
         CRITICAL_SECTION	m_CS;
 
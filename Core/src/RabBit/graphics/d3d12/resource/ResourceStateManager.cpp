@@ -3,6 +3,8 @@
 #include "GpuResource.h"
 #include "../GraphicsDevice.h"
 
+#include "utils/debug/Stats.h"
+
 namespace RB::Graphics::D3D12
 {
     ResourceStateManager* g_ResourceStateManager = nullptr;
@@ -32,6 +34,32 @@ namespace RB::Graphics::D3D12
         InsertResourceBarrier(CD3DX12_RESOURCE_BARRIER::Transition(res, old_state, to_state, D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES));
     }
 
+    bool ResourceStateManager::BeginSplitTransition(GpuResource* resource, D3D12_RESOURCE_STATES to_state, D3D12_RESOURCE_STATES& out_before_state)
+    {
+        if (resource->IsInState(to_state))
+        {
+            return false;
+        }
+
+        ID3D12Resource* res = resource->GetResource().Get();
+
+        out_before_state = resource->GetState();
+
+        // The resource is tracked in its new state right away, it should not be used until the split transition is ended
+        resource->UpdateState(to_state);
+
+        InsertResourceBarrier(CD3DX12_RESOURCE_BARRIER::Transition(res, out_before_state, to_state, D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES, D3D12_RESOURCE_BARRIER_FLAG_BEGIN_ONLY));
+
+        return true;
+    }
+
+    void ResourceStateManager::EndSplitTransition(GpuResource* resource, D3D12_RESOURCE_STATES before_state, D3D12_RESOURCE_STATES after_state)
+    {
+        ID3D12Resource* res = resource->GetResource().Get();
+
+        InsertResourceBarrier(CD3DX12_RESOURCE_BARRIER::Transition(res, before_state, after_state, D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES, D3D12_RESOURCE_BARRIER_FLAG_END_ONLY));
+    }
+
     void ResourceStateManager::InsertUAVBarrier(GpuResource* resource)
     {
         ID3D12Resource* res = resource ? resource->GetResource().Get() : nullptr;
@@ -51,6 +79,7 @@ namespace RB::Graphics::D3D12
         }
 
         command_list->ResourceBarrier(m_PendingBarriers.size(), m_PendingBarriers.data());
+        RB_STAT_ADD(ResourceBarriers, m_PendingBarriers.size());
 
         m_PendingBarriers.clear();
     }
@@ -16,6 +16,10 @@ namespace RB::Graphics::D3D12
 
         void TransitionResource(GpuResource* resource, D3D12_RESOURCE_STATES to_state);
 
+        // Returns false when the resource is already in the requested state and no split transition was started
+        bool BeginSplitTransition(GpuResource* resource, D3D12_RESOURCE_STATES to_state, D3D12_RESOURCE_STATES& out_before_state);
+        void EndSplitTransition(GpuResource* resource, D3D12_RESOURCE_STATES before_state, D3D12_RESOURCE_STATES after_state);
+
         void InsertUAVBarrier(GpuResource* resource);
         void InsertAliasBarrier(GpuResource* before, GpuResource* after);
 
@@ -2,152 +2,116 @@
 #include "UploadAllocator.h"
 #include "ResourceManager.h"
 
+#include "utils/debug/Stats.h"
+
 namespace RB::Graphics::D3D12
 {
-    // ----------------------------------------------------------------------------
-    //									UploadPage
-    // ----------------------------------------------------------------------------
-
-    UploadPage::UploadPage(const char* name, uint64_t size)
+    UploadAllocator::UploadAllocator(const char* name, uint64_t ring_size)
         : m_Name(name)
-        , m_ResourceSize(size)
-        , m_UploadOffset(0)
+        , m_Ring(ring_size)
     {
         m_UploadResource = new GpuResource();
-        g_ResourceManager->ScheduleCreateUploadResource(m_UploadResource, m_Name, { m_ResourceSize });
+        g_ResourceManager->ScheduleCreateUploadResource(m_UploadResource, m_Name, { ring_size });
 
+        // Upload resources can stay mapped for their whole lifetime
         m_UploadResource->GetResource()->Map(0, nullptr, (void**)&m_WriteAddress);
         m_GpuAddress = m_UploadResource->GetResource()->GetGPUVirtualAddress();
-    }
 
-    UploadPage::~UploadPage()
-    {
-        delete m_UploadResource;
+        InitializeCriticalSection(&m_FallbackCS);
     }
 
-    void UploadPage::Reset()
+    // Should only be deleted when the GPU is done with all the submissions
+    UploadAllocator::~UploadAllocator()
     {
-        m_UploadOffset = 0;
-    }
+        for (GpuResource* resource : m_UnsubmittedFallbacks)
+        {
+            delete resource;
+        }
 
-    bool UploadPage::HasSpace(uint64_t size, uint64_t alignment)
-    {
-        return Math::AlignUp(Math::AlignUp(m_UploadOffset, alignment) + size, alignment) <= m_ResourceSize;
+        for (FallbackResource& fallback : m_InFlightFallbacks)
+        {
+            delete fallback.resource;
+        }
+
+        m_UnsubmittedFallbacks.clear();
+        m_InFlightFallbacks.clear();
+
+        delete m_UploadResource;
+
+        DeleteCriticalSection(&m_FallbackCS);
     }
 
-    UploadAllocation UploadPage::Allocate(uint64_t size, uint64_t alignment)
+    UploadAllocation UploadAllocator::Allocate(uint64_t size, uint64_t alignment)
     {
-        RB_ASSERT_FATAL(LOGTAG_GRAPHICS, HasSpace(size, alignment), L"Not enough space to allocate %d bytes on upload resource: %s", size, m_Name);
-
         uint64_t aligned_size = Math::AlignUp(size, alignment);
-        m_UploadOffset = Math::AlignUp(m_UploadOffset, alignment);
+        uint64_t offset       = m_Ring.Allocate(aligned_size, alignment);
 
-        UploadAllocation location = {};
-        location.resource           = m_UploadResource;
-        location.maxWriteSize       = aligned_size;
-        location.offset             = m_UploadOffset;
-        location.address            = m_GpuAddress + m_UploadOffset;
-        location.cpuWriteAddress    = m_WriteAddress + m_UploadOffset;
+        RB_STAT_ADD(UploadedBytes, aligned_size);
 
-        m_UploadOffset += aligned_size;
+        UploadAllocation allocation = {};
+        allocation.maxWriteSize = aligned_size;
 
-        return location;
-    }
+        if (offset != kInvalidRingOffset)
+        {
+            allocation.resource         = m_UploadResource;
+            allocation.offset           = offset;
+            allocation.address          = m_GpuAddress + offset;
+            allocation.cpuWriteAddress  = m_WriteAddress + offset;
 
-    // ----------------------------------------------------------------------------
-    //								UploadAllocator
-    // ----------------------------------------------------------------------------
+            return allocation;
+        }
 
-    UploadAllocator::UploadAllocator(const char* name, uint64_t page_size)
-        : m_Name(name)
-        , m_PageSize(page_size)
-        , m_CurrentPage(-1)
-        , m_ResetCounter(0)
-    {
+        // Does not fit in the ring (too big, or the GPU is too far behind), give it its own resource
+        GpuResource* resource = new GpuResource();
+        g_ResourceManager->ScheduleCreateUploadResource(resource, m_Name, { aligned_size });
 
-    }
+        allocation.resource = resource;
+        allocation.offset   = 0;
+        allocation.address  = resource->GetResource()->GetGPUVirtualAddress();
+        resource->GetResource()->Map(0, nullptr, (void**)&allocation.cpuWriteAddress);
 
-    UploadAllocator::~UploadAllocator()
-    {
-        for (int i = 0; i < m_Pages.size(); i++)
-        {
-            delete m_Pages[i];
-        }
+        EnterCriticalSection(&m_FallbackCS);
+        m_UnsubmittedFallbacks.push_back(resource);
+        LeaveCriticalSection(&m_FallbackCS);
 
-        m_Pages.clear();
+        return allocation;
     }
 
-    void UploadAllocator::Reset()
+    void UploadAllocator::Submit(uint64_t fence_value)
     {
-        for (UploadPage* page : m_Pages)
-        {
-            page->Reset();
-        }
+        m_Ring.Submit(fence_value);
 
-        m_ResetCounter++;
-        m_LastHighestPage = Math::Max(m_LastHighestPage, m_CurrentPage);
+        EnterCriticalSection(&m_FallbackCS);
 
-        // Every x resets, check if there are any pages not used, if so, delete them
-        if (m_ResetCounter == m_DeleteCheck)
+        for (GpuResource* resource : m_UnsubmittedFallbacks)
         {
-            for (int i = m_LastHighestPage + 1; i < m_Pages.size(); ++i)
-            {
-                delete m_Pages[i];
-            }
-
-            m_Pages.resize(Math::Max(m_LastHighestPage + 1, 0));
-
-            m_ResetCounter = 0;
-            m_LastHighestPage = 0;
+            m_InFlightFallbacks.push_back({ resource, fence_value });
         }
 
-        m_CurrentPage = 0;
+        m_UnsubmittedFallbacks.clear();
+
+        LeaveCriticalSection(&m_FallbackCS);
     }
 
-    UploadAllocation UploadAllocator::Allocate(uint64_t size, uint64_t alignment)
+    void UploadAllocator::Retire(uint64_t completed_fence_value)
     {
-        RB_ASSERT_FATAL(LOGTAG_GRAPHICS, size <= m_PageSize, L"Upload resource: %s, is too small to allocate %d bytes, increase the page size", m_Name, size);
+        m_Ring.Retire(completed_fence_value);
 
-        if (m_CurrentPage == -1)
-        {
-            m_CurrentPage = AddNewPage();
-        }
+        EnterCriticalSection(&m_FallbackCS);
 
-        if (!m_Pages[m_CurrentPage]->HasSpace(size, alignment))
+        for (int32_t i = m_InFlightFallbacks.size() - 1; i >= 0; --i)
         {
-            // Check if other pages have space
-            bool found_space = false;
-            for (int i = 0; i < m_Pages.size(); ++i)
-            {
-                if (m_Pages[i]->HasSpace(size, alignment))
-                {
-                    found_space = true;
-
-                    // Make sure to keep track of which pages were used
-                    m_LastHighestPage = Math::Max(m_LastHighestPage, m_CurrentPage);
-
-                    m_CurrentPage = i;
-                    break;
-                }
-            }
-
-            if (!found_space)
+            if (m_InFlightFallbacks[i].fenceValue > completed_fence_value)
             {
-                m_CurrentPage = AddNewPage();
+                continue;
             }
-        }
-
-        return m_Pages[m_CurrentPage]->Allocate(size, alignment);
-    }
 
-    int32_t UploadAllocator::AddNewPage()
-    {
-        std::string name(m_Name);
-        name += " Page ";
-        name += std::to_string(m_Pages.size());
+            delete m_InFlightFallbacks[i].resource;
 
-        m_Pages.push_back(new UploadPage(name.c_str(), m_PageSize));
+            m_InFlightFallbacks[i] = m_InFlightFallbacks.back();
+            m_InFlightFallbacks.pop_back();
+        }
 
-        return m_Pages.size() - 1;
+        LeaveCriticalSection(&m_FallbackCS);
     }
-}
\ No newline at end of file
+}
@@ -1,11 +1,18 @@
 #pragma once
 
+#include "graphics/UploadRing.h"
+
 #include <d3d12.h>
 
 namespace RB::Graphics::D3D12
 {
     class GpuResource;
 
+    // Upload ring size of the graphics and compute interfaces, which mostly upload constant data
+    constexpr uint64_t kUploadRingSize      = k4MB;
+    // The copy interface uploads the streamed resources, so its ring fits the default streaming budget of a frame
+    constexpr uint64_t kCopyUploadRingSize  = k32MB;
+
     struct UploadAllocation
     {
         GpuResource*                resource;
@@ -15,50 +22,43 @@ namespace RB::Graphics::D3D12
         uint8_t*                    cpuWriteAddress;	// Contains the offset
     };
 
-    class UploadPage
+    // Suballocates upload memory from one persistently mapped upload resource using an UploadRing. Allocations that do not fit
+    // in the ring get their own upload resource, which is kept alive until the GPU is done with it.
+    // Allocate can be called from multiple threads, Submit and Retire only from the thread that executes the command lists.
+    class UploadAllocator
     {
     public:
-        UploadPage(const char* name, uint64_t size);
-        ~UploadPage();
-
-        void Reset();
-
-        bool HasSpace(uint64_t size, uint64_t alignment);
+        UploadAllocator(const char* name, uint64_t ring_size);
+        ~UploadAllocator();
 
         UploadAllocation Allocate(uint64_t size, uint64_t alignment);
 
-    private:
-        const char* m_Name;
+        // Should be called with the fence value of the command list(s) that use all the allocations done so far
+        void Submit(uint64_t fence_value);
 
-        GpuResource*                m_UploadResource;
-        D3D12_GPU_VIRTUAL_ADDRESS	m_GpuAddress;
-        uint8_t*                    m_WriteAddress;
-        uint64_t					m_UploadOffset;
-        uint64_t					m_ResourceSize;
-    };
+        // Frees the allocations of the submissions that have been finished by the GPU
+        void Retire(uint64_t completed_fence_value);
 
-    class UploadAllocator
-    {
-    public:
-        UploadAllocator(const char* name, uint64_t page_size);
-        ~UploadAllocator();
-
-        void Reset();
-
-        UploadAllocation Allocate(uint64_t size, uint64_t alignment);
+        UploadRingStats GetStats() const { return m_Ring.GetStats(); }
 
     private:
-        int32_t AddNewPage();
+        struct FallbackResource
+        {
+            GpuResource*    resource;
+            uint64_t        fenceValue;
+        };
 
-        const char*         m_Name;
+        const char*                 m_Name;
 
-        List<UploadPage*>	m_Pages;
-        int32_t				m_CurrentPage;
+        GpuResource*                m_UploadResource;
+        D3D12_GPU_VIRTUAL_ADDRESS	m_GpuAddress;
+        uint8_t*                    m_WriteAddress;
 
-        uint64_t			m_PageSize;
+        UploadRing                  m_Ring;
 
-        const uint32_t		m_DeleteCheck = 10;
-        uint32_t			m_ResetCounter;
-        int32_t				m_LastHighestPage;
+        // Guards the fallback resources
+        CRITICAL_SECTION            m_FallbackCS;
+        List<GpuResource*>          m_UnsubmittedFallbacks;
+        List<FallbackResource>      m_InFlightFallbacks;
     };
-}
\ No newline at end of file
+}
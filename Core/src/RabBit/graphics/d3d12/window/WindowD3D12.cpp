@@ -14,6 +14,7 @@
 #include "events/WindowEvent.h"
 #include "events/MouseEvent.h"
 #include "events/KeyEvent.h"
+#include "events/input/Input.h"
 
 using namespace RB::Events;
 
@@ -55,6 +56,20 @@ namespace RB::Graphics::D3D12
             delete[] wchar_name;
         }
 
+        // Raw mouse motion, so the input samples get the motion at the rate of the mouse instead of the coalesced cursor position
+        {
+            RAWINPUTDEVICE raw_mouse = {};
+            raw_mouse.usUsagePage   = 0x01;     // Generic desktop controls
+            raw_mouse.usUsage       = 0x02;     // Mouse
+            raw_mouse.dwFlags       = 0;
+            raw_mouse.hwndTarget    = nullptr;  // Follows the keyboard focus
+
+            if (!::RegisterRawInputDevices(&raw_mouse, 1, sizeof(raw_mouse)))
+            {
+                RB_LOG_WARN(LOGTAG_WINDOWING, "Failed to register the raw mouse input, only the cursor position will be sampled");
+            }
+        }
+
         // Create swapchain
         {
             // TODO Add the option for an HDR swapchain
@@ -338,10 +353,71 @@ namespace RB::Graphics::D3D12
         case WM_SYSKEYDOWN:
         case WM_KEYDOWN:
         {
+            g_InputSampler->AddKey(GetInputTimestamp(), static_cast<KeyCode>(wParam), true);
+
             KeyPressedEvent e(static_cast<KeyCode>(wParam), false);
             g_EventManager->InsertEvent(e);
         }
         break;
+        case WM_SYSKEYUP:
+        case WM_KEYUP:
+        {
+            g_InputSampler->AddKey(GetInputTimestamp(), static_cast<KeyCode>(wParam), false);
+
+            // The system menu (Alt, F10) is handled by the default procedure
+            if (message == WM_SYSKEYUP)
+            {
+                return DefWindowProcW(hwnd, message, wParam, lParam);
+            }
+        }
+        break;
+        case WM_MOUSEMOVE:
+        {
+            g_InputSampler->AddMouseMove(GetInputTimestamp(), (float)(int16_t)LOWORD(lParam), (float)(int16_t)HIWORD(lParam));
+        }
+        break;
+        case WM_LBUTTONDOWN:
+        case WM_LBUTTONUP:
+        {
+            g_InputSampler->AddMouseButton(GetInputTimestamp(), MouseCode::ButtonLeft, message == WM_LBUTTONDOWN);
+        }
+        break;
+        case WM_RBUTTONDOWN:
+        case WM_RBUTTONUP:
+        {
+            g_InputSampler->AddMouseButton(GetInputTimestamp(), MouseCode::ButtonRight, message == WM_RBUTTONDOWN);
+        }
+        break;
+        case WM_MBUTTONDOWN:
+        case WM_MBUTTONUP:
+        {
+            g_InputSampler->AddMouseButton(GetInputTimestamp(), MouseCode::ButtonMiddle, message == WM_MBUTTONDOWN);
+        }
+        break;
+        case WM_MOUSEWHEEL:
+        {
+            g_InputSampler->AddMouseScroll(GetInputTimestamp(), 0.0f, (float)GET_WHEEL_DELTA_WPARAM(wParam) / WHEEL_DELTA);
+        }
+        break;
+        case WM_MOUSEHWHEEL:
+        {
+            g_InputSampler->AddMouseScroll(GetInputTimestamp(), (float)GET_WHEEL_DELTA_WPARAM(wParam) / WHEEL_DELTA, 0.0f);
+        }
+        break;
+        case WM_INPUT:
+        {
+            RAWINPUT raw = {};
+            UINT size = sizeof(raw);
+
+            if (::GetRawInputData((HRAWINPUT)lParam, RID_INPUT, &raw, &size, sizeof(RAWINPUTHEADER)) != (UINT)-1 &&
+                raw.header.dwType == RIM_TYPEMOUSE && (raw.data.mouse.usFlags & MOUSE_MOVE_ABSOLUTE) == 0)
+            {
+                g_InputSampler->AddMouseDelta(GetInputTimestamp(), (float)raw.data.mouse.lLastX, (float)raw.data.mouse.lLastY);
+            }
+
+            // Lets the system clean up the raw input
+            return DefWindowProcW(hwnd, message, wParam, lParam);
+        }
         case WM_SYSCHAR:
             break;
         case WM_SIZE:
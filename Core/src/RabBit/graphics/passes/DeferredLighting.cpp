@@ -37,7 +37,8 @@ namespace RB::Graphics
 
                 // Output textures
                 {
-                    RenderTextureDesc{"Lit",  RenderResourceFormat::R32G32B32A32_FLOAT, kRTSize_Full, kRTSize_Full, kRTFlag_AllowRenderTarget},
+                    // Every pixel is lit by the dispatch in Render, so a clear of an aliased texture can be skipped
+                    RenderTextureDesc{"Lit",  RenderResourceFormat::R32G32B32A32_FLOAT, kRTSize_Full, kRTSize_Full, kRTFlag_AllowRenderTarget | kRTFlag_FullyOverwritten},
                 },
                 1,
 
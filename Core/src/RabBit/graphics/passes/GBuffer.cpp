@@ -4,6 +4,13 @@
 #include "graphics/RenderResource.h"
 #include "graphics/RenderInterface.h"
 #include "graphics/View.h"
+#include "graphics/Renderer.h"
+#include "graphics/ResourceStreamer.h"
+#include "graphics/ResourceDefaults.h"
+#include "graphics/TextureResidency.h"
+#include "graphics/GeometryPool.h"
+
+#include "app/Application.h"
 
 #include "entity/Scene.h"
 #include "entity/components/Mesh.h"
@@ -20,6 +27,7 @@ namespace RB::Graphics
         {
             VertexBuffer*   vb;
             IndexBuffer*    ib;
+            GeometryRange   range;          // Set when the buffers are the page buffers of the geometry pool
             Texture*        texture;
             Math::Float4x4	modelMatrix;
         };
@@ -62,6 +70,28 @@ namespace RB::Graphics
             });
     }
 
+    // Rough size (in pixels) of an object on the screen. Meshes do not have bounds yet, so the biggest scale is used as its radius.
+    static float EstimateScreenSize(const ViewContext* view_context, const Entity::Transform* transform)
+    {
+        Math::Float4x4 world_to_view = view_context->viewFrustum.GetWorldToViewMatrix();
+        Math::Float4x4 view_to_clip  = view_context->viewFrustum.GetViewToClipMatrix();
+
+        float radius = Math::Max(Math::Max(transform->scale.x, transform->scale.y), transform->scale.z);
+        float size   = radius * view_to_clip.a11 * view_context->viewport.height;
+
+        // Perspective projection, the size gets smaller with the distance
+        if (view_to_clip.a23 != 0.0f)
+        {
+            // The view matrix holds the negated position of the camera
+            Math::Float3 camera_position = world_to_view.GetPosition() * -1.0f;
+            float distance = (transform->position - camera_position).GetLength();
+
+            size /= Math::Max(distance, 0.001f);
+        }
+
+        return size;
+    }
+
     RenderPassEntry* GBufferPass::SubmitEntry(const ViewContext* view_context, const Entity::Scene* const scene)
     {
         auto mesh_renderers = scene->GetComponentsWithTypeOf<Entity::MeshRenderer>();
@@ -70,13 +100,33 @@ namespace RB::Graphics
 
         uint32_t total_entries = 0;
 
+        ResourceStreamer* streamer = Application::GetInstance()->GetRenderer()->GetStreamer();
+        TextureResidencyManager* residency = Application::GetInstance()->GetRenderer()->GetTextureResidency();
+        GeometryPool* geometry_pool = Application::GetInstance()->GetRenderer()->GetGeometryPool();
+
+        // Resources of objects that are in view should be streamed first
+        auto is_ready_or_prioritize = [streamer](const RenderResource* resource) -> bool
+        {
+            if (resource->ReadyToRender())
+            {
+                return true;
+            }
+
+            streamer->Prioritize(resource, StreamPriority::Visible);
+            return false;
+        };
+
         for (int i = 0; i < mesh_renderers.size(); ++i)
         {
             const Entity::MeshRenderer* mesh_renderer = (const Entity::MeshRenderer*)mesh_renderers[i];
             const Entity::Mesh* mesh = mesh_renderer->GetMesh();
             const Entity::Material* mat = mesh_renderer->GetMaterial();
 
-            if (mesh->GetVertexBuffer()->ReadyToRender() || mat->GetTexture()->ReadyToRender())
+            bool vb_ready  = is_ready_or_prioritize(mesh->GetVertexBuffer());
+            bool ib_ready  = mesh->GetIndexBuffer() == nullptr || is_ready_or_prioritize(mesh->GetIndexBuffer());
+
+            // Can not render the geometry without its buffers
+            if (!vb_ready || !ib_ready)
             {
                 continue;
             }
@@ -88,10 +138,36 @@ namespace RB::Graphics
                 continue;
             }
 
+            // Let the residency manager know which mips are needed for the size of the object on the screen
+            if (mat->GetStreamedTexture() != kInvalidStreamedTexture)
+            {
+                residency->RequestScreenSize(mat->GetStreamedTexture(), EstimateScreenSize(view_context, transform));
+            }
+
+            // Use the fallback texture until the first mips of the actual texture are streamed
+            Texture2D* texture = ResidentOr(mat->GetTexture(), g_TexDefaultStreaming);
+
+            if (!texture->ReadyToRender())
+            {
+                continue;
+            }
+
             GBufferEntry::ModelEntry entry = {};
-            entry.vb            = mesh->GetVertexBuffer();
-            entry.ib            = mesh->GetIndexBuffer();
-            entry.texture       = mat->GetTexture();
+            entry.texture       = texture;
+
+            // Pooled meshes are drawn from the page buffers, so consecutive draws from the same page do not have to rebind them
+            if (mesh->IsPooled())
+            {
+                entry.range = mesh->GetGeometryRange();
+                entry.vb    = geometry_pool->GetVertexBuffer(entry.range.page);
+                entry.ib    = geometry_pool->GetIndexBuffer(entry.range.page);
+            }
+            else
+            {
+                entry.vb    = mesh->GetVertexBuffer();
+                entry.ib    = mesh->GetIndexBuffer();
+            }
+
             entry.modelMatrix   = transform->GetLocalToWorldMatrix();
 
             entries[total_entries] = entry;
@@ -104,6 +180,12 @@ namespace RB::Graphics
             return nullptr;
         }
 
+        // Group the draws per vertex buffer
+        std::sort(entries, entries + total_entries, [](const GBufferEntry::ModelEntry& a, const GBufferEntry::ModelEntry& b) -> bool
+        {
+            return a.vb < b.vb;
+        });
+
         GBufferEntry* entry = new GBufferEntry();
         entry->entries      = entries;
         entry->totalEntries = total_entries;
@@ -128,27 +210,44 @@ namespace RB::Graphics
 
         in.renderInterface->SetRenderTarget(&bundle);
 
+        // The graph textures can be bigger than the view (they are pooled), so only render to the part of the view
+        in.renderInterface->SetViewport(in.viewContext->viewport);
+
         GBufferEntry* entry = (GBufferEntry*)in.entryContext;
 
         // Set the frame constants
         in.viewContext->SetFrameConstants(in.renderInterface);
 
+        VertexBuffer* bound_vb = nullptr;
+
         for (int i = 0; i < entry->totalEntries; ++i)
         {
             GBufferEntry::ModelEntry& model_entry = entry->entries[i];
 
-            in.renderInterface->SetVertexBuffer(model_entry.vb);
-
-            if (model_entry.ib)
+            if (model_entry.vb != bound_vb)
             {
-                in.renderInterface->SetIndexBuffer(model_entry.ib);
+                in.renderInterface->SetVertexBuffer(model_entry.vb);
+
+                if (model_entry.ib)
+                {
+                    in.renderInterface->SetIndexBuffer(model_entry.ib);
+                }
+
+                bound_vb = model_entry.vb;
             }
 
             in.renderInterface->SetConstantShaderData(kInstanceCB, &model_entry.modelMatrix, sizeof(model_entry.modelMatrix));
 
             in.renderInterface->SetShaderResourceInput(model_entry.texture, 1);
 
-            in.renderInterface->Draw();
+            if (model_entry.range.page != kInvalidGeometryPage)
+            {
+                in.renderInterface->DrawRange(model_entry.range.GetIndexCount(), model_entry.range.GetStartIndex(), model_entry.range.GetBaseVertex());
+            }
+            else
+            {
+                in.renderInterface->Draw();
+            }
         }
     }
 }
\ No newline at end of file
@@ -12,7 +12,7 @@ void CS_ApplyLightingDeferred(uint2 screen_coord : SV_DispatchThreadID)
 
     float2 uv = TransformPixelCoordsToScreenUVs(screen_coord);
 
-    GBuffer gbuf = SampleGBuffer(indices, uv);
+    GBuffer gbuf = SampleGBuffer(indices, screen_coord);
 
     if (gbuf.depth <= 0.0001f)
     {
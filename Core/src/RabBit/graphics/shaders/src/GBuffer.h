@@ -45,12 +45,12 @@ GBuffer SampleGBuffer(GBufferTexIndices textures, float2 uv)
 	return DecodeGBuffer(enc);
 }
 
-// For compute shaders
+// For compute shaders, loads the texel directly so it also works when the GBuffer textures are bigger than the view
 GBuffer SampleGBuffer(GBufferTexIndices textures, uint2 screen_coord)
 {
 	GBufferEncoded enc;
-	enc.gbuf0 = FetchTex2D(textures.gbuf0).SampleLevel(g_ClampAnisoSampler, screen_coord, 0);
-	enc.gbuf1 = FetchTex2D(textures.gbuf1).SampleLevel(g_ClampAnisoSampler, screen_coord, 0);
+	enc.gbuf0 = FetchTex2D(textures.gbuf0).Load(int3(screen_coord, 0));
+	enc.gbuf1 = FetchTex2D(textures.gbuf1).Load(int3(screen_coord, 0));
 	return DecodeGBuffer(enc);
 }
 
@@ -1,5 +1,11 @@
 #pragma once
 
+#include <emmintrin.h>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
 namespace RB
 {
     // Custom data containers
@@ -21,4 +27,495 @@ namespace RB
 
     template<class T>
     using Queue = std::queue<T>;
-}
\ No newline at end of file
+
+    template<class T>
+    using Deque = std::deque<T>;
+
+    // ---------------------------------------------------------------------------
+    //								FlatHashTable
+    // ---------------------------------------------------------------------------
+
+    namespace FlatHash
+    {
+        // Slots that are probed at once
+        constexpr size_t kGroupWidth    = 16;
+
+        // Full slots store the lower 7 bits of the hash, so only empty and deleted slots have the highest bit set
+        constexpr int8_t kEmpty         = -128;
+        constexpr int8_t kDeleted       = -2;
+
+        // The control bytes of a group of slots
+        struct Group
+        {
+            __m128i control;
+
+            explicit Group(const int8_t* group_control)
+                : control(_mm_loadu_si128((const __m128i*)group_control))
+            {
+            }
+
+            // A bit per slot of the group
+            uint32_t Match(int8_t h2) const         { return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), control)); }
+            uint32_t MatchEmpty() const             { return Match(kEmpty); }
+            uint32_t MatchEmptyOrDeleted() const    { return (uint32_t)_mm_movemask_epi8(control); }
+        };
+
+        inline uint32_t LowestSetBit(uint32_t mask)
+        {
+#if defined(_MSC_VER)
+            unsigned long index;
+            _BitScanForward(&index, mask);
+            return index;
+#else
+            return __builtin_ctz(mask);
+#endif
+        }
+
+        // std::hash of integers and pointers is the value itself on some platforms, the bits are mixed so the lower and upper bits can both be used
+        inline uint64_t Mix(uint64_t hash)
+        {
+            hash *= 0x9E3779B97F4A7C15ull;
+            return hash ^ (hash >> 32);
+        }
+
+        struct MapKeyOf
+        {
+            template<class Pair>
+            const auto& operator()(const Pair& slot) const { return slot.first; }
+        };
+
+        struct SetKeyOf
+        {
+            template<class Key>
+            const Key& operator()(const Key& slot) const { return slot; }
+        };
+    }
+
+    // Open addressing hash table in the style of the Swiss tables. Every slot has a control byte with 7 bits of its hash,
+    // a lookup compares the control bytes of 16 slots at once (SSE2) and only compares the keys of the slots that match.
+    // The slots are stored in a single array, instead of a heap node per element like UnorderedMap.
+    // Inserting can move the elements, so pointers, references and iterators are only valid until the next insert.
+    // Use FlatMap or FlatSet, they have the same interface as the std containers.
+    template<class Key, class Slot, class KeyOf, class Hash, class Equal>
+    class FlatHashTable
+    {
+    public:
+        static_assert(alignof(Slot) <= FlatHash::kGroupWidth, "The slots are stored right after the control bytes");
+
+        template<bool IsConst>
+        class Iterator
+        {
+        public:
+            using TableType = std::conditional_t<IsConst, const FlatHashTable, FlatHashTable>;
+            using Reference = std::conditional_t<IsConst, const Slot&, Slot&>;
+            using Pointer   = std::conditional_t<IsConst, const Slot*, Slot*>;
+
+            using iterator_category = std::forward_iterator_tag;
+            using value_type        = Slot;
+            using difference_type   = ptrdiff_t;
+            using pointer           = Pointer;
+            using reference         = Reference;
+
+            Iterator() = default;
+
+            Iterator(TableType* table, size_t index)
+                : m_Table(table)
+                , m_Index(index)
+            {
+                SkipFreeSlots();
+            }
+
+            operator Iterator<true>() const { return Iterator<true>(m_Table, m_Index); }
+
+            Reference operator*() const  { return m_Table->m_Slots[m_Index]; }
+            Pointer   operator->() const { return &m_Table->m_Slots[m_Index]; }
+
+            Iterator& operator++()
+            {
+                ++m_Index;
+                SkipFreeSlots();
+                return *this;
+            }
+
+            Iterator operator++(int)
+            {
+                Iterator previous = *this;
+                ++(*this);
+                return previous;
+            }
+
+            bool operator==(const Iterator& other) const { return m_Index == other.m_Index; }
+            bool operator!=(const Iterator& other) const { return m_Index != other.m_Index; }
+
+        private:
+            void SkipFreeSlots()
+            {
+                while (m_Index < m_Table->m_Capacity && m_Table->m_Control[m_Index] < 0)
+                {
+                    ++m_Index;
+                }
+            }
+
+            TableType*  m_Table = nullptr;
+            size_t      m_Index = 0;
+
+            friend class FlatHashTable;
+        };
+
+        using key_type          = Key;
+        using value_type        = Slot;
+        using size_type         = size_t;
+        using iterator          = Iterator<false>;
+        using const_iterator    = Iterator<true>;
+
+        FlatHashTable() = default;
+
+        FlatHashTable(const FlatHashTable& other)
+        {
+            if (other.m_Size > 0)
+            {
+                reserve(other.m_Size);
+            }
+
+            for (const Slot& slot : other)
+            {
+                new (&m_Slots[PrepareInsert(HashOf(KeyOf()(slot)))]) Slot(slot);
+            }
+        }
+
+        FlatHashTable(FlatHashTable&& other) noexcept
+        {
+            Swap(other);
+        }
+
+        FlatHashTable& operator=(FlatHashTable other) noexcept
+        {
+            Swap(other);
+            return *this;
+        }
+
+        ~FlatHashTable()
+        {
+            clear();
+            ::operator delete(m_Control);
+        }
+
+        iterator        begin()         { return iterator(this, 0); }
+        iterator        end()           { return iterator(this, m_Capacity); }
+        const_iterator  begin() const   { return const_iterator(this, 0); }
+        const_iterator  end() const     { return const_iterator(this, m_Capacity); }
+
+        size_t          size() const        { return m_Size; }
+        bool            empty() const       { return m_Size == 0; }
+        size_t          capacity() const    { return m_Capacity; }
+
+        iterator        find(const Key& key)        { return iterator(this, FindIndex(key)); }
+        const_iterator  find(const Key& key) const  { return const_iterator(this, FindIndex(key)); }
+        size_t          count(const Key& key) const { return FindIndex(key) != m_Capacity ? 1 : 0; }
+        bool            contains(const Key& key) const { return FindIndex(key) != m_Capacity; }
+
+        // Returns the element after the erased one, the other elements do not move
+        iterator erase(const_iterator itr)
+        {
+            EraseIndex(itr.m_Index);
+            return iterator(this, itr.m_Index + 1);
+        }
+
+        iterator erase(iterator itr)
+        {
+            return erase(const_iterator(itr));
+        }
+
+        size_t erase(const Key& key)
+        {
+            size_t index = FindIndex(key);
+
+            if (index == m_Capacity)
+            {
+                return 0;
+            }
+
+            EraseIndex(index);
+            return 1;
+        }
+
+        // Keeps the memory
+        void clear()
+        {
+            for (size_t i = 0; i < m_Capacity; ++i)
+            {
+                if (m_Control[i] >= 0)
+                {
+                    m_Slots[i].~Slot();
+                }
+            }
+
+            if (m_Capacity > 0)
+            {
+                memset(m_Control, (uint8_t)FlatHash::kEmpty, m_Capacity);
+            }
+
+            m_Size          = 0;
+            m_Deleted       = 0;
+            m_GrowthLeft    = GetMaxLoad(m_Capacity);
+        }
+
+        // Makes room for the amount of elements, so they can be inserted without moving the others
+        void reserve(size_t count)
+        {
+            size_t capacity = FlatHash::kGroupWidth;
+
+            while (GetMaxLoad(capacity) < count)
+            {
+                capacity *= 2;
+            }
+
+            if (capacity > m_Capacity)
+            {
+                Rehash(capacity);
+            }
+        }
+
+    protected:
+        // Constructs the slot from the arguments when the key is not in the table yet
+        template<class ... Args>
+        std::pair<iterator, bool> EmplaceWithKey(const Key& key, Args&& ... args)
+        {
+            uint64_t hash = HashOf(key);
+            size_t index = FindIndex(key, hash);
+
+            if (index != m_Capacity)
+            {
+                return { iterator(this, index), false };
+            }
+
+            index = PrepareInsert(hash);
+            new (&m_Slots[index]) Slot(std::forward<Args>(args)...);
+
+            return { iterator(this, index), true };
+        }
+
+    private:
+        // At most 7/8 of the slots are used, so there is always an empty slot to stop a lookup
+        static size_t GetMaxLoad(size_t capacity) { return capacity - capacity / 8; }
+
+        uint64_t HashOf(const Key& key) const { return FlatHash::Mix((uint64_t)m_Hash(key)); }
+
+        size_t FindIndex(const Key& key) const
+        {
+            return m_Size > 0 ? FindIndex(key, HashOf(key)) : m_Capacity;
+        }
+
+        size_t FindIndex(const Key& key, uint64_t hash) const
+        {
+            if (m_Capacity == 0)
+            {
+                return m_Capacity;
+            }
+
+            size_t group_mask = m_Capacity / FlatHash::kGroupWidth - 1;
+            size_t group = (size_t)(hash >> 7) & group_mask;
+            int8_t h2 = (int8_t)(hash & 0x7F);
+
+            // Triangular probing over the groups, this visits every group because the amount of groups is a power of 2
+            for (size_t step = 1; ; ++step)
+            {
+                FlatHash::Group control(m_Control + group * FlatHash::kGroupWidth);
+
+                for (uint32_t match = control.Match(h2); match != 0; match &= match - 1)
+                {
+                    size_t index = group * FlatHash::kGroupWidth + FlatHash::LowestSetBit(match);
+
+                    if (m_Equal(KeyOf()(m_Slots[index]), key))
+                    {
+                        return index;
+                    }
+                }
+
+                if (control.MatchEmpty() != 0)
+                {
+                    return m_Capacity;
+                }
+
+                group = (group + step) & group_mask;
+            }
+        }
+
+        size_t FindFreeSlot(uint64_t hash) const
+        {
+            size_t group_mask = m_Capacity / FlatHash::kGroupWidth - 1;
+            size_t group = (size_t)(hash >> 7) & group_mask;
+
+            for (size_t step = 1; ; ++step)
+            {
+                uint32_t free = FlatHash::Group(m_Control + group * FlatHash::kGroupWidth).MatchEmptyOrDeleted();
+
+                if (free != 0)
+                {
+                    return group * FlatHash::kGroupWidth + FlatHash::LowestSetBit(free);
+                }
+
+                group = (group + step) & group_mask;
+            }
+        }
+
+        // Marks a free slot for the hash as used, the caller constructs the slot
+        size_t PrepareInsert(uint64_t hash)
+        {
+            if (m_Capacity == 0)
+            {
+                Rehash(FlatHash::kGroupWidth);
+            }
+
+            size_t index = FindFreeSlot(hash);
+
+            if (m_GrowthLeft == 0 && m_Control[index] == FlatHash::kEmpty)
+            {
+                // When most of the used slots are deleted ones, cleaning them up is enough
+                Rehash(m_Size * 2 < GetMaxLoad(m_Capacity) ? m_Capacity : m_Capacity * 2);
+                index = FindFreeSlot(hash);
+            }
+
+            if (m_Control[index] == FlatHash::kEmpty)
+            {
+                m_GrowthLeft--;
+            }
+            else
+            {
+                m_Deleted--;
+            }
+
+            m_Control[index] = (int8_t)(hash & 0x7F);
+            m_Size++;
+
+            return index;
+        }
+
+        void EraseIndex(size_t index)
+        {
+            m_Slots[index].~Slot();
+            m_Size--;
+
+            // A lookup only continues past a group that has no empty slots. When the group of the slot still has an empty slot,
+            // no lookup ever went past it, so the slot can be empty again instead of deleted.
+            if (FlatHash::Group(m_Control + (index & ~(FlatHash::kGroupWidth - 1))).MatchEmpty() != 0)
+            {
+                m_Control[index] = FlatHash::kEmpty;
+                m_GrowthLeft++;
+            }
+            else
+            {
+                m_Control[index] = FlatHash::kDeleted;
+                m_Deleted++;
+            }
+        }
+
+        void Rehash(size_t capacity)
+        {
+            int8_t* old_control     = m_Control;
+            Slot*   old_slots       = m_Slots;
+            size_t  old_capacity    = m_Capacity;
+
+            // The control bytes and the slots in 1 allocation
+            m_Control       = (int8_t*)::operator new(capacity + capacity * sizeof(Slot));
+            m_Slots         = (Slot*)(m_Control + capacity);
+            m_Capacity      = capacity;
+            m_Size          = 0;
+            m_Deleted       = 0;
+            m_GrowthLeft    = GetMaxLoad(capacity);
+
+            memset(m_Control, (uint8_t)FlatHash::kEmpty, capacity);
+
+            for (size_t i = 0; i < old_capacity; ++i)
+            {
+                if (old_control[i] >= 0)
+                {
+                    size_t index = FindFreeSlot(HashOf(KeyOf()(old_slots[i])));
+
+                    m_Control[index] = old_control[i];
+                    new (&m_Slots[index]) Slot(std::move(old_slots[i]));
+                    old_slots[i].~Slot();
+
+                    m_GrowthLeft--;
+                    m_Size++;
+                }
+            }
+
+            ::operator delete(old_control);
+        }
+
+        void Swap(FlatHashTable& other)
+        {
+            std::swap(m_Control, other.m_Control);
+            std::swap(m_Slots, other.m_Slots);
+            std::swap(m_Capacity, other.m_Capacity);
+            std::swap(m_Size, other.m_Size);
+            std::swap(m_Deleted, other.m_Deleted);
+            std::swap(m_GrowthLeft, other.m_GrowthLeft);
+        }
+
+        int8_t*     m_Control       = nullptr;
+        Slot*       m_Slots         = nullptr;
+        size_t      m_Capacity      = 0;        // 0 or a power of 2 of at least a group
+        size_t      m_Size          = 0;
+        size_t      m_Deleted       = 0;
+        size_t      m_GrowthLeft    = 0;        // Empty slots that can be used before a rehash is needed
+
+        Hash        m_Hash;
+        Equal       m_Equal;
+    };
+
+    // Drop in for UnorderedMap, see FlatHashTable for the differences
+    template<class Key, class Value, class Hash = std::hash<Key>, class Equal = std::equal_to<Key>>
+    class FlatMap : public FlatHashTable<Key, std::pair<Key, Value>, FlatHash::MapKeyOf, Hash, Equal>
+    {
+        using Base = FlatHashTable<Key, std::pair<Key, Value>, FlatHash::MapKeyOf, Hash, Equal>;
+
+    public:
+        using mapped_type       = Value;
+        using iterator          = typename Base::iterator;
+        using const_iterator    = typename Base::const_iterator;
+
+        template<class ... Args>
+        std::pair<iterator, bool> emplace(const Key& key, Args&& ... args)
+        {
+            return Base::EmplaceWithKey(key, std::piecewise_construct, std::forward_as_tuple(key), std::forward_as_tuple(std::forward<Args>(args)...));
+        }
+
+        std::pair<iterator, bool> insert(const std::pair<Key, Value>& value)
+        {
+            return Base::EmplaceWithKey(value.first, value);
+        }
+
+        std::pair<iterator, bool> insert(std::pair<Key, Value>&& value)
+        {
+            return Base::EmplaceWithKey(value.first, std::move(value));
+        }
+
+        Value& operator[](const Key& key)
+        {
+            return emplace(key).first->second;
+        }
+    };
+
+    // Drop in for std::unordered_set, see FlatHashTable for the differences. The keys should not be changed through the iterators.
+    template<class Key, class Hash = std::hash<Key>, class Equal = std::equal_to<Key>>
+    class FlatSet : public FlatHashTable<Key, Key, FlatHash::SetKeyOf, Hash, Equal>
+    {
+        using Base = FlatHashTable<Key, Key, FlatHash::SetKeyOf, Hash, Equal>;
+
+    public:
+        using iterator          = typename Base::iterator;
+        using const_iterator    = typename Base::const_iterator;
+
+        std::pair<iterator, bool> insert(const Key& key)
+        {
+            return Base::EmplaceWithKey(key, key);
+        }
+
+        std::pair<iterator, bool> insert(Key&& key)
+        {
+            return Base::EmplaceWithKey(key, std::move(key));
+        }
+    };
+}
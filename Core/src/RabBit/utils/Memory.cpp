@@ -0,0 +1,468 @@
+#include "RabBitCommon.h"
+#include "Memory.h"
+
+#include "utils/debug/MemoryTracker.h"
+
+namespace RB
+{
+    namespace
+    {
+        constexpr uint32_t kInvalidCacheSlot = UINT32_MAX;
+
+#ifdef RB_ENABLE_ASSERTS
+        constexpr uint8_t kFreedBlockPattern        = 0xDD;
+        constexpr uint8_t kAllocatedBlockPattern    = 0xCD;
+
+        // The first bytes of a free block can hold the link to the next free block
+        bool IsPoisoned(const void* block, uint32_t block_size)
+        {
+            const uint8_t* bytes = (const uint8_t*)block;
+
+            for (uint32_t i = sizeof(void*); i < block_size; ++i)
+            {
+                if (bytes[i] != kFreedBlockPattern)
+                {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+#endif
+
+        // The free blocks in the free list of a pool point to the next free block
+        void*& NextBlock(void* block)
+        {
+            return *(void**)block;
+        }
+
+        // Which pool uses which thread cache slot, so a thread that exits can give its cached blocks back
+        struct PoolRegistry
+        {
+            CRITICAL_SECTION    cs;
+            PoolAllocator*      pools[kPoolMaxThreadCachedPools] = {};
+            uint64_t            nextSerial = 1;
+
+            PoolRegistry()
+            {
+                InitializeCriticalSection(&cs);
+            }
+        };
+
+        PoolRegistry& GetRegistry()
+        {
+            // Never destroyed, threads can exit while the statics are destroyed
+            static NeverDestroyed<PoolRegistry> registry;
+            return registry.Get();
+        }
+    }
+
+    struct PoolAllocator::ThreadCache
+    {
+        uint64_t    serial;
+        uint32_t    epoch;
+        uint32_t    count;
+        void*       blocks[kPoolThreadCacheSize];
+    };
+
+    // The caches of a thread, a cache is only made once the thread uses the pool
+    struct PoolThreadCaches
+    {
+        PoolAllocator::ThreadCache* caches[kPoolMaxThreadCachedPools] = {};
+
+        ~PoolThreadCaches()
+        {
+            PoolRegistry& registry = GetRegistry();
+
+            EnterCriticalSection(&registry.cs);
+
+            for (uint32_t i = 0; i < kPoolMaxThreadCachedPools; ++i)
+            {
+                PoolAllocator::ThreadCache* cache = caches[i];
+
+                if (!cache)
+                {
+                    continue;
+                }
+
+                // The pool can be destroyed already, or it took the blocks back with FreeAll
+                PoolAllocator* pool = registry.pools[i];
+
+                if (pool && pool->m_Serial == cache->serial && pool->m_Epoch.load(std::memory_order_acquire) == cache->epoch && cache->count > 0)
+                {
+                    pool->FreeShared(cache->blocks, cache->count);
+                }
+
+                SAFE_FREE(cache);
+            }
+
+            LeaveCriticalSection(&registry.cs);
+        }
+    };
+
+    thread_local PoolThreadCaches g_PoolThreadCaches;
+
+    // ---------------------------------------------------------------------------
+    //								PoolAllocator
+    // ---------------------------------------------------------------------------
+
+    PoolAllocator::PoolAllocator(uint32_t block_size, uint32_t blocks_per_page, Utils::Debug::MemoryTag tag)
+        : m_BlockSize(Math::AlignUp(std::max(block_size, (uint32_t)sizeof(void*)), kPoolBlockAlignment))
+        , m_BlocksPerPage(blocks_per_page)
+        , m_Tag(tag)
+        , m_CacheSlot(kInvalidCacheSlot)
+        , m_Epoch(0)
+#ifdef RB_ENABLE_MEMORY_TRACKING
+        , m_TrackedBlocks(0)
+#endif
+        , m_FreeList(nullptr)
+        , m_UsedBlocks(0)
+        , m_HeapAllocations(0)
+        , m_LockCount(0)
+    {
+        RB_ASSERT_FATAL(LOGTAG_MAIN, blocks_per_page > 0, "A page of a pool should have at least 1 block");
+
+        InitializeCriticalSection(&m_CS);
+
+        PoolRegistry& registry = GetRegistry();
+
+        EnterCriticalSection(&registry.cs);
+
+        m_Serial = registry.nextSerial++;
+
+        for (uint32_t i = 0; i < kPoolMaxThreadCachedPools; ++i)
+        {
+            if (!registry.pools[i])
+            {
+                registry.pools[i] = this;
+                m_CacheSlot = i;
+                break;
+            }
+        }
+
+        LeaveCriticalSection(&registry.cs);
+
+        if (m_CacheSlot == kInvalidCacheSlot)
+        {
+            RB_LOG_WARN(LOGTAG_MAIN, "Too many pools, the pool of %u byte blocks does not get thread caches", m_BlockSize);
+        }
+    }
+
+    PoolAllocator::~PoolAllocator()
+    {
+        if (m_CacheSlot != kInvalidCacheSlot)
+        {
+            PoolRegistry& registry = GetRegistry();
+
+            // The blocks that are still in thread caches are thrown away when the next pool in this slot is used
+            EnterCriticalSection(&registry.cs);
+            registry.pools[m_CacheSlot] = nullptr;
+            LeaveCriticalSection(&registry.cs);
+        }
+
+#ifdef RB_ENABLE_MEMORY_TRACKING
+        // The blocks that were not freed are leaked, but their pages are freed now
+        Utils::Debug::MemoryTracker::FreePooled(m_Tag, m_BlockSize, m_TrackedBlocks.exchange(0, std::memory_order_relaxed));
+#endif
+
+        for (void* page : m_Pages)
+        {
+            SAFE_FREE(page);
+        }
+
+        DeleteCriticalSection(&m_CS);
+    }
+
+    void* PoolAllocator::Allocate()
+    {
+        ThreadCache* cache = GetThreadCache();
+        void* block;
+
+        if (cache && cache->count > 0)
+        {
+            block = cache->blocks[--cache->count];
+        }
+        else
+        {
+            block = AllocateShared(cache);
+        }
+
+#ifdef RB_ENABLE_ASSERTS
+        RB_ASSERT(LOGTAG_MAIN, IsPoisoned(block, m_BlockSize), "A block of the pool was written to after it was freed");
+        memset(block, kAllocatedBlockPattern, m_BlockSize);
+#endif
+
+#ifdef RB_ENABLE_MEMORY_TRACKING
+        m_TrackedBlocks.fetch_add(1, std::memory_order_relaxed);
+        Utils::Debug::MemoryTracker::AllocatePooled(m_Tag, m_BlockSize);
+#endif
+
+        return block;
+    }
+
+    void PoolAllocator::Free(void* block)
+    {
+        if (!block)
+        {
+            return;
+        }
+
+#ifdef RB_ENABLE_ASSERTS
+        RB_ASSERT(LOGTAG_MAIN, !IsPoisoned(block, m_BlockSize), "A block of the pool is probably freed twice");
+        memset(block, kFreedBlockPattern, m_BlockSize);
+#endif
+
+#ifdef RB_ENABLE_MEMORY_TRACKING
+        m_TrackedBlocks.fetch_sub(1, std::memory_order_relaxed);
+        Utils::Debug::MemoryTracker::FreePooled(m_Tag, m_BlockSize, 1);
+#endif
+
+        ThreadCache* cache = GetThreadCache();
+
+        if (!cache)
+        {
+            FreeShared(&block, 1);
+            return;
+        }
+
+        if (cache->count == kPoolThreadCacheSize)
+        {
+            // Give the blocks back that were freed the longest ago, they are the least likely to still be in the CPU cache
+            constexpr uint32_t half = kPoolThreadCacheSize / 2;
+
+            FreeShared(cache->blocks, half);
+            memmove(cache->blocks, cache->blocks + half, (kPoolThreadCacheSize - half) * sizeof(void*));
+            cache->count -= half;
+        }
+
+        cache->blocks[cache->count++] = block;
+    }
+
+    void PoolAllocator::FreeAll()
+    {
+#ifdef RB_ENABLE_MEMORY_TRACKING
+        Utils::Debug::MemoryTracker::FreePooled(m_Tag, m_BlockSize, m_TrackedBlocks.exchange(0, std::memory_order_relaxed));
+#endif
+
+        EnterCriticalSection(&m_CS);
+
+        // The blocks in the thread caches are thrown away the next time the threads use the pool
+        m_Epoch.fetch_add(1, std::memory_order_release);
+
+        m_FreeList = nullptr;
+
+        for (auto itr = m_Pages.rbegin(); itr != m_Pages.rend(); ++itr)
+        {
+            uint8_t* page = (uint8_t*)*itr;
+
+#ifdef RB_ENABLE_ASSERTS
+            memset(page, kFreedBlockPattern, (size_t)m_BlockSize * m_BlocksPerPage);
+#endif
+
+            for (uint32_t i = m_BlocksPerPage; i-- > 0;)
+            {
+                NextBlock(page + (size_t)i * m_BlockSize) = m_FreeList;
+                m_FreeList = page + (size_t)i * m_BlockSize;
+            }
+        }
+
+        m_UsedBlocks = 0;
+
+        LeaveCriticalSection(&m_CS);
+    }
+
+    PoolAllocatorStats PoolAllocator::GetStats()
+    {
+        PoolAllocatorStats stats = {};
+
+        EnterCriticalSection(&m_CS);
+        stats.blockSize         = m_BlockSize;
+        stats.pageCount         = m_Pages.size();
+        stats.usedBlocks        = m_UsedBlocks;
+        stats.heapAllocations   = m_HeapAllocations;
+        stats.lockCount         = m_LockCount;
+        LeaveCriticalSection(&m_CS);
+
+        return stats;
+    }
+
+    PoolAllocator::ThreadCache* PoolAllocator::GetThreadCache()
+    {
+        if (m_CacheSlot == kInvalidCacheSlot)
+        {
+            return nullptr;
+        }
+
+        ThreadCache*& cache = g_PoolThreadCaches.caches[m_CacheSlot];
+
+        if (!cache)
+        {
+            RB_MEMORY_TAG(Pools);
+            cache = ALLOC_HEAPC(ThreadCache, 1);
+            RB_ASSERT_FATAL_RELEASE(LOGTAG_MAIN, cache, "Could not allocate the thread cache of a pool");
+
+            cache->serial = 0;
+        }
+
+        uint32_t epoch = m_Epoch.load(std::memory_order_acquire);
+
+        // The slot was used by a pool that is destroyed by now, or FreeAll took the blocks back
+        if (cache->serial != m_Serial || cache->epoch != epoch)
+        {
+            cache->serial   = m_Serial;
+            cache->epoch    = epoch;
+            cache->count    = 0;
+        }
+
+        return cache;
+    }
+
+    void PoolAllocator::AddPage()
+    {
+        RB_MEMORY_TAG(Pools);
+
+        uint8_t* page = (uint8_t*)ALLOC_HEAP((size_t)m_BlockSize * m_BlocksPerPage);
+        RB_ASSERT_FATAL_RELEASE(LOGTAG_MAIN, page, "Could not allocate a page of %u byte blocks", m_BlockSize);
+
+#ifdef RB_ENABLE_ASSERTS
+        memset(page, kFreedBlockPattern, (size_t)m_BlockSize * m_BlocksPerPage);
+#endif
+
+        // Linked from the back, so the blocks are handed out in the order of their addresses
+        for (uint32_t i = m_BlocksPerPage; i-- > 0;)
+        {
+            NextBlock(page + (size_t)i * m_BlockSize) = m_FreeList;
+            m_FreeList = page + (size_t)i * m_BlockSize;
+        }
+
+        m_Pages.push_back(page);
+        m_HeapAllocations++;
+    }
+
+    void* PoolAllocator::AllocateShared(ThreadCache* cache)
+    {
+        EnterCriticalSection(&m_CS);
+
+        if (!m_FreeList)
+        {
+            AddPage();
+        }
+
+        void* block = m_FreeList;
+        m_FreeList = NextBlock(block);
+        m_UsedBlocks++;
+
+        // Also fill half of the thread cache, so the next allocations of this thread do not have to lock. No pages are added for this.
+        if (cache)
+        {
+            while (m_FreeList && cache->count < kPoolThreadCacheSize / 2)
+            {
+                cache->blocks[cache->count++] = m_FreeList;
+                m_FreeList = NextBlock(m_FreeList);
+                m_UsedBlocks++;
+            }
+        }
+
+        m_LockCount++;
+
+        LeaveCriticalSection(&m_CS);
+
+        return block;
+    }
+
+    void PoolAllocator::FreeShared(void** blocks, uint32_t count)
+    {
+        EnterCriticalSection(&m_CS);
+
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            NextBlock(blocks[i]) = m_FreeList;
+            m_FreeList = blocks[i];
+        }
+
+        m_UsedBlocks -= count;
+        m_LockCount++;
+
+        LeaveCriticalSection(&m_CS);
+    }
+
+    // ---------------------------------------------------------------------------
+    //								SlabAllocator
+    // ---------------------------------------------------------------------------
+
+    SlabAllocator::SlabAllocator(uint32_t max_size, uint32_t page_size, Utils::Debug::MemoryTag tag)
+        : m_MaxSize(Math::AlignUp(max_size, kPoolBlockAlignment))
+        , m_Tag(tag)
+        , m_LargeAllocations(0)
+    {
+        for (uint32_t size = kPoolBlockAlignment; size <= m_MaxSize; size += kPoolBlockAlignment)
+        {
+            m_Pools.push_back(new PoolAllocator(size, std::max(page_size / size, 16u), tag));
+        }
+    }
+
+    SlabAllocator::~SlabAllocator()
+    {
+        for (PoolAllocator* pool : m_Pools)
+        {
+            delete pool;
+        }
+    }
+
+    void* SlabAllocator::Allocate(size_t size)
+    {
+        if (size > m_MaxSize)
+        {
+            m_LargeAllocations.fetch_add(1, std::memory_order_relaxed);
+
+#ifdef RB_ENABLE_MEMORY_TRACKING
+            Utils::Debug::MemoryTagScope tag_scope(m_Tag);
+#endif
+
+            void* memory = ALLOC_HEAP(size);
+            RB_ASSERT_FATAL_RELEASE(LOGTAG_MAIN, memory, "Could not allocate %llu bytes", (uint64_t)size);
+
+            return memory;
+        }
+
+        return m_Pools[(std::max<size_t>(size, 1) - 1) / kPoolBlockAlignment]->Allocate();
+    }
+
+    void SlabAllocator::Free(void* memory, size_t size)
+    {
+        if (size > m_MaxSize)
+        {
+            SAFE_FREE(memory);
+            return;
+        }
+
+        m_Pools[(std::max<size_t>(size, 1) - 1) / kPoolBlockAlignment]->Free(memory);
+    }
+
+    void SlabAllocator::FreeAll()
+    {
+        for (PoolAllocator* pool : m_Pools)
+        {
+            pool->FreeAll();
+        }
+    }
+
+    PoolAllocatorStats SlabAllocator::GetStats()
+    {
+        PoolAllocatorStats stats = {};
+        stats.blockSize         = m_MaxSize;
+        stats.heapAllocations   = m_LargeAllocations.load(std::memory_order_relaxed);
+
+        for (PoolAllocator* pool : m_Pools)
+        {
+            PoolAllocatorStats pool_stats = pool->GetStats();
+
+            stats.pageCount         += pool_stats.pageCount;
+            stats.usedBlocks        += pool_stats.usedBlocks;
+            stats.heapAllocations   += pool_stats.heapAllocations;
+            stats.lockCount         += pool_stats.lockCount;
+        }
+
+        return stats;
+    }
+}
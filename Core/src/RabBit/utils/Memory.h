@@ -18,17 +18,53 @@
 
 #include <memory>
 
+namespace RB::Utils::Debug
+{
+    // What an allocation is used for, see utils/debug/MemoryTracker.h. Lives here so the pool allocators can be given a tag.
+    enum class MemoryTag : uint8_t
+    {
+        Untagged,
+        Entity,
+        Streaming,
+        Graphics,
+        Assets,
+        Events,
+        Jobs,
+        Debug,      // Logs, profiler and stats, kept until the process exits so not part of the leak dump
+        Pools,      // Pages of the pool allocators that are not handed out, the used blocks are counted under the tag of their pool
+
+        Count
+    };
+}
+
+#ifdef RB_ENABLE_MEMORY_TRACKING
+namespace RB::Utils::Debug::MemoryTracker
+{
+    // See utils/debug/MemoryTracker.h
+    void* Allocate(size_t size);
+    void  Free(void* memory);
+}
+#endif
+
 namespace RB
 {
     #define ALLOC_STACK(size)		    alloca((size))
     #define ALLOC_STACKC(type, count)   (type*)alloca(sizeof(type) * (count))
+
+    // Memory of ALLOC_HEAP should always be freed with SAFE_FREE, when tracked it does not come directly from malloc
+#ifdef RB_ENABLE_MEMORY_TRACKING
+    #define ALLOC_HEAP(size)		    RB::Utils::Debug::MemoryTracker::Allocate((size))
+    #define ALLOC_HEAPC(type, count)	(type*)RB::Utils::Debug::MemoryTracker::Allocate(sizeof(type) * (count))
+    #define SAFE_FREE(obj)			    if ((obj) != nullptr) { RB::Utils::Debug::MemoryTracker::Free(obj); (obj) = nullptr; }
+#else
     #define ALLOC_HEAP(size)		    malloc((size))
     #define ALLOC_HEAPC(type, count)	(type*)malloc(sizeof(type) * (count))
+    #define SAFE_FREE(obj)			    if ((obj) != nullptr) { free(obj); (obj) = nullptr; }
+#endif
     
     #define SAFE_RELEASE(obj)		    (obj)->Release();
     #define SAFE_DELETE(obj)		    if ((obj) != nullptr) { delete (obj); (obj) = nullptr; }
     #define SAFE_DELETE_ARR(obj)	    if ((obj) != nullptr) { delete[] (obj); (obj) = nullptr; }
-    #define SAFE_FREE(obj)			    if ((obj) != nullptr) { free(obj); (obj) = nullptr; }
 
     // Custom graphics pointer
     template<class T>
@@ -57,4 +93,168 @@ namespace RB
     {
         return std::make_unique<T>(std::forward<Args>(args)...);
     }
+
+    // A function local static that is never destroyed, for things that can still be used while the other statics are destroyed.
+    // Constructed on first use like any function local static: static NeverDestroyed<T> value(args); return value.Get();
+    template<typename T>
+    class NeverDestroyed
+    {
+    public:
+        template<typename ... Args>
+        NeverDestroyed(Args&& ... args)
+        {
+            new (m_Storage) T(std::forward<Args>(args)...);
+        }
+
+        NeverDestroyed(const NeverDestroyed&) = delete;
+        NeverDestroyed& operator=(const NeverDestroyed&) = delete;
+
+        T& Get() { return *std::launder(reinterpret_cast<T*>(m_Storage)); }
+
+    private:
+        alignas(T) uint8_t m_Storage[sizeof(T)];
+    };
+
+    // ---------------------------------------------------------------------------
+    //								PoolAllocator
+    // ---------------------------------------------------------------------------
+
+    // Free blocks every thread keeps per pool, half of them go back to the pool when the cache is full
+    constexpr uint32_t kPoolThreadCacheSize         = 32;
+    // Pools that can have thread caches at the same time, the other pools lock on every allocation
+    constexpr uint32_t kPoolMaxThreadCachedPools    = 64;
+    // Block sizes are rounded up to this, so every block is aligned like malloc does
+    constexpr uint32_t kPoolBlockAlignment          = 16;
+
+    struct PoolAllocatorStats
+    {
+        uint32_t    blockSize;
+        uint64_t    pageCount;
+        uint64_t    usedBlocks;         // Blocks that are not in the free list of the pool, this includes the blocks in the thread caches
+        uint64_t    heapAllocations;    // Pages and too big allocations that went to the heap
+        uint64_t    lockCount;          // Times the free list of the pool was locked, the rest was handled by the thread caches
+    };
+
+    // Fixed size blocks that are carved out of bigger pages, the pages are only given back to the heap when the pool is destroyed.
+    // Allocate and Free can be called from any thread, every thread has a small cache of free blocks so most calls do not lock.
+    // When asserts are enabled the free blocks are poisoned, writes to a block after it has been freed are asserted on.
+    // When memory tracking is enabled the blocks that are handed out are counted under the memory tag of the pool.
+    class PoolAllocator
+    {
+    public:
+        PoolAllocator(uint32_t block_size, uint32_t blocks_per_page = 256, Utils::Debug::MemoryTag tag = Utils::Debug::MemoryTag::Untagged);
+        ~PoolAllocator();
+
+        void*       Allocate();
+        void        Free(void* block);
+
+        // Gives all the blocks back at once, instead of one by one.
+        // Nothing that was allocated from the pool should be used anymore, also not by other threads.
+        void        FreeAll();
+
+        uint32_t    GetBlockSize() const { return m_BlockSize; }
+        PoolAllocatorStats GetStats();
+
+    private:
+        struct ThreadCache;
+
+        ThreadCache* GetThreadCache();
+
+        // Should be called while holding m_CS
+        void        AddPage();
+
+        void*       AllocateShared(ThreadCache* cache);
+        void        FreeShared(void** blocks, uint32_t count);
+
+        const uint32_t          m_BlockSize;
+        const uint32_t          m_BlocksPerPage;
+        const Utils::Debug::MemoryTag m_Tag;
+        uint32_t                m_CacheSlot;
+        uint64_t                m_Serial;           // Never reused, so the thread caches of a destroyed pool are not used by the next pool in its slot
+        std::atomic<uint32_t>   m_Epoch;            // Changed by FreeAll, which throws the blocks in the thread caches away
+#ifdef RB_ENABLE_MEMORY_TRACKING
+        std::atomic<uint64_t>   m_TrackedBlocks;    // Handed out and counted under the tag, the thread caches are not included
+#endif
+
+        // Only used while holding the lock, on its own cache line so the threads reading the epoch are not slowed down
+        alignas(64) CRITICAL_SECTION m_CS;
+        void*                   m_FreeList;
+        List<void*>             m_Pages;
+        uint64_t                m_UsedBlocks;
+        uint64_t                m_HeapAllocations;
+        uint64_t                m_LockCount;
+
+        friend struct PoolThreadCaches;
+    };
+
+    // A PoolAllocator for a single type
+    template<typename T>
+    class ObjectPool
+    {
+    public:
+        static_assert(alignof(T) <= kPoolBlockAlignment, "The type is aligned more than the blocks of the pool");
+
+        ObjectPool(uint32_t objects_per_page = 256, Utils::Debug::MemoryTag tag = Utils::Debug::MemoryTag::Untagged)
+            : m_Allocator(sizeof(T), objects_per_page, tag)
+        {
+        }
+
+        template<typename ... Args>
+        T* New(Args&& ... args)
+        {
+            return new (m_Allocator.Allocate()) T(std::forward<Args>(args)...);
+        }
+
+        void Delete(T* object)
+        {
+            if (object)
+            {
+                object->~T();
+                m_Allocator.Free(object);
+            }
+        }
+
+        PoolAllocatorStats GetStats() { return m_Allocator.GetStats(); }
+
+    private:
+        PoolAllocator m_Allocator;
+    };
+
+    // ---------------------------------------------------------------------------
+    //								SlabAllocator
+    // ---------------------------------------------------------------------------
+
+    // Routes new and delete of the class, and all the classes that derive from it, to a SlabAllocator.
+    // Delete needs the real size of the object, so the class should have a virtual destructor.
+    #define RB_SLAB_NEW_DELETE(get_slab) \
+        static void* operator new(size_t size)                                          { return (get_slab).Allocate(size); } \
+        static void  operator delete(void* memory, size_t size)                         { (get_slab).Free(memory, size); } \
+        static void* operator new(size_t size, std::align_val_t alignment)              { return ::operator new(size, alignment); } \
+        static void  operator delete(void* memory, size_t size, std::align_val_t alignment) { ::operator delete(memory, size, alignment); }
+
+    // A PoolAllocator per size class of kPoolBlockAlignment bytes, for objects of different sizes that are allocated and freed a lot.
+    // Allocations that are bigger than the max size go to the heap. All of them are tagged with the memory tag of the slab.
+    class SlabAllocator
+    {
+    public:
+        SlabAllocator(uint32_t max_size = 256, uint32_t page_size = 16 * 1024, Utils::Debug::MemoryTag tag = Utils::Debug::MemoryTag::Untagged);
+        ~SlabAllocator();
+
+        void*       Allocate(size_t size);
+        // The size should be the size that was allocated
+        void        Free(void* memory, size_t size);
+
+        // See PoolAllocator::FreeAll, does not free the allocations that went to the heap
+        void        FreeAll();
+
+        uint32_t    GetMaxSize() const { return m_MaxSize; }
+        // Summed over all the size classes
+        PoolAllocatorStats GetStats();
+
+    private:
+        const uint32_t          m_MaxSize;
+        const Utils::Debug::MemoryTag m_Tag;
+        List<PoolAllocator*>    m_Pools;
+        std::atomic<uint64_t>   m_LargeAllocations;
+    };
 }
\ No newline at end of file
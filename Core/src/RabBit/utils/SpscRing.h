@@ -0,0 +1,79 @@
+#pragma once
+
+#include "RabBitCommon.h"
+
+namespace RB
+{
+    // ---------------------------------------------------------------------------
+    //								SpscRing
+    // ---------------------------------------------------------------------------
+
+    // Lock free ring with 1 writer and 1 reader. When the reader falls too far behind the newest items are dropped.
+    template<typename T>
+    class SpscRing
+    {
+    public:
+        // The capacity should be a power of 2
+        SpscRing(uint32_t capacity)
+            : m_Mask(capacity - 1)
+            , m_Items(new T[capacity])
+            , m_Head(0)
+            , m_Tail(0)
+            , m_DroppedCount(0)
+        {
+            RB_ASSERT_FATAL(LOGTAG_MAIN, capacity > 0 && (capacity & m_Mask) == 0, "The capacity of a ring should be a power of 2");
+        }
+
+        ~SpscRing()
+        {
+            delete[] m_Items;
+        }
+
+        SpscRing(const SpscRing&) = delete;
+        SpscRing& operator=(const SpscRing&) = delete;
+
+        // Returns false when the ring is full
+        bool Push(const T& item)
+        {
+            uint64_t head = m_Head.load(std::memory_order_relaxed);
+
+            if (head - m_Tail.load(std::memory_order_acquire) > m_Mask)
+            {
+                m_DroppedCount.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+
+            m_Items[head & m_Mask] = item;
+            m_Head.store(head + 1, std::memory_order_release);
+
+            return true;
+        }
+
+        // Appends all the items that have been pushed so far, oldest first
+        uint32_t PopAll(List<T>& out_items)
+        {
+            uint64_t tail = m_Tail.load(std::memory_order_relaxed);
+            uint64_t head = m_Head.load(std::memory_order_acquire);
+
+            for (uint64_t i = tail; i < head; ++i)
+            {
+                out_items.push_back(m_Items[i & m_Mask]);
+            }
+
+            m_Tail.store(head, std::memory_order_release);
+
+            return (uint32_t)(head - tail);
+        }
+
+        uint64_t GetDroppedCount() const { return m_DroppedCount.load(std::memory_order_relaxed); }
+
+    private:
+        const uint64_t          m_Mask;
+        T*                      m_Items;
+
+        // On their own cache lines, so the writer and the reader do not slow each other down
+        alignas(64) std::atomic<uint64_t> m_Head;
+        alignas(64) std::atomic<uint64_t> m_Tail;
+        std::atomic<uint64_t>   m_DroppedCount;
+    };
+}
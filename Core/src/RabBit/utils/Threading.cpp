@@ -1,8 +1,18 @@
 #include "RabBitCommon.h"
 #include "Threading.h"
 
+#include "utils/debug/Profiler.h"
+#include "utils/debug/Stats.h"
+
 namespace RB
 {
+    SlabAllocator& GetJobDataSlab()
+    {
+        // Never destroyed, job data can still be deleted while the statics are destroyed
+        static NeverDestroyed<SlabAllocator> slab(512, 16 * 1024, Utils::Debug::MemoryTag::Jobs);
+        return slab.Get();
+    }
+
     // ---------------------------------------------------------------------------
     //								WorkerThread
     // ---------------------------------------------------------------------------
@@ -304,6 +314,7 @@ namespace RB
         WorkerThread::SharedContext* context = (WorkerThread::SharedContext*)param;
 
         RB_LOG(LOGTAG_MAIN, "Started worker thread: %ws", context->name);
+        RB_PROFILE_THREAD(context->name);
 
         while (true)
         {
@@ -370,10 +381,14 @@ namespace RB
 
             // Do the job
             {
+                RB_PROFILE_CPU_SCOPED("Job");
+
                 (*current_job.function)(current_job.data);
                 SAFE_DELETE(current_job.data);
             }
 
+            RB_STAT_ADD(JobsExecuted, 1);
+
             // Notify that we are done with a job
             {
                 EnterCriticalSection(&context->completedCS);
@@ -389,4 +404,281 @@ namespace RB
 
         return 0;
     }
+
+    // ---------------------------------------------------------------------------
+    //								WorkerPool
+    // ---------------------------------------------------------------------------
+
+    DWORD WINAPI WorkerPoolLoop(PVOID param);
+
+    WorkerPool::WorkerPool(const wchar_t* name, uint32_t thread_count, const ThreadPriority& priority)
+        : m_Name(name)
+        , m_NextJobID(0)
+        , m_Terminating(false)
+    {
+        InitializeCriticalSection(&m_CS);
+        InitializeConditionVariable(&m_KickCV);
+        InitializeConditionVariable(&m_CompletedCV);
+
+        if (thread_count == 0)
+        {
+            SYSTEM_INFO info;
+            GetSystemInfo(&info);
+
+            thread_count = Math::Max((int)info.dwNumberOfProcessors - 2, 1);
+        }
+
+        int job_prio = 0;
+        switch (priority)
+        {
+        case ThreadPriority::Low:	  job_prio = THREAD_PRIORITY_BELOW_NORMAL;	break;
+        case ThreadPriority::Medium:  job_prio = THREAD_PRIORITY_NORMAL;		break;
+        case ThreadPriority::High:	  job_prio = THREAD_PRIORITY_ABOVE_NORMAL;  break;
+        case ThreadPriority::Highest: job_prio = THREAD_PRIORITY_HIGHEST;		break;
+        default:
+            RB_LOG_ERROR(LOGTAG_MAIN, "Did not implement this thread priority yet");
+            break;
+        }
+
+        for (uint32_t i = 0; i < thread_count; ++i)
+        {
+            DWORD id;
+            HANDLE thread = CreateThread(NULL, 0, WorkerPoolLoop, (PVOID)this, 0, &id);
+            RB_ASSERT_FATAL_RELEASE(LOGTAG_MAIN, thread != 0, "Failed to create worker pool thread");
+
+            SetThreadDescription(thread, name);
+            SetThreadPriority(thread, job_prio);
+
+            m_Threads.push_back(thread);
+        }
+
+        RB_LOG(LOGTAG_MAIN, "Started worker pool: %ws (%d threads)", name, thread_count);
+    }
+
+    WorkerPool::~WorkerPool()
+    {
+        // The threads only stop once the queue is empty
+        EnterCriticalSection(&m_CS);
+        m_Terminating = true;
+        LeaveCriticalSection(&m_CS);
+        WakeAllConditionVariable(&m_KickCV);
+
+        WaitForMultipleObjects(m_Threads.size(), m_Threads.data(), TRUE, INFINITE);
+
+        for (HANDLE thread : m_Threads)
+        {
+            CloseHandle(thread);
+        }
+
+        m_Threads.clear();
+
+        DeleteCriticalSection(&m_CS);
+    }
+
+    JobTypeID WorkerPool::AddJobType(JobFunction function)
+    {
+        EnterCriticalSection(&m_CS);
+
+        m_JobTypes.push_back(function);
+        JobTypeID type_id = m_JobTypes.size() - 1;
+
+        LeaveCriticalSection(&m_CS);
+
+        return type_id;
+    }
+
+    JobID WorkerPool::ScheduleJob(JobTypeID type_id, JobData* data)
+    {
+        EnterCriticalSection(&m_CS);
+
+        if (type_id >= m_JobTypes.size())
+        {
+            LeaveCriticalSection(&m_CS);
+            RB_LOG_ERROR(LOGTAG_MAIN, "Could not schedule job, JobType does not exist");
+            SAFE_DELETE(data);
+            return UINT64_MAX;
+        }
+
+        Job job = {};
+        job.id          = m_NextJobID++;
+        job.function    = &m_JobTypes[type_id];
+        job.data        = data;
+
+        m_PendingJobs.emplace(job.id, job);
+        m_PendingOrder.push_back(job.id);
+
+        LeaveCriticalSection(&m_CS);
+        WakeConditionVariable(&m_KickCV);
+
+        return job.id;
+    }
+
+    void WorkerPool::PrioritizeJob(JobID job_id)
+    {
+        EnterCriticalSection(&m_CS);
+
+        // The old place in the order is skipped, the job is taken at the front
+        if (m_PendingJobs.contains(job_id))
+        {
+            m_PendingOrder.push_front(job_id);
+        }
+
+        LeaveCriticalSection(&m_CS);
+    }
+
+    bool WorkerPool::IsFinished(JobID job_id)
+    {
+        EnterCriticalSection(&m_CS);
+
+        bool finished = !m_PendingJobs.contains(job_id) && !IsRunning(job_id);
+
+        LeaveCriticalSection(&m_CS);
+
+        return finished;
+    }
+
+    void WorkerPool::Sync(JobID job_id)
+    {
+        EnterCriticalSection(&m_CS);
+
+        auto itr = m_PendingJobs.find(job_id);
+
+        if (itr != m_PendingJobs.end())
+        {
+            // Nobody started on it yet, just do it ourselves
+            Job job = itr->second;
+            m_PendingJobs.erase(itr);
+
+            if (m_PendingJobs.empty())
+            {
+                m_PendingOrder.clear();
+            }
+
+            RunJob(job);
+        }
+        else
+        {
+            // A job waiting on itself (e.g. through a callback) would never finish
+            bool own_job = std::any_of(m_RunningJobs.begin(), m_RunningJobs.end(), [job_id](const RunningJob& running) {
+                return running.id == job_id && running.threadId == GetCurrentThreadId();
+                });
+
+            while (!own_job && IsRunning(job_id))
+            {
+                SleepConditionVariableCS(&m_CompletedCV, &m_CS, INFINITE);
+            }
+        }
+
+        LeaveCriticalSection(&m_CS);
+    }
+
+    void WorkerPool::SyncAll()
+    {
+        EnterCriticalSection(&m_CS);
+
+        while (!m_PendingJobs.empty() || !m_RunningJobs.empty())
+        {
+            SleepConditionVariableCS(&m_CompletedCV, &m_CS, INFINITE);
+        }
+
+        LeaveCriticalSection(&m_CS);
+    }
+
+    bool WorkerPool::IsExecutingJob(JobID job_id)
+    {
+        EnterCriticalSection(&m_CS);
+
+        bool executing = std::any_of(m_RunningJobs.begin(), m_RunningJobs.end(), [job_id](const RunningJob& running) {
+            return running.id == job_id && running.threadId == GetCurrentThreadId();
+            });
+
+        LeaveCriticalSection(&m_CS);
+
+        return executing;
+    }
+
+    void WorkerPool::RunJob(const Job& job)
+    {
+        m_RunningJobs.push_back({ job.id, GetCurrentThreadId() });
+
+        LeaveCriticalSection(&m_CS);
+
+        {
+            RB_PROFILE_CPU_SCOPED("Job");
+
+            (*job.function)(job.data);
+            JobData* data = job.data;
+            SAFE_DELETE(data);
+        }
+
+        RB_STAT_ADD(JobsExecuted, 1);
+
+        EnterCriticalSection(&m_CS);
+
+        auto itr = std::find_if(m_RunningJobs.begin(), m_RunningJobs.end(), [&job](const RunningJob& running) { return running.id == job.id; });
+        m_RunningJobs.erase(itr);
+
+        WakeAllConditionVariable(&m_CompletedCV);
+    }
+
+    WorkerPool::Job WorkerPool::PopPendingJob()
+    {
+        while (true)
+        {
+            JobID job_id = m_PendingOrder.front();
+            m_PendingOrder.pop_front();
+
+            auto itr = m_PendingJobs.find(job_id);
+
+            if (itr == m_PendingJobs.end())
+            {
+                continue;
+            }
+
+            Job job = itr->second;
+            m_PendingJobs.erase(itr);
+
+            // Only skipped ids can be left
+            if (m_PendingJobs.empty())
+            {
+                m_PendingOrder.clear();
+            }
+
+            return job;
+        }
+    }
+
+    bool WorkerPool::IsRunning(JobID job_id) const
+    {
+        return std::any_of(m_RunningJobs.begin(), m_RunningJobs.end(), [job_id](const RunningJob& running) { return running.id == job_id; });
+    }
+
+    DWORD WINAPI WorkerPoolLoop(PVOID param)
+    {
+        WorkerPool* pool = (WorkerPool*)param;
+
+        RB_PROFILE_THREAD(pool->m_Name);
+
+        EnterCriticalSection(&pool->m_CS);
+
+        while (true)
+        {
+            while (pool->m_PendingJobs.empty() && !pool->m_Terminating)
+            {
+                SleepConditionVariableCS(&pool->m_KickCV, &pool->m_CS, INFINITE);
+            }
+
+            // Only terminate once all the scheduled work is done
+            if (pool->m_PendingJobs.empty())
+            {
+                break;
+            }
+
+            pool->RunJob(pool->PopPendingJob());
+        }
+
+        LeaveCriticalSection(&pool->m_CS);
+
+        return 0;
+    }
 }
\ No newline at end of file
@@ -18,10 +18,16 @@ namespace RB
         Default     = Medium
     };
 
+    // The slab that all the JobData is allocated from
+    SlabAllocator& GetJobDataSlab();
+
     // Make sure to do all your deletes and free's in the destructor!
+    // New and delete go to a slab, jobs are scheduled and deleted every frame.
     struct JobData
     {
         virtual ~JobData() = default;
+
+        RB_SLAB_NEW_DELETE(GetJobDataSlab())
     };
 
     using JobTypeID     = uint32_t;
@@ -110,6 +116,81 @@ namespace RB
         friend DWORD WINAPI WorkerThreadLoop(PVOID param);
     };
 
+    // ---------------------------------------------------------------------------
+    //								WorkerPool
+    // ---------------------------------------------------------------------------
+
+    // A group of threads that all take their jobs from 1 shared queue, for work that can run in parallel.
+    // Unlike the WorkerThread all methods are thread safe, so jobs can be scheduled and synced from any thread.
+    class WorkerPool
+    {
+    public:
+        // A thread count of 0 uses the cores that are left over by the main and render thread
+        WorkerPool(const wchar_t* name, uint32_t thread_count = 0, const ThreadPriority& priority = ThreadPriority::Default);
+
+        // Finishes all the scheduled jobs first
+        ~WorkerPool();
+
+        JobTypeID	AddJobType(JobFunction function);
+
+        // The JobData is deleted when the job is completed (allocate the data with new!)
+        JobID		ScheduleJob(JobTypeID type_id, JobData* data);
+
+        // Moves the job to the front of the queue
+        void		PrioritizeJob(JobID job_id);
+
+        bool		IsFinished(JobID job_id);
+
+        // Runs the job on the calling thread when no worker picked it up yet, so a sync never waits on the rest of the queue
+        void		Sync(JobID job_id);
+        // Should not be called from a job
+        void		SyncAll();
+
+        // Whether the job is being executed by the calling thread
+        bool		IsExecutingJob(JobID job_id);
+
+        uint32_t	GetThreadCount() const { return m_Threads.size(); }
+
+    private:
+        struct Job
+        {
+            JobID        id;
+            JobFunction* function;
+            JobData*     data;
+        };
+
+        struct RunningJob
+        {
+            JobID        id;
+            DWORD        threadId;
+        };
+
+        // Should be called while holding m_CS, which is released while the job runs
+        void RunJob(const Job& job);
+
+        // Takes the job at the front of the queue, should be called while holding m_CS and with at least 1 pending job
+        Job  PopPendingJob();
+
+        bool IsRunning(JobID job_id) const;
+
+        const wchar_t*		m_Name;
+        List<HANDLE>		m_Threads;
+        Deque<JobFunction>	m_JobTypes;			// A deque so the pointers in the scheduled jobs stay valid when adding types
+        // Indexed by id so syncing or prioritizing a job does not search the queue. The order can have the ids of jobs that
+        // were already taken (by Sync) or moved to the front (by PrioritizeJob), those are skipped.
+        FlatMap<JobID, Job>	m_PendingJobs;
+        Deque<JobID>		m_PendingOrder;
+        List<RunningJob>	m_RunningJobs;
+        JobID				m_NextJobID;
+        bool				m_Terminating;
+
+        CRITICAL_SECTION	m_CS;
+        CONDITION_VARIABLE	m_KickCV;
+        CONDITION_VARIABLE	m_CompletedCV;
+
+        friend DWORD WINAPI WorkerPoolLoop(PVOID param);
+    };
+
     // ---------------------------------------------------------------------------
     //							ThreadedVariable
     // ---------------------------------------------------------------------------
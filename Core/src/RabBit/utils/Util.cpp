@@ -1,6 +1,10 @@
 #include "RabBitCommon.h"
 #include "Util.h"
 
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
 namespace RB
 {
     // https://stackoverflow.com/questions/109023/count-the-number-of-set-bits-in-a-32-bit-integer
@@ -12,4 +16,37 @@ namespace RB
         bitset *= 0x01010101;                                           // horizontal sum of bytes
         return  bitset >> 24;                                           // return just that top byte (after truncating to 32-bit even when int is wider than uint32_t)
     }
+
+    uint32_t FindLowestSetBit(uint32_t bitset)
+    {
+#if defined(_MSC_VER)
+        unsigned long index;
+        _BitScanForward(&index, bitset);
+        return index;
+#else
+        return __builtin_ctz(bitset);
+#endif
+    }
+
+    uint32_t FindLowestSetBit(uint64_t bitset)
+    {
+#if defined(_MSC_VER)
+        unsigned long index;
+        _BitScanForward64(&index, bitset);
+        return index;
+#else
+        return __builtin_ctzll(bitset);
+#endif
+    }
+
+    uint32_t FindHighestSetBit(uint64_t bitset)
+    {
+#if defined(_MSC_VER)
+        unsigned long index;
+        _BitScanReverse64(&index, bitset);
+        return index;
+#else
+        return 63 - __builtin_clzll(bitset);
+#endif
+    }
 }
\ No newline at end of file
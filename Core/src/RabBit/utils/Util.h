@@ -26,4 +26,9 @@ namespace RB
     }
 
     uint32_t NumberOfSetBits(uint32_t bitset);
+
+    // Index of the lowest/highest set bit, the bitset should not be 0
+    uint32_t FindLowestSetBit(uint32_t bitset);
+    uint32_t FindLowestSetBit(uint64_t bitset);
+    uint32_t FindHighestSetBit(uint64_t bitset);
 }
\ No newline at end of file
@@ -7,82 +7,285 @@
 #ifdef RB_ENABLE_LOGS
 namespace RB::Utils::Debug
 {
-    void Logger::OpenConsole()
+    // How long the flush thread sleeps when nobody asks for a flush
+    constexpr DWORD kLogFlushIntervalMs = 10;
+
+    namespace
     {
-        setlocale(LC_ALL, "");
+        struct LoggerContext
+        {
+            CRITICAL_SECTION    cs;
+            CONDITION_VARIABLE  wakeCV;
+            CONDITION_VARIABLE  flushedCV;
 
-        AllocConsole();
-        int succeeded = freopen_s((FILE**)stdout, "CONOUT$", "w", stdout);
-    }
+            HANDLE              thread          = nullptr;
+            bool                terminating     = false;
 
-    void Logger::SetModeNormal()
-    {
-        // Green
-        HANDLE console = GetStdHandle(STD_OUTPUT_HANDLE);
-        SetConsoleTextAttribute(console, 2);
-    }
+            // The rings of all threads that ever logged, they are kept until the end so the last logs of a thread are never lost
+            List<LogRing*>      rings;
 
-    void Logger::SetModeWarn()
-    {
-        // Orange
-        HANDLE console = GetStdHandle(STD_OUTPUT_HANDLE);
-        SetConsoleTextAttribute(console, 6);
+            uint64_t            flushRequested  = 0;
+            uint64_t            flushCompleted  = 0;
+
+            uint64_t            startTimestamp  = 0;
+            FILE*               file            = nullptr;
+
+            LoggerContext();
+            ~LoggerContext();
+
+            void Stop();
+        };
+
+        LoggerContext& GetContext()
+        {
+            static LoggerContext context;
+            return context;
+        }
+
+        void SetConsoleColor(LogLevel level)
+        {
+            // Green, orange and red
+            WORD color = level == LogLevel::Error ? 4 : (level == LogLevel::Warn ? 6 : 2);
+
+            HANDLE console = GetStdHandle(STD_OUTPUT_HANDLE);
+            SetConsoleTextAttribute(console, color);
+        }
+
+        // Writes out the records of all rings in the order they were logged. Should only be called by 1 thread at a time.
+        void WriteRecords(const List<LogRing*>& rings, uint64_t start_timestamp, FILE* file)
+        {
+            char line[kLogMaxLineLength];
+            LogLevel console_level = LogLevel::Padding;
+
+            while (true)
+            {
+                LogRing* oldest_ring = nullptr;
+                const LogRecord* oldest = nullptr;
+
+                for (LogRing* ring : rings)
+                {
+                    const LogRecord* record = ring->Peek();
+
+                    if (record && (!oldest || record->timestamp < oldest->timestamp))
+                    {
+                        oldest_ring = ring;
+                        oldest      = record;
+                    }
+                }
+
+                if (!oldest)
+                {
+                    break;
+                }
+
+                uint32_t length = FormatLogRecord(*oldest, start_timestamp, line, _countof(line) - 1);
+                line[length++] = '\n';
+                line[length]   = 0;
+
+                if (oldest->level != console_level)
+                {
+                    console_level = oldest->level;
+                    SetConsoleColor(console_level);
+                }
+
+                fwrite(line, 1, length, stdout);
+
+                if (file)
+                {
+                    fwrite(line, 1, length, file);
+                }
+
+                oldest_ring->Pop();
+            }
+
+            fflush(stdout);
+
+            if (file)
+            {
+                fflush(file);
+            }
+        }
+
+        DWORD WINAPI FlushThreadLoop(PVOID param)
+        {
+            LoggerContext* context = (LoggerContext*)param;
+
+            EnterCriticalSection(&context->cs);
+
+            while (true)
+            {
+                uint64_t flush_target = context->flushRequested;
+                bool terminating = context->terminating;
+
+                // Rings are never removed, so a copy of the list can be used without holding the lock
+                List<LogRing*> rings = context->rings;
+                FILE* file = context->file;
+
+                LeaveCriticalSection(&context->cs);
+
+                WriteRecords(rings, context->startTimestamp, file);
+
+                EnterCriticalSection(&context->cs);
+
+                context->flushCompleted = flush_target;
+                WakeAllConditionVariable(&context->flushedCV);
+
+                if (terminating)
+                {
+                    break;
+                }
+
+                if (context->flushRequested == flush_target && !context->terminating)
+                {
+                    SleepConditionVariableCS(&context->wakeCV, &context->cs, kLogFlushIntervalMs);
+                }
+            }
+
+            LeaveCriticalSection(&context->cs);
+
+            return 0;
+        }
+
+        LoggerContext::LoggerContext()
+        {
+            InitializeCriticalSection(&cs);
+            InitializeConditionVariable(&wakeCV);
+            InitializeConditionVariable(&flushedCV);
+
+            startTimestamp = GetLogTimestamp();
+
+            DWORD id;
+            thread = CreateThread(NULL, 0, FlushThreadLoop, (PVOID)this, 0, &id);
+            SetThreadDescription(thread, L"Log flush");
+        }
+
+        LoggerContext::~LoggerContext()
+        {
+            Stop();
+
+            for (LogRing* ring : rings)
+            {
+                delete ring;
+            }
+
+            rings.clear();
+
+            DeleteCriticalSection(&cs);
+        }
+
+        void LoggerContext::Stop()
+        {
+            EnterCriticalSection(&cs);
+            HANDLE flush_thread = thread;
+            terminating = true;
+            WakeConditionVariable(&wakeCV);
+            LeaveCriticalSection(&cs);
+
+            if (flush_thread)
+            {
+                WaitForSingleObject(flush_thread, INFINITE);
+                CloseHandle(flush_thread);
+            }
+
+            EnterCriticalSection(&cs);
+
+            thread = nullptr;
+            WriteRecords(rings, startTimestamp, file);
+
+            if (file)
+            {
+                fclose(file);
+                file = nullptr;
+            }
+
+            // Flushes that were waiting on the flush thread are done now
+            WakeAllConditionVariable(&flushedCV);
+
+            LeaveCriticalSection(&cs);
+        }
     }
 
-    void Logger::SetModeError()
+    void Logger::OpenConsole()
     {
-        // Red
-        HANDLE console = GetStdHandle(STD_OUTPUT_HANDLE);
-        SetConsoleTextAttribute(console, 4);
+        setlocale(LC_ALL, "");
+
+        AllocConsole();
+        int succeeded = freopen_s((FILE**)stdout, "CONOUT$", "w", stdout);
     }
 
-    void Logger::LogCore(const wchar_t* tag, const char* format, ...)
+    void Logger::OpenFile(const char* path)
     {
-        if (strlen(format) == 0)
+        LoggerContext& context = GetContext();
+
+        FILE* file = nullptr;
+        if (fopen_s(&file, path, "w") != 0)
         {
-            wprintf(L"\n");
+            RB_LOG_WARN(LOGTAG_MAIN, "Could not open log file: %s", path);
             return;
         }
 
-        // TODO Also print out the timestamp
+        EnterCriticalSection(&context.cs);
+        FILE* old_file = context.file;
+        context.file = file;
+        LeaveCriticalSection(&context.cs);
+
+        // Make sure the flush thread is not writing to the old file anymore
+        Flush();
 
-        va_list args;
-        va_start(args, format);
-        if (wcslen(tag) != 0)
-            wprintf(L"[RabBit-%s] ", tag);
-        vprintf(format, args);
-        va_end(args);
+        if (old_file)
+        {
+            fclose(old_file);
+        }
     }
 
-    void Logger::LogCore(const wchar_t* tag, const wchar_t* format, ...)
+    void Logger::Flush()
     {
-        if (wcslen(format) == 0)
+        LoggerContext& context = GetContext();
+
+        EnterCriticalSection(&context.cs);
+
+        if (context.thread)
         {
-            wprintf(L"\n");
-            return;
+            uint64_t target = ++context.flushRequested;
+            WakeConditionVariable(&context.wakeCV);
+
+            while (context.thread && context.flushCompleted < target)
+            {
+                SleepConditionVariableCS(&context.flushedCV, &context.cs, INFINITE);
+            }
+        }
+
+        if (!context.thread)
+        {
+            // The flush thread is gone, write the records out on this thread
+            WriteRecords(context.rings, context.startTimestamp, context.file);
         }
 
-        va_list args;
-        va_start(args, format);
-        if (wcslen(tag) != 0)
-            wprintf(L"[RabBit-%s] ", tag);
-        vwprintf(format, args);
-        va_end(args);
+        LeaveCriticalSection(&context.cs);
     }
 
-    void Logger::LogApp(const char* format, ...)
+    void Logger::Shutdown()
     {
-        if (strlen(format) == 0)
+        GetContext().Stop();
+    }
+
+    LogRing* Logger::GetThreadRing()
+    {
+        static thread_local LogRing* ring = nullptr;
+
+        if (!ring)
         {
-            wprintf(L"\n");
-            return;
+            RB_MEMORY_TAG(Debug);
+            ring = new LogRing(kLogThreadRingSize);
+
+            LoggerContext& context = GetContext();
+
+            EnterCriticalSection(&context.cs);
+            context.rings.push_back(ring);
+            LeaveCriticalSection(&context.cs);
         }
 
-        va_list args;
-        va_start(args, format);
-        wprintf(L"[App] ");
-        vprintf(format, args);
-        va_end(args);
+        return ring;
     }
 }
-#endif
\ No newline at end of file
+#endif
@@ -2,7 +2,9 @@
 
 #include "Core.h"
 
-#ifndef RB_ENABLE_LOGS
+#ifdef RB_ENABLE_LOGS
+#include "LogRing.h"
+#else
 #include <cstdio>
 #include <string>
 #endif
@@ -20,16 +22,17 @@ namespace RB::Utils::Debug
 {
 #ifdef RB_ENABLE_LOGS
 
-    // TODO Make logging thread safe
+    // The call site only packs the format pointer and arguments into a ring of the calling thread,
+    // they are formatted and written out by the flush thread
 
     #ifdef RB_CORE_ACCESS
-        #define RB_LOG(tag, ...)		{ RB::Utils::Debug::Logger::SetModeNormal();	RB::Utils::Debug::Logger::LogCore(tag, __VA_ARGS__); RB::Utils::Debug::Logger::LogCore(L"", ""); }	
-        #define RB_LOG_WARN(tag, ...)	{ RB::Utils::Debug::Logger::SetModeWarn();		RB::Utils::Debug::Logger::LogCore(tag, "[%s::%d] ", RB_FUNCTION_STR, RB_LINE_STR); RB::Utils::Debug::Logger::LogCore(L"", __VA_ARGS__); RB::Utils::Debug::Logger::LogCore(L"", ""); }
-        #define RB_LOG_ERROR(tag, ...)	{ RB::Utils::Debug::Logger::SetModeError();		RB::Utils::Debug::Logger::LogCore(tag, "[%s::%d] ", RB_FUNCTION_STR, RB_LINE_STR); RB::Utils::Debug::Logger::LogCore(L"", __VA_ARGS__); RB::Utils::Debug::Logger::LogCore(L"", ""); }
+        #define RB_LOG(tag, ...)		RB::Utils::Debug::Logger::Log(RB::Utils::Debug::LogLevel::Normal,	tag, nullptr, 0, __VA_ARGS__)
+        #define RB_LOG_WARN(tag, ...)	RB::Utils::Debug::Logger::Log(RB::Utils::Debug::LogLevel::Warn,		tag, RB_FUNCTION_STR, RB_LINE_STR, __VA_ARGS__)
+        #define RB_LOG_ERROR(tag, ...)	RB::Utils::Debug::Logger::Log(RB::Utils::Debug::LogLevel::Error,	tag, RB_FUNCTION_STR, RB_LINE_STR, __VA_ARGS__)
     #else
-        #define RB_LOG(...)				{ RB::Utils::Debug::Logger::SetModeNormal(); 	RB::Utils::Debug::Logger::LogApp(__VA_ARGS__); RB::Utils::Debug::Logger::LogApp(""); }	
-        #define RB_LOG_WARN(...)		{ RB::Utils::Debug::Logger::SetModeWarn();		RB::Utils::Debug::Logger::LogApp("[%s::%d] ", RB_FUNCTION_STR, RB_LINE_STR); RB::Utils::Debug::Logger::LogCore(L"", __VA_ARGS__); RB::Utils::Debug::Logger::LogApp(""); }
-        #define RB_LOG_ERROR(...)		{ RB::Utils::Debug::Logger::SetModeError();		RB::Utils::Debug::Logger::LogApp("[%s::%d] ", RB_FUNCTION_STR, RB_LINE_STR); RB::Utils::Debug::Logger::LogCore(L"", __VA_ARGS__); RB::Utils::Debug::Logger::LogApp(""); }
+        #define RB_LOG(...)				RB::Utils::Debug::Logger::Log(RB::Utils::Debug::LogLevel::Normal,	nullptr, nullptr, 0, __VA_ARGS__)
+        #define RB_LOG_WARN(...)		RB::Utils::Debug::Logger::Log(RB::Utils::Debug::LogLevel::Warn,		nullptr, RB_FUNCTION_STR, RB_LINE_STR, __VA_ARGS__)
+        #define RB_LOG_ERROR(...)		RB::Utils::Debug::Logger::Log(RB::Utils::Debug::LogLevel::Error,	nullptr, RB_FUNCTION_STR, RB_LINE_STR, __VA_ARGS__)
     #endif
     
     #ifdef RB_CORE_ACCESS
@@ -60,14 +63,34 @@ namespace RB::Utils::Debug
     namespace Logger
     {
         void OpenConsole();
+        // Also writes the logs to the file, until Shutdown is called
+        void OpenFile(const char* path);
+
+        // Blocks until everything that has been logged so far is written out
+        void Flush();
+        // Writes out the remaining logs and stops the flush thread, logs after this are only written out on the next Flush
+        void Shutdown();
 
-        void SetModeNormal();
-        void SetModeWarn();
-        void SetModeError();
+        // The ring of the calling thread, created the first time the thread logs
+        LogRing* GetThreadRing();
 
-        void LogCore(const wchar_t* tag, const char* format, ...);
-        void LogCore(const wchar_t* tag, const wchar_t* format, ...);
-        void LogApp(const char* format, ...);
+        template<typename... Args>
+        inline void Log(LogLevel level, const wchar_t* tag, const char* function, uint32_t line, const char* format, const Args&... args)
+        {
+            LogRing* ring = GetThreadRing();
+
+            // The flush thread is falling behind, wait for it to empty the ring
+            while (!WriteLogRecord(*ring, level, tag, function, line, format, args...))
+            {
+                Flush();
+            }
+
+            // Errors are often followed by a crash or exception, make sure they are out before that
+            if (level == LogLevel::Error)
+            {
+                Flush();
+            }
+        }
     }
 #endif
-}
\ No newline at end of file
+}
@@ -0,0 +1,391 @@
+#include "RabBitCommon.h"
+#include "LogRing.h"
+
+namespace RB::Utils::Debug
+{
+    // ---------------------------------------------------------------------------
+    //								LogRing
+    // ---------------------------------------------------------------------------
+
+    LogRing::LogRing(uint32_t size)
+        : m_Size(size)
+        , m_Data(nullptr)
+        , m_Head(0)
+        , m_WriteEnd(0)
+        , m_CachedTail(0)
+        , m_Tail(0)
+        , m_CachedHead(0)
+    {
+        // Malloc is aligned to at least kLogAlignment
+        m_Data = (uint8_t*)ALLOC_HEAP(m_Size);
+    }
+
+    LogRing::~LogRing()
+    {
+        SAFE_FREE(m_Data);
+    }
+
+    LogRecord* LogRing::BeginWrite(uint32_t size)
+    {
+        if (size > m_Size)
+        {
+            return nullptr;
+        }
+
+        uint64_t head   = m_Head.load(std::memory_order_relaxed);
+        uint32_t offset = head % m_Size;
+
+        // Records are never split, skip the end of the ring when it does not fit anymore
+        uint32_t padding = offset + size > m_Size ? m_Size - offset : 0;
+
+        if (head + padding + size - m_CachedTail > m_Size)
+        {
+            m_CachedTail = m_Tail.load(std::memory_order_acquire);
+
+            if (head + padding + size - m_CachedTail > m_Size)
+            {
+                return nullptr;
+            }
+        }
+
+        if (padding > 0)
+        {
+            LogRecord* padding_record = (LogRecord*)(m_Data + offset);
+            padding_record->size  = padding;
+            padding_record->level = LogLevel::Padding;
+
+            head  += padding;
+            offset = 0;
+        }
+
+        m_WriteEnd = head + size;
+
+        return (LogRecord*)(m_Data + offset);
+    }
+
+    void LogRing::EndWrite()
+    {
+        m_Head.store(m_WriteEnd, std::memory_order_release);
+    }
+
+    const LogRecord* LogRing::Peek()
+    {
+        uint64_t tail = m_Tail.load(std::memory_order_relaxed);
+
+        while (true)
+        {
+            if (tail == m_CachedHead)
+            {
+                m_CachedHead = m_Head.load(std::memory_order_acquire);
+
+                if (tail == m_CachedHead)
+                {
+                    return nullptr;
+                }
+            }
+
+            const LogRecord* record = (const LogRecord*)(m_Data + tail % m_Size);
+
+            if (record->level != LogLevel::Padding)
+            {
+                return record;
+            }
+
+            tail += record->size;
+            m_Tail.store(tail, std::memory_order_release);
+        }
+    }
+
+    void LogRing::Pop()
+    {
+        // Can not assert here, the flush thread is not allowed to log
+        const LogRecord* record = Peek();
+        if (!record)
+        {
+            return;
+        }
+
+        m_Tail.store(m_Tail.load(std::memory_order_relaxed) + record->size, std::memory_order_release);
+    }
+
+    // ---------------------------------------------------------------------------
+    //								Formatting
+    // ---------------------------------------------------------------------------
+
+    namespace
+    {
+        struct LineWriter
+        {
+            char*       buffer;
+            uint32_t    capacity;   // Without the null terminator
+            uint32_t    length;
+
+            void Append(const char* string, uint32_t string_length)
+            {
+                uint32_t count = length + string_length > capacity ? capacity - length : string_length;
+                memcpy(buffer + length, string, count);
+                length += count;
+            }
+
+            void Append(const char* string)
+            {
+                Append(string, strlen(string));
+            }
+
+            template<typename... Args>
+            void AppendFormat(const char* format, Args... args)
+            {
+                int written = snprintf(buffer + length, capacity - length + 1, format, args...);
+                if (written > 0)
+                {
+                    length += (uint32_t)written > capacity - length ? capacity - length : (uint32_t)written;
+                }
+            }
+
+            void AppendWide(const wchar_t* string)
+            {
+                std::mbstate_t state = {};
+                char multibyte[MB_LEN_MAX];
+
+                for (; *string != 0 && length < capacity; ++string)
+                {
+                    size_t count = wcrtomb(multibyte, *string, &state);
+                    if (count == (size_t)-1)
+                    {
+                        multibyte[0] = '?';
+                        count = 1;
+                        state = {};
+                    }
+
+                    Append(multibyte, count);
+                }
+            }
+        };
+
+        bool IsLengthModifier(char c)
+        {
+            return c == 'h' || c == 'l' || c == 'L' || c == 'w' || c == 'z' || c == 'j' || c == 't';
+        }
+
+        bool IsConversion(char c)
+        {
+            return strchr("diouxXfFeEgGaAcsSpn", c) != nullptr;
+        }
+
+        const LogArgHeader* NextArg(const LogArgHeader* arg)
+        {
+            return (const LogArgHeader*)((const uint8_t*)(arg + 1) + LogPacking::AlignUp(arg->size));
+        }
+    }
+
+    uint32_t FormatLogMessage(const LogRecord& record, char* buffer, uint32_t buffer_size)
+    {
+        LineWriter writer = { buffer, buffer_size - 1, 0 };
+
+        const LogArgHeader* arg = (const LogArgHeader*)(&record + 1);
+        uint32_t args_left = record.argCount;
+
+        const char* format = record.format;
+        while (*format != 0 && writer.length < writer.capacity)
+        {
+            const char* percent = strchr(format, '%');
+            if (!percent)
+            {
+                writer.Append(format);
+                break;
+            }
+
+            writer.Append(format, percent - format);
+
+            if (percent[1] == '%')
+            {
+                writer.Append("%", 1);
+                format = percent + 2;
+                continue;
+            }
+
+            // Copy the flags, width and precision of the specifier, the length is replaced by the one of the packed argument
+            char spec[32];
+            uint32_t spec_length = 0;
+            spec[spec_length++] = '%';
+
+            const char* c = percent + 1;
+            while (*c != 0 && strchr("-+ #0123456789.", *c) && spec_length < _countof(spec) - 4)
+            {
+                spec[spec_length++] = *c++;
+            }
+
+            while (IsLengthModifier(*c))
+            {
+                c++;
+            }
+
+            char conversion = *c;
+            if (!IsConversion(conversion))
+            {
+                // Not a specifier that can be handled, print it as is
+                writer.Append(percent, c - percent);
+                format = c;
+                continue;
+            }
+
+            format = c + 1;
+
+            if (args_left == 0)
+            {
+                writer.Append("(missing)");
+                continue;
+            }
+
+            const void* payload = arg + 1;
+
+            switch (arg->type)
+            {
+            case LogArgType::Int:
+            case LogArgType::UInt:
+            {
+                uint64_t value;
+                memcpy(&value, payload, sizeof(value));
+
+                if (conversion == 'c')
+                {
+                    spec[spec_length++] = 'c';
+                    spec[spec_length] = 0;
+                    writer.AppendFormat(spec, (int)value);
+                }
+                else if (strchr("fFeEgGaA", conversion))
+                {
+                    spec[spec_length++] = conversion;
+                    spec[spec_length] = 0;
+                    writer.AppendFormat(spec, arg->type == LogArgType::Int ? (double)(int64_t)value : (double)value);
+                }
+                else if (strchr("diouxX", conversion))
+                {
+                    spec[spec_length++] = 'l';
+                    spec[spec_length++] = 'l';
+                    spec[spec_length++] = conversion;
+                    spec[spec_length] = 0;
+                    writer.AppendFormat(spec, (long long)value);
+                }
+                else
+                {
+                    writer.Append("(invalid)");
+                }
+                break;
+            }
+            case LogArgType::Double:
+            {
+                double value;
+                memcpy(&value, payload, sizeof(value));
+
+                if (strchr("diouxXc", conversion))
+                {
+                    spec[spec_length++] = 'l';
+                    spec[spec_length++] = 'l';
+                    spec[spec_length++] = conversion == 'c' ? 'd' : conversion;
+                    spec[spec_length] = 0;
+                    writer.AppendFormat(spec, (long long)value);
+                }
+                else if (strchr("fFeEgGaA", conversion))
+                {
+                    spec[spec_length++] = conversion;
+                    spec[spec_length] = 0;
+                    writer.AppendFormat(spec, value);
+                }
+                else
+                {
+                    writer.Append("(invalid)");
+                }
+                break;
+            }
+            case LogArgType::String:
+            {
+                if (conversion == 's' || conversion == 'S')
+                {
+                    spec[spec_length++] = 's';
+                    spec[spec_length] = 0;
+                    writer.AppendFormat(spec, (const char*)payload);
+                }
+                else
+                {
+                    writer.Append("(invalid)");
+                }
+                break;
+            }
+            case LogArgType::WideString:
+            {
+                if (conversion == 's' || conversion == 'S')
+                {
+                    // Converted to the multibyte encoding of the locale, the flags and width are not applied
+                    writer.AppendWide((const wchar_t*)payload);
+                }
+                else
+                {
+                    writer.Append("(invalid)");
+                }
+                break;
+            }
+            case LogArgType::Pointer:
+            {
+                const void* value;
+                memcpy(&value, payload, sizeof(value));
+
+                if (conversion == 'p')
+                {
+                    spec[spec_length++] = 'p';
+                    spec[spec_length] = 0;
+                    writer.AppendFormat(spec, value);
+                }
+                else if (strchr("diouxX", conversion))
+                {
+                    spec[spec_length++] = 'l';
+                    spec[spec_length++] = 'l';
+                    spec[spec_length++] = conversion;
+                    spec[spec_length] = 0;
+                    writer.AppendFormat(spec, (long long)(uintptr_t)value);
+                }
+                else
+                {
+                    writer.Append("(invalid)");
+                }
+                break;
+            }
+            }
+
+            arg = NextArg(arg);
+            args_left--;
+        }
+
+        buffer[writer.length] = 0;
+        return writer.length;
+    }
+
+    uint32_t FormatLogRecord(const LogRecord& record, uint64_t start_timestamp, char* buffer, uint32_t buffer_size)
+    {
+        LineWriter writer = { buffer, buffer_size - 1, 0 };
+
+        double seconds = record.timestamp > start_timestamp ? (record.timestamp - start_timestamp) / 1e9 : 0.0;
+        writer.AppendFormat("[%10.4f] ", seconds);
+
+        if (record.tag)
+        {
+            writer.Append("[RabBit-");
+            writer.AppendWide(record.tag);
+            writer.Append("] ");
+        }
+        else
+        {
+            writer.Append("[App] ");
+        }
+
+        if (record.function)
+        {
+            writer.AppendFormat("[%s::%u] ", record.function, record.line);
+        }
+
+        writer.length += FormatLogMessage(record, buffer + writer.length, writer.capacity - writer.length + 1);
+
+        buffer[writer.length] = 0;
+        return writer.length;
+    }
+}
@@ -0,0 +1,255 @@
+#pragma once
+
+#include "Core.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <cwchar>
+#include <type_traits>
+
+namespace RB::Utils::Debug
+{
+    enum class LogLevel : uint8_t
+    {
+        Normal,
+        Warn,
+        Error,
+
+        Padding     // Unused space at the end of a ring, not a message
+    };
+
+    enum class LogArgType : uint8_t
+    {
+        Int,
+        UInt,
+        Double,
+        String,
+        WideString,
+        Pointer
+    };
+
+    // Everything in a ring is aligned to this
+    constexpr uint32_t kLogAlignment        = 8;
+    constexpr uint32_t kLogThreadRingSize   = 64 * 1024;
+    constexpr uint32_t kLogMaxArgs          = 16;
+    // Longer string arguments are cut off, so a message with the max amount of arguments always fits in a ring
+    constexpr uint32_t kLogMaxStringLength  = 512;
+    // Length of a formatted line, longer lines are cut off
+    constexpr uint32_t kLogMaxLineLength    = 2048;
+
+    // A single log call, followed by its packed arguments. The tag, function and format are only pointed to and should be literals.
+    struct LogRecord
+    {
+        uint32_t        size;           // Including the arguments
+        LogLevel        level;
+        uint8_t         argCount;
+        uint32_t        line;
+        uint64_t        timestamp;
+        const wchar_t*  tag;            // nullptr for the logs of the application
+        const char*     function;       // nullptr when the call site is not printed
+        const char*     format;
+    };
+
+    // In front of every packed argument, the payload is padded to the alignment
+    struct LogArgHeader
+    {
+        LogArgType  type;
+        uint32_t    size;   // Of the payload
+    };
+
+    // Nanoseconds, only used to order and print the messages
+    inline uint64_t GetLogTimestamp()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    // Lock free ring of log records with 1 writer (the logging thread) and 1 reader (the flush thread).
+    // A record is never split at the end of the ring, the space that is left over is skipped with a padding record.
+    class LogRing
+    {
+    public:
+        // The size should be a multiple of kLogAlignment
+        LogRing(uint32_t size);
+        ~LogRing();
+
+        // Returns nullptr when there is not enough space, the reader has to catch up first.
+        // The record is not visible to the reader until EndWrite is called.
+        LogRecord*          BeginWrite(uint32_t size);
+        void                EndWrite();
+
+        // Returns the oldest record that has not been popped yet, or nullptr when the ring is empty
+        const LogRecord*    Peek();
+        void                Pop();
+
+        uint32_t            GetSize() const { return m_Size; }
+
+    private:
+        const uint32_t                      m_Size;
+        uint8_t*                            m_Data;
+
+        // Writer
+        alignas(64) std::atomic<uint64_t>   m_Head;
+        uint64_t                            m_WriteEnd;
+        uint64_t                            m_CachedTail;
+
+        // Reader
+        alignas(64) std::atomic<uint64_t>   m_Tail;
+        uint64_t                            m_CachedHead;
+    };
+
+    // Formats the message of the record, returns the length of the written string (without the null terminator)
+    uint32_t FormatLogMessage(const LogRecord& record, char* buffer, uint32_t buffer_size);
+
+    // Formats the full line of the record with the timestamp (relative to start_timestamp), tag and call site
+    uint32_t FormatLogRecord(const LogRecord& record, uint64_t start_timestamp, char* buffer, uint32_t buffer_size);
+
+    namespace LogPacking
+    {
+        constexpr const char* kNullString = "(null)";
+
+        constexpr uint32_t AlignUp(uint32_t size) { return (size + kLogAlignment - 1) & ~(kLogAlignment - 1); }
+
+        template<typename T>
+        constexpr bool IsString()     { return std::is_same_v<T, char*> || std::is_same_v<T, const char*>; }
+
+        template<typename T>
+        constexpr bool IsWideString() { return std::is_same_v<T, wchar_t*> || std::is_same_v<T, const wchar_t*>; }
+
+        template<typename T>
+        inline uint32_t GetStringLength(const T* string)
+        {
+            size_t length;
+            if constexpr (std::is_same_v<T, char>)
+                length = strlen(string);
+            else
+                length = wcslen(string);
+
+            return length < kLogMaxStringLength ? (uint32_t)length : kLogMaxStringLength;
+        }
+
+        template<typename Arg>
+        inline uint32_t GetPackedSize(const Arg& arg)
+        {
+            using T = std::decay_t<Arg>;
+
+            if constexpr (IsString<T>())
+            {
+                const char* string = arg;
+                return sizeof(LogArgHeader) + AlignUp(GetStringLength(string ? string : kNullString) + 1);
+            }
+            else if constexpr (IsWideString<T>())
+            {
+                const wchar_t* string = arg;
+                return sizeof(LogArgHeader) + AlignUp((GetStringLength(string ? string : L"(null)") + 1) * sizeof(wchar_t));
+            }
+            else
+            {
+                return sizeof(LogArgHeader) + sizeof(uint64_t);
+            }
+        }
+
+        template<typename T>
+        inline void PackString(uint8_t*& dst, LogArgType type, const T* string)
+        {
+            uint32_t length = GetStringLength(string);
+
+            LogArgHeader* header = (LogArgHeader*)dst;
+            header->type = type;
+            header->size = (length + 1) * sizeof(T);
+
+            T* payload = (T*)(header + 1);
+            memcpy(payload, string, length * sizeof(T));
+            payload[length] = 0;
+
+            dst += sizeof(LogArgHeader) + AlignUp(header->size);
+        }
+
+        template<typename T>
+        inline void PackScalar(uint8_t*& dst, LogArgType type, T value)
+        {
+            LogArgHeader* header = (LogArgHeader*)dst;
+            header->type = type;
+            header->size = sizeof(T);
+
+            memcpy(header + 1, &value, sizeof(T));
+
+            dst += sizeof(LogArgHeader) + sizeof(uint64_t);
+        }
+
+        template<typename Arg>
+        inline void Pack(uint8_t*& dst, const Arg& arg)
+        {
+            using T = std::decay_t<Arg>;
+
+            if constexpr (IsString<T>())
+            {
+                const char* string = arg;
+                PackString(dst, LogArgType::String, string ? string : kNullString);
+            }
+            else if constexpr (IsWideString<T>())
+            {
+                const wchar_t* string = arg;
+                PackString(dst, LogArgType::WideString, string ? string : L"(null)");
+            }
+            else if constexpr (std::is_enum_v<T>)
+            {
+                PackScalar(dst, LogArgType::Int, (int64_t)arg);
+            }
+            else if constexpr (std::is_floating_point_v<T>)
+            {
+                PackScalar(dst, LogArgType::Double, (double)arg);
+            }
+            else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>)
+            {
+                PackScalar(dst, LogArgType::Int, (int64_t)arg);
+            }
+            else if constexpr (std::is_integral_v<T>)
+            {
+                PackScalar(dst, LogArgType::UInt, (uint64_t)arg);
+            }
+            else if constexpr (std::is_pointer_v<T> || std::is_null_pointer_v<T>)
+            {
+                PackScalar(dst, LogArgType::Pointer, (const void*)arg);
+            }
+            else
+            {
+                static_assert(std::is_pointer_v<T>, "Type can not be logged, only numbers, enums, strings and pointers are supported");
+            }
+        }
+    }
+
+    // Packs a log call into the ring, without formatting anything. Returns false when the ring is full.
+    template<typename... Args>
+    inline bool WriteLogRecord(LogRing& ring, LogLevel level, const wchar_t* tag, const char* function, uint32_t line, const char* format, const Args&... args)
+    {
+        static_assert(sizeof...(Args) <= kLogMaxArgs, "Too many log arguments");
+
+        uint32_t size = sizeof(LogRecord) + (0 + ... + LogPacking::GetPackedSize(args));
+
+        LogRecord* record = ring.BeginWrite(size);
+        if (!record)
+        {
+            return false;
+        }
+
+        record->size        = size;
+        record->level       = level;
+        record->argCount    = sizeof...(Args);
+        record->line        = line;
+        record->timestamp   = GetLogTimestamp();
+        record->tag         = tag;
+        record->function    = function;
+        record->format      = format;
+
+        if constexpr (sizeof...(Args) > 0)
+        {
+            uint8_t* args_data = (uint8_t*)(record + 1);
+            (LogPacking::Pack(args_data, args), ...);
+        }
+
+        ring.EndWrite();
+        return true;
+    }
+}
@@ -0,0 +1,476 @@
+#include "RabBitCommon.h"
+#include "MemoryTracker.h"
+#include "Stats.h"
+
+#include <chrono>
+#include <new>
+
+namespace RB::Utils::Debug
+{
+    namespace
+    {
+        constexpr const char* kMemoryTagNames[] =
+        {
+            "Untagged",
+            "Entity",
+            "Streaming",
+            "Graphics",
+            "Assets",
+            "Events",
+            "Jobs",
+            "Debug",
+            "Pools",
+        };
+
+        static_assert(_countof(kMemoryTagNames) == (uint32_t)MemoryTag::Count, "Every memory tag should have a name");
+
+        // Lines of the leak dump, the rest is only counted
+        constexpr uint32_t kMaxDumpedLeaks = 32;
+
+        // In front of every tracked allocation, keeps the allocation aligned like malloc does
+        struct alignas(16) AllocationHeader
+        {
+            AllocationHeader*   previous;
+            AllocationHeader*   next;
+            uint64_t            size;
+            uint64_t            id;
+            MemoryTag           tag;
+        };
+
+        struct TagCounters
+        {
+            uint64_t liveBytes;
+            uint64_t peakBytes;
+            uint64_t liveAllocations;
+            uint64_t totalAllocations;
+            uint64_t totalBytes;
+
+            // Part of the live counters above
+            uint64_t pooledAllocations;
+            uint64_t pooledBytes;
+
+            uint64_t runningFrameAllocations;
+            uint64_t runningFrameBytes;
+            uint64_t frameAllocations;
+            uint64_t frameBytes;
+        };
+
+        struct MemoryTrackerContext
+        {
+            CRITICAL_SECTION    cs;
+
+            // All live allocations, newest first
+            AllocationHeader*   first = nullptr;
+            uint64_t            nextId = 0;
+
+            TagCounters         tags[(uint32_t)MemoryTag::Count] = {};
+            uint64_t            liveBytes = 0;
+            uint64_t            peakBytes = 0;
+            double              frameSeconds = 0.0;
+            std::chrono::steady_clock::time_point frameStart;
+
+            MemoryTrackerContext()
+            {
+                InitializeCriticalSection(&cs);
+                frameStart = std::chrono::steady_clock::now();
+            }
+        };
+
+        thread_local MemoryTag g_ThreadTag = MemoryTag::Untagged;
+
+        MemoryTrackerContext& GetContext()
+        {
+            // Never destroyed, memory is still freed while the other statics are destroyed
+            static NeverDestroyed<MemoryTrackerContext> context;
+            return context.Get();
+        }
+
+        MemoryTagStats ToStats(const TagCounters& counters, double frame_seconds)
+        {
+            MemoryTagStats stats = {};
+            stats.liveBytes             = counters.liveBytes;
+            stats.peakBytes             = counters.peakBytes;
+            stats.liveAllocations       = counters.liveAllocations;
+            stats.pooledAllocations     = counters.pooledAllocations;
+            stats.totalAllocations      = counters.totalAllocations;
+            stats.totalBytes            = counters.totalBytes;
+            stats.frameAllocations      = counters.frameAllocations;
+            stats.frameBytes            = counters.frameBytes;
+            stats.allocationsPerSecond  = frame_seconds > 0.0 ? counters.frameAllocations / frame_seconds : 0.0;
+
+            return stats;
+        }
+    }
+
+    const char* GetMemoryTagName(MemoryTag tag)
+    {
+        return kMemoryTagNames[(uint32_t)tag];
+    }
+
+    void* MemoryTracker::Allocate(size_t size)
+    {
+        AllocationHeader* header = (AllocationHeader*)malloc(sizeof(AllocationHeader) + size);
+
+        if (!header)
+        {
+            return nullptr;
+        }
+
+        MemoryTrackerContext& context = GetContext();
+
+        header->size = size;
+        header->tag  = g_ThreadTag;
+
+        EnterCriticalSection(&context.cs);
+
+        header->id       = context.nextId++;
+        header->previous = nullptr;
+        header->next     = context.first;
+
+        if (context.first)
+        {
+            context.first->previous = header;
+        }
+
+        context.first = header;
+
+        TagCounters& counters = context.tags[(uint32_t)header->tag];
+        counters.liveBytes += size;
+        counters.peakBytes  = std::max(counters.peakBytes, counters.liveBytes);
+        counters.liveAllocations++;
+        counters.totalAllocations++;
+        counters.totalBytes += size;
+        counters.runningFrameAllocations++;
+        counters.runningFrameBytes += size;
+
+        context.liveBytes += size;
+        context.peakBytes  = std::max(context.peakBytes, context.liveBytes);
+
+        LeaveCriticalSection(&context.cs);
+
+        return header + 1;
+    }
+
+    void MemoryTracker::Free(void* memory)
+    {
+        if (!memory)
+        {
+            return;
+        }
+
+        AllocationHeader* header = (AllocationHeader*)memory - 1;
+        MemoryTrackerContext& context = GetContext();
+
+        EnterCriticalSection(&context.cs);
+
+        if (header->previous)
+        {
+            header->previous->next = header->next;
+        }
+        else
+        {
+            context.first = header->next;
+        }
+
+        if (header->next)
+        {
+            header->next->previous = header->previous;
+        }
+
+        TagCounters& counters = context.tags[(uint32_t)header->tag];
+        counters.liveBytes -= header->size;
+        counters.liveAllocations--;
+
+        context.liveBytes -= header->size;
+
+        LeaveCriticalSection(&context.cs);
+
+        free(header);
+    }
+
+    void MemoryTracker::AllocatePooled(MemoryTag tag, size_t block_size)
+    {
+        MemoryTrackerContext& context = GetContext();
+
+        EnterCriticalSection(&context.cs);
+
+        // The page is already part of the total live bytes
+        context.tags[(uint32_t)MemoryTag::Pools].liveBytes -= block_size;
+
+        TagCounters& counters = context.tags[(uint32_t)tag];
+        counters.liveBytes += block_size;
+        counters.peakBytes  = std::max(counters.peakBytes, counters.liveBytes);
+        counters.liveAllocations++;
+        counters.pooledAllocations++;
+        counters.pooledBytes += block_size;
+        counters.totalAllocations++;
+        counters.totalBytes += block_size;
+        counters.runningFrameAllocations++;
+        counters.runningFrameBytes += block_size;
+
+        LeaveCriticalSection(&context.cs);
+    }
+
+    void MemoryTracker::FreePooled(MemoryTag tag, size_t block_size, uint64_t count)
+    {
+        if (count == 0)
+        {
+            return;
+        }
+
+        MemoryTrackerContext& context = GetContext();
+        uint64_t bytes = block_size * count;
+
+        EnterCriticalSection(&context.cs);
+
+        TagCounters& counters = context.tags[(uint32_t)tag];
+        counters.liveBytes -= bytes;
+        counters.liveAllocations -= count;
+        counters.pooledAllocations -= count;
+        counters.pooledBytes -= bytes;
+
+        context.tags[(uint32_t)MemoryTag::Pools].liveBytes += bytes;
+
+        LeaveCriticalSection(&context.cs);
+    }
+
+    MemoryTag MemoryTracker::GetThreadTag()
+    {
+        return g_ThreadTag;
+    }
+
+    void MemoryTracker::SetThreadTag(MemoryTag tag)
+    {
+        g_ThreadTag = tag;
+    }
+
+    void MemoryTracker::EndFrame()
+    {
+        MemoryTrackerContext& context = GetContext();
+
+        uint64_t frame_allocations = 0;
+
+        EnterCriticalSection(&context.cs);
+
+        auto now = std::chrono::steady_clock::now();
+        context.frameSeconds = std::chrono::duration<double>(now - context.frameStart).count();
+        context.frameStart   = now;
+
+        for (TagCounters& counters : context.tags)
+        {
+            counters.frameAllocations           = counters.runningFrameAllocations;
+            counters.frameBytes                 = counters.runningFrameBytes;
+            counters.runningFrameAllocations    = 0;
+            counters.runningFrameBytes          = 0;
+
+            frame_allocations += counters.frameAllocations;
+        }
+
+        uint64_t live_bytes = context.liveBytes;
+
+        LeaveCriticalSection(&context.cs);
+
+        RB_STAT_SET(HeapAllocations, frame_allocations);
+        RB_STAT_SET(HeapLiveBytes, live_bytes);
+    }
+
+    MemoryReport MemoryTracker::GetReport()
+    {
+        MemoryTrackerContext& context = GetContext();
+        MemoryReport report = {};
+
+        EnterCriticalSection(&context.cs);
+
+        for (uint32_t i = 0; i < (uint32_t)MemoryTag::Count; ++i)
+        {
+            report.tags[i] = ToStats(context.tags[i], context.frameSeconds);
+
+            report.total.liveBytes            += report.tags[i].liveBytes;
+            report.total.liveAllocations      += report.tags[i].liveAllocations;
+            report.total.pooledAllocations    += report.tags[i].pooledAllocations;
+            report.total.totalAllocations     += report.tags[i].totalAllocations;
+            report.total.totalBytes           += report.tags[i].totalBytes;
+            report.total.frameAllocations     += report.tags[i].frameAllocations;
+            report.total.frameBytes           += report.tags[i].frameBytes;
+            report.total.allocationsPerSecond += report.tags[i].allocationsPerSecond;
+        }
+
+        // The peaks of the tags can be at different moments
+        report.total.peakBytes = context.peakBytes;
+
+        LeaveCriticalSection(&context.cs);
+
+        return report;
+    }
+
+    void MemoryTracker::LogReport()
+    {
+        MemoryReport report = GetReport();
+
+        RB_LOG(LOGTAG_MAIN, "%-10s %14s %14s %12s %14s %14s", "Tag", "Live (KB)", "Peak (KB)", "Live allocs", "Frame allocs", "Allocs/s");
+
+        for (uint32_t i = 0; i <= (uint32_t)MemoryTag::Count; ++i)
+        {
+            const MemoryTagStats& stats = i < (uint32_t)MemoryTag::Count ? report.tags[i] : report.total;
+            const char* name = i < (uint32_t)MemoryTag::Count ? GetMemoryTagName((MemoryTag)i) : "Total";
+
+            RB_LOG(LOGTAG_MAIN, "%-10s %14.1f %14.1f %12llu %14llu %14.1f", name, stats.liveBytes / 1024.0, stats.peakBytes / 1024.0,
+                stats.liveAllocations, stats.frameAllocations, stats.allocationsPerSecond);
+        }
+    }
+
+    uint64_t MemoryTracker::GetNextAllocationId()
+    {
+        MemoryTrackerContext& context = GetContext();
+
+        EnterCriticalSection(&context.cs);
+        uint64_t id = context.nextId;
+        LeaveCriticalSection(&context.cs);
+
+        return id;
+    }
+
+    uint64_t MemoryTracker::DumpLeaks(uint64_t first_allocation_id)
+    {
+        struct Leak
+        {
+            uint64_t    id;
+            uint64_t    size;
+            MemoryTag   tag;
+        };
+
+        // Nothing is logged while holding the lock, the logger allocates as well
+        Leak leaks[kMaxDumpedLeaks];
+        uint64_t dumped_count = 0;
+        uint64_t leak_count = 0;
+        uint64_t leaked_bytes[(uint32_t)MemoryTag::Count] = {};
+        uint64_t leaked_allocations[(uint32_t)MemoryTag::Count] = {};
+        uint64_t leaked_blocks[(uint32_t)MemoryTag::Count] = {};
+
+        MemoryTrackerContext& context = GetContext();
+
+        EnterCriticalSection(&context.cs);
+
+        // The pages themselves are kept until the process exits, the blocks that are still handed out are the leaks
+        for (uint32_t i = 0; i < (uint32_t)MemoryTag::Count; ++i)
+        {
+            if (i == (uint32_t)MemoryTag::Debug || i == (uint32_t)MemoryTag::Pools)
+            {
+                continue;
+            }
+
+            leak_count              += context.tags[i].pooledAllocations;
+            leaked_bytes[i]         += context.tags[i].pooledBytes;
+            leaked_allocations[i]   += context.tags[i].pooledAllocations;
+            leaked_blocks[i]         = context.tags[i].pooledAllocations;
+        }
+
+        // Newest first, the list is sorted on id
+        for (AllocationHeader* header = context.first; header && header->id >= first_allocation_id; header = header->next)
+        {
+            if (header->tag == MemoryTag::Debug || header->tag == MemoryTag::Pools)
+            {
+                continue;
+            }
+
+            if (dumped_count < kMaxDumpedLeaks)
+            {
+                leaks[dumped_count++] = { header->id, header->size, header->tag };
+            }
+
+            leak_count++;
+            leaked_bytes[(uint32_t)header->tag] += header->size;
+            leaked_allocations[(uint32_t)header->tag]++;
+        }
+
+        LeaveCriticalSection(&context.cs);
+
+        if (leak_count == 0)
+        {
+            return 0;
+        }
+
+        RB_LOG_WARN(LOGTAG_MAIN, "%llu allocations were not freed:", leak_count);
+
+        for (uint32_t i = 0; i < (uint32_t)MemoryTag::Count; ++i)
+        {
+            if (leaked_allocations[i] > 0)
+            {
+                RB_LOG_WARN(LOGTAG_MAIN, "  %s: %llu allocations (%llu pool blocks), %llu bytes", GetMemoryTagName((MemoryTag)i), leaked_allocations[i],
+                    leaked_blocks[i], leaked_bytes[i]);
+            }
+        }
+
+        for (uint64_t i = 0; i < dumped_count; ++i)
+        {
+            RB_LOG_WARN(LOGTAG_MAIN, "  Allocation %llu: %llu bytes (%s)", leaks[i].id, leaks[i].size, GetMemoryTagName(leaks[i].tag));
+        }
+
+        return leak_count;
+    }
+}
+
+#ifdef RB_ENABLE_MEMORY_TRACKING
+// ---------------------------------------------------------------------------
+//								Global new and delete
+// ---------------------------------------------------------------------------
+
+// Over-aligned types keep using the default aligned new and delete, so they are not tracked
+
+void* operator new(size_t size)
+{
+    void* memory = RB::Utils::Debug::MemoryTracker::Allocate(size > 0 ? size : 1);
+
+    if (!memory)
+    {
+        throw std::bad_alloc();
+    }
+
+    return memory;
+}
+
+void* operator new[](size_t size)
+{
+    return operator new(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept
+{
+    return RB::Utils::Debug::MemoryTracker::Allocate(size > 0 ? size : 1);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept
+{
+    return RB::Utils::Debug::MemoryTracker::Allocate(size > 0 ? size : 1);
+}
+
+void operator delete(void* memory) noexcept
+{
+    RB::Utils::Debug::MemoryTracker::Free(memory);
+}
+
+void operator delete[](void* memory) noexcept
+{
+    RB::Utils::Debug::MemoryTracker::Free(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept
+{
+    RB::Utils::Debug::MemoryTracker::Free(memory);
+}
+
+void operator delete[](void* memory, size_t) noexcept
+{
+    RB::Utils::Debug::MemoryTracker::Free(memory);
+}
+
+void operator delete(void* memory, const std::nothrow_t&) noexcept
+{
+    RB::Utils::Debug::MemoryTracker::Free(memory);
+}
+
+void operator delete[](void* memory, const std::nothrow_t&) noexcept
+{
+    RB::Utils::Debug::MemoryTracker::Free(memory);
+}
+#endif
@@ -0,0 +1,86 @@
+#pragma once
+
+#include "RabBitCommon.h"
+
+namespace RB::Utils::Debug
+{
+    // Everything that is allocated (new, ALLOC_HEAP) by the thread while in the scope is tagged, the innermost scope wins.
+    // Only does something when the memory tracking is compiled in (RABBIT_ENABLE_MEMORY_TRACKING in CMake).
+#ifdef RB_ENABLE_MEMORY_TRACKING
+    #define RB_MEMORY_TAG(tag)	RB::Utils::Debug::MemoryTagScope rb_memory_tag_scope(RB::Utils::Debug::MemoryTag::tag);
+#else
+    #define RB_MEMORY_TAG(tag)
+#endif
+
+    // MemoryTag is declared in utils/Memory.h
+
+    const char* GetMemoryTagName(MemoryTag tag);
+
+    struct MemoryTagStats
+    {
+        uint64_t    liveBytes;
+        uint64_t    peakBytes;
+        uint64_t    liveAllocations;
+        uint64_t    pooledAllocations;  // Blocks of pool allocators with this tag that are handed out, also part of the live allocations
+        uint64_t    totalAllocations;
+        uint64_t    totalBytes;
+
+        // Of the last finished frame (see MemoryTracker::EndFrame)
+        uint64_t    frameAllocations;
+        uint64_t    frameBytes;
+        double      allocationsPerSecond;
+    };
+
+    struct MemoryReport
+    {
+        MemoryTagStats  tags[(uint32_t)MemoryTag::Count];
+        MemoryTagStats  total;
+    };
+
+    // Every tracked allocation has a small header in front of it, which links all the live allocations together (for the leak dump).
+    // The bookkeeping is done under a single lock, so this is meant for finding out where the memory goes and not for shipping builds.
+    namespace MemoryTracker
+    {
+        // malloc and free with tracking, new and delete are routed to these when the tracking is compiled in
+        void*       Allocate(size_t size);
+        void        Free(void* memory);
+
+        // Called by the pool allocators, moves blocks from the pages (tagged Pools) to the tag of the pool and back
+        void        AllocatePooled(MemoryTag tag, size_t block_size);
+        void        FreePooled(MemoryTag tag, size_t block_size, uint64_t count);
+
+        MemoryTag   GetThreadTag();
+        void        SetThreadTag(MemoryTag tag);
+
+        // Moves the allocations of the running frame into the stats of the last frame, should be called once per frame
+        void        EndFrame();
+
+        MemoryReport GetReport();
+        void        LogReport();
+
+        // Allocations get increasing ids, so the allocations since a point in time can be found
+        uint64_t    GetNextAllocationId();
+
+        // Logs the allocations that were made since the id and are still alive, returns the amount of them.
+        // Pool blocks have no id, all the blocks that are still handed out are part of the dump.
+        uint64_t    DumpLeaks(uint64_t first_allocation_id);
+    }
+
+    class MemoryTagScope
+    {
+    public:
+        MemoryTagScope(MemoryTag tag)
+            : m_PreviousTag(MemoryTracker::GetThreadTag())
+        {
+            MemoryTracker::SetThreadTag(tag);
+        }
+
+        ~MemoryTagScope()
+        {
+            MemoryTracker::SetThreadTag(m_PreviousTag);
+        }
+
+    private:
+        MemoryTag m_PreviousTag;
+    };
+}
@@ -0,0 +1,290 @@
+#include "RabBitCommon.h"
+#include "Profiler.h"
+#include "MemoryTracker.h"
+
+#include <fstream>
+
+namespace RB::Utils::Debug
+{
+    // ---------------------------------------------------------------------------
+    //								Profiler
+    // ---------------------------------------------------------------------------
+
+    std::atomic<bool> Profiler::g_Capturing = false;
+
+    namespace
+    {
+        struct ProfilerContext
+        {
+            CRITICAL_SECTION        cs;
+
+            // Threads are never removed, the zones of a thread that exited can still be collected
+            List<ProfileThread*>    threads;
+            List<uint64_t>          droppedAtStart;
+
+            ProfileCapture          capture;
+
+            ProfilerContext()
+            {
+                InitializeCriticalSection(&cs);
+            }
+
+            ~ProfilerContext()
+            {
+                for (ProfileThread* thread : threads)
+                {
+                    delete thread;
+                }
+
+                threads.clear();
+
+                DeleteCriticalSection(&cs);
+            }
+        };
+
+        ProfilerContext& GetContext()
+        {
+            static ProfilerContext context;
+            return context;
+        }
+
+        // Should be called with the lock held
+        void CollectThreads(ProfilerContext& context)
+        {
+            ProfileCapture& capture = context.capture;
+
+            for (uint32_t i = 0; i < context.threads.size(); ++i)
+            {
+                ProfileThread* thread = context.threads[i];
+
+                if (capture.threads.size() <= i)
+                {
+                    capture.threads.push_back({ thread->id, "", {}, 0 });
+                }
+
+                ProfileThreadCapture& thread_capture = capture.threads[i];
+
+                // Zones that started before the capture were still running when it began
+                uint32_t first = thread_capture.zones.size();
+                thread->ring.PopAll(thread_capture.zones);
+
+                thread_capture.zones.erase(std::remove_if(thread_capture.zones.begin() + first, thread_capture.zones.end(), [&](const ProfileZone& zone)
+                {
+                    return zone.start < capture.start;
+                }), thread_capture.zones.end());
+
+                thread_capture.name         = thread->name;
+                thread_capture.droppedCount = thread->ring.GetDroppedCount() - context.droppedAtStart[i];
+            }
+        }
+
+        void AppendJsonString(std::string& out, const char* string)
+        {
+            out += '"';
+
+            for (const char* c = string; *c != 0; ++c)
+            {
+                switch (*c)
+                {
+                case '"':  out += "\\\""; break;
+                case '\\': out += "\\\\"; break;
+                case '\n': out += "\\n";  break;
+                case '\t': out += "\\t";  break;
+                default:
+                    if ((unsigned char)*c < 0x20)
+                    {
+                        char escaped[8];
+                        snprintf(escaped, sizeof(escaped), "\\u%04x", *c);
+                        out += escaped;
+                    }
+                    else
+                    {
+                        out += *c;
+                    }
+                    break;
+                }
+            }
+
+            out += '"';
+        }
+    }
+
+    void Profiler::SetThreadName(const char* name)
+    {
+        ProfileThread* thread = GetThread();
+
+        EnterCriticalSection(&GetContext().cs);
+        thread->name = name;
+        LeaveCriticalSection(&GetContext().cs);
+    }
+
+    void Profiler::SetThreadName(const wchar_t* name)
+    {
+        char narrow_name[128];
+        RB_ASSERT_FATAL(LOGTAG_MAIN, wcslen(name) < _countof(narrow_name), "Thread name is too long");
+        WcharToChar(name, narrow_name);
+
+        SetThreadName(narrow_name);
+    }
+
+    void Profiler::BeginCapture()
+    {
+        ProfilerContext& context = GetContext();
+
+        EnterCriticalSection(&context.cs);
+
+        if (g_Capturing.load())
+        {
+            LeaveCriticalSection(&context.cs);
+            return;
+        }
+
+        // Throw away whatever was left over from the previous capture
+        List<ProfileZone> stale;
+        for (uint32_t i = 0; i < context.threads.size(); ++i)
+        {
+            context.threads[i]->ring.PopAll(stale);
+            context.droppedAtStart[i] = context.threads[i]->ring.GetDroppedCount();
+        }
+
+        context.capture = {};
+        context.capture.start = GetProfileTimestamp();
+
+        g_Capturing.store(true);
+
+        LeaveCriticalSection(&context.cs);
+    }
+
+    void Profiler::Collect()
+    {
+        if (!IsCapturing())
+        {
+            return;
+        }
+
+        ProfilerContext& context = GetContext();
+
+        EnterCriticalSection(&context.cs);
+        CollectThreads(context);
+        LeaveCriticalSection(&context.cs);
+    }
+
+    ProfileCapture Profiler::EndCapture()
+    {
+        ProfilerContext& context = GetContext();
+
+        EnterCriticalSection(&context.cs);
+
+        g_Capturing.store(false);
+
+        CollectThreads(context);
+        context.capture.end = GetProfileTimestamp();
+
+        ProfileCapture capture = std::move(context.capture);
+        context.capture = {};
+
+        LeaveCriticalSection(&context.cs);
+
+        // Parents before their children, so the trace viewers nest them correctly
+        for (ProfileThreadCapture& thread : capture.threads)
+        {
+            std::sort(thread.zones.begin(), thread.zones.end(), [](const ProfileZone& a, const ProfileZone& b)
+            {
+                return a.start < b.start || (a.start == b.start && a.depth < b.depth);
+            });
+        }
+
+        return capture;
+    }
+
+    ProfileThread* Profiler::GetThread()
+    {
+        static thread_local ProfileThread* thread = nullptr;
+
+        if (!thread)
+        {
+            RB_MEMORY_TAG(Debug);
+            ProfilerContext& context = GetContext();
+
+            EnterCriticalSection(&context.cs);
+
+            thread = new ProfileThread(context.threads.size());
+            thread->name = "Thread " + std::to_string(thread->id);
+
+            context.threads.push_back(thread);
+            context.droppedAtStart.push_back(0);
+
+            LeaveCriticalSection(&context.cs);
+        }
+
+        return thread;
+    }
+
+    ProfileThread* Profiler::CreateTrack(const char* name)
+    {
+        RB_MEMORY_TAG(Debug);
+        ProfilerContext& context = GetContext();
+
+        EnterCriticalSection(&context.cs);
+
+        ProfileThread* track = new ProfileThread(context.threads.size());
+        track->name = name;
+
+        context.threads.push_back(track);
+        context.droppedAtStart.push_back(0);
+
+        LeaveCriticalSection(&context.cs);
+
+        return track;
+    }
+
+    void Profiler::WriteChromeTrace(const ProfileCapture& capture, std::string& out_json)
+    {
+        out_json += "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+        bool first = true;
+        char buffer[128];
+
+        for (const ProfileThreadCapture& thread : capture.threads)
+        {
+            out_json += first ? "\n" : ",\n";
+            first = false;
+
+            snprintf(buffer, sizeof(buffer), "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":", thread.id);
+            out_json += buffer;
+            AppendJsonString(out_json, thread.name.c_str());
+            out_json += "}}";
+
+            for (const ProfileZone& zone : thread.zones)
+            {
+                out_json += ",\n{\"name\":";
+                AppendJsonString(out_json, zone.name);
+
+                // Microseconds, relative to the start of the capture
+                snprintf(buffer, sizeof(buffer), ",\"cat\":\"cpu\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%u}",
+                    (zone.start - capture.start) / 1000.0, (zone.end - zone.start) / 1000.0, thread.id);
+                out_json += buffer;
+            }
+        }
+
+        out_json += "\n]}\n";
+    }
+
+    bool Profiler::SaveChromeTrace(const ProfileCapture& capture, const char* path)
+    {
+        std::ofstream file(path, std::ios::out | std::ios::binary);
+
+        if (!file.is_open())
+        {
+            RB_LOG_ERROR(LOGTAG_MAIN, "Could not open file: %s", path);
+            return false;
+        }
+
+        std::string json;
+        WriteChromeTrace(capture, json);
+
+        file.write(json.data(), json.size());
+
+        return file.good();
+    }
+}
@@ -0,0 +1,135 @@
+#pragma once
+
+#include "RabBitCommon.h"
+#include "utils/SpscRing.h"
+
+#include <chrono>
+#include <string>
+
+namespace RB::Utils::Debug
+{
+    // CPU zones, the name should be a literal (or at least outlive the capture)
+#ifdef RB_ENABLE_PROFILING
+    #define RB_PROFILE_CPU_SCOPED(name)		RB::Utils::Debug::ProfileCpuScoped rb_profile_cpu_scoped(name);
+    #define RB_PROFILE_CPU_FUNCTION()		RB::Utils::Debug::ProfileCpuScoped rb_profile_cpu_scoped(RB_FUNCTION_STR);
+    #define RB_PROFILE_THREAD(name)			RB::Utils::Debug::Profiler::SetThreadName(name);
+#else
+    #define RB_PROFILE_CPU_SCOPED(name)
+    #define RB_PROFILE_CPU_FUNCTION()
+    #define RB_PROFILE_THREAD(name)
+#endif
+
+    // Max amount of zones a thread can record between 2 collects, the newest zones are dropped when a thread records more
+    constexpr uint32_t kProfileZoneRingSize = 16384;
+
+    struct ProfileZone
+    {
+        const char* name;
+        uint64_t    start;      // Nanoseconds
+        uint64_t    end;
+        uint32_t    depth;      // Amount of zones this zone is nested in
+    };
+
+    // Nanoseconds, high resolution (QueryPerformanceCounter on Windows)
+    inline uint64_t GetProfileTimestamp()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    // The zones of a single thread, with 1 writer (the thread itself) and 1 reader (the thread collecting the capture)
+    using ProfileZoneRing = SpscRing<ProfileZone>;
+
+    // Everything a thread (or a track, see Profiler::CreateTrack) has recorded, only touched by its writer (besides the ring)
+    struct ProfileThread
+    {
+        uint32_t        id;             // In order of the first zone of the thread
+        std::string     name;
+        ProfileZoneRing ring;
+        uint32_t        depth = 0;
+
+        ProfileThread(uint32_t thread_id) : id(thread_id), ring(kProfileZoneRingSize) {}
+    };
+
+    struct ProfileThreadCapture
+    {
+        uint32_t            id;
+        std::string         name;
+        List<ProfileZone>   zones;
+        uint64_t            droppedCount;
+    };
+
+    struct ProfileCapture
+    {
+        uint64_t                    start = 0;
+        uint64_t                    end = 0;
+        List<ProfileThreadCapture>  threads;
+    };
+
+    namespace Profiler
+    {
+        extern std::atomic<bool> g_Capturing;
+
+        // Shown in the trace, defaults to "Thread <id>"
+        void SetThreadName(const char* name);
+        void SetThreadName(const wchar_t* name);
+
+        // Zones are only recorded during a capture
+        void BeginCapture();
+        // Moves the zones that have been recorded so far into the capture. Should be called regularly (once per frame) during a capture,
+        // so the rings of the threads do not fill up.
+        void Collect();
+        // Stops recording and returns everything that was recorded since BeginCapture
+        ProfileCapture EndCapture();
+
+        inline bool IsCapturing()
+        {
+            return g_Capturing.load(std::memory_order_relaxed);
+        }
+
+        // The thread data of the calling thread, created the first time it is needed
+        ProfileThread* GetThread();
+
+        // A timeline that does not belong to a thread, for zones that are measured elsewhere (e.g. on the GPU). Only a single thread should
+        // push into the ring of a track, the zones are filtered and collected like the zones of a thread. Tracks are never removed.
+        ProfileThread* CreateTrack(const char* name);
+
+        // Chrome trace event format, can be loaded in chrome://tracing and Perfetto
+        void WriteChromeTrace(const ProfileCapture& capture, std::string& out_json);
+        bool SaveChromeTrace(const ProfileCapture& capture, const char* path);
+    }
+
+    class ProfileCpuScoped
+    {
+    public:
+        ProfileCpuScoped(const char* name)
+        {
+            if (!Profiler::IsCapturing())
+            {
+                m_Thread = nullptr;
+                return;
+            }
+
+            m_Thread = Profiler::GetThread();
+            m_Name   = name;
+            m_Depth  = m_Thread->depth++;
+            m_Start  = GetProfileTimestamp();
+        }
+
+        ~ProfileCpuScoped()
+        {
+            if (!m_Thread)
+            {
+                return;
+            }
+
+            m_Thread->ring.Push({ m_Name, m_Start, GetProfileTimestamp(), m_Depth });
+            m_Thread->depth--;
+        }
+
+    private:
+        ProfileThread*  m_Thread;
+        const char*     m_Name;
+        uint64_t        m_Start;
+        uint32_t        m_Depth;
+    };
+}
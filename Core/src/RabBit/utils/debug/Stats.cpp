@@ -0,0 +1,315 @@
+#include "RabBitCommon.h"
+#include "Stats.h"
+#include "MemoryTracker.h"
+
+#include <fstream>
+
+namespace RB::Utils::Debug
+{
+    namespace
+    {
+        constexpr StatInfo kStatInfos[] =
+        {
+            { "FrameTime",              StatKind::Gauge,    StatUnit::Microseconds },
+            { "WindowUpdateTime",       StatKind::Counter,  StatUnit::Microseconds },
+            { "EventProcessTime",       StatKind::Counter,  StatUnit::Microseconds },
+            { "EngineUpdateTime",       StatKind::Counter,  StatUnit::Microseconds },
+            { "AppUpdateTime",          StatKind::Counter,  StatUnit::Microseconds },
+            { "RenderSubmitTime",       StatKind::Counter,  StatUnit::Microseconds },
+            { "EventsProcessed",        StatKind::Counter,  StatUnit::Count },
+
+            { "GpuFrameTime",           StatKind::Gauge,    StatUnit::Microseconds },
+            { "DrawCalls",              StatKind::Counter,  StatUnit::Count },
+            { "Dispatches",             StatKind::Counter,  StatUnit::Count },
+            { "ResourceBarriers",       StatKind::Counter,  StatUnit::Count },
+            { "UploadedBytes",          StatKind::Counter,  StatUnit::Bytes },
+            { "DescriptorsAllocated",   StatKind::Counter,  StatUnit::Count },
+
+            { "StreamedBytes",          StatKind::Counter,  StatUnit::Bytes },
+            { "StreamQueueDepth",       StatKind::Gauge,    StatUnit::Count },
+
+            { "JobsExecuted",           StatKind::Counter,  StatUnit::Count },
+
+            { "HeapAllocations",        StatKind::Gauge,    StatUnit::Count },
+            { "HeapLiveBytes",          StatKind::Gauge,    StatUnit::Bytes },
+        };
+
+        static_assert(_countof(kStatInfos) == (uint32_t)Stat::Count, "Every stat should have its info");
+
+        const char* GetUnitName(StatUnit unit)
+        {
+            switch (unit)
+            {
+            case StatUnit::Bytes:           return "bytes";
+            case StatUnit::Microseconds:    return "us";
+            case StatUnit::Count:
+            default:                        return "count";
+            }
+        }
+
+        struct StatsContext
+        {
+            CRITICAL_SECTION    cs;
+
+            // Ring of frames, every frame has a value per stat
+            List<int64_t>       values;
+            List<uint64_t>      frameIndices;
+            uint32_t            head = 0;
+            uint32_t            frameCount = 0;
+
+            StatsContext()
+            {
+                InitializeCriticalSection(&cs);
+                Resize(kStatsHistorySize);
+            }
+
+            ~StatsContext()
+            {
+                DeleteCriticalSection(&cs);
+            }
+
+            void Resize(uint32_t history_size)
+            {
+                values.assign((uint64_t)history_size * (uint32_t)Stat::Count, 0);
+                frameIndices.assign(history_size, 0);
+                head       = 0;
+                frameCount = 0;
+            }
+
+            uint32_t GetHistorySize() const { return frameIndices.size(); }
+
+            // The i-th oldest frame in the history
+            uint32_t GetSlot(uint32_t i) const
+            {
+                return (head + GetHistorySize() - frameCount + i) % GetHistorySize();
+            }
+
+            int64_t GetValue(uint32_t slot, Stat stat) const
+            {
+                return values[(uint64_t)slot * (uint32_t)Stat::Count + (uint32_t)stat];
+            }
+        };
+
+        StatsContext& GetContext()
+        {
+            RB_MEMORY_TAG(Debug);
+            static StatsContext context;
+            return context;
+        }
+
+        // Should be called with the lock held
+        StatSummary Summarize(const StatsContext& context, Stat stat, List<int64_t>& sorted)
+        {
+            sorted.clear();
+
+            for (uint32_t i = 0; i < context.frameCount; ++i)
+            {
+                sorted.push_back(context.GetValue(context.GetSlot(i), stat));
+            }
+
+            StatSummary summary = {};
+            summary.frameCount = sorted.size();
+
+            if (sorted.empty())
+            {
+                return summary;
+            }
+
+            std::sort(sorted.begin(), sorted.end());
+
+            double total = 0.0;
+            for (int64_t value : sorted)
+            {
+                total += value;
+            }
+
+            // Nearest rank
+            auto percentile = [&](uint32_t p)
+            {
+                uint32_t rank = (p * sorted.size() + 99) / 100;
+                return sorted[rank > 0 ? rank - 1 : 0];
+            };
+
+            summary.min     = sorted.front();
+            summary.max     = sorted.back();
+            summary.average = total / sorted.size();
+            summary.p50     = percentile(50);
+            summary.p95     = percentile(95);
+            summary.p99     = percentile(99);
+
+            return summary;
+        }
+
+        bool SaveFile(const std::string& data, const char* path)
+        {
+            std::ofstream file(path, std::ios::out | std::ios::binary);
+
+            if (!file.is_open())
+            {
+                RB_LOG_ERROR(LOGTAG_MAIN, "Could not open file: %s", path);
+                return false;
+            }
+
+            file.write(data.data(), data.size());
+
+            return file.good();
+        }
+    }
+
+    const StatInfo& GetStatInfo(Stat stat)
+    {
+        return kStatInfos[(uint32_t)stat];
+    }
+
+    StatValue Stats::g_Values[(uint32_t)Stat::Count];
+
+    void Stats::EndFrame(uint64_t frame_index)
+    {
+        StatsContext& context = GetContext();
+
+        EnterCriticalSection(&context.cs);
+
+        int64_t* frame_values = &context.values[(uint64_t)context.head * (uint32_t)Stat::Count];
+
+        for (uint32_t i = 0; i < (uint32_t)Stat::Count; ++i)
+        {
+            std::atomic<int64_t>& value = g_Values[i].value;
+            frame_values[i] = kStatInfos[i].kind == StatKind::Counter ? value.exchange(0, std::memory_order_relaxed) : value.load(std::memory_order_relaxed);
+        }
+
+        context.frameIndices[context.head] = frame_index;
+        context.head = (context.head + 1) % context.GetHistorySize();
+        context.frameCount = std::min(context.frameCount + 1, context.GetHistorySize());
+
+        LeaveCriticalSection(&context.cs);
+    }
+
+    void Stats::SetHistorySize(uint32_t frame_count)
+    {
+        RB_ASSERT_FATAL(LOGTAG_MAIN, frame_count > 0, "The stats should keep at least 1 frame");
+
+        StatsContext& context = GetContext();
+        RB_MEMORY_TAG(Debug);
+
+        EnterCriticalSection(&context.cs);
+        context.Resize(frame_count);
+        LeaveCriticalSection(&context.cs);
+    }
+
+    uint32_t Stats::GetHistory(Stat stat, List<int64_t>& out_values)
+    {
+        StatsContext& context = GetContext();
+
+        EnterCriticalSection(&context.cs);
+
+        for (uint32_t i = 0; i < context.frameCount; ++i)
+        {
+            out_values.push_back(context.GetValue(context.GetSlot(i), stat));
+        }
+
+        uint32_t frame_count = context.frameCount;
+
+        LeaveCriticalSection(&context.cs);
+
+        return frame_count;
+    }
+
+    StatSummary Stats::GetSummary(Stat stat)
+    {
+        StatsContext& context = GetContext();
+        List<int64_t> sorted;
+
+        EnterCriticalSection(&context.cs);
+        StatSummary summary = Summarize(context, stat, sorted);
+        LeaveCriticalSection(&context.cs);
+
+        return summary;
+    }
+
+    void Stats::WriteCsv(std::string& out_csv)
+    {
+        StatsContext& context = GetContext();
+
+        EnterCriticalSection(&context.cs);
+
+        out_csv += "Frame";
+        for (const StatInfo& info : kStatInfos)
+        {
+            out_csv += ',';
+            out_csv += info.name;
+        }
+        out_csv += '\n';
+
+        char buffer[32];
+
+        for (uint32_t i = 0; i < context.frameCount; ++i)
+        {
+            uint32_t slot = context.GetSlot(i);
+
+            snprintf(buffer, sizeof(buffer), "%llu", (unsigned long long)context.frameIndices[slot]);
+            out_csv += buffer;
+
+            for (uint32_t stat = 0; stat < (uint32_t)Stat::Count; ++stat)
+            {
+                snprintf(buffer, sizeof(buffer), ",%lld", (long long)context.GetValue(slot, (Stat)stat));
+                out_csv += buffer;
+            }
+
+            out_csv += '\n';
+        }
+
+        LeaveCriticalSection(&context.cs);
+    }
+
+    void Stats::WriteJson(std::string& out_json)
+    {
+        StatsContext& context = GetContext();
+        List<int64_t> sorted;
+        char buffer[256];
+
+        EnterCriticalSection(&context.cs);
+
+        uint64_t first_frame = context.frameCount > 0 ? context.frameIndices[context.GetSlot(0)] : 0;
+        snprintf(buffer, sizeof(buffer), "{\"frameCount\":%u,\"firstFrame\":%llu,\"stats\":[", context.frameCount, (unsigned long long)first_frame);
+        out_json += buffer;
+
+        for (uint32_t stat = 0; stat < (uint32_t)Stat::Count; ++stat)
+        {
+            const StatInfo& info = kStatInfos[stat];
+            StatSummary summary = Summarize(context, (Stat)stat, sorted);
+
+            snprintf(buffer, sizeof(buffer), "%s\n{\"name\":\"%s\",\"kind\":\"%s\",\"unit\":\"%s\",\"min\":%lld,\"max\":%lld,\"average\":%.3f,\"p50\":%lld,\"p95\":%lld,\"p99\":%lld,\"values\":[",
+                stat == 0 ? "" : ",", info.name, info.kind == StatKind::Counter ? "counter" : "gauge", GetUnitName(info.unit),
+                (long long)summary.min, (long long)summary.max, summary.average, (long long)summary.p50, (long long)summary.p95, (long long)summary.p99);
+            out_json += buffer;
+
+            for (uint32_t i = 0; i < context.frameCount; ++i)
+            {
+                snprintf(buffer, sizeof(buffer), i == 0 ? "%lld" : ",%lld", (long long)context.GetValue(context.GetSlot(i), (Stat)stat));
+                out_json += buffer;
+            }
+
+            out_json += "]}";
+        }
+
+        LeaveCriticalSection(&context.cs);
+
+        out_json += "\n]}\n";
+    }
+
+    bool Stats::SaveCsv(const char* path)
+    {
+        std::string csv;
+        WriteCsv(csv);
+
+        return SaveFile(csv, path);
+    }
+
+    bool Stats::SaveJson(const char* path)
+    {
+        std::string json;
+        WriteJson(json);
+
+        return SaveFile(json, path);
+    }
+}
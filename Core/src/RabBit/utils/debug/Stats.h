@@ -0,0 +1,150 @@
+#pragma once
+
+#include "RabBitCommon.h"
+
+#include <chrono>
+#include <string>
+
+namespace RB::Utils::Debug
+{
+    // Can be used from any thread, a stat is a single relaxed atomic operation
+    #define RB_STAT_ADD(stat, value)	RB::Utils::Debug::Stats::Add(RB::Utils::Debug::Stat::stat, (int64_t)(value));
+    #define RB_STAT_SET(stat, value)	RB::Utils::Debug::Stats::Set(RB::Utils::Debug::Stat::stat, (int64_t)(value));
+    #define RB_STAT_TIME_SCOPED(stat)	RB::Utils::Debug::StatTimerScoped rb_stat_timer_scoped(RB::Utils::Debug::Stat::stat);
+
+    enum class Stat : uint32_t
+    {
+        // Main thread
+        FrameTime,
+        WindowUpdateTime,
+        EventProcessTime,
+        EngineUpdateTime,
+        AppUpdateTime,
+        RenderSubmitTime,
+        EventsProcessed,
+
+        // Rendering
+        GpuFrameTime,
+        DrawCalls,
+        Dispatches,
+        ResourceBarriers,
+        UploadedBytes,
+        DescriptorsAllocated,
+
+        // Streaming
+        StreamedBytes,
+        StreamQueueDepth,
+
+        // Threading
+        JobsExecuted,
+
+        // Memory, only filled when the memory tracking is compiled in
+        HeapAllocations,
+        HeapLiveBytes,
+
+        Count
+    };
+
+    enum class StatKind : uint8_t
+    {
+        Counter,    // Summed over a frame, starts at 0 again every frame
+        Gauge       // Keeps the last value that was set
+    };
+
+    enum class StatUnit : uint8_t
+    {
+        Count,
+        Bytes,
+        Microseconds
+    };
+
+    struct StatInfo
+    {
+        const char* name;
+        StatKind    kind;
+        StatUnit    unit;
+    };
+
+    const StatInfo& GetStatInfo(Stat stat);
+
+    // Frames that are kept by default
+    constexpr uint32_t kStatsHistorySize = 600;
+
+    // Over the frames in the history
+    struct StatSummary
+    {
+        uint32_t    frameCount;
+        int64_t     min;
+        int64_t     max;
+        double      average;
+        int64_t     p50;
+        int64_t     p95;
+        int64_t     p99;
+    };
+
+    struct alignas(64) StatValue
+    {
+        std::atomic<int64_t> value;
+    };
+
+    namespace Stats
+    {
+        // Every stat has its own cache line, so threads that touch different stats do not slow each other down
+        extern StatValue g_Values[(uint32_t)Stat::Count];
+
+        inline void Add(Stat stat, int64_t value)
+        {
+            g_Values[(uint32_t)stat].value.fetch_add(value, std::memory_order_relaxed);
+        }
+
+        inline void Set(Stat stat, int64_t value)
+        {
+            g_Values[(uint32_t)stat].value.store(value, std::memory_order_relaxed);
+        }
+
+        // The value of the frame that is running right now
+        inline int64_t Get(Stat stat)
+        {
+            return g_Values[(uint32_t)stat].value.load(std::memory_order_relaxed);
+        }
+
+        // Should be called once at the end of every frame (by the main thread). Moves the values into the history and resets the counters.
+        // Counters that are filled by other threads (e.g. the render thread) end up in the frame of the main thread they were added in.
+        void EndFrame(uint64_t frame_index);
+
+        // Also clears the history
+        void SetHistorySize(uint32_t frame_count);
+
+        // The values of the frames in the history, oldest first. Returns the amount of frames.
+        uint32_t GetHistory(Stat stat, List<int64_t>& out_values);
+        StatSummary GetSummary(Stat stat);
+
+        // A row per frame in the history and a column per stat
+        void WriteCsv(std::string& out_csv);
+        // The summary and the values of every stat
+        void WriteJson(std::string& out_json);
+
+        bool SaveCsv(const char* path);
+        bool SaveJson(const char* path);
+    }
+
+    // Adds the time spent in the scope to the stat, in microseconds
+    class StatTimerScoped
+    {
+    public:
+        StatTimerScoped(Stat stat)
+            : m_Stat(stat)
+            , m_Start(std::chrono::steady_clock::now())
+        {
+        }
+
+        ~StatTimerScoped()
+        {
+            Stats::Add(m_Stat, std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - m_Start).count());
+        }
+
+    private:
+        Stat                                    m_Stat;
+        std::chrono::steady_clock::time_point   m_Start;
+    };
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <string>
+
+// The results end up in the XML/JSON report of the run (--gtest_output), not on stdout
+inline void RecordBenchmarkValue(const char* key, double value)
+{
+    ::testing::Test::RecordProperty(key, std::to_string(value));
+}
+
+inline double GetBenchmarkMs(std::chrono::high_resolution_clock::time_point start, std::chrono::high_resolution_clock::time_point end)
+{
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
@@ -0,0 +1,102 @@
+#include "Benchmark.h"
+#include <RabBit/events/Event.h>
+#include <RabBit/events/MouseEvent.h>
+
+using namespace RB;
+using namespace RB::Events;
+
+namespace
+{
+    class MouseListener : public EventListener
+    {
+    public:
+        MouseListener(int category) : EventListener(category)
+        {
+            Subscribe<MouseMovedEvent>([this](MouseMovedEvent&)
+            {
+                mouseMoves++;
+                return true;
+            });
+        }
+
+        uint64_t    mouseMoves = 0;
+        float       scrollSum = 0.0f;
+
+    private:
+        bool OnEvent(Event& event) override
+        {
+            BindEvent<MouseScrolledEvent>([&](MouseScrolledEvent& e) { scrollSum += e.GetOffsetY(); }, event);
+            return true;
+        }
+    };
+
+    struct ScopedEventManager
+    {
+        ScopedEventManager()  { g_EventManager = new EventManager(); }
+        ~ScopedEventManager() { SAFE_DELETE(g_EventManager); }
+    };
+}
+
+TEST(EventBenchmark, MouseInputThroughput)
+{
+    // A couple of raw input sources sending mouse moves and scrolls at a high rate while the listeners process them
+    constexpr uint32_t kProducerCount = 4;
+    constexpr uint32_t kEventsPerProducer = 250000;
+
+    ScopedEventManager manager;
+    MouseListener main_listener(kEventCat_Input);
+    MouseListener mouse_listener(kEventCat_Mouse);
+
+    std::atomic<uint32_t> finished_producers = 0;
+
+    auto start = std::chrono::high_resolution_clock::now();
+
+    std::vector<std::thread> producers;
+    for (uint32_t p = 0; p < kProducerCount; ++p)
+    {
+        producers.emplace_back([&]()
+        {
+            for (uint32_t i = 0; i < kEventsPerProducer; ++i)
+            {
+                // Real input never gets this far ahead of the listeners, do not fill up the whole pool
+                while (g_EventManager->GetPool().GetUsedCount() > kEventPoolSlotsPerChunk * kEventPoolMaxChunks / 2)
+                {
+                    std::this_thread::yield();
+                }
+
+                if (i % 2 == 0)
+                {
+                    g_EventManager->InsertEvent(MouseMovedEvent(1.0f, (float)i));
+                }
+                else
+                {
+                    g_EventManager->InsertEvent(MouseScrolledEvent(0.0f, 1.0f));
+                }
+            }
+
+            finished_producers++;
+        });
+    }
+
+    while (finished_producers.load() < kProducerCount)
+    {
+        main_listener.ProcessEvents();
+        mouse_listener.ProcessEvents();
+    }
+
+    main_listener.ProcessEvents();
+    mouse_listener.ProcessEvents();
+
+    auto end = std::chrono::high_resolution_clock::now();
+
+    for (std::thread& producer : producers)
+    {
+        producer.join();
+    }
+
+    ASSERT_EQ(main_listener.scrollSum, (float)(kProducerCount * kEventsPerProducer / 2));
+
+    RecordBenchmarkValue("events_per_second", (kProducerCount * kEventsPerProducer) / (GetBenchmarkMs(start, end) / 1000.0));
+    RecordBenchmarkValue("moves_after_coalescing", (double)main_listener.mouseMoves);
+    RecordBenchmarkValue("pool_slots", (double)g_EventManager->GetPool().GetSlotCount());
+}
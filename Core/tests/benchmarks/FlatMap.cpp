@@ -0,0 +1,86 @@
+#include "Benchmark.h"
+#include <RabBit/RabBitCommon.h>
+
+#include <random>
+
+using namespace RB;
+
+namespace
+{
+    template<class MapType>
+    double BenchmarkLookups(const List<uint64_t>& keys, const List<uint64_t>& lookups, uint64_t& out_sum)
+    {
+        MapType map;
+        for (uint64_t key : keys)
+        {
+            map.insert({ key, key });
+        }
+
+        auto start = std::chrono::high_resolution_clock::now();
+
+        for (uint64_t key : lookups)
+        {
+            auto itr = map.find(key);
+            if (itr != map.end())
+            {
+                out_sum += itr->second;
+            }
+        }
+
+        return GetBenchmarkMs(start, std::chrono::high_resolution_clock::now());
+    }
+
+    template<class MapType>
+    double BenchmarkInserts(const List<uint64_t>& keys)
+    {
+        auto start = std::chrono::high_resolution_clock::now();
+
+        MapType map;
+        for (uint64_t key : keys)
+        {
+            map.insert({ key, key });
+        }
+
+        return GetBenchmarkMs(start, std::chrono::high_resolution_clock::now());
+    }
+}
+
+TEST(FlatMapBenchmark, LookupsAndInserts)
+{
+    constexpr uint32_t kLookupCount = 5000000;
+
+    std::mt19937_64 random(42);
+
+    // Like the pipeline hashes: a couple of hundred of them that are looked up all the time, and a big table that does not fit in the CPU cache
+    for (uint32_t key_count : { 256u, 1000000u })
+    {
+        List<uint64_t> keys(key_count);
+        for (uint64_t& key : keys)
+        {
+            key = random();
+        }
+
+        // 90% hits
+        List<uint64_t> lookups(kLookupCount);
+        for (uint64_t& key : lookups)
+        {
+            key = random() % 10 == 0 ? random() : keys[random() % key_count];
+        }
+
+        uint64_t flat_sum = 0, unordered_sum = 0;
+        double flat_ms      = BenchmarkLookups<FlatMap<uint64_t, uint64_t>>(keys, lookups, flat_sum);
+        double unordered_ms = BenchmarkLookups<UnorderedMap<uint64_t, uint64_t>>(keys, lookups, unordered_sum);
+
+        ASSERT_EQ(flat_sum, unordered_sum);
+
+        double flat_insert_ms       = BenchmarkInserts<FlatMap<uint64_t, uint64_t>>(keys);
+        double unordered_insert_ms  = BenchmarkInserts<UnorderedMap<uint64_t, uint64_t>>(keys);
+
+        // Per key count, e.g. flat_map_lookup_ms_256
+        std::string suffix = "_" + std::to_string(key_count);
+        RecordBenchmarkValue(("flat_map_lookup_ms" + suffix).c_str(), flat_ms);
+        RecordBenchmarkValue(("unordered_map_lookup_ms" + suffix).c_str(), unordered_ms);
+        RecordBenchmarkValue(("flat_map_insert_ms" + suffix).c_str(), flat_insert_ms);
+        RecordBenchmarkValue(("unordered_map_insert_ms" + suffix).c_str(), unordered_insert_ms);
+    }
+}
@@ -0,0 +1,38 @@
+#include "Benchmark.h"
+#include <RabBit/utils/debug/LogRing.h>
+
+using namespace RB;
+using namespace RB::Utils::Debug;
+
+TEST(LogBenchmark, CallSiteCost)
+{
+    // Only the packing is timed, the formatting happens on the flush thread
+    constexpr uint32_t kRounds = 200;
+
+    LogRing ring(kLogThreadRingSize);
+    uint64_t calls = 0;
+    double milliseconds = 0.0;
+
+    for (uint32_t round = 0; round < kRounds; ++round)
+    {
+        auto start = std::chrono::high_resolution_clock::now();
+
+        uint32_t count = 0;
+        while (WriteLogRecord(ring, LogLevel::Normal, L"Test", nullptr, 0, "Frame %u took %.3f ms on %s", count, 16.6f, "Main"))
+        {
+            count++;
+        }
+
+        milliseconds += GetBenchmarkMs(start, std::chrono::high_resolution_clock::now());
+        calls += count;
+
+        while (ring.Peek())
+        {
+            ring.Pop();
+        }
+    }
+
+    ASSERT_TRUE(calls > 0);
+
+    RecordBenchmarkValue("ns_per_call", milliseconds * 1000000.0 / calls);
+}
@@ -0,0 +1,126 @@
+#include "Benchmark.h"
+#include <RabBit/RabBitCommon.h>
+
+using namespace RB;
+
+namespace
+{
+    SlabAllocator& GetBenchmarkSlab()
+    {
+        static SlabAllocator slab(256);
+        return slab;
+    }
+
+    struct HeapComponent
+    {
+        virtual ~HeapComponent() = default;
+        virtual void Update(float delta_time) { value += delta_time; }
+
+        float value = 0.0f;
+    };
+
+    struct PooledComponent : HeapComponent
+    {
+        RB_SLAB_NEW_DELETE(GetBenchmarkSlab())
+    };
+
+    template<typename Base, uint32_t PayloadSize>
+    struct BenchmarkComponent : Base
+    {
+        void Update(float delta_time) override { Base::value += delta_time * payload[0]; }
+
+        uint8_t payload[PayloadSize] = { 1 };
+    };
+
+    struct BenchmarkResult
+    {
+        double createMs;
+        double updateMs;
+        double destroyMs;
+    };
+
+    // Components of a couple of sizes are made while the rest of the engine allocates as well, in a heap that has been in use for a while
+    template<typename Base>
+    BenchmarkResult RunComponentBenchmark(uint32_t count)
+    {
+        BenchmarkResult result;
+        List<Base*> components;
+        List<std::string> other_allocations;
+
+        components.reserve(count);
+        other_allocations.reserve(count * 2);
+
+        // Leaves holes of all kinds of sizes in the heap
+        for (uint32_t i = 0; i < count * 2; ++i)
+        {
+            other_allocations.emplace_back(32 + (i * 7919) % 256, 'x');
+        }
+
+        for (uint32_t i = 0; i < count * 2; i += 2)
+        {
+            other_allocations[(i * 7919) % (count * 2)] = std::string();
+        }
+
+        auto start = std::chrono::high_resolution_clock::now();
+
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            switch (i % 3)
+            {
+            case 0: components.push_back(new BenchmarkComponent<Base, 24>()); break;
+            case 1: components.push_back(new BenchmarkComponent<Base, 56>()); break;
+            case 2: components.push_back(new BenchmarkComponent<Base, 120>()); break;
+            }
+
+            other_allocations.emplace_back(32 + i % 64, 'x');
+        }
+
+        auto created = std::chrono::high_resolution_clock::now();
+
+        for (uint32_t frame = 0; frame < 20; ++frame)
+        {
+            for (Base* component : components)
+            {
+                component->Update(0.016f);
+            }
+        }
+
+        auto updated = std::chrono::high_resolution_clock::now();
+
+        for (Base* component : components)
+        {
+            delete component;
+        }
+
+        auto destroyed = std::chrono::high_resolution_clock::now();
+
+        result.createMs  = GetBenchmarkMs(start, created);
+        result.updateMs  = GetBenchmarkMs(created, updated);
+        result.destroyMs = GetBenchmarkMs(updated, destroyed);
+
+        return result;
+    }
+}
+
+TEST(SlabAllocatorBenchmark, Components)
+{
+    constexpr uint32_t kComponentCount = 300000;
+
+    BenchmarkResult heap = RunComponentBenchmark<HeapComponent>(kComponentCount);
+    BenchmarkResult pooled = RunComponentBenchmark<PooledComponent>(kComponentCount);
+
+    PoolAllocatorStats stats = GetBenchmarkSlab().GetStats();
+
+    // A heap allocation per page instead of per component
+    ASSERT_TRUE(stats.heapAllocations * 100 < kComponentCount);
+    ASSERT_TRUE(stats.usedBlocks <= kPoolThreadCacheSize * 3);
+
+    RecordBenchmarkValue("heap_create_ms", heap.createMs);
+    RecordBenchmarkValue("heap_update_ms", heap.updateMs);
+    RecordBenchmarkValue("heap_destroy_ms", heap.destroyMs);
+    RecordBenchmarkValue("slab_create_ms", pooled.createMs);
+    RecordBenchmarkValue("slab_update_ms", pooled.updateMs);
+    RecordBenchmarkValue("slab_destroy_ms", pooled.destroyMs);
+    RecordBenchmarkValue("slab_heap_allocations", (double)stats.heapAllocations);
+    RecordBenchmarkValue("slab_lock_count", (double)stats.lockCount);
+}
@@ -0,0 +1,42 @@
+#include "Benchmark.h"
+#include <RabBit/utils/debug/Profiler.h>
+
+using namespace RB;
+using namespace RB::Utils::Debug;
+
+TEST(ProfilerBenchmark, ZoneCost)
+{
+    constexpr uint32_t kZoneCount = 10000;
+    constexpr uint32_t kRounds = 100;
+
+    Profiler::BeginCapture();
+
+    double milliseconds = 0.0;
+
+    for (uint32_t round = 0; round < kRounds; ++round)
+    {
+        auto start = std::chrono::high_resolution_clock::now();
+
+        for (uint32_t i = 0; i < kZoneCount; ++i)
+        {
+            ProfileCpuScoped zone("Zone");
+        }
+
+        milliseconds += GetBenchmarkMs(start, std::chrono::high_resolution_clock::now());
+
+        Profiler::Collect();
+    }
+
+    ProfileCapture capture = Profiler::EndCapture();
+
+    uint64_t zones = 0;
+    for (const ProfileThreadCapture& thread : capture.threads)
+    {
+        zones += thread.zones.size();
+        ASSERT_EQ(thread.droppedCount, 0u);
+    }
+
+    ASSERT_EQ(zones, (uint64_t)kZoneCount * kRounds);
+
+    RecordBenchmarkValue("ns_per_zone", milliseconds * 1000000.0 / zones);
+}
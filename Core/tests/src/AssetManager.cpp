@@ -0,0 +1,65 @@
+#include <gtest/gtest.h>
+#include <RabBit/app/AssetManager.h>
+#include <RabBit/graphics/TextureResidency.h>
+#include <RabBit/utils/debug/MemoryTracker.h>
+
+#include <fstream>
+
+using namespace RB;
+using namespace RB::Graphics;
+
+namespace
+{
+    // A 4x2 binary PPM, STB reads it as RGB so the alpha channel is forced
+    void WriteTestImage(const char* path)
+    {
+        const uint8_t pixels[4 * 2 * 3] =
+        {
+            0,   0,   0,    100, 100, 100,  200, 0, 0,  200, 0, 0,
+            40,  40,  40,   60,  60,  60,   0, 200, 0,  0, 200, 0,
+        };
+
+        std::ofstream file(path, std::ios::out | std::ios::binary);
+        file << "P6\n4 2\n255\n";
+        file.write((const char*)pixels, sizeof(pixels));
+    }
+}
+
+TEST(AssetManagerTest, GenerateMipChain)
+{
+    WriteTestImage("AssetManagerTest.ppm");
+    AssetManager::Init("");
+
+#ifdef RB_ENABLE_MEMORY_TRACKING
+    uint64_t live_bytes = Utils::Debug::MemoryTracker::GetReport().tags[(uint32_t)Utils::Debug::MemoryTag::Assets].liveBytes;
+#endif
+
+    {
+        LoadedImage image;
+        ASSERT_TRUE(AssetManager::LoadImage8Bit("AssetManagerTest.ppm", &image, 4));
+        ASSERT_EQ(image.format, RenderResourceFormat::R8G8B8A8_UNORM);
+
+        AssetManager::GenerateMipChain8Bit(&image);
+
+        ASSERT_EQ(image.data, nullptr);
+        ASSERT_EQ(image.mipLevels, 3u);
+        ASSERT_EQ(image.dataSize, GetMipChainSize(4, 2, 4, 0, 3));
+
+        const uint8_t* mip1 = (const uint8_t*)image.mipChain + GetMipSize(4, 2, 4, 0);
+        ASSERT_EQ(mip1[0], 50);     // (0 + 100 + 40 + 60) / 4
+        ASSERT_EQ(mip1[4], 100);    // (200 + 200 + 0 + 0) / 4
+        ASSERT_EQ(mip1[7], 255);
+
+#ifdef RB_ENABLE_MEMORY_TRACKING
+        // STB allocates with malloc, only the mip chain is tracked
+        ASSERT_EQ(Utils::Debug::MemoryTracker::GetReport().tags[(uint32_t)Utils::Debug::MemoryTag::Assets].liveBytes - live_bytes, image.dataSize);
+#endif
+    }
+
+#ifdef RB_ENABLE_MEMORY_TRACKING
+    // The mip chain is freed through the tracker, it does not come directly from malloc
+    ASSERT_EQ(Utils::Debug::MemoryTracker::GetReport().tags[(uint32_t)Utils::Debug::MemoryTag::Assets].liveBytes, live_bytes);
+#endif
+
+    std::remove("AssetManagerTest.ppm");
+}
@@ -0,0 +1,124 @@
+#include <gtest/gtest.h>
+#include <RabBit/graphics/DescriptorAllocator.h>
+
+using namespace RB;
+using namespace RB::Graphics;
+
+TEST(DescriptorAllocatorTest, SlotsAreUnique)
+{
+    DescriptorSlotAllocator slots(200);
+
+    List<bool> used(200, false);
+    for (uint32_t i = 0; i < 200; ++i)
+    {
+        uint32_t slot = slots.Allocate();
+        ASSERT_TRUE(slot < 200);
+        ASSERT_FALSE(used[slot]);
+        used[slot] = true;
+    }
+
+    // The slots past the capacity in the last word are never handed out
+    ASSERT_EQ(slots.Allocate(), kInvalidDescriptorSlot);
+    ASSERT_EQ(slots.GetUsedCount(), 200u);
+}
+
+TEST(DescriptorAllocatorTest, FreedSlotsAreReused)
+{
+    DescriptorSlotAllocator slots(4096);
+
+    for (uint32_t i = 0; i < 4096; ++i)
+    {
+        ASSERT_EQ(slots.Allocate(), i);
+    }
+
+    slots.Free(3000);
+    slots.Free(70);
+
+    // The lowest free slot comes first
+    ASSERT_FALSE(slots.IsAllocated(70));
+    ASSERT_EQ(slots.Allocate(), 70u);
+    ASSERT_EQ(slots.Allocate(), 3000u);
+    ASSERT_EQ(slots.Allocate(), kInvalidDescriptorSlot);
+}
+
+TEST(DescriptorAllocatorTest, RandomSlots)
+{
+    DescriptorSlotAllocator slots(10000);
+
+    List<uint32_t> allocated;
+    List<bool> used(10000, false);
+    uint32_t seed = 12345;
+
+    for (uint32_t i = 0; i < 20000; ++i)
+    {
+        seed = seed * 1664525 + 1013904223;
+
+        if (!allocated.empty() && (seed >> 16) % 3 == 0)
+        {
+            uint32_t index = (seed >> 8) % allocated.size();
+            slots.Free(allocated[index]);
+            used[allocated[index]] = false;
+            allocated[index] = allocated.back();
+            allocated.pop_back();
+            continue;
+        }
+
+        uint32_t slot = slots.Allocate();
+        ASSERT_TRUE(slot < 10000);
+        ASSERT_FALSE(used[slot]);
+        used[slot] = true;
+        allocated.push_back(slot);
+    }
+
+    ASSERT_EQ(slots.GetUsedCount(), (uint32_t)allocated.size());
+}
+
+TEST(DescriptorAllocatorTest, TransientCycles)
+{
+    TransientDescriptorRing ring(64, 3);
+
+    // A single cycle can use the whole ring
+    ASSERT_EQ(ring.Allocate(40), 0u);
+    ASSERT_EQ(ring.Allocate(24), 40u);
+    ASSERT_EQ(ring.Allocate(1), kInvalidDescriptorSlot);
+
+    // The descriptors are only reused once the cycle is old enough
+    ring.Cycle();
+    ASSERT_EQ(ring.Allocate(1), kInvalidDescriptorSlot);
+    ring.Cycle();
+    ASSERT_EQ(ring.Allocate(1), kInvalidDescriptorSlot);
+    ring.Cycle();
+    ASSERT_EQ(ring.Allocate(10), 0u);
+
+    // Contiguous descriptors are never split over the end of the ring
+    ASSERT_EQ(ring.Allocate(50), 10u);
+    ring.Cycle();
+    ring.Cycle();
+    ring.Cycle();
+    ASSERT_EQ(ring.Allocate(8), 0u);
+    ASSERT_EQ(ring.GetHighWaterMark(), 64u);
+}
+
+TEST(DescriptorAllocatorTest, TransientBlocks)
+{
+    TransientDescriptorRing ring(256, 3);
+
+    TransientDescriptorBlock a, b;
+
+    // Every block gets its own part of the ring
+    uint32_t first_a = ring.Allocate(a);
+    uint32_t first_b = ring.Allocate(b);
+    ASSERT_EQ(first_b - first_a, kTransientDescriptorBlockSize);
+
+    for (uint32_t i = 1; i < kTransientDescriptorBlockSize; ++i)
+    {
+        ASSERT_EQ(ring.Allocate(a), first_a + i);
+    }
+
+    // A full block or a new cycle takes a new block from the ring
+    uint32_t next_a = ring.Allocate(a);
+    ASSERT_EQ(next_a, first_b + kTransientDescriptorBlockSize);
+
+    ring.Cycle();
+    ASSERT_EQ(ring.Allocate(b), next_a + kTransientDescriptorBlockSize);
+}
@@ -0,0 +1,308 @@
+#include <gtest/gtest.h>
+#include <RabBit/events/Event.h>
+#include <RabBit/events/MouseEvent.h>
+#include <RabBit/events/WindowEvent.h>
+
+using namespace RB;
+using namespace RB::Events;
+
+namespace
+{
+    class TestListener : public EventListener
+    {
+    public:
+        TestListener(int category) : EventListener(category)
+        {
+            Subscribe<WindowResizeEvent>([this](WindowResizeEvent& e)
+            {
+                lastWidth = e.GetWidth();
+                return Handle(e);
+            });
+
+            Subscribe<MouseMovedEvent>([this](MouseMovedEvent& e)
+            {
+                mouseMoves++;
+                lastMouseY = e.GetMouseY();
+                return Handle(e);
+            });
+        }
+
+        List<EventType>     types;
+        uint32_t            lastWidth = 0;
+        uint64_t            mouseMoves = 0;
+        float               lastMouseY = 0.0f;
+        float               scrollSum = 0.0f;
+        bool                deferNext = false;
+
+    private:
+        bool Handle(Event& event)
+        {
+            if (deferNext)
+            {
+                deferNext = false;
+                return false;
+            }
+
+            types.push_back(event.GetEventType());
+            return true;
+        }
+
+        bool OnEvent(Event& event) override
+        {
+            BindEvent<MouseScrolledEvent>([&](MouseScrolledEvent& e) { scrollSum += e.GetOffsetY(); }, event);
+
+            return Handle(event);
+        }
+    };
+
+    struct ScopedEventManager
+    {
+        ScopedEventManager()  { g_EventManager = new EventManager(); }
+        ~ScopedEventManager() { SAFE_DELETE(g_EventManager); }
+    };
+}
+
+TEST(EventTest, PoolReusesSlots)
+{
+    EventPool pool;
+
+    EventSlot* slot = pool.Acquire(MouseMovedEvent(1.0f, 2.0f), 2);
+    ASSERT_EQ(slot->event->GetEventType(), EventType::MouseMoved);
+    ASSERT_EQ(pool.GetUsedCount(), 1u);
+
+    // The slot is shared until every listener released it
+    pool.Release(slot);
+    ASSERT_EQ(pool.GetUsedCount(), 1u);
+    pool.Release(slot);
+    ASSERT_EQ(pool.GetUsedCount(), 0u);
+
+    EventSlot* reused = pool.Acquire(MouseScrolledEvent(0.0f, 1.0f), 1);
+    ASSERT_EQ(reused, slot);
+    ASSERT_EQ(pool.GetSlotCount(), kEventPoolSlotsPerChunk);
+    pool.Release(reused);
+}
+
+TEST(EventTest, QueueOverflowKeepsOrder)
+{
+    EventPool pool;
+    EventQueue queue(4);
+
+    List<EventSlot*> pushed;
+    for (uint32_t i = 0; i < 10; ++i)
+    {
+        pushed.push_back(pool.Acquire(MouseMovedEvent((float)i, 0.0f), 1));
+        queue.Push(pushed.back());
+    }
+
+    List<EventSlot*> popped;
+    queue.PopAll(popped);
+    ASSERT_TRUE(popped == pushed);
+
+    // The queue is usable again after the overflow
+    queue.Push(pushed[0]);
+    popped.clear();
+    queue.PopAll(popped);
+    ASSERT_EQ(popped.size(), 1u);
+
+    for (EventSlot* slot : pushed)
+    {
+        pool.Release(slot);
+    }
+}
+
+namespace RB::Events
+{
+    struct EventQueueTestAccess
+    {
+        static bool Claim(EventQueue& queue, uint64_t& out_position) { return queue.TryClaim(out_position); }
+        static void Publish(EventQueue& queue, uint64_t position, EventSlot* slot) { queue.Publish(position, slot); }
+    };
+}
+
+TEST(EventTest, QueueOverflowWaitsForStalledProducer)
+{
+    EventPool pool;
+    EventQueue queue(4);
+
+    List<EventSlot*> pushed;
+    for (uint32_t i = 0; i < 6; ++i)
+    {
+        pushed.push_back(pool.Acquire(MouseMovedEvent((float)i, 0.0f), 1));
+    }
+
+    // The first producer claims a cell but does not write it yet, the second one fills up the ring and goes to the overflow
+    uint64_t stalled_position;
+    ASSERT_TRUE(EventQueueTestAccess::Claim(queue, stalled_position));
+    for (uint32_t i = 1; i < 5; ++i)
+    {
+        queue.Push(pushed[i]);
+    }
+
+    // Nothing can be popped before the stalled cell, so the overflow has to wait as well
+    List<EventSlot*> popped;
+    queue.PopAll(popped);
+    ASSERT_TRUE(popped.empty());
+
+    // Keeps going to the overflow, behind the events that are still in the ring
+    queue.Push(pushed[5]);
+
+    EventQueueTestAccess::Publish(queue, stalled_position, pushed[0]);
+    queue.PopAll(popped);
+    ASSERT_TRUE(popped == pushed);
+
+    for (EventSlot* slot : pushed)
+    {
+        pool.Release(slot);
+    }
+}
+
+TEST(EventTest, ListenerOverwritesAndDefers)
+{
+    ScopedEventManager manager;
+    TestListener window_listener(kEventCat_Window);
+    TestListener mouse_listener(kEventCat_Mouse);
+
+    int window = 0;
+    g_EventManager->InsertEvent(WindowResizeEvent(&window, 100, 100));
+    g_EventManager->InsertEvent(WindowCloseRequestEvent(&window));
+    g_EventManager->InsertEvent(WindowResizeEvent(&window, 200, 200));
+    g_EventManager->InsertEvent(MouseMovedEvent(1.0f, 1.0f));
+
+    // Only the last resize is left, the mouse move is received because the listener subscribed to it
+    window_listener.ProcessEvents();
+    ASSERT_EQ(window_listener.types.size(), 3u);
+    ASSERT_EQ(window_listener.types[0], EventType::WindowCloseRequest);
+    ASSERT_EQ(window_listener.types[1], EventType::WindowResize);
+    ASSERT_EQ(window_listener.types[2], EventType::MouseMoved);
+    ASSERT_EQ(window_listener.lastWidth, 200u);
+
+    // A deferred event is processed again the next time, before the newer events
+    mouse_listener.deferNext = true;
+    mouse_listener.ProcessEvents();
+    ASSERT_EQ(mouse_listener.types.size(), 1u);
+    ASSERT_EQ(mouse_listener.types[0], EventType::MouseMoved);
+
+    g_EventManager->InsertEvent(MouseScrolledEvent(0.0f, 1.0f));
+    mouse_listener.ProcessEvents();
+    ASSERT_EQ(mouse_listener.types.size(), 3u);
+    ASSERT_EQ(mouse_listener.types[1], EventType::WindowResize);
+    ASSERT_EQ(mouse_listener.types[2], EventType::MouseScrolled);
+
+    ASSERT_EQ(g_EventManager->GetPool().GetUsedCount(), 0u);
+}
+
+TEST(EventTest, TypedSubscriptions)
+{
+    ScopedEventManager manager;
+    TestListener no_category(kEventCat_None);
+    TestListener keyboard(kEventCat_Keyboard);
+
+    int window = 0;
+    g_EventManager->InsertEvent(MouseMovedEvent(1.0f, 1.0f));
+    g_EventManager->InsertEvent(MouseScrolledEvent(0.0f, 1.0f));
+    g_EventManager->InsertEvent(WindowCloseRequestEvent(&window));
+
+    // Only the subscribed types are received, the categories only add the events that go to OnEvent
+    no_category.ProcessEvents();
+    ASSERT_EQ(no_category.types.size(), 1u);
+    ASSERT_EQ(no_category.mouseMoves, 1u);
+    ASSERT_EQ(no_category.scrollSum, 0.0f);
+
+    keyboard.ProcessEvents();
+    ASSERT_EQ(keyboard.types.size(), 1u);
+    ASSERT_EQ(keyboard.types[0], EventType::MouseMoved);
+
+    ASSERT_EQ(g_EventManager->GetPool().GetUsedCount(), 0u);
+}
+
+TEST(EventTest, MouseMovesAreCoalesced)
+{
+    ScopedEventManager manager;
+    TestListener listener(kEventCat_Mouse);
+
+    for (uint32_t i = 0; i < 100; ++i)
+    {
+        g_EventManager->InsertEvent(MouseMovedEvent(0.0f, (float)i));
+        g_EventManager->InsertEvent(MouseScrolledEvent(0.0f, 1.0f));
+    }
+
+    // Only the newest position is left, the scrolls are all kept
+    listener.ProcessEvents();
+    ASSERT_EQ(listener.mouseMoves, 1u);
+    ASSERT_EQ(listener.lastMouseY, 99.0f);
+    ASSERT_EQ(listener.scrollSum, 100.0f);
+    ASSERT_EQ(listener.types.size(), 101u);
+
+    // A deferred move is replaced by a newer one as well
+    g_EventManager->InsertEvent(MouseMovedEvent(0.0f, 1.0f));
+    listener.deferNext = true;
+    listener.ProcessEvents();
+
+    g_EventManager->InsertEvent(MouseMovedEvent(0.0f, 2.0f));
+    listener.ProcessEvents();
+    ASSERT_EQ(listener.mouseMoves, 3u);
+    ASSERT_EQ(listener.lastMouseY, 2.0f);
+    ASSERT_EQ(listener.types.size(), 102u);
+
+    ASSERT_EQ(g_EventManager->GetPool().GetUsedCount(), 0u);
+}
+
+TEST(EventTest, ConcurrentMouseInput)
+{
+    // Simulates a couple of raw input sources sending mouse moves and scrolls while the listeners process them (see benchmarks/Events.cpp for the throughput)
+    constexpr uint32_t kProducerCount = 4;
+    constexpr uint32_t kEventsPerProducer = 25000;
+
+    ScopedEventManager manager;
+    TestListener main_listener(kEventCat_Input);
+    TestListener mouse_listener(kEventCat_Mouse);
+
+    std::atomic<uint32_t> finished_producers = 0;
+
+    std::vector<std::thread> producers;
+    for (uint32_t p = 0; p < kProducerCount; ++p)
+    {
+        producers.emplace_back([&]()
+        {
+            for (uint32_t i = 0; i < kEventsPerProducer; ++i)
+            {
+                // Real input never gets this far ahead of the listeners, do not fill up the whole pool
+                while (g_EventManager->GetPool().GetUsedCount() > kEventPoolSlotsPerChunk * kEventPoolMaxChunks / 2)
+                {
+                    std::this_thread::yield();
+                }
+
+                if (i % 2 == 0)
+                {
+                    g_EventManager->InsertEvent(MouseMovedEvent(1.0f, (float)i));
+                }
+                else
+                {
+                    g_EventManager->InsertEvent(MouseScrolledEvent(0.0f, 1.0f));
+                }
+            }
+
+            finished_producers++;
+        });
+    }
+
+    while (finished_producers.load() < kProducerCount)
+    {
+        main_listener.ProcessEvents();
+        mouse_listener.ProcessEvents();
+    }
+
+    main_listener.ProcessEvents();
+    mouse_listener.ProcessEvents();
+
+    for (std::thread& producer : producers)
+    {
+        producer.join();
+    }
+
+    // The moves are coalesced, but no scroll can get lost
+    ASSERT_TRUE(main_listener.mouseMoves > 0 && main_listener.mouseMoves <= kProducerCount * kEventsPerProducer / 2);
+    ASSERT_EQ(main_listener.scrollSum, (float)(kProducerCount * kEventsPerProducer / 2));
+    ASSERT_EQ(mouse_listener.scrollSum, (float)(kProducerCount * kEventsPerProducer / 2));
+    ASSERT_EQ(g_EventManager->GetPool().GetUsedCount(), 0u);
+}
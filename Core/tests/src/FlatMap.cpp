@@ -0,0 +1,192 @@
+#include <gtest/gtest.h>
+#include <RabBit/RabBitCommon.h>
+
+#include <random>
+
+using namespace RB;
+
+namespace
+{
+    struct Tracked
+    {
+        static inline int64_t alive = 0;
+
+        Tracked(int v = 0) : value(v) { alive++; }
+        Tracked(const Tracked& other) : value(other.value) { alive++; }
+        Tracked(Tracked&& other) noexcept : value(other.value) { alive++; }
+        ~Tracked() { alive--; }
+
+        Tracked& operator=(const Tracked& other) = default;
+
+        int value;
+    };
+}
+
+TEST(FlatMapTest, InsertFindErase)
+{
+    FlatMap<uint32_t, uint32_t> map;
+    ASSERT_TRUE(map.empty());
+    ASSERT_TRUE(map.find(1) == map.end());
+
+    ASSERT_TRUE(map.emplace(1, 10).second);
+    ASSERT_TRUE(map.insert({ 2, 20 }).second);
+    map[3] = 30;
+
+    // Does not overwrite
+    auto result = map.emplace(1, 11);
+    ASSERT_FALSE(result.second);
+    ASSERT_EQ(result.first->second, 10u);
+
+    ASSERT_EQ(map.size(), 3u);
+    ASSERT_EQ(map.find(2)->second, 20u);
+    ASSERT_EQ(map[3], 30u);
+    ASSERT_EQ(map.count(4), 0u);
+
+    ASSERT_EQ(map.erase(2), 1u);
+    ASSERT_EQ(map.erase(2), 0u);
+    ASSERT_TRUE(map.find(2) == map.end());
+    ASSERT_EQ(map.size(), 2u);
+
+    map.erase(map.find(1));
+    ASSERT_FALSE(map.contains(1));
+    ASSERT_TRUE(map.contains(3));
+}
+
+TEST(FlatMapTest, MatchesUnorderedMap)
+{
+    // Random inserts and erases on a small key range, so there are plenty of collisions, deleted slots and rehashes
+    FlatMap<uint64_t, uint64_t> map;
+    UnorderedMap<uint64_t, uint64_t> reference;
+
+    std::mt19937_64 random(1234);
+
+    for (uint32_t i = 0; i < 200000; ++i)
+    {
+        uint64_t key = random() % 5000;
+
+        switch (random() % 3)
+        {
+        case 0:
+        case 1:
+            map[key] = i;
+            reference[key] = i;
+            break;
+        case 2:
+            ASSERT_EQ(map.erase(key), reference.erase(key));
+            break;
+        }
+
+        ASSERT_EQ(map.size(), reference.size());
+    }
+
+    for (const auto& pair : reference)
+    {
+        auto itr = map.find(pair.first);
+        ASSERT_TRUE(itr != map.end());
+        ASSERT_EQ(itr->second, pair.second);
+    }
+
+    size_t iterated = 0;
+    for (const auto& pair : map)
+    {
+        ASSERT_EQ(reference[pair.first], pair.second);
+        iterated++;
+    }
+
+    ASSERT_EQ(iterated, reference.size());
+
+    // Never more than 7/8 full
+    ASSERT_TRUE(map.size() <= map.capacity() - map.capacity() / 8);
+}
+
+TEST(FlatMapTest, NonTrivialValues)
+{
+    {
+        FlatMap<int, Tracked> map;
+
+        for (int i = 0; i < 1000; ++i)
+        {
+            map.emplace(i, i * 2);
+        }
+
+        ASSERT_EQ(Tracked::alive, 1000);
+
+        for (int i = 0; i < 1000; i += 2)
+        {
+            map.erase(i);
+        }
+
+        ASSERT_EQ(Tracked::alive, 500);
+        ASSERT_EQ(map.find(501)->second.value, 1002);
+
+        FlatMap<int, Tracked> copy = map;
+        ASSERT_EQ(Tracked::alive, 1000);
+        ASSERT_EQ(copy.find(999)->second.value, 1998);
+
+        FlatMap<int, Tracked> moved = std::move(copy);
+        ASSERT_EQ(Tracked::alive, 1000);
+        ASSERT_TRUE(copy.empty());
+        ASSERT_EQ(moved.size(), 500u);
+
+        map.clear();
+        ASSERT_EQ(Tracked::alive, 500);
+    }
+
+    ASSERT_EQ(Tracked::alive, 0);
+
+    FlatMap<std::string, List<uint32_t>> lists;
+    lists["a"].push_back(1);
+    lists["a"].push_back(2);
+    lists["b"].push_back(3);
+    ASSERT_EQ(lists["a"].size(), 2u);
+    ASSERT_EQ(lists.find("b")->second[0], 3u);
+}
+
+TEST(FlatMapTest, EraseWhileIterating)
+{
+    FlatMap<uint32_t, uint32_t> map;
+    for (uint32_t i = 0; i < 100; ++i)
+    {
+        map[i] = i;
+    }
+
+    for (auto itr = map.begin(); itr != map.end();)
+    {
+        if (itr->first % 2 == 0)
+        {
+            itr = map.erase(itr);
+        }
+        else
+        {
+            ++itr;
+        }
+    }
+
+    ASSERT_EQ(map.size(), 50u);
+
+    const FlatMap<uint32_t, uint32_t>& const_map = map;
+    for (const auto& pair : const_map)
+    {
+        ASSERT_EQ(pair.first % 2, 1u);
+    }
+
+    ASSERT_TRUE(const_map.find(3) != const_map.end());
+}
+
+TEST(FlatMapTest, Set)
+{
+    FlatSet<const void*> set;
+    int values[64];
+
+    for (int& value : values)
+    {
+        ASSERT_TRUE(set.insert(&value).second);
+    }
+
+    ASSERT_FALSE(set.insert(&values[10]).second);
+    ASSERT_EQ(set.size(), 64u);
+    ASSERT_TRUE(set.contains(&values[63]));
+
+    set.erase(&values[63]);
+    ASSERT_FALSE(set.contains(&values[63]));
+}
@@ -0,0 +1,94 @@
+#include <gtest/gtest.h>
+#include <RabBit/graphics/GeometryPool.h>
+
+using namespace RB;
+using namespace RB::Graphics;
+
+TEST(GeometryPoolTest, RangesShareAPage)
+{
+    GeometryPoolAllocator allocator(32 * 1024, 16 * 1024);
+
+    GeometryRange a, b;
+    ASSERT_TRUE(allocator.Allocate(32, 100, 300, a));
+    ASSERT_TRUE(allocator.Allocate(32, 50, 120, b));
+
+    ASSERT_EQ(allocator.GetPageCount(), 1u);
+    ASSERT_EQ(a.page, b.page);
+
+    // The ranges do not overlap, so both can be drawn from the same buffers with their offsets
+    ASSERT_TRUE(a.vertices.offset + a.vertices.size <= b.vertices.offset || b.vertices.offset + b.vertices.size <= a.vertices.offset);
+    ASSERT_TRUE(a.indices.offset + a.indices.size <= b.indices.offset || b.indices.offset + b.indices.size <= a.indices.offset);
+    ASSERT_EQ(a.GetIndexCount(), 300u);
+    ASSERT_EQ(b.GetIndexCount(), 120u);
+
+    GeometryPoolStats stats = allocator.GetStats();
+    ASSERT_EQ(stats.allocationCount, 2u);
+    ASSERT_EQ(stats.usedVertexBytes, 150u * 32);
+    ASSERT_EQ(stats.usedIndexBytes, 420u * sizeof(uint32_t));
+}
+
+TEST(GeometryPoolTest, PagesPerVertexSize)
+{
+    GeometryPoolAllocator allocator(32 * 1024, 16 * 1024);
+
+    GeometryRange a, b, c;
+    ASSERT_TRUE(allocator.Allocate(32, 10, 30, a));
+    ASSERT_TRUE(allocator.Allocate(12, 10, 30, b));
+    ASSERT_TRUE(allocator.Allocate(32, 10, 30, c));
+
+    ASSERT_EQ(allocator.GetPageCount(), 2u);
+    ASSERT_NE(a.page, b.page);
+    ASSERT_EQ(a.page, c.page);
+    ASSERT_EQ(allocator.GetPageVertexSize(b.page), 12u);
+}
+
+TEST(GeometryPoolTest, FullPageAddsPage)
+{
+    GeometryPoolAllocator allocator(32 * 1024, 16 * 1024);
+
+    // A page holds 1024 vertices of 32 bytes
+    GeometryRange a, b, too_big;
+    ASSERT_TRUE(allocator.Allocate(32, 800, 3, a));
+    ASSERT_TRUE(allocator.Allocate(32, 800, 3, b));
+    ASSERT_NE(a.page, b.page);
+
+    ASSERT_FALSE(allocator.Allocate(32, 2000, 3, too_big));
+    ASSERT_FALSE(allocator.Allocate(32, 10, 5000, too_big));
+    ASSERT_EQ(too_big.page, kInvalidGeometryPage);
+
+    // Freed ranges are reused
+    allocator.Free(a);
+
+    GeometryRange reused;
+    ASSERT_TRUE(allocator.Allocate(32, 1024, 3, reused));
+    ASSERT_EQ(reused.page, a.page);
+    ASSERT_EQ(allocator.GetPageCount(), 2u);
+}
+
+TEST(GeometryPoolTest, FreeMergesRanges)
+{
+    GeometryPoolAllocator allocator(32 * 1024, 16 * 1024);
+
+    List<GeometryRange> ranges(8);
+    for (GeometryRange& range : ranges)
+    {
+        ASSERT_TRUE(allocator.Allocate(32, 128, 512, range));
+    }
+
+    ASSERT_EQ(allocator.GetPageCount(), 1u);
+
+    for (const GeometryRange& range : ranges)
+    {
+        allocator.Free(range);
+    }
+
+    GeometryPoolStats stats = allocator.GetStats();
+    ASSERT_EQ(stats.allocationCount, 0u);
+    ASSERT_EQ(stats.usedVertexBytes, 0u);
+
+    // Everything is one free range again
+    GeometryRange all;
+    ASSERT_TRUE(allocator.Allocate(32, 1024, 4096, all));
+    ASSERT_EQ(all.GetBaseVertex(), 0);
+    ASSERT_EQ(all.GetStartIndex(), 0u);
+}
@@ -0,0 +1,194 @@
+#include <gtest/gtest.h>
+#include <RabBit/graphics/GpuProfiler.h>
+#include <RabBit/utils/debug/Profiler.h>
+
+using namespace RB;
+using namespace RB::Graphics;
+using namespace RB::Utils::Debug;
+
+namespace
+{
+    // Stands in for the fence of a queue, the GPU finishes the submissions whenever the test completes them
+    struct FakeFence
+    {
+        uint64_t signaled = 0;
+        uint64_t completed = 0;
+
+        uint64_t Signal() { return ++signaled; }
+    };
+
+    void Execute(GpuProfiler& profiler, FakeFence& fence)
+    {
+        profiler.Resolve();
+        profiler.Submit(fence.Signal());
+        profiler.ReadBack(fence.completed);
+    }
+
+    const ProfileThreadCapture* FindTrack(const ProfileCapture& capture, const char* name)
+    {
+        for (const ProfileThreadCapture& thread : capture.threads)
+        {
+            if (thread.name == name)
+            {
+                return &thread;
+            }
+        }
+
+        return nullptr;
+    }
+}
+
+TEST(GpuProfilerTest, NestedZones)
+{
+    Profiler::BeginCapture();
+
+    // Every timestamp is 1 microsecond after the previous one
+    GpuProfiler profiler(new GpuTimestampBackendNull(64, 1000), 64, "GPU Nested");
+    FakeFence fence;
+
+    profiler.BeginZone("Frame");
+    {
+        profiler.BeginZone("Opaque");
+        profiler.EndZone();
+
+        profiler.BeginZone("Transparent");
+        profiler.EndZone();
+    }
+    profiler.EndZone();
+
+    Execute(profiler, fence);
+
+    // The GPU is not done yet, nothing is waited on
+    ASSERT_EQ(profiler.GetPendingZoneCount(), 3u);
+    ASSERT_TRUE(profiler.FindTiming("Frame") == nullptr);
+
+    fence.completed = fence.signaled;
+    profiler.ReadBack(fence.completed);
+
+    ASSERT_EQ(profiler.GetPendingZoneCount(), 0u);
+    ASSERT_EQ(profiler.FindTiming("Opaque")->duration, 1000u);
+    ASSERT_EQ(profiler.FindTiming("Transparent")->duration, 1000u);
+    ASSERT_EQ(profiler.FindTiming("Frame")->duration, 5000u);
+
+    Profiler::Collect();
+    ProfileCapture capture = Profiler::EndCapture();
+
+    // Published on the timeline of the CPU profiler
+    const ProfileThreadCapture* track = FindTrack(capture, "GPU Nested");
+    ASSERT_TRUE(track != nullptr);
+    ASSERT_EQ(track->zones.size(), 3u);
+
+    ASSERT_STREQ(track->zones[0].name, "Frame");
+    ASSERT_STREQ(track->zones[1].name, "Opaque");
+    ASSERT_STREQ(track->zones[2].name, "Transparent");
+    ASSERT_EQ(track->zones[0].depth, 0u);
+    ASSERT_EQ(track->zones[1].depth, 1u);
+    ASSERT_EQ(track->zones[2].start - track->zones[0].start, 3000u);
+}
+
+TEST(GpuProfilerTest, ZoneAcrossSubmissions)
+{
+    GpuProfiler profiler(new GpuTimestampBackendNull(64, 1000), 64, "GPU Submissions");
+    FakeFence fence;
+
+    profiler.BeginZone("Frame");
+    Execute(profiler, fence);
+
+    profiler.BeginZone("Post");
+    profiler.EndZone();
+    profiler.EndZone();
+    Execute(profiler, fence);
+
+    // Only the begin of the frame is read back
+    fence.completed = 1;
+    profiler.ReadBack(fence.completed);
+    ASSERT_EQ(profiler.GetPendingZoneCount(), 2u);
+
+    fence.completed = 2;
+    profiler.ReadBack(fence.completed);
+    ASSERT_EQ(profiler.GetPendingZoneCount(), 0u);
+    ASSERT_EQ(profiler.FindTiming("Frame")->duration, 3000u);
+    ASSERT_EQ(profiler.FindTiming("Post")->duration, 1000u);
+
+    // Nothing to resolve, so nothing to wait for
+    Execute(profiler, fence);
+    fence.completed = fence.signaled;
+    profiler.ReadBack(fence.completed);
+    ASSERT_EQ(profiler.FindTiming("Frame")->count, 1u);
+}
+
+TEST(GpuProfilerTest, DropsWhenQueriesInFlight)
+{
+    GpuProfiler profiler(new GpuTimestampBackendNull(8, 1000), 8, "GPU Drops");
+    FakeFence fence;
+
+    for (uint32_t i = 0; i < 6; ++i)
+    {
+        profiler.BeginZone("Pass");
+        profiler.EndZone();
+    }
+
+    Execute(profiler, fence);
+
+    ASSERT_EQ(profiler.GetDroppedCount(), 2u);
+    ASSERT_EQ(profiler.GetPendingZoneCount(), 4u);
+
+    // An open zone keeps a query for its end
+    profiler.BeginZone("Outer");
+    profiler.BeginZone("Inner");
+    profiler.EndZone();
+    profiler.EndZone();
+    ASSERT_EQ(profiler.GetDroppedCount(), 4u);
+
+    fence.completed = fence.signaled;
+    profiler.ReadBack(fence.completed);
+    ASSERT_EQ(profiler.FindTiming("Pass")->count, 4u);
+
+    // The queries can be used again
+    profiler.BeginZone("Pass");
+    profiler.EndZone();
+    ASSERT_EQ(profiler.GetDroppedCount(), 4u);
+}
+
+TEST(GpuProfilerTest, FramesInFlight)
+{
+    // A few frames of latency with a small amount of queries, so the queries wrap around many times
+    constexpr uint32_t kFrameCount = 1000;
+    constexpr uint32_t kFrameLatency = 3;
+
+    GpuProfiler profiler(new GpuTimestampBackendNull(32, 1000), 32, "GPU Frames");
+    FakeFence fence;
+
+    for (uint32_t frame = 0; frame < kFrameCount; ++frame)
+    {
+        profiler.BeginZone("Frame");
+        {
+            profiler.BeginZone("Shadows");
+            profiler.EndZone();
+
+            // An intermediate submission in the middle of the frame
+            Execute(profiler, fence);
+
+            profiler.BeginZone("Opaque");
+            profiler.EndZone();
+        }
+        profiler.EndZone();
+
+        Execute(profiler, fence);
+
+        fence.completed = fence.signaled > kFrameLatency * 2 ? fence.signaled - kFrameLatency * 2 : 0;
+        profiler.ReadBack(fence.completed);
+
+        ASSERT_TRUE(profiler.GetPendingZoneCount() <= (kFrameLatency + 1) * 3);
+    }
+
+    fence.completed = fence.signaled;
+    profiler.ReadBack(fence.completed);
+
+    ASSERT_EQ(profiler.GetDroppedCount(), 0u);
+    ASSERT_EQ(profiler.GetPendingZoneCount(), 0u);
+    ASSERT_EQ(profiler.FindTiming("Frame")->count, kFrameCount);
+    ASSERT_EQ(profiler.FindTiming("Frame")->duration, 5000u);
+    ASSERT_EQ(profiler.FindTiming("Shadows")->duration, 1000u);
+    ASSERT_EQ(profiler.FindTiming("Opaque")->duration, 1000u);
+}
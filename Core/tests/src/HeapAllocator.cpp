@@ -0,0 +1,173 @@
+#include <gtest/gtest.h>
+#include <RabBit/graphics/HeapAllocator.h>
+
+using namespace RB;
+using namespace RB::Graphics;
+
+static constexpr uint64_t kTestGranularity = 64 * 1024;
+
+TEST(HeapAllocatorTest, AllocateAndFree)
+{
+    HeapAllocator heap(kTestGranularity * 16, kTestGranularity);
+
+    HeapBlock a, b, c;
+    ASSERT_TRUE(heap.Allocate(100, 1, a));
+    ASSERT_TRUE(heap.Allocate(kTestGranularity * 2, 1, b));
+    ASSERT_TRUE(heap.Allocate(kTestGranularity + 1, 1, c));
+
+    // Sizes are rounded up to the granularity and blocks never overlap
+    ASSERT_EQ(a.size, kTestGranularity);
+    ASSERT_EQ(b.size, kTestGranularity * 2);
+    ASSERT_EQ(c.size, kTestGranularity * 2);
+    ASSERT_TRUE(a.offset + a.size <= b.offset || b.offset + b.size <= a.offset);
+    ASSERT_TRUE(b.offset + b.size <= c.offset || c.offset + c.size <= b.offset);
+    ASSERT_TRUE(a.offset + a.size <= c.offset || c.offset + c.size <= a.offset);
+
+    HeapAllocatorStats stats = heap.GetStats();
+    ASSERT_EQ(stats.usedBytes, kTestGranularity * 5);
+    ASSERT_EQ(stats.allocationCount, 3u);
+
+    ASSERT_TRUE(heap.Free(b));
+    ASSERT_TRUE(heap.Free(a));
+    ASSERT_TRUE(heap.Free(c));
+
+    // Everything is merged back into 1 block
+    stats = heap.GetStats();
+    ASSERT_TRUE(heap.IsEmpty());
+    ASSERT_EQ(stats.usedBytes, 0u);
+    ASSERT_EQ(stats.freeBlockCount, 1u);
+    ASSERT_EQ(stats.largestFreeBlock, kTestGranularity * 16);
+    ASSERT_EQ(stats.fragmentation, 0.0f);
+}
+
+TEST(HeapAllocatorTest, FullHeapFails)
+{
+    HeapAllocator heap(kTestGranularity * 4, kTestGranularity);
+
+    HeapBlock all, none;
+    ASSERT_TRUE(heap.Allocate(kTestGranularity * 4, 1, all));
+    ASSERT_FALSE(heap.Allocate(1, 1, none));
+    ASSERT_EQ(none.index, kInvalidHeapBlock);
+
+    ASSERT_FALSE(heap.Allocate(kTestGranularity * 5, 1, none));
+
+    heap.Free(all);
+    ASSERT_TRUE(heap.Allocate(1, 1, none));
+}
+
+TEST(HeapAllocatorTest, Alignment)
+{
+    HeapAllocator heap(kTestGranularity * 256, kTestGranularity);
+
+    HeapBlock small, aligned;
+    ASSERT_TRUE(heap.Allocate(1, 1, small));
+    ASSERT_TRUE(heap.Allocate(kTestGranularity, kTestGranularity * 64, aligned));
+
+    ASSERT_EQ(aligned.offset % (kTestGranularity * 64), 0u);
+    ASSERT_EQ(aligned.size, kTestGranularity);
+
+    // The padding in front of the aligned block is still usable
+    HeapBlock padding;
+    ASSERT_TRUE(heap.Allocate(kTestGranularity, 1, padding));
+    ASSERT_TRUE(padding.offset < aligned.offset);
+}
+
+TEST(HeapAllocatorTest, Fragmentation)
+{
+    HeapAllocator heap(kTestGranularity * 8, kTestGranularity);
+
+    HeapBlock blocks[8];
+    for (HeapBlock& block : blocks)
+    {
+        ASSERT_TRUE(heap.Allocate(kTestGranularity, 1, block));
+    }
+
+    // Free every other block, half of the heap is free but nothing bigger than 1 block fits
+    for (uint32_t i = 0; i < 8; i += 2)
+    {
+        heap.Free(blocks[i]);
+    }
+
+    HeapAllocatorStats stats = heap.GetStats();
+    ASSERT_EQ(stats.freeBlockCount, 4u);
+    ASSERT_EQ(stats.largestFreeBlock, kTestGranularity);
+    ASSERT_FLOAT_EQ(stats.fragmentation, 0.75f);
+
+    HeapBlock big;
+    ASSERT_FALSE(heap.Allocate(kTestGranularity * 2, 1, big));
+
+    // Freeing a block in between merges its neighbours
+    heap.Free(blocks[1]);
+
+    stats = heap.GetStats();
+    ASSERT_EQ(stats.freeBlockCount, 3u);
+    ASSERT_EQ(stats.largestFreeBlock, kTestGranularity * 3);
+    ASSERT_TRUE(heap.Allocate(kTestGranularity * 3, 1, big));
+    ASSERT_EQ(big.offset, 0u);
+}
+
+TEST(HeapAllocatorTest, AliasedBlocks)
+{
+    HeapAllocator heap(kTestGranularity * 4, kTestGranularity);
+
+    HeapBlock block;
+    ASSERT_TRUE(heap.Allocate(kTestGranularity * 4, 1, block));
+
+    heap.AddReference(block);
+
+    // The memory stays in use until every resource using it is freed
+    ASSERT_FALSE(heap.Free(block));
+    ASSERT_FALSE(heap.IsEmpty());
+
+    ASSERT_TRUE(heap.Free(block));
+    ASSERT_TRUE(heap.IsEmpty());
+}
+
+TEST(HeapAllocatorTest, RandomAllocations)
+{
+    HeapAllocator heap(kTestGranularity * 1024, kTestGranularity);
+
+    std::vector<HeapBlock> blocks;
+    uint32_t seed = 12345;
+
+    for (uint32_t i = 0; i < 2000; ++i)
+    {
+        seed = seed * 1664525 + 1013904223;
+
+        if (!blocks.empty() && (seed >> 16) % 3 == 0)
+        {
+            uint32_t index = (seed >> 8) % blocks.size();
+            heap.Free(blocks[index]);
+            blocks[index] = blocks.back();
+            blocks.pop_back();
+            continue;
+        }
+
+        HeapBlock block;
+        if (heap.Allocate(((seed >> 12) % 16 + 1) * kTestGranularity, 1, block))
+        {
+            for (const HeapBlock& other : blocks)
+            {
+                ASSERT_TRUE(block.offset + block.size <= other.offset || other.offset + other.size <= block.offset);
+            }
+
+            ASSERT_TRUE(block.offset + block.size <= heap.GetSize());
+            blocks.push_back(block);
+        }
+    }
+
+    uint64_t used = 0;
+    for (const HeapBlock& block : blocks)
+    {
+        used += block.size;
+    }
+
+    ASSERT_EQ(heap.GetStats().usedBytes, used);
+
+    for (const HeapBlock& block : blocks)
+    {
+        heap.Free(block);
+    }
+
+    ASSERT_EQ(heap.GetStats().freeBlockCount, 1u);
+}
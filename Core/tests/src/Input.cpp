@@ -0,0 +1,138 @@
+#include <gtest/gtest.h>
+#include <RabBit/events/input/InputRing.h>
+
+using namespace RB;
+using namespace RB::Events;
+
+TEST(InputTest, RingKeepsOrder)
+{
+    InputRing ring(4);
+
+    for (uint32_t i = 0; i < 6; ++i)
+    {
+        ring.Push({ i, InputSampleType::MouseDelta, 0, (float)i, 0.0f });
+    }
+
+    // The newest samples are dropped when the reader falls behind
+    ASSERT_EQ(ring.GetDroppedCount(), 2u);
+
+    List<InputSample> samples;
+    ASSERT_EQ(ring.PopAll(samples), 4u);
+
+    for (uint32_t i = 0; i < 4; ++i)
+    {
+        ASSERT_EQ(samples[i].timestamp, (uint64_t)i);
+    }
+
+    ASSERT_TRUE(ring.Push({ 10, InputSampleType::MouseDelta, 0, 0.0f, 0.0f }));
+    ASSERT_EQ(ring.PopAll(samples), 1u);
+}
+
+TEST(InputTest, FrameViews)
+{
+    InputSampler sampler;
+
+    sampler.AddKey(1, KeyCode::A, true);
+    sampler.AddMouseMove(2, 10.0f, 20.0f);
+    sampler.AddMouseDelta(3, 1.0f, -1.0f);
+    sampler.AddMouseDelta(4, 2.0f, -2.0f);
+    sampler.AddMouseMove(5, 13.0f, 17.0f);
+    sampler.AddKey(6, KeyCode::A, false);
+    sampler.AddMouseButton(7, MouseCode::ButtonLeft, true);
+    sampler.AddMouseScroll(8, 0.0f, 1.0f);
+    sampler.AddMouseScroll(9, 0.0f, 1.0f);
+
+    const InputFrame& frame = sampler.SampleFrame();
+
+    // The full resolution view has every sample of both devices in order
+    ASSERT_EQ(frame.samples.size(), 9u);
+    for (uint32_t i = 0; i < frame.samples.size(); ++i)
+    {
+        ASSERT_EQ(frame.samples[i].timestamp, (uint64_t)i + 1);
+    }
+
+    // The key was tapped within the frame
+    ASSERT_TRUE(frame.WasKeyPressed(KeyCode::A));
+    ASSERT_TRUE(frame.WasKeyReleased(KeyCode::A));
+    ASSERT_FALSE(frame.IsKeyDown(KeyCode::A));
+
+    ASSERT_EQ(frame.mouseX, 13.0f);
+    ASSERT_EQ(frame.mouseY, 17.0f);
+    ASSERT_EQ(frame.mouseDeltaX, 3.0f);
+    ASSERT_EQ(frame.mouseDeltaY, -3.0f);
+    ASSERT_EQ(frame.scrollY, 2.0f);
+    ASSERT_TRUE(frame.IsMouseButtonDown(MouseCode::ButtonLeft));
+    ASSERT_EQ(frame.lastTimestamp, 9u);
+}
+
+TEST(InputTest, StateCarriesOver)
+{
+    InputSampler sampler;
+
+    sampler.AddKey(1, KeyCode::W, true);
+    sampler.AddMouseMove(1, 5.0f, 5.0f);
+    sampler.SampleFrame();
+
+    // Key repeats of a held key are not a new press
+    sampler.AddKey(2, KeyCode::W, true);
+    const InputFrame& frame = sampler.SampleFrame();
+
+    ASSERT_TRUE(frame.IsKeyDown(KeyCode::W));
+    ASSERT_FALSE(frame.WasKeyPressed(KeyCode::W));
+    ASSERT_EQ(frame.mouseX, 5.0f);
+    ASSERT_EQ(frame.mouseDeltaX, 0.0f);
+
+    sampler.AddKey(3, KeyCode::W, false);
+    ASSERT_FALSE(sampler.SampleFrame().IsKeyDown(KeyCode::W));
+}
+
+TEST(InputTest, InjectedHighRateInput)
+{
+    // A synthetic 8 kHz mouse on a separate thread, while the main thread samples frames
+    constexpr uint32_t kSampleCount = 200000;
+
+    InputSampler sampler;
+    std::atomic<bool> done = false;
+
+    std::thread device([&]()
+    {
+        for (uint32_t i = 0; i < kSampleCount; ++i)
+        {
+            sampler.AddMouseDelta(i, 1.0f, 0.0f);
+        }
+
+        done = true;
+    });
+
+    double total_delta = 0.0;
+    uint64_t sample_count = 0;
+    uint64_t last_timestamp = 0;
+    bool ordered = true;
+
+    while (true)
+    {
+        bool finished = done.load();
+        const InputFrame& frame = sampler.SampleFrame();
+
+        for (const InputSample& sample : frame.samples)
+        {
+            ordered &= sample_count == 0 || sample.timestamp > last_timestamp;
+            last_timestamp = sample.timestamp;
+            sample_count++;
+        }
+
+        total_delta += frame.mouseDeltaX;
+
+        if (finished)
+        {
+            break;
+        }
+    }
+
+    device.join();
+
+    // Nothing is lost or reordered, except for the samples that did not fit while the reader was behind
+    ASSERT_TRUE(ordered);
+    ASSERT_EQ(sample_count + sampler.GetDroppedCount(), (uint64_t)kSampleCount);
+    ASSERT_EQ(total_delta, (double)sample_count);
+}
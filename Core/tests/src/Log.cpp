@@ -0,0 +1,156 @@
+#include <gtest/gtest.h>
+#include <RabBit/utils/debug/LogRing.h>
+
+using namespace RB;
+using namespace RB::Utils::Debug;
+
+namespace
+{
+    std::string FormatNext(LogRing& ring)
+    {
+        const LogRecord* record = ring.Peek();
+        if (!record)
+        {
+            return "(empty)";
+        }
+
+        char line[kLogMaxLineLength];
+        FormatLogMessage(*record, line, kLogMaxLineLength);
+        ring.Pop();
+
+        return line;
+    }
+
+    enum class TestEnum { A, B, C };
+}
+
+TEST(LogTest, FormatsPackedArguments)
+{
+    LogRing ring(kLogThreadRingSize);
+
+    // Strings are copied into the ring, the buffer can be reused right after the call
+    char name[16] = "Window";
+    ASSERT_TRUE(WriteLogRecord(ring, LogLevel::Normal, L"Test", nullptr, 0, "%s is %d x %u, %.2f%% (%llu bytes)", name, -5, 10u, 99.5f, 1ull << 40));
+    strcpy(name, "Overwritten");
+
+    ASSERT_TRUE(WriteLogRecord(ring, LogLevel::Normal, L"Test", nullptr, 0, "%ws: %05d|%-4d|%x|%c|%d", L"Wide", 42, 7, 255u, 'a', TestEnum::C));
+    ASSERT_TRUE(WriteLogRecord(ring, LogLevel::Normal, L"Test", nullptr, 0, "No arguments"));
+    ASSERT_TRUE(WriteLogRecord(ring, LogLevel::Normal, L"Test", nullptr, 0, "%s %d %d", (const char*)nullptr, 1));
+
+    ASSERT_EQ(FormatNext(ring), "Window is -5 x 10, 99.50% (1099511627776 bytes)");
+    ASSERT_EQ(FormatNext(ring), "Wide: 00042|7   |ff|a|2");
+    ASSERT_EQ(FormatNext(ring), "No arguments");
+    ASSERT_EQ(FormatNext(ring), "(null) 1 (missing)");
+    ASSERT_EQ(FormatNext(ring), "(empty)");
+}
+
+TEST(LogTest, FormatsRecordPrefix)
+{
+    LogRing ring(kLogThreadRingSize);
+
+    uint64_t start = GetLogTimestamp();
+    ASSERT_TRUE(WriteLogRecord(ring, LogLevel::Warn, L"Graphics", "Function", 12, "Value %d", 3));
+    ASSERT_TRUE(WriteLogRecord(ring, LogLevel::Normal, nullptr, nullptr, 0, "From the app"));
+
+    char line[kLogMaxLineLength];
+
+    FormatLogRecord(*ring.Peek(), start, line, kLogMaxLineLength);
+    ring.Pop();
+    ASSERT_TRUE(strstr(line, "] [RabBit-Graphics] [Function::12] Value 3") != nullptr);
+    ASSERT_EQ(line[0], '[');
+
+    FormatLogRecord(*ring.Peek(), start, line, kLogMaxLineLength);
+    ring.Pop();
+    ASSERT_TRUE(strstr(line, "] [App] From the app") != nullptr);
+
+    // Long lines are cut off
+    char long_string[kLogMaxStringLength * 2];
+    memset(long_string, 'x', sizeof(long_string) - 1);
+    long_string[sizeof(long_string) - 1] = 0;
+
+    ASSERT_TRUE(WriteLogRecord(ring, LogLevel::Normal, nullptr, nullptr, 0, "%s", long_string));
+
+    char short_line[64];
+    ASSERT_EQ(FormatLogRecord(*ring.Peek(), start, short_line, sizeof(short_line)), sizeof(short_line) - 1);
+    ASSERT_EQ(FormatLogMessage(*ring.Peek(), line, kLogMaxLineLength), kLogMaxStringLength);
+    ring.Pop();
+}
+
+TEST(LogTest, FullRingWrapsAround)
+{
+    LogRing ring(1024);
+
+    // Fill the ring, the writer has to wait for the reader
+    uint32_t written = 0;
+    while (WriteLogRecord(ring, LogLevel::Normal, nullptr, nullptr, 0, "Message %u", written))
+    {
+        written++;
+    }
+
+    ASSERT_TRUE(written > 0);
+
+    for (uint32_t i = 0; i < written; ++i)
+    {
+        ASSERT_EQ(FormatNext(ring), "Message " + std::to_string(i));
+    }
+
+    // Records are not split at the end of the ring
+    for (uint32_t i = 0; i < 100; ++i)
+    {
+        ASSERT_TRUE(WriteLogRecord(ring, LogLevel::Normal, nullptr, nullptr, 0, "%s %u", "Wrapping around", i));
+        ASSERT_EQ(FormatNext(ring), "Wrapping around " + std::to_string(i));
+    }
+
+    ASSERT_EQ(FormatNext(ring), "(empty)");
+}
+
+TEST(LogTest, ConcurrentReader)
+{
+    // A thread logging as fast as it can while another thread formats the messages, like the flush thread does
+    constexpr uint32_t kMessageCount = 200000;
+
+    LogRing ring(kLogThreadRingSize);
+    std::atomic<bool> done = false;
+    uint32_t formatted = 0;
+    bool in_order = true;
+
+    std::thread reader([&]()
+    {
+        char line[kLogMaxLineLength];
+
+        while (true)
+        {
+            bool finished = done.load();
+
+            while (const LogRecord* record = ring.Peek())
+            {
+                FormatLogMessage(*record, line, kLogMaxLineLength);
+                in_order &= std::to_string(formatted) + " on Main" == line;
+
+                ring.Pop();
+                formatted++;
+            }
+
+            if (finished)
+            {
+                break;
+            }
+
+            std::this_thread::yield();
+        }
+    });
+
+    for (uint32_t i = 0; i < kMessageCount; ++i)
+    {
+        while (!WriteLogRecord(ring, LogLevel::Normal, L"Test", nullptr, 0, "%u on %s", i, "Main"))
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    done = true;
+    reader.join();
+
+    ASSERT_EQ(formatted, kMessageCount);
+    ASSERT_TRUE(in_order);
+}
@@ -0,0 +1,202 @@
+#include <gtest/gtest.h>
+#include <RabBit/utils/debug/MemoryTracker.h>
+
+using namespace RB;
+using namespace RB::Utils::Debug;
+
+namespace
+{
+    // The tests only touch the Assets and Debug tags, so other allocations in the process do not get in the way
+    MemoryTagStats GetTagStats(MemoryTag tag)
+    {
+        return MemoryTracker::GetReport().tags[(uint32_t)tag];
+    }
+}
+
+TEST(MemoryTrackerTest, LiveAndPeakBytes)
+{
+    MemoryTagStats before = GetTagStats(MemoryTag::Assets);
+
+    void* first;
+    void* second;
+    {
+        MemoryTagScope scope(MemoryTag::Assets);
+        first  = MemoryTracker::Allocate(100);
+        second = MemoryTracker::Allocate(28);
+    }
+
+    ASSERT_EQ((uintptr_t)first % 16, 0u);
+    ASSERT_EQ(MemoryTracker::GetThreadTag(), MemoryTag::Untagged);
+
+    MemoryTagStats during = GetTagStats(MemoryTag::Assets);
+    ASSERT_EQ(during.liveBytes - before.liveBytes, 128u);
+    ASSERT_EQ(during.liveAllocations - before.liveAllocations, 2u);
+    ASSERT_EQ(during.totalAllocations - before.totalAllocations, 2u);
+
+    // Freeing does not need the tag, it is stored with the allocation
+    MemoryTracker::Free(first);
+    MemoryTracker::Free(second);
+
+    MemoryTagStats after = GetTagStats(MemoryTag::Assets);
+    ASSERT_EQ(after.liveBytes, before.liveBytes);
+    ASSERT_EQ(after.liveAllocations, before.liveAllocations);
+    ASSERT_EQ(after.totalBytes - before.totalBytes, 128u);
+    ASSERT_TRUE(after.peakBytes >= before.liveBytes + 128);
+}
+
+TEST(MemoryTrackerTest, NestedScopes)
+{
+    MemoryTagStats assets_before = GetTagStats(MemoryTag::Assets);
+    MemoryTagStats debug_before  = GetTagStats(MemoryTag::Debug);
+
+    void* outer;
+    void* inner;
+    {
+        MemoryTagScope assets(MemoryTag::Assets);
+        {
+            MemoryTagScope debug(MemoryTag::Debug);
+            inner = MemoryTracker::Allocate(16);
+        }
+        outer = MemoryTracker::Allocate(32);
+    }
+
+    ASSERT_EQ(GetTagStats(MemoryTag::Assets).liveBytes - assets_before.liveBytes, 32u);
+    ASSERT_EQ(GetTagStats(MemoryTag::Debug).liveBytes - debug_before.liveBytes, 16u);
+
+    MemoryTracker::Free(outer);
+    MemoryTracker::Free(inner);
+}
+
+TEST(MemoryTrackerTest, FrameAllocations)
+{
+    // Twice, so the allocations of the earlier tests are out of the last frame as well
+    MemoryTracker::EndFrame();
+    MemoryTracker::EndFrame();
+
+    {
+        MemoryTagScope scope(MemoryTag::Assets);
+        for (uint32_t i = 0; i < 10; ++i)
+        {
+            MemoryTracker::Free(MemoryTracker::Allocate(64));
+        }
+    }
+
+    // Only visible once the frame has ended
+    ASSERT_EQ(GetTagStats(MemoryTag::Assets).frameAllocations, 0u);
+
+    MemoryTracker::EndFrame();
+
+    MemoryTagStats stats = GetTagStats(MemoryTag::Assets);
+    ASSERT_EQ(stats.frameAllocations, 10u);
+    ASSERT_EQ(stats.frameBytes, 640u);
+
+    MemoryTracker::EndFrame();
+    ASSERT_EQ(GetTagStats(MemoryTag::Assets).frameAllocations, 0u);
+}
+
+TEST(MemoryTrackerTest, DumpLeaks)
+{
+    uint64_t first_allocation = MemoryTracker::GetNextAllocationId();
+    // Blocks of the pools that are handed out (e.g. components) are always part of the dump
+    uint64_t pool_blocks = MemoryTracker::GetReport().total.pooledAllocations;
+
+    void* leaked;
+    void* debug;
+    void* freed;
+    {
+        MemoryTagScope scope(MemoryTag::Assets);
+        leaked = MemoryTracker::Allocate(8);
+        freed  = MemoryTracker::Allocate(8);
+    }
+    {
+        // Debug allocations live until the process exits, they are not reported
+        MemoryTagScope scope(MemoryTag::Debug);
+        debug = MemoryTracker::Allocate(8);
+    }
+
+    MemoryTracker::Free(freed);
+
+    ASSERT_EQ(MemoryTracker::DumpLeaks(first_allocation), pool_blocks + 1);
+    ASSERT_EQ(MemoryTracker::DumpLeaks(MemoryTracker::GetNextAllocationId()), pool_blocks);
+
+    MemoryTracker::Free(leaked);
+    MemoryTracker::Free(debug);
+
+    ASSERT_EQ(MemoryTracker::DumpLeaks(first_allocation), pool_blocks);
+}
+
+#ifdef RB_ENABLE_MEMORY_TRACKING
+TEST(MemoryTrackerTest, PoolBlocks)
+{
+    MemoryTagStats before = GetTagStats(MemoryTag::Assets);
+    uint64_t pool_blocks = MemoryTracker::GetReport().total.pooledAllocations;
+
+    {
+        PoolAllocator pool(64, 16, MemoryTag::Assets);
+
+        void* blocks[3];
+        for (void*& block : blocks)
+        {
+            block = pool.Allocate();
+        }
+
+        // Counted under the tag of the pool instead of under Pools
+        MemoryTagStats during = GetTagStats(MemoryTag::Assets);
+        ASSERT_EQ(during.liveBytes - before.liveBytes, 3 * 64u);
+        ASSERT_EQ(during.liveAllocations - before.liveAllocations, 3u);
+        ASSERT_EQ(during.pooledAllocations - before.pooledAllocations, 3u);
+
+        // The blocks have no allocation id, so they are leaks no matter where the dump starts
+        ASSERT_EQ(MemoryTracker::DumpLeaks(MemoryTracker::GetNextAllocationId()), pool_blocks + 3);
+
+        pool.Free(blocks[0]);
+        ASSERT_EQ(GetTagStats(MemoryTag::Assets).pooledAllocations - before.pooledAllocations, 2u);
+    }
+
+    // The blocks that were not freed are gone with the pool
+    MemoryTagStats after = GetTagStats(MemoryTag::Assets);
+    ASSERT_EQ(after.liveBytes, before.liveBytes);
+    ASSERT_EQ(after.liveAllocations, before.liveAllocations);
+    ASSERT_EQ(after.pooledAllocations, before.pooledAllocations);
+    ASSERT_EQ(after.totalAllocations - before.totalAllocations, 3u);
+}
+#endif
+
+TEST(MemoryTrackerTest, ConcurrentAllocations)
+{
+    constexpr uint32_t kThreadCount = 4;
+    constexpr uint32_t kAllocationCount = 10000;
+
+    MemoryTagStats before = GetTagStats(MemoryTag::Assets);
+
+    List<std::thread> threads;
+    for (uint32_t i = 0; i < kThreadCount; ++i)
+    {
+        threads.emplace_back([]()
+        {
+            MemoryTagScope scope(MemoryTag::Assets);
+
+            void* memory[8] = {};
+            for (uint32_t j = 0; j < kAllocationCount; ++j)
+            {
+                MemoryTracker::Free(memory[j % 8]);
+                memory[j % 8] = MemoryTracker::Allocate(j % 100 + 1);
+            }
+
+            for (void* m : memory)
+            {
+                MemoryTracker::Free(m);
+            }
+        });
+    }
+
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    MemoryTagStats after = GetTagStats(MemoryTag::Assets);
+    ASSERT_EQ(after.liveBytes, before.liveBytes);
+    ASSERT_EQ(after.liveAllocations, before.liveAllocations);
+    ASSERT_EQ(after.totalAllocations - before.totalAllocations, (uint64_t)kThreadCount * kAllocationCount);
+}
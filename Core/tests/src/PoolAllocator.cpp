@@ -0,0 +1,234 @@
+#include <gtest/gtest.h>
+#include <RabBit/utils/Threading.h>
+
+using namespace RB;
+
+TEST(PoolAllocatorTest, AllocateAndFree)
+{
+    PoolAllocator pool(40, 8);
+    ASSERT_EQ(pool.GetBlockSize(), 48u);
+
+    void* blocks[20];
+    for (void*& block : blocks)
+    {
+        block = pool.Allocate();
+        ASSERT_EQ((uintptr_t)block % kPoolBlockAlignment, 0u);
+    }
+
+    for (uint32_t i = 0; i < 20; ++i)
+    {
+        for (uint32_t j = i + 1; j < 20; ++j)
+        {
+            ASSERT_TRUE(blocks[i] != blocks[j]);
+        }
+    }
+
+    PoolAllocatorStats stats = pool.GetStats();
+    ASSERT_EQ(stats.pageCount, 3u);
+    ASSERT_EQ(stats.heapAllocations, 3u);
+
+    // The block that was freed last comes back first, it is the most likely to still be in the CPU cache
+    pool.Free(blocks[5]);
+    ASSERT_EQ(pool.Allocate(), blocks[5]);
+
+    for (void* block : blocks)
+    {
+        pool.Free(block);
+    }
+
+    // Some blocks stay in the cache of this thread
+    ASSERT_TRUE(pool.GetStats().usedBlocks <= kPoolThreadCacheSize);
+    ASSERT_EQ(pool.GetStats().pageCount, 3u);
+}
+
+TEST(PoolAllocatorTest, ThreadCachesAvoidTheLock)
+{
+    constexpr uint32_t kRounds = 10000;
+
+    PoolAllocator pool(64);
+
+    void* blocks[8];
+    for (uint32_t i = 0; i < kRounds; ++i)
+    {
+        for (void*& block : blocks)
+        {
+            block = pool.Allocate();
+        }
+
+        for (void* block : blocks)
+        {
+            pool.Free(block);
+        }
+    }
+
+    // Only the first allocation had to go to the shared free list
+    ASSERT_EQ(pool.GetStats().lockCount, 1u);
+}
+
+TEST(PoolAllocatorTest, FreeOnOtherThread)
+{
+    constexpr uint32_t kBlockCount = 100000;
+
+    PoolAllocator pool(32);
+
+    // Like job data: made by one thread, deleted by another
+    std::atomic<void*> handoff[64] = {};
+    uint32_t errors = 0;
+
+    std::thread producer([&]()
+    {
+        for (uint32_t i = 0; i < kBlockCount; ++i)
+        {
+            uint32_t* block = (uint32_t*)pool.Allocate();
+            *block = i;
+
+            while (handoff[i % 64].load(std::memory_order_acquire) != nullptr)
+            {
+                std::this_thread::yield();
+            }
+
+            handoff[i % 64].store(block, std::memory_order_release);
+        }
+    });
+
+    std::thread consumer([&]()
+    {
+        for (uint32_t i = 0; i < kBlockCount; ++i)
+        {
+            void* block;
+            while ((block = handoff[i % 64].load(std::memory_order_acquire)) == nullptr)
+            {
+                std::this_thread::yield();
+            }
+
+            if (*(uint32_t*)block != i)
+            {
+                errors++;
+            }
+
+            handoff[i % 64].store(nullptr, std::memory_order_release);
+            pool.Free(block);
+        }
+    });
+
+    producer.join();
+    consumer.join();
+
+    ASSERT_EQ(errors, 0u);
+
+    // The threads gave their cached blocks back when they exited
+    PoolAllocatorStats stats = pool.GetStats();
+    ASSERT_EQ(stats.usedBlocks, 0u);
+    ASSERT_TRUE(stats.lockCount < kBlockCount / 4);
+}
+
+TEST(PoolAllocatorTest, FreeAll)
+{
+    PoolAllocator pool(16, 64);
+
+    for (uint32_t i = 0; i < 1000; ++i)
+    {
+        pool.Allocate();
+    }
+
+    uint64_t page_count = pool.GetStats().pageCount;
+
+    pool.FreeAll();
+    ASSERT_EQ(pool.GetStats().usedBlocks, 0u);
+
+    // The pages are reused
+    for (uint32_t i = 0; i < 1000; ++i)
+    {
+        pool.Allocate();
+    }
+
+    ASSERT_EQ(pool.GetStats().pageCount, page_count);
+}
+
+#ifdef RB_ENABLE_ASSERTS
+TEST(PoolAllocatorTest, Poisoning)
+{
+    PoolAllocator pool(64);
+
+    uint8_t* block = (uint8_t*)pool.Allocate();
+    ASSERT_EQ(block[63], 0xCD);
+
+    pool.Free(block);
+    ASSERT_EQ(block[8], 0xDD);
+    ASSERT_EQ(block[63], 0xDD);
+}
+#endif
+
+TEST(PoolAllocatorTest, ObjectPool)
+{
+    struct Counted
+    {
+        Counted(int* c) : counter(c) { (*counter)++; }
+        ~Counted() { (*counter)--; }
+
+        int* counter;
+    };
+
+    int alive = 0;
+    ObjectPool<Counted> pool;
+
+    Counted* a = pool.New(&alive);
+    Counted* b = pool.New(&alive);
+    ASSERT_EQ(alive, 2);
+
+    pool.Delete(a);
+    pool.Delete(b);
+    pool.Delete(nullptr);
+    ASSERT_EQ(alive, 0);
+}
+
+TEST(SlabAllocatorTest, SizeClasses)
+{
+    SlabAllocator slab(128);
+
+    void* small = slab.Allocate(1);
+    void* medium = slab.Allocate(100);
+    void* large = slab.Allocate(1000);
+
+    memset(small, 1, 1);
+    memset(medium, 2, 100);
+    memset(large, 3, 1000);
+
+    PoolAllocatorStats stats = slab.GetStats();
+    ASSERT_EQ(stats.pageCount, 2u);
+    ASSERT_EQ(stats.heapAllocations, 3u);
+
+    slab.Free(small, 1);
+    slab.Free(medium, 100);
+    slab.Free(large, 1000);
+
+    // Blocks of the same size class are reused, also for a different size
+    ASSERT_EQ(slab.Allocate(112), medium);
+}
+
+TEST(SlabAllocatorTest, JobData)
+{
+    struct Data : JobData
+    {
+        uint64_t values[10];
+    };
+
+    uint64_t used = GetJobDataSlab().GetStats().usedBlocks;
+
+    // Enough to need blocks from the shared free list, not only from the thread cache
+    List<Data*> data;
+    for (uint32_t i = 0; i < 100; ++i)
+    {
+        data.push_back(new Data());
+    }
+
+    ASSERT_TRUE(GetJobDataSlab().GetStats().usedBlocks > used);
+
+    for (Data* d : data)
+    {
+        JobData* base = d;
+        SAFE_DELETE(base);
+    }
+
+    ASSERT_TRUE(GetJobDataSlab().GetStats().usedBlocks <= used + kPoolThreadCacheSize);
+}
@@ -0,0 +1,130 @@
+#include <gtest/gtest.h>
+#include <RabBit/utils/debug/Profiler.h>
+
+using namespace RB;
+using namespace RB::Utils::Debug;
+
+namespace
+{
+    const ProfileThreadCapture* FindThread(const ProfileCapture& capture, const char* name)
+    {
+        for (const ProfileThreadCapture& thread : capture.threads)
+        {
+            if (thread.name == name)
+            {
+                return &thread;
+            }
+        }
+
+        return nullptr;
+    }
+}
+
+TEST(ProfilerTest, RingDropsWhenFull)
+{
+    ProfileZoneRing ring(4);
+
+    for (uint32_t i = 0; i < 6; ++i)
+    {
+        ring.Push({ "Zone", i, i + 1, 0 });
+    }
+
+    ASSERT_EQ(ring.GetDroppedCount(), 2u);
+
+    List<ProfileZone> zones;
+    ASSERT_EQ(ring.PopAll(zones), 4u);
+    ASSERT_EQ(zones[3].start, 3u);
+
+    ASSERT_TRUE(ring.Push({ "Zone", 10, 11, 0 }));
+}
+
+TEST(ProfilerTest, NestedZones)
+{
+    Profiler::SetThreadName("Test Main");
+
+    // Nothing is recorded outside of a capture
+    {
+        ProfileCpuScoped zone("Before");
+    }
+
+    Profiler::BeginCapture();
+
+    {
+        ProfileCpuScoped frame("Frame");
+
+        {
+            ProfileCpuScoped update("Update");
+            ProfileCpuScoped inner("Inner");
+        }
+
+        ProfileCpuScoped submit("Submit");
+    }
+
+    std::thread worker([]()
+    {
+        Profiler::SetThreadName(L"Test Worker");
+
+        for (uint32_t i = 0; i < 3; ++i)
+        {
+            ProfileCpuScoped job("Job");
+        }
+    });
+    worker.join();
+
+    Profiler::Collect();
+
+    {
+        ProfileCpuScoped after_collect("After collect");
+    }
+
+    ProfileCapture capture = Profiler::EndCapture();
+
+    const ProfileThreadCapture* main_thread = FindThread(capture, "Test Main");
+    ASSERT_TRUE(main_thread != nullptr);
+    ASSERT_EQ(main_thread->zones.size(), 5u);
+    ASSERT_EQ(main_thread->droppedCount, 0u);
+
+    // Ordered by start time, parents before their children
+    const List<ProfileZone>& zones = main_thread->zones;
+    ASSERT_STREQ(zones[0].name, "Frame");
+    ASSERT_STREQ(zones[1].name, "Update");
+    ASSERT_STREQ(zones[2].name, "Inner");
+    ASSERT_STREQ(zones[3].name, "Submit");
+    ASSERT_STREQ(zones[4].name, "After collect");
+
+    ASSERT_EQ(zones[0].depth, 0u);
+    ASSERT_EQ(zones[1].depth, 1u);
+    ASSERT_EQ(zones[2].depth, 2u);
+    ASSERT_EQ(zones[3].depth, 1u);
+
+    for (uint32_t i = 1; i < 4; ++i)
+    {
+        ASSERT_TRUE(zones[i].start >= zones[0].start && zones[i].end <= zones[0].end);
+    }
+
+    const ProfileThreadCapture* worker_thread = FindThread(capture, "Test Worker");
+    ASSERT_TRUE(worker_thread != nullptr);
+    ASSERT_EQ(worker_thread->zones.size(), 3u);
+    ASSERT_NE(worker_thread->id, main_thread->id);
+
+    // The next capture starts empty
+    Profiler::BeginCapture();
+    capture = Profiler::EndCapture();
+    ASSERT_EQ(FindThread(capture, "Test Main")->zones.size(), 0u);
+}
+
+TEST(ProfilerTest, ChromeTrace)
+{
+    ProfileCapture capture;
+    capture.start = 1000;
+    capture.end   = 100000;
+    capture.threads.push_back({ 3, "Render \"Thread\"", { { "Pass", 2000, 4500, 0 } }, 0 });
+
+    std::string json;
+    Profiler::WriteChromeTrace(capture, json);
+
+    ASSERT_TRUE(json.find("\"traceEvents\":[") != std::string::npos);
+    ASSERT_TRUE(json.find("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":3,\"args\":{\"name\":\"Render \\\"Thread\\\"\"}}") != std::string::npos);
+    ASSERT_TRUE(json.find("{\"name\":\"Pass\",\"cat\":\"cpu\",\"ph\":\"X\",\"ts\":1.000,\"dur\":2.500,\"pid\":1,\"tid\":3}") != std::string::npos);
+    ASSERT_EQ(json.substr(json.size() - 4), "\n]}\n");
+}
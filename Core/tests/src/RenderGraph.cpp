@@ -0,0 +1,327 @@
+#include <gtest/gtest.h>
+#include <RabBit/graphics/RenderGraphBarriers.h>
+#include <RabBit/graphics/RenderGraphScheduler.h>
+#include <RabBit/graphics/RenderTexturePool.h>
+
+using namespace RB;
+using namespace RB::Graphics;
+
+static bool HasBarrier(const BarrierBoundary& boundary, ResourceID resource, ResourceState state, BarrierSplit split)
+{
+    for (const PlannedBarrier& barrier : boundary.barriers)
+    {
+        if (barrier.resource == resource && barrier.state == state && barrier.split == split)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static bool HasBarrier(const BarrierBoundary& boundary, ResourceID resource)
+{
+    for (const PlannedBarrier& barrier : boundary.barriers)
+    {
+        if (barrier.resource == resource)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static List<ScheduledPass> GraphicsOnly(uint32_t pass_count)
+{
+    return List<ScheduledPass>(pass_count, { RenderQueueType::Graphics, -1, false });
+}
+
+TEST(RenderGraphTest, BarrierPlanDirectDependency)
+{
+    // Pass 0 writes resource 0, pass 1 reads it
+    List<List<PassResourceUsage>> usages =
+    {
+        { { 0, ResourceState::RENDER_TARGET } },
+        { { 0, ResourceState::PIXEL_SHADER_RESOURCE }, { 1, ResourceState::UNORDERED_ACCESS } },
+    };
+
+    List<BarrierBoundary> plan;
+    BuildBarrierPlan(usages, GraphicsOnly(usages.size()), plan);
+
+    ASSERT_EQ(plan.size(), 2);
+
+    ASSERT_EQ(plan[0].barriers.size(), 2);
+    ASSERT_TRUE(HasBarrier(plan[0], 0, ResourceState::RENDER_TARGET, BarrierSplit::None));
+    ASSERT_TRUE(HasBarrier(plan[0], 1, ResourceState::UNORDERED_ACCESS, BarrierSplit::Begin));
+
+    ASSERT_EQ(plan[1].barriers.size(), 2);
+    ASSERT_TRUE(HasBarrier(plan[1], 0, ResourceState::PIXEL_SHADER_RESOURCE, BarrierSplit::None));
+    ASSERT_TRUE(HasBarrier(plan[1], 1, ResourceState::UNORDERED_ACCESS, BarrierSplit::End));
+}
+
+TEST(RenderGraphTest, BarrierPlanSplitOverGap)
+{
+    // Pass 1 does not touch resource 0, so its transition to a shader resource is split around it
+    List<List<PassResourceUsage>> usages =
+    {
+        { { 0, ResourceState::RENDER_TARGET } },
+        { { 1, ResourceState::DEPTH_WRITE } },
+        { { 0, ResourceState::PIXEL_SHADER_RESOURCE }, { 1, ResourceState::PIXEL_SHADER_RESOURCE } },
+    };
+
+    List<BarrierBoundary> plan;
+    BuildBarrierPlan(usages, GraphicsOnly(usages.size()), plan);
+
+    ASSERT_EQ(plan.size(), 3);
+
+    ASSERT_EQ(plan[0].barriers.size(), 2);
+    ASSERT_TRUE(HasBarrier(plan[0], 0, ResourceState::RENDER_TARGET, BarrierSplit::None));
+    ASSERT_TRUE(HasBarrier(plan[0], 1, ResourceState::DEPTH_WRITE, BarrierSplit::Begin));
+
+    ASSERT_EQ(plan[1].barriers.size(), 2);
+    ASSERT_TRUE(HasBarrier(plan[1], 0, ResourceState::PIXEL_SHADER_RESOURCE, BarrierSplit::Begin));
+    ASSERT_TRUE(HasBarrier(plan[1], 1, ResourceState::DEPTH_WRITE, BarrierSplit::End));
+
+    ASSERT_EQ(plan[2].barriers.size(), 2);
+    ASSERT_TRUE(HasBarrier(plan[2], 0, ResourceState::PIXEL_SHADER_RESOURCE, BarrierSplit::End));
+    ASSERT_TRUE(HasBarrier(plan[2], 1, ResourceState::PIXEL_SHADER_RESOURCE, BarrierSplit::None));
+}
+
+TEST(RenderGraphTest, BarrierPlanSkipsSameState)
+{
+    List<List<PassResourceUsage>> usages =
+    {
+        { { 0, ResourceState::PIXEL_SHADER_RESOURCE } },
+        { { 0, ResourceState::PIXEL_SHADER_RESOURCE } },
+        { { 0, ResourceState::PIXEL_SHADER_RESOURCE } },
+    };
+
+    List<BarrierBoundary> plan;
+    BuildBarrierPlan(usages, GraphicsOnly(usages.size()), plan);
+
+    ASSERT_EQ(plan.size(), 3);
+    ASSERT_EQ(plan[0].barriers.size(), 1);
+    ASSERT_TRUE(plan[1].barriers.empty());
+    ASSERT_TRUE(plan[2].barriers.empty());
+}
+
+TEST(RenderGraphTest, BarrierPlanWaitsForCompute)
+{
+    // 0: Graphics writes 0
+    // 1: Compute reads 0, writes 1
+    // 2: Graphics writes 2 (independent of the compute pass)
+    // 3: Graphics reads 1 & 2
+    List<PassScheduleDesc> passes =
+    {
+        { false, {},        { 0 } },
+        { true,  { 0 },     { 1 } },
+        { false, {},        { 2 } },
+        { false, { 1, 2 },  { 3 } },
+    };
+
+    List<List<PassResourceUsage>> usages =
+    {
+        { { 0, ResourceState::RENDER_TARGET } },
+        { { 0, ResourceState::NON_PIXEL_SHADER_RESOURCE }, { 1, ResourceState::UNORDERED_ACCESS } },
+        { { 2, ResourceState::RENDER_TARGET } },
+        { { 1, ResourceState::PIXEL_SHADER_RESOURCE }, { 2, ResourceState::PIXEL_SHADER_RESOURCE } },
+    };
+
+    List<ScheduledPass> schedule;
+    BuildQueueSchedule(passes, schedule);
+
+    List<BarrierBoundary> plan;
+    BuildBarrierPlan(usages, schedule, plan);
+
+    ASSERT_EQ(schedule[1].queue, RenderQueueType::Compute);
+    ASSERT_EQ(schedule[3].waitForPass, 1);
+
+    // The compute queue can still be writing resource 1 during pass 2, so the transition is not split over it
+    ASSERT_FALSE(HasBarrier(plan[2], 1));
+    ASSERT_EQ(plan[2].joinComputePass, -1);
+
+    // Only after the graphics queue waited on the compute pass
+    ASSERT_EQ(plan[3].joinComputePass, 1);
+    ASSERT_TRUE(HasBarrier(plan[3], 1, ResourceState::PIXEL_SHADER_RESOURCE, BarrierSplit::None));
+}
+
+TEST(RenderGraphTest, BarrierPlanJoinsComputeWithoutWait)
+{
+    // Two compute passes after each other do not wait on each other, but the transition between them is recorded on the graphics queue
+    List<PassScheduleDesc> passes =
+    {
+        { false, {},        { 0 } },
+        { true,  {},        { 1 } },
+        { true,  { 1 },     { 2 } },
+        { false, { 0, 2 },  { 3 } },
+    };
+
+    List<List<PassResourceUsage>> usages =
+    {
+        { { 0, ResourceState::RENDER_TARGET } },
+        { { 1, ResourceState::UNORDERED_ACCESS } },
+        { { 1, ResourceState::NON_PIXEL_SHADER_RESOURCE }, { 2, ResourceState::UNORDERED_ACCESS } },
+        { { 0, ResourceState::PIXEL_SHADER_RESOURCE }, { 2, ResourceState::PIXEL_SHADER_RESOURCE } },
+    };
+
+    List<ScheduledPass> schedule;
+    BuildQueueSchedule(passes, schedule);
+
+    List<BarrierBoundary> plan;
+    BuildBarrierPlan(usages, schedule, plan);
+
+    ASSERT_EQ(schedule[2].queue, RenderQueueType::Compute);
+    ASSERT_EQ(schedule[2].waitForPass, -1);
+
+    ASSERT_EQ(plan[2].joinComputePass, 1);
+    ASSERT_TRUE(HasBarrier(plan[2], 1, ResourceState::NON_PIXEL_SHADER_RESOURCE, BarrierSplit::None));
+
+    // Graphics transitions are still split over the compute passes
+    ASSERT_TRUE(HasBarrier(plan[1], 0, ResourceState::PIXEL_SHADER_RESOURCE, BarrierSplit::Begin));
+    ASSERT_EQ(plan[3].joinComputePass, 2);
+}
+
+TEST(RenderGraphTest, ScheduleOverlapsIndependentWork)
+{
+    // 0: Graphics writes 0
+    // 1: Compute reads 0, writes 1
+    // 2: Graphics writes 2 (independent of the compute pass)
+    // 3: Graphics reads 1 & 2
+    List<PassScheduleDesc> passes =
+    {
+        { false, {},     { 0 } },
+        { true,  { 0 },  { 1 } },
+        { false, {},     { 2 } },
+        { false, { 1, 2 }, { 3 } },
+    };
+
+    List<ScheduledPass> schedule;
+    BuildQueueSchedule(passes, schedule);
+
+    ASSERT_EQ(schedule.size(), 4);
+
+    ASSERT_EQ(schedule[0].queue, RenderQueueType::Graphics);
+    ASSERT_TRUE(schedule[0].signal);
+
+    ASSERT_EQ(schedule[1].queue, RenderQueueType::Compute);
+    ASSERT_EQ(schedule[1].waitForPass, 0);
+    ASSERT_TRUE(schedule[1].signal);
+
+    // Does not depend on the compute pass, so it can overlap with it
+    ASSERT_EQ(schedule[2].queue, RenderQueueType::Graphics);
+    ASSERT_EQ(schedule[2].waitForPass, -1);
+    ASSERT_FALSE(schedule[2].signal);
+
+    ASSERT_EQ(schedule[3].queue, RenderQueueType::Graphics);
+    ASSERT_EQ(schedule[3].waitForPass, 1);
+}
+
+TEST(RenderGraphTest, ScheduleSkipsCoveredWaits)
+{
+    // Both compute passes depend on pass 0, but the second one is already covered by the wait of the first one
+    List<PassScheduleDesc> passes =
+    {
+        { false, {},        { 0 } },
+        { true,  { 0 },     { 1 } },
+        { true,  { 0 },     { 2 } },
+        { false, { 1, 2 },  { 3 } },
+    };
+
+    List<ScheduledPass> schedule;
+    BuildQueueSchedule(passes, schedule);
+
+    ASSERT_EQ(schedule[1].waitForPass, 0);
+    ASSERT_EQ(schedule[2].waitForPass, -1);
+
+    // Waiting on the last compute pass also covers the first one
+    ASSERT_EQ(schedule[3].waitForPass, 2);
+    ASSERT_FALSE(schedule[1].signal);
+    ASSERT_TRUE(schedule[2].signal);
+}
+
+TEST(RenderGraphTest, ScheduleWriteAfterRead)
+{
+    // The graphics pass overwrites a resource the compute pass is still reading
+    List<PassScheduleDesc> passes =
+    {
+        { false, {},     { 0 } },
+        { true,  { 0 },  { 1 } },
+        { false, {},     { 0 } },
+        { true,  { 1 },  { 2 } }, // Last pass always stays on the graphics queue
+    };
+
+    List<ScheduledPass> schedule;
+    BuildQueueSchedule(passes, schedule);
+
+    ASSERT_EQ(schedule[2].queue, RenderQueueType::Graphics);
+    ASSERT_EQ(schedule[2].waitForPass, 1);
+
+    ASSERT_EQ(schedule[3].queue, RenderQueueType::Graphics);
+    ASSERT_EQ(schedule[3].waitForPass, -1);
+}
+
+TEST(RenderGraphTest, ClearPlanSkipsOverwrittenResources)
+{
+    // Like the GBuffer and deferred lighting passes: resource 1 is lit by a fullscreen dispatch and 2 aliases a texture that requires a clear
+    List<List<PassResourceTouch>> touches =
+    {
+        { { 0, false }, { 1, false } },
+        { { 0, false }, { 2, true } },
+        { { 2, false }, { 3, true }, { 4, false } },
+    };
+
+    // Every resource except 3 asked for a clear before the graph
+    List<ResourceID> clears;
+    BuildClearList(touches, [](ResourceID id) { return id != 3; }, clears);
+
+    // Only the first touch counts, 2 is fully overwritten before it is read
+    ASSERT_EQ(clears.size(), 3);
+    ASSERT_EQ(clears[0], 0);
+    ASSERT_EQ(clears[1], 1);
+    ASSERT_EQ(clears[2], 4);
+
+    // The same resource is kept when the first pass does not write all of it
+    touches[1][1].fullyOverwritten = false;
+    BuildClearList(touches, [](ResourceID id) { return id != 3; }, clears);
+
+    ASSERT_EQ(clears.size(), 4);
+    ASSERT_EQ(clears[2], 2);
+}
+
+TEST(RenderGraphTest, TexturePoolBucketSizes)
+{
+    ASSERT_EQ(GetBucketedTextureSize(1), kRenderTexturePoolBucketSize);
+    ASSERT_EQ(GetBucketedTextureSize(kRenderTexturePoolBucketSize), kRenderTexturePoolBucketSize);
+    ASSERT_EQ(GetBucketedTextureSize(kRenderTexturePoolBucketSize + 1), kRenderTexturePoolBucketSize * 2);
+    ASSERT_EQ(GetBucketedTextureSize(1920), 1920u);
+    ASSERT_EQ(GetBucketedTextureSize(1080), 1088u);
+}
+
+TEST(RenderGraphTest, TexturePoolReuse)
+{
+    PooledTextureDesc pooled = { RenderResourceFormat::R32G32B32A32_FLOAT, 1920, 1088, true, false };
+
+    // Small resizes keep using the same texture
+    PooledTextureDesc requested = { RenderResourceFormat::R32G32B32A32_FLOAT, 1900, 1070, true, false };
+    ASSERT_TRUE(IsPooledTextureReusable(pooled, requested));
+
+    // Too big
+    requested.width = 1921;
+    ASSERT_FALSE(IsPooledTextureReusable(pooled, requested));
+
+    // Too much wasted memory
+    requested.width  = 800;
+    requested.height = 600;
+    ASSERT_FALSE(IsPooledTextureReusable(pooled, requested));
+
+    // Different usage
+    requested.width         = 1920;
+    requested.height        = 1080;
+    requested.renderTarget  = false;
+    ASSERT_FALSE(IsPooledTextureReusable(pooled, requested));
+
+    requested.renderTarget  = true;
+    requested.format        = RenderResourceFormat::D32_FLOAT;
+    ASSERT_FALSE(IsPooledTextureReusable(pooled, requested));
+}
@@ -0,0 +1,138 @@
+#include <gtest/gtest.h>
+#include <RabBit/graphics/RetirementRing.h>
+
+using namespace RB;
+using namespace RB::Graphics;
+
+// Stands in for the fence of a queue, the GPU finishes the submissions whenever the test completes them
+struct FakeFence
+{
+    uint64_t signaled = 0;
+    uint64_t completed = 0;
+
+    uint64_t Signal() { return ++signaled; }
+};
+
+TEST(RetirementRingTest, RetireInOrder)
+{
+    RetirementRing ring;
+    FakeFence fence;
+    List<uint32_t> retired;
+
+    ring.Add(ring.GetOpenSubmission(), 1);
+    ring.Add(ring.GetOpenSubmission(), 2);
+    ring.Submit(fence.Signal());
+
+    ring.Add(ring.GetOpenSubmission(), 3);
+    ring.Submit(fence.Signal());
+
+    ASSERT_EQ(ring.GetInFlightCount(), 2u);
+    ASSERT_EQ(ring.GetItemCount(), 3u);
+
+    // Nothing is done yet
+    ring.Retire(fence.completed, retired);
+    ASSERT_EQ(retired.size(), 0u);
+
+    fence.completed = 1;
+    ring.Retire(fence.completed, retired);
+    ASSERT_EQ(retired.size(), 2u);
+    ASSERT_EQ(retired[0], 1u);
+    ASSERT_EQ(retired[1], 2u);
+
+    fence.completed = 2;
+    ring.Retire(fence.completed, retired);
+    ASSERT_EQ(retired.size(), 3u);
+    ASSERT_EQ(retired[2], 3u);
+    ASSERT_EQ(ring.GetInFlightCount(), 0u);
+    ASSERT_EQ(ring.GetItemCount(), 0u);
+}
+
+TEST(RetirementRingTest, OpenSubmissionIsNotRetired)
+{
+    RetirementRing ring;
+    FakeFence fence;
+    List<uint32_t> retired;
+
+    uint64_t open = ring.GetOpenSubmission();
+    ring.Add(open, 7);
+
+    // The GPU can be idle, the item still waits for the work that is being recorded
+    ring.Retire(UINT64_MAX, retired);
+    ASSERT_EQ(retired.size(), 0u);
+    ASSERT_FALSE(ring.IsRetired(open));
+
+    ring.Submit(fence.Signal());
+    fence.completed = fence.signaled;
+    ring.Retire(fence.completed, retired);
+
+    ASSERT_EQ(retired.size(), 1u);
+    ASSERT_TRUE(ring.IsRetired(open));
+}
+
+TEST(RetirementRingTest, AddToInFlightSubmission)
+{
+    RetirementRing ring;
+    FakeFence fence;
+    List<uint32_t> retired;
+
+    // A resource used in the first submission is deleted while the second one is executing
+    uint64_t first = ring.GetOpenSubmission();
+    ring.Submit(fence.Signal());
+    ring.Submit(fence.Signal());
+
+    ring.Add(first, 42);
+
+    fence.completed = 1;
+    ring.Retire(fence.completed, retired);
+
+    // Released with the first submission, without waiting on the second one
+    ASSERT_EQ(retired.size(), 1u);
+    ASSERT_EQ(retired[0], 42u);
+    ASSERT_EQ(ring.GetInFlightCount(), 1u);
+}
+
+TEST(RetirementRingTest, GrowsWhenTheGpuFallsBehind)
+{
+    RetirementRing ring(2);
+    FakeFence fence;
+    List<uint32_t> retired;
+
+    for (uint32_t i = 0; i < 100; ++i)
+    {
+        ring.Add(ring.GetOpenSubmission(), i);
+        ring.Submit(fence.Signal());
+
+        // Retire a bit every now and then, so the ring also wraps around
+        if (i % 7 == 6)
+        {
+            fence.completed = fence.signaled - 3;
+            ring.Retire(fence.completed, retired);
+        }
+    }
+
+    fence.completed = fence.signaled;
+    ring.Retire(fence.completed, retired);
+
+    ASSERT_EQ(retired.size(), 100u);
+    for (uint32_t i = 0; i < 100; ++i)
+    {
+        ASSERT_EQ(retired[i], i);
+    }
+}
+
+TEST(RetirementRingTest, RetireAll)
+{
+    RetirementRing ring;
+    FakeFence fence;
+    List<uint32_t> retired;
+
+    ring.Add(ring.GetOpenSubmission(), 1);
+    ring.Submit(fence.Signal());
+    ring.Add(ring.GetOpenSubmission(), 2);
+
+    ring.RetireAll(retired);
+
+    ASSERT_EQ(retired.size(), 2u);
+    ASSERT_EQ(ring.GetItemCount(), 0u);
+    ASSERT_EQ(ring.GetInFlightCount(), 0u);
+}
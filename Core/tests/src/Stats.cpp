@@ -0,0 +1,149 @@
+#include <gtest/gtest.h>
+#include <RabBit/utils/debug/Stats.h>
+
+using namespace RB;
+using namespace RB::Utils::Debug;
+
+namespace
+{
+    void ResetStats(uint32_t history_size)
+    {
+        for (uint32_t i = 0; i < (uint32_t)Stat::Count; ++i)
+        {
+            Stats::Set((Stat)i, 0);
+        }
+
+        Stats::SetHistorySize(history_size);
+    }
+}
+
+TEST(StatsTest, CountersAndGauges)
+{
+    ResetStats(8);
+
+    RB_STAT_ADD(DrawCalls, 3);
+    RB_STAT_ADD(DrawCalls, 4);
+    RB_STAT_SET(StreamQueueDepth, 12);
+    Stats::EndFrame(100);
+
+    // Counters start over, gauges keep their value
+    RB_STAT_ADD(DrawCalls, 1);
+    Stats::EndFrame(101);
+
+    List<int64_t> draws;
+    ASSERT_EQ(Stats::GetHistory(Stat::DrawCalls, draws), 2u);
+    ASSERT_EQ(draws[0], 7);
+    ASSERT_EQ(draws[1], 1);
+    ASSERT_EQ(Stats::Get(Stat::DrawCalls), 0);
+
+    List<int64_t> depths;
+    Stats::GetHistory(Stat::StreamQueueDepth, depths);
+    ASSERT_EQ(depths[0], 12);
+    ASSERT_EQ(depths[1], 12);
+
+    ASSERT_STREQ(GetStatInfo(Stat::UploadedBytes).name, "UploadedBytes");
+    ASSERT_TRUE(GetStatInfo(Stat::FrameTime).kind == StatKind::Gauge);
+}
+
+TEST(StatsTest, HistoryWrapsAround)
+{
+    ResetStats(4);
+
+    for (uint32_t frame = 0; frame < 10; ++frame)
+    {
+        RB_STAT_ADD(JobsExecuted, frame);
+        Stats::EndFrame(frame);
+    }
+
+    // Only the newest frames are kept, oldest first
+    List<int64_t> jobs;
+    ASSERT_EQ(Stats::GetHistory(Stat::JobsExecuted, jobs), 4u);
+    ASSERT_EQ(jobs[0], 6);
+    ASSERT_EQ(jobs[3], 9);
+}
+
+TEST(StatsTest, Percentiles)
+{
+    ResetStats(200);
+
+    // 1 to 100, in a shuffled order
+    for (uint32_t i = 0; i < 100; ++i)
+    {
+        RB_STAT_SET(FrameTime, (i * 37) % 100 + 1);
+        Stats::EndFrame(i);
+    }
+
+    StatSummary summary = Stats::GetSummary(Stat::FrameTime);
+    ASSERT_EQ(summary.frameCount, 100u);
+    ASSERT_EQ(summary.min, 1);
+    ASSERT_EQ(summary.max, 100);
+    ASSERT_EQ(summary.p50, 50);
+    ASSERT_EQ(summary.p95, 95);
+    ASSERT_EQ(summary.p99, 99);
+    ASSERT_TRUE(summary.average > 50.49 && summary.average < 50.51);
+
+    ResetStats(200);
+    ASSERT_EQ(Stats::GetSummary(Stat::FrameTime).frameCount, 0u);
+}
+
+TEST(StatsTest, Export)
+{
+    ResetStats(8);
+
+    RB_STAT_ADD(DrawCalls, 5);
+    RB_STAT_ADD(UploadedBytes, 1024);
+    Stats::EndFrame(7);
+
+    RB_STAT_ADD(DrawCalls, 6);
+    Stats::EndFrame(8);
+
+    std::string csv;
+    Stats::WriteCsv(csv);
+
+    ASSERT_EQ(csv.substr(0, csv.find('\n')).find("Frame,FrameTime,"), 0u);
+    ASSERT_TRUE(csv.find("\n7,") != std::string::npos);
+    ASSERT_EQ(std::count(csv.begin(), csv.end(), '\n'), 3);
+
+    std::string json;
+    Stats::WriteJson(json);
+
+    ASSERT_EQ(json.find("{\"frameCount\":2,\"firstFrame\":7,\"stats\":["), 0u);
+    ASSERT_TRUE(json.find("{\"name\":\"DrawCalls\",\"kind\":\"counter\",\"unit\":\"count\",\"min\":5,\"max\":6,\"average\":5.500,\"p50\":5,\"p95\":6,\"p99\":6,\"values\":[5,6]}") != std::string::npos);
+    ASSERT_TRUE(json.find("\"name\":\"UploadedBytes\",\"kind\":\"counter\",\"unit\":\"bytes\"") != std::string::npos);
+    ASSERT_EQ(json.substr(json.size() - 4), "\n]}\n");
+}
+
+TEST(StatsTest, ConcurrentCounters)
+{
+    constexpr uint32_t kThreadCount = 4;
+    constexpr uint32_t kAddCount = 100000;
+
+    ResetStats(8);
+
+    List<std::thread> threads;
+    for (uint32_t i = 0; i < kThreadCount; ++i)
+    {
+        threads.emplace_back([]()
+        {
+            for (uint32_t j = 0; j < kAddCount; ++j)
+            {
+                RB_STAT_ADD(JobsExecuted, 1);
+                RB_STAT_ADD(DescriptorsAllocated, 2);
+            }
+        });
+    }
+
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    Stats::EndFrame(0);
+
+    List<int64_t> jobs, descriptors;
+    Stats::GetHistory(Stat::JobsExecuted, jobs);
+    Stats::GetHistory(Stat::DescriptorsAllocated, descriptors);
+
+    ASSERT_EQ(jobs[0], (int64_t)kThreadCount * kAddCount);
+    ASSERT_EQ(descriptors[0], (int64_t)kThreadCount * kAddCount * 2);
+}
@@ -0,0 +1,395 @@
+#include <gtest/gtest.h>
+#include <RabBit/graphics/ResourceStreamer.h>
+#include <RabBit/graphics/TextureResidency.h>
+
+using namespace RB;
+using namespace RB::Graphics;
+
+// The queue never touches the resources, so fake addresses are fine
+static RenderResource* FakeResource(uintptr_t id)
+{
+    return reinterpret_cast<RenderResource*>(id);
+}
+
+static Streamable MakeStreamable(uintptr_t id, uint64_t size, StreamPriority priority = StreamPriority::Normal)
+{
+    Streamable streamable = {};
+    streamable.resource     = FakeResource(id);
+    streamable.uploadData   = nullptr;
+    streamable.uploadSize   = size;
+    streamable.priority     = priority;
+    return streamable;
+}
+
+TEST(StreamingTest, QueuePriorityOrder)
+{
+    StreamQueue queue;
+    queue.Push(MakeStreamable(1, 16, StreamPriority::Background));
+    queue.Push(MakeStreamable(2, 16, StreamPriority::Normal));
+    queue.Push(MakeStreamable(3, 16, StreamPriority::Critical));
+    queue.Push(MakeStreamable(4, 16, StreamPriority::Visible));
+
+    ASSERT_EQ(queue.GetDepth(), 4u);
+
+    StreamBudget budget = { 1024, 100.0 };
+    Streamable next;
+
+    uint32_t count = 0;
+    uintptr_t expected_order[] = { 3, 4, 2, 1 };
+
+    while (queue.PopNext(budget, 0, 0.0, count, next))
+    {
+        ASSERT_EQ(next.resource, FakeResource(expected_order[count]));
+        count++;
+    }
+
+    ASSERT_EQ(count, 4u);
+    ASSERT_TRUE(queue.IsEmpty());
+}
+
+TEST(StreamingTest, QueueByteBudget)
+{
+    StreamQueue queue;
+    queue.Push(MakeStreamable(1, 600));
+    queue.Push(MakeStreamable(2, 600));
+
+    StreamBudget budget = { 1000, 100.0 };
+    Streamable next;
+
+    // The first one always goes, even if it would not fit on its own
+    ASSERT_TRUE(queue.PopNext(budget, 0, 0.0, 0, next));
+    ASSERT_FALSE(queue.PopNext(budget, 600, 0.0, 1, next));
+    ASSERT_EQ(queue.GetDepth(), 1u);
+
+    // Next frame
+    ASSERT_TRUE(queue.PopNext(budget, 0, 0.0, 0, next));
+    ASSERT_EQ(next.resource, FakeResource(2));
+}
+
+TEST(StreamingTest, QueueTimeBudget)
+{
+    StreamQueue queue;
+    queue.Push(MakeStreamable(1, 1));
+    queue.Push(MakeStreamable(2, 1));
+    queue.Push(MakeStreamable(3, 1, StreamPriority::Critical));
+
+    StreamBudget budget = { 1024, 2.0 };
+    Streamable next;
+
+    ASSERT_TRUE(queue.PopNext(budget, 0, 0.0, 0, next));
+    ASSERT_EQ(next.resource, FakeResource(3));
+
+    // Out of time
+    ASSERT_FALSE(queue.PopNext(budget, 1, 2.5, 1, next));
+
+    // Critical streamables ignore the budget
+    queue.Push(MakeStreamable(4, 1, StreamPriority::Critical));
+    ASSERT_TRUE(queue.PopNext(budget, 1, 2.5, 1, next));
+    ASSERT_EQ(next.resource, FakeResource(4));
+}
+
+TEST(StreamingTest, QueuePromote)
+{
+    StreamQueue queue;
+    queue.Push(MakeStreamable(1, 16));
+    queue.Push(MakeStreamable(2, 16, StreamPriority::Background));
+
+    ASSERT_TRUE(queue.Promote(FakeResource(2), StreamPriority::Visible));
+
+    // Already queued with a higher priority
+    ASSERT_FALSE(queue.Promote(FakeResource(2), StreamPriority::Normal));
+    ASSERT_FALSE(queue.Promote(FakeResource(5), StreamPriority::Visible));
+
+    StreamBudget budget = { 1024, 100.0 };
+    Streamable next;
+
+    ASSERT_TRUE(queue.PopNext(budget, 0, 0.0, 0, next));
+    ASSERT_EQ(next.resource, FakeResource(2));
+    ASSERT_EQ(next.priority, StreamPriority::Visible);
+    ASSERT_EQ(queue.GetDepth(), 1u);
+}
+
+TEST(StreamingTest, QueuePromoteSkipsStaleEntries)
+{
+    StreamQueue queue;
+    queue.Push(MakeStreamable(1, 16, StreamPriority::Background));
+    queue.Push(MakeStreamable(2, 16, StreamPriority::Background));
+
+    ASSERT_TRUE(queue.Promote(FakeResource(1), StreamPriority::Normal));
+    ASSERT_TRUE(queue.Promote(FakeResource(1), StreamPriority::Visible));
+    ASSERT_EQ(queue.GetDepth(), 2u);
+
+    StreamBudget budget = { 1024, 100.0 };
+    Streamable next;
+
+    ASSERT_TRUE(queue.PopNext(budget, 0, 0.0, 0, next));
+    ASSERT_EQ(next.resource, FakeResource(1));
+
+    // Queued again after it was streamed, the entries that were left behind by the promotions are not streamed a second time
+    queue.Push(MakeStreamable(1, 16, StreamPriority::Background));
+
+    uint32_t count = 0;
+    uintptr_t expected_order[] = { 2, 1 };
+
+    while (queue.PopNext(budget, 0, 0.0, count, next))
+    {
+        ASSERT_EQ(next.resource, FakeResource(expected_order[count]));
+        ASSERT_EQ(next.priority, StreamPriority::Background);
+        count++;
+    }
+
+    ASSERT_EQ(count, 2u);
+    ASSERT_TRUE(queue.IsEmpty());
+}
+
+class FakeStreamResource : public RenderResource
+{
+public:
+    FakeStreamResource() : RenderResource(RenderResourceType::VertexBuffer) {}
+
+    const char* GetName() const override { return "Fake stream resource"; }
+    void* GetNativeResource() const override { return nullptr; }
+    RenderResourceFormat GetFormat() const override { return RenderResourceFormat::Unkown; }
+};
+
+TEST(StreamingTest, StagingMemoryCounters)
+{
+    FakeStreamResource copied_resource;
+    FakeStreamResource owned_resource;
+    FakeStreamResource reserved_resource;
+
+    // Nothing is kicked, so no copy interface is needed
+    ResourceStreamer streamer(nullptr, false);
+
+    uint8_t caller_data[64] = {};
+
+    Streamable streamable = {};
+    streamable.resource     = &copied_resource;
+    streamable.uploadData   = caller_data;
+    streamable.uploadSize   = sizeof(caller_data);
+    streamer.ScheduleForStream(streamable);
+
+    ASSERT_FALSE(copied_resource.ReadyToRender());
+
+    // Ownership of the data is handed over, no copy is made
+    streamable.resource     = &owned_resource;
+    streamable.uploadData   = ALLOC_HEAP(128);
+    streamable.uploadSize   = 128;
+    streamer.ScheduleForStream(streamable, StreamDataMode::TakeOwnership);
+
+    // The loader writes directly into the staging memory
+    void* staging = streamer.ReserveStagingMemory(256);
+    memset(staging, 0xFF, 256);
+
+    StreamingStats stats = streamer.GetStats();
+    ASSERT_EQ(stats.stagingBytesInUse, 64u + 128u + 256u);
+
+    streamable.resource     = &reserved_resource;
+    streamable.uploadData   = staging;
+    streamable.uploadSize   = 256;
+    streamer.ScheduleForStream(streamable, StreamDataMode::TakeOwnership);
+
+    stats = streamer.GetStats();
+    ASSERT_EQ(stats.queueDepth, 3u);
+    ASSERT_EQ(stats.totalBytesCopied, 64u);
+    ASSERT_EQ(stats.stagingBytesInUse, 64u + 128u + 256u);
+    ASSERT_EQ(stats.peakStagingBytes, 64u + 128u + 256u);
+
+    // Reserved memory that is not used is given back
+    void* unused = streamer.ReserveStagingMemory(512);
+    streamer.ReleaseStagingMemory(unused);
+
+    stats = streamer.GetStats();
+    ASSERT_EQ(stats.stagingBytesInUse, 64u + 128u + 256u);
+    ASSERT_EQ(stats.peakStagingBytes, 64u + 128u + 256u + 512u);
+}
+
+TEST(StreamingTest, ResidencyStateTransitions)
+{
+    FakeStreamResource resource;
+    FakeStreamResource fallback;
+
+    // Resources without initial data can be used directly
+    ASSERT_EQ(resource.GetResidencyState(), ResidencyState::Resident);
+    ASSERT_TRUE(resource.ReadyToRender());
+
+    ResourceStreamer streamer(nullptr, false);
+
+    uint8_t data[16] = {};
+
+    Streamable streamable = {};
+    streamable.resource     = &resource;
+    streamable.uploadData   = data;
+    streamable.uploadSize   = sizeof(data);
+    streamer.ScheduleForStream(streamable);
+
+    ASSERT_EQ(resource.GetResidencyState(), ResidencyState::Pending);
+    ASSERT_TRUE(resource.IsStreaming());
+    ASSERT_EQ(ResidentOr<RenderResource>(&resource, &fallback), &fallback);
+    ASSERT_EQ(ResidentOr<RenderResource>(&resource, nullptr), nullptr);
+
+    // Can not be evicted while it is streaming
+    ASSERT_FALSE(resource.TransitionResidency(ResidencyState::Resident, ResidencyState::Evicting));
+
+    // What the streamer does when recording and finishing the upload
+    ASSERT_TRUE(resource.TransitionResidency(ResidencyState::Pending, ResidencyState::Uploading));
+    ASSERT_FALSE(resource.ReadyToRender());
+    ASSERT_TRUE(resource.TransitionResidency(ResidencyState::Uploading, ResidencyState::Resident));
+    ASSERT_EQ(ResidentOr<RenderResource>(&resource, &fallback), &resource);
+
+    ASSERT_TRUE(resource.TransitionResidency(ResidencyState::Resident, ResidencyState::Evicting));
+    ASSERT_FALSE(resource.ReadyToRender());
+    ASSERT_FALSE(resource.IsStreaming());
+
+    ASSERT_TRUE(IsValidResidencyTransition(ResidencyState::Resident, ResidencyState::Pending));
+    ASSERT_FALSE(IsValidResidencyTransition(ResidencyState::Pending, ResidencyState::Resident));
+    ASSERT_FALSE(IsValidResidencyTransition(ResidencyState::Evicting, ResidencyState::Resident));
+}
+
+TEST(StreamingTest, MipMath)
+{
+    ASSERT_EQ(GetMipLevelCount(1, 1), 1u);
+    ASSERT_EQ(GetMipLevelCount(256, 256), 9u);
+    ASSERT_EQ(GetMipLevelCount(256, 64), 9u);
+
+    ASSERT_EQ(GetMipSize(256, 64, 4, 7), 2u * 1u * 4u);
+    ASSERT_EQ(GetMipChainSize(4, 4, 4, 0, 3), 64u + 16u + 4u);
+    ASSERT_EQ(GetMipChainSize(4, 4, 4, 1, 3), 16u + 4u);
+
+    ASSERT_EQ(GetDesiredMip(1024, 1024, 11, 2048.0f), 0u);
+    ASSERT_EQ(GetDesiredMip(1024, 1024, 11, 1024.0f), 0u);
+    ASSERT_EQ(GetDesiredMip(1024, 1024, 11, 300.0f), 1u);
+    ASSERT_EQ(GetDesiredMip(1024, 1024, 11, 256.0f), 2u);
+    ASSERT_EQ(GetDesiredMip(1024, 1024, 11, 0.0f), 10u);
+}
+
+// Finishes all the actions of the policy directly, until nothing changes anymore
+static uint32_t SettleResidency(TextureResidencyPolicy& policy, uint64_t frame_index, uint64_t budget)
+{
+    List<TextureResidencyAction> actions;
+    uint32_t total_actions = 0;
+
+    do
+    {
+        actions.clear();
+        policy.Update(frame_index, budget, actions);
+
+        for (const TextureResidencyAction& action : actions)
+        {
+            policy.SetResidentMip(action.id, action.mip);
+        }
+
+        total_actions += actions.size();
+    }
+    while (!actions.empty());
+
+    return total_actions;
+}
+
+TEST(StreamingTest, ResidencyLoadsCoarsestFirst)
+{
+    TextureResidencyPolicy policy;
+    StreamedTextureID id = policy.Register(1024, 1024, 11, 4);
+
+    // 1024 >> 4 == kTextureResidencyTailSize
+    ASSERT_EQ(policy.GetTailMip(id), 4u);
+    ASSERT_EQ(policy.GetResidentMip(id), 11u);
+
+    policy.RequestMip(id, 0, 0);
+
+    List<TextureResidencyAction> actions;
+    uint32_t expected_mip = 4;
+
+    while (true)
+    {
+        actions.clear();
+        policy.Update(0, UINT64_MAX, actions);
+
+        if (actions.empty())
+        {
+            break;
+        }
+
+        ASSERT_EQ(actions.size(), 1u);
+        ASSERT_EQ(actions[0].type, TextureResidencyActionType::Load);
+        ASSERT_EQ(actions[0].mip, expected_mip);
+        ASSERT_TRUE(actions[0].visible);
+
+        // Nothing new is started while the previous action is still pending
+        List<TextureResidencyAction> pending_actions;
+        policy.Update(0, UINT64_MAX, pending_actions);
+        ASSERT_TRUE(pending_actions.empty());
+
+        policy.SetResidentMip(id, actions[0].mip);
+        expected_mip--;
+    }
+
+    ASSERT_EQ(policy.GetResidentMip(id), 0u);
+    ASSERT_EQ(policy.GetResidentBytes(), GetMipChainSize(1024, 1024, 4, 0, 11));
+}
+
+TEST(StreamingTest, ResidencyBudgetEvictsLeastRecentlyUsed)
+{
+    TextureResidencyPolicy policy;
+    StreamedTextureID old_id = policy.Register(256, 256, 9, 4);
+    StreamedTextureID new_id = policy.Register(256, 256, 9, 4);
+
+    policy.RequestMip(old_id, 0, 0);
+    policy.RequestMip(new_id, 0, 0);
+    SettleResidency(policy, 0, UINT64_MAX);
+
+    ASSERT_EQ(policy.GetResidentMip(old_id), 0u);
+    ASSERT_EQ(policy.GetResidentMip(new_id), 0u);
+
+    // Only one of the textures fits completely next to the tail of the other
+    uint64_t budget = GetMipChainSize(256, 256, 4, 0, 9) + GetMipChainSize(256, 256, 4, 2, 9);
+
+    policy.RequestMip(new_id, 0, 1);
+
+    List<TextureResidencyAction> actions;
+    policy.Update(1, budget, actions);
+
+    ASSERT_EQ(actions.size(), 1u);
+    ASSERT_EQ(actions[0].id, old_id);
+    ASSERT_EQ(actions[0].type, TextureResidencyActionType::Evict);
+    ASSERT_EQ(actions[0].mip, policy.GetTailMip(old_id));
+
+    policy.SetResidentMip(old_id, actions[0].mip);
+    ASSERT_LE(policy.GetResidentBytes(), budget);
+
+    // Requesting the old texture again does not go over the budget, so it can only load the mips that still fit
+    policy.RequestMip(old_id, 0, 2);
+    policy.RequestMip(new_id, 0, 2);
+    SettleResidency(policy, 2, budget);
+
+    ASSERT_LE(policy.GetResidentBytes(), budget);
+    ASSERT_EQ(policy.GetResidentMip(new_id) + policy.GetResidentMip(old_id), policy.GetTailMip(old_id));
+}
+
+TEST(StreamingTest, ResidencyUnusedDropsToTail)
+{
+    TextureResidencyPolicy policy;
+    StreamedTextureID id = policy.Register(512, 256, 10, 4);
+
+    // A texture that is never requested only gets its tail
+    ASSERT_EQ(SettleResidency(policy, 0, UINT64_MAX), 1u);
+    ASSERT_EQ(policy.GetResidentMip(id), policy.GetTailMip(id));
+
+    // Multiple views can request the same texture, the finest mip wins
+    policy.RequestMip(id, 3, 1);
+    policy.RequestMip(id, 1, 1);
+    policy.RequestMip(id, 2, 1);
+    SettleResidency(policy, 1, UINT64_MAX);
+    ASSERT_EQ(policy.GetResidentMip(id), 1u);
+
+    // Still recently used
+    ASSERT_EQ(SettleResidency(policy, 1 + kTextureResidencyUnusedFrames, UINT64_MAX), 0u);
+
+    List<TextureResidencyAction> actions;
+    policy.Update(2 + kTextureResidencyUnusedFrames, UINT64_MAX, actions);
+
+    ASSERT_EQ(actions.size(), 1u);
+    ASSERT_EQ(actions[0].type, TextureResidencyActionType::Evict);
+    ASSERT_EQ(actions[0].mip, policy.GetTailMip(id));
+    ASSERT_FALSE(actions[0].visible);
+}
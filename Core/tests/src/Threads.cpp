@@ -378,4 +378,187 @@ TEST(ThreadTest, PrioritizationCancelTest)
 TEST(ThreadTest, UltimatePrioritizationCancelSyncTest)
 {
     
-}
\ No newline at end of file
+}
+
+TEST(ThreadTest, PoolRunsAllJobs)
+{
+    std::atomic<int> result = 0;
+
+    struct Data : JobData
+    {
+        std::atomic<int>* var;
+    };
+
+    auto job_test = [](JobData* data)
+    {
+        Sleep(10);
+
+        Data* d = (Data*)data;
+        d->var->fetch_add(1);
+    };
+
+    WorkerPool pool(L"test", 4);
+    JobTypeID job_type = pool.AddJobType(job_test);
+
+    for (int i = 0; i < 100; i++)
+    {
+        Data* data = new Data();
+        data->var = &result;
+        pool.ScheduleJob(job_type, data);
+    }
+
+    pool.SyncAll();
+
+    ASSERT_EQ(result.load(), 100);
+}
+
+TEST(ThreadTest, PoolSyncRunsPendingJob)
+{
+    struct Data : JobData
+    {
+        DWORD* threadId;
+    };
+
+    DWORD blocker_thread = 0;
+    DWORD synced_thread = 0;
+
+    auto job_test = [](JobData* data)
+    {
+        Data* d = (Data*)data;
+        *d->threadId = GetCurrentThreadId();
+    };
+
+    auto blocking_job = [](JobData* data)
+    {
+        Sleep(1000);
+
+        Data* d = (Data*)data;
+        *d->threadId = GetCurrentThreadId();
+    };
+
+    WorkerPool pool(L"test", 1);
+    JobTypeID job_type = pool.AddJobType(job_test);
+    JobTypeID blocking_type = pool.AddJobType(blocking_job);
+
+    Data* blocker = new Data();
+    blocker->threadId = &blocker_thread;
+    JobID blocker_job = pool.ScheduleJob(blocking_type, blocker);
+
+    Data* synced = new Data();
+    synced->threadId = &synced_thread;
+    JobID synced_job = pool.ScheduleJob(job_type, synced);
+
+    Sleep(50);
+
+    // The only worker is busy, so the sync does the job on this thread instead of waiting on the blocking job
+    pool.Sync(synced_job);
+
+    ASSERT_EQ(pool.IsFinished(synced_job), true);
+    ASSERT_EQ(pool.IsFinished(blocker_job), false);
+    ASSERT_EQ(synced_thread, GetCurrentThreadId());
+
+    pool.Sync(blocker_job);
+
+    ASSERT_EQ(pool.IsFinished(blocker_job), true);
+    ASSERT_NE(blocker_thread, GetCurrentThreadId());
+}
+
+TEST(ThreadTest, PoolScheduleFromJobs)
+{
+    std::atomic<int> result = 0;
+
+    struct Data : JobData
+    {
+        WorkerPool*       pool;
+        JobTypeID         type;
+        std::atomic<int>* var;
+        int               depth;
+    };
+
+    // Every job schedules 2 new ones until the depth is reached
+    auto job_test = [](JobData* data)
+    {
+        Data* d = (Data*)data;
+        d->var->fetch_add(1);
+
+        if (d->depth == 0)
+        {
+            return;
+        }
+
+        for (int i = 0; i < 2; i++)
+        {
+            Data* child = new Data(*d);
+            child->depth = d->depth - 1;
+            d->pool->ScheduleJob(d->type, child);
+        }
+    };
+
+    WorkerPool pool(L"test", 3);
+    JobTypeID job_type = pool.AddJobType(job_test);
+
+    Data* root = new Data();
+    root->pool  = &pool;
+    root->type  = job_type;
+    root->var   = &result;
+    root->depth = 6;
+    pool.ScheduleJob(job_type, root);
+
+    pool.SyncAll();
+
+    ASSERT_EQ(result.load(), 127);
+}
+
+TEST(ThreadTest, PoolPrioritizeJob)
+{
+    struct Data : JobData
+    {
+        List<int>*  order;
+        int         value;
+    };
+
+    List<int> order;
+
+    auto job_test = [](JobData* data)
+    {
+        Data* d = (Data*)data;
+        d->order->push_back(d->value);
+    };
+
+    auto blocking_job = [](JobData* data)
+    {
+        Sleep(200);
+    };
+
+    WorkerPool pool(L"test", 1);
+    JobTypeID job_type = pool.AddJobType(job_test);
+    JobTypeID blocking_type = pool.AddJobType(blocking_job);
+
+    pool.ScheduleJob(blocking_type, new Data());
+    Sleep(50);
+
+    JobID jobs[4];
+    for (int i = 0; i < 4; i++)
+    {
+        Data* data = new Data();
+        data->order = &order;
+        data->value = i;
+        jobs[i] = pool.ScheduleJob(job_type, data);
+    }
+
+    // While the only worker is busy: 3 goes first, 1 is taken out of the queue by the sync and is not run again
+    pool.PrioritizeJob(jobs[3]);
+    pool.Sync(jobs[1]);
+    pool.PrioritizeJob(jobs[1]);
+
+    ASSERT_EQ(pool.IsFinished(jobs[1]), true);
+    ASSERT_EQ(pool.IsFinished(jobs[3]), false);
+
+    pool.SyncAll();
+
+    ASSERT_EQ(order.size(), 4);
+    ASSERT_EQ(order[0], 1);
+    ASSERT_EQ(order[1], 3);
+    ASSERT_EQ(order[2], 0);
+    ASSERT_EQ(order[3], 2);
+}
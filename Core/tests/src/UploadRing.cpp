@@ -0,0 +1,134 @@
+#include <gtest/gtest.h>
+#include <RabBit/graphics/UploadRing.h>
+
+#include <thread>
+#include <mutex>
+
+using namespace RB;
+using namespace RB::Graphics;
+
+TEST(UploadRingTest, AllocateAligned)
+{
+    UploadRing ring(1024);
+
+    ASSERT_EQ(ring.Allocate(10, 1), 0u);
+    ASSERT_EQ(ring.Allocate(16, 16), 16u);
+    ASSERT_EQ(ring.Allocate(1, 256), 256u);
+
+    UploadRingStats stats = ring.GetStats();
+    ASSERT_EQ(stats.size, 1024u);
+    ASSERT_EQ(stats.usedBytes, 257u);
+    ASSERT_EQ(stats.overflowCount, 0u);
+}
+
+TEST(UploadRingTest, TextureUpload)
+{
+    // Like UploadDataToResource: a buffer upload followed by a texture upload, which is aligned to the texture data placement (512)
+    UploadRing ring(4096);
+
+    ASSERT_EQ(ring.Allocate(100, 1), 0u);
+    ASSERT_EQ(ring.Allocate(1000, 512), 512u);
+
+    // Buffers are created in the common state, textures as copy destination
+    ASSERT_TRUE(IsUploadDestinationState(RenderResourceType::Buffer, ResourceState::COMMON));
+    ASSERT_FALSE(IsUploadDestinationState(RenderResourceType::Buffer, ResourceState::COPY_DEST));
+    ASSERT_TRUE(IsUploadDestinationState(RenderResourceType::Texture, ResourceState::COPY_DEST));
+    ASSERT_TRUE(IsUploadDestinationState(RenderResourceType::Texture, ResourceState::COMMON));
+    ASSERT_FALSE(IsUploadDestinationState(RenderResourceType::Texture, ResourceState::PIXEL_SHADER_RESOURCE));
+}
+
+TEST(UploadRingTest, FullRingOverflows)
+{
+    UploadRing ring(256);
+
+    ASSERT_EQ(ring.Allocate(200, 1), 0u);
+    ASSERT_EQ(ring.Allocate(100, 1), kInvalidRingOffset);
+    ASSERT_EQ(ring.Allocate(512, 1), kInvalidRingOffset);
+
+    UploadRingStats stats = ring.GetStats();
+    ASSERT_EQ(stats.overflowCount, 2u);
+    ASSERT_EQ(stats.overflowBytes, 612u);
+    ASSERT_EQ(stats.usedBytes, 200u);
+}
+
+TEST(UploadRingTest, RetireByFence)
+{
+    UploadRing ring(256);
+
+    ASSERT_EQ(ring.Allocate(100, 1), 0u);
+    ring.Submit(1);
+    ASSERT_EQ(ring.Allocate(100, 1), 100u);
+    ring.Submit(2);
+
+    // Nothing allocated, so this submission should not keep anything alive
+    ring.Submit(3);
+
+    ASSERT_EQ(ring.Allocate(100, 1), kInvalidRingOffset);
+
+    ring.Retire(0);
+    ASSERT_EQ(ring.GetStats().usedBytes, 200u);
+
+    ring.Retire(1);
+    ASSERT_EQ(ring.GetStats().usedBytes, 100u);
+
+    // Does not fit at the end anymore, so it wraps around to the start of the buffer
+    ASSERT_EQ(ring.Allocate(100, 1), 0u);
+    ring.Submit(4);
+
+    UploadRingStats stats = ring.GetStats();
+    ASSERT_EQ(stats.usedBytes, 256u);
+    ASSERT_EQ(stats.highWaterMark, 256u);
+
+    ring.Retire(4);
+    stats = ring.GetStats();
+    ASSERT_EQ(stats.usedBytes, 0u);
+    ASSERT_EQ(stats.highWaterMark, 256u);
+
+    ring.ResetHighWaterMark();
+    ASSERT_EQ(ring.GetStats().highWaterMark, 0u);
+}
+
+TEST(UploadRingTest, ConcurrentAllocationsDoNotOverlap)
+{
+    constexpr uint32_t kThreadCount     = 8;
+    constexpr uint32_t kAllocationCount = 1000;
+    constexpr uint64_t kAllocationSize  = 64;
+
+    UploadRing ring(kThreadCount * kAllocationCount * kAllocationSize);
+
+    std::mutex offsets_mutex;
+    std::vector<uint64_t> offsets;
+
+    std::vector<std::thread> threads;
+    for (uint32_t t = 0; t < kThreadCount; ++t)
+    {
+        threads.emplace_back([&]()
+        {
+            std::vector<uint64_t> local;
+            for (uint32_t i = 0; i < kAllocationCount; ++i)
+            {
+                local.push_back(ring.Allocate(kAllocationSize, 16));
+            }
+
+            std::lock_guard<std::mutex> lock(offsets_mutex);
+            offsets.insert(offsets.end(), local.begin(), local.end());
+        });
+    }
+
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    ASSERT_EQ(offsets.size(), kThreadCount * kAllocationCount);
+
+    std::sort(offsets.begin(), offsets.end());
+
+    for (uint64_t i = 0; i < offsets.size(); ++i)
+    {
+        ASSERT_NE(offsets[i], kInvalidRingOffset);
+        ASSERT_EQ(offsets[i], i * kAllocationSize);
+    }
+
+    ASSERT_EQ(ring.GetStats().overflowCount, 0u);
+}